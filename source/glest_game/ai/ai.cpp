@@ -16,6 +16,7 @@
 #include "unit.h"
 #include "map.h"
 #include "faction_type.h"
+#include "config.h"
 #include "leak_dumper.h"
 
 using namespace Shared::Graphics;
@@ -314,6 +315,19 @@ void Ai::init(AiInterface *aiInterface, int useStartLocation) {
 	aiRules.push_back(new AiRuleExpand(this));
 	aiRules.push_back(new AiRuleRepair(this));
 	aiRules.push_back(new AiRuleRepair(this));
+
+	deferredAiRuleList.clear();
+	deferredAiRuleCount = 0;
+	aiRuleTimeBudgetMicroseconds = Config::getInstance().getInt("AiRuleTimeBudgetMicroseconds","5000");
+
+	// Without server controlled AI every player runs the CPU factions
+	// itself, each on its own clock, so a time budget would defer different
+	// rules on each of them and the game would go out of synch
+	const GameSettings *settings = aiInterface->getWorld()->getGameSettings();
+	if(settings != NULL && settings->isNetworkGame() == true &&
+		settings->getEnableServerControlledAI() == false) {
+		aiRuleTimeBudgetMicroseconds = 0;
+	}
 }
 
 Ai::~Ai() {
@@ -393,8 +407,24 @@ void Ai::update() {
 		aiInterface->giveCommandSwitchTeamVote(aiInterface->getMyFaction(),voteResult);
 	}
 
-	//process ai rules
+	//process ai rules, ones deferred on earlier frames go first
+	std::vector<int> dueAiRuleList;
+	dueAiRuleList.swap(deferredAiRuleList);
 	for(unsigned int ruleIdx = 0; ruleIdx < aiRules.size(); ++ruleIdx) {
+		if(isAiRuleDue(ruleIdx) == true &&
+			std::find(dueAiRuleList.begin(),dueAiRuleList.end(),(int)ruleIdx) == dueAiRuleList.end()) {
+			dueAiRuleList.push_back(ruleIdx);
+		}
+	}
+
+	// The time budget is only set when this player alone decides the AI
+	// commands, see init()
+	Chrono chronoBudget;
+	chronoBudget.start();
+	bool ranAiRule = false;
+
+	for(unsigned int dueIdx = 0; dueIdx < dueAiRuleList.size(); ++dueIdx) {
+		int ruleIdx = dueAiRuleList[dueIdx];
 		AiRule *rule = aiRules[ruleIdx];
 		if(rule == NULL) {
 			throw megaglest_runtime_error("rule == NULL");
@@ -402,23 +432,32 @@ void Ai::update() {
 
 		if(SystemFlags::getSystemSettingType(SystemFlags::debugPerformance).enabled && chrono.getMillis() > 0) SystemFlags::OutputDebug(SystemFlags::debugPerformance,"In [%s::%s Line: %d] took msecs: %lld [ruleIdx = %d]\n",__FILE__,__FUNCTION__,__LINE__,chrono.getMillis(),ruleIdx);
 
-		if((aiInterface->getTimer() % (rule->getTestInterval() * GameConstants::updateFps / 1000)) == 0) {
+		// Always run at least one rule per update so deferred work drains
+		if(aiRuleTimeBudgetMicroseconds > 0 && ranAiRule == true &&
+			rule->isDeferrable() == true &&
+			chronoBudget.getMicros() >= aiRuleTimeBudgetMicroseconds) {
 
-			if(SystemFlags::getSystemSettingType(SystemFlags::debugPerformance).enabled && chrono.getMillis() > 0) SystemFlags::OutputDebug(SystemFlags::debugPerformance,"In [%s::%s Line: %d] took msecs: %lld [ruleIdx = %d, before rule->test()]\n",__FILE__,__FUNCTION__,__LINE__,chrono.getMillis(),ruleIdx);
+			deferredAiRuleList.push_back(ruleIdx);
+			deferredAiRuleCount++;
+			aiInterface->printLog(4, intToStr(1000 * aiInterface->getTimer() / GameConstants::updateFps) + ": Deferred rule: " + rule->getName() + " total deferred: " + intToStr(deferredAiRuleCount) + '\n');
+			continue;
+		}
+		ranAiRule = true;
 
-			//printf("Testing AI Faction # %d RULE Name[%s]\n",aiInterface->getFactionIndex(),rule->getName().c_str());
+		if(SystemFlags::getSystemSettingType(SystemFlags::debugPerformance).enabled && chrono.getMillis() > 0) SystemFlags::OutputDebug(SystemFlags::debugPerformance,"In [%s::%s Line: %d] took msecs: %lld [ruleIdx = %d, before rule->test()]\n",__FILE__,__FUNCTION__,__LINE__,chrono.getMillis(),ruleIdx);
 
-			if(rule->test()) {
-				if(outputAIBehaviourToConsole()) printf("\n\nYYYYY Executing AI Faction # %d RULE Name[%s]\n\n",aiInterface->getFactionIndex(),rule->getName().c_str());
+		//printf("Testing AI Faction # %d RULE Name[%s]\n",aiInterface->getFactionIndex(),rule->getName().c_str());
 
-				aiInterface->printLog(3, intToStr(1000 * aiInterface->getTimer() / GameConstants::updateFps) + ": Executing rule: " + rule->getName() + '\n');
+		if(rule->test()) {
+			if(outputAIBehaviourToConsole()) printf("\n\nYYYYY Executing AI Faction # %d RULE Name[%s]\n\n",aiInterface->getFactionIndex(),rule->getName().c_str());
 
-				if(SystemFlags::getSystemSettingType(SystemFlags::debugPerformance).enabled && chrono.getMillis() > 0) SystemFlags::OutputDebug(SystemFlags::debugPerformance,"In [%s::%s Line: %d] took msecs: %lld [ruleIdx = %d, before rule->execute() [%s]]\n",__FILE__,__FUNCTION__,__LINE__,chrono.getMillis(),ruleIdx,rule->getName().c_str());
+			aiInterface->printLog(3, intToStr(1000 * aiInterface->getTimer() / GameConstants::updateFps) + ": Executing rule: " + rule->getName() + '\n');
 
-				rule->execute();
+			if(SystemFlags::getSystemSettingType(SystemFlags::debugPerformance).enabled && chrono.getMillis() > 0) SystemFlags::OutputDebug(SystemFlags::debugPerformance,"In [%s::%s Line: %d] took msecs: %lld [ruleIdx = %d, before rule->execute() [%s]]\n",__FILE__,__FUNCTION__,__LINE__,chrono.getMillis(),ruleIdx,rule->getName().c_str());
 
-				if(SystemFlags::getSystemSettingType(SystemFlags::debugPerformance).enabled && chrono.getMillis() > 0) SystemFlags::OutputDebug(SystemFlags::debugPerformance,"In [%s::%s Line: %d] took msecs: %lld [ruleIdx = %d, after rule->execute() [%s]]\n",__FILE__,__FUNCTION__,__LINE__,chrono.getMillis(),ruleIdx,rule->getName().c_str());
-			}
+			rule->execute();
+
+			if(SystemFlags::getSystemSettingType(SystemFlags::debugPerformance).enabled && chrono.getMillis() > 0) SystemFlags::OutputDebug(SystemFlags::debugPerformance,"In [%s::%s Line: %d] took msecs: %lld [ruleIdx = %d, after rule->execute() [%s]]\n",__FILE__,__FUNCTION__,__LINE__,chrono.getMillis(),ruleIdx,rule->getName().c_str());
 		}
 	}
 
@@ -426,32 +465,25 @@ void Ai::update() {
 }
 
 
+// Each faction and rule gets a fixed phase offset so several AI players
+// created on the same frame don't all run the same rules together
+bool Ai::isAiRuleDue(int ruleIdx) const {
+	int testIntervalFrames = aiRules[ruleIdx]->getTestInterval() * GameConstants::updateFps / 1000;
+	if(testIntervalFrames <= 0) {
+		return true;
+	}
+	int phaseOffset = aiInterface->getFactionIndex() * (GameConstants::updateFps / GameConstants::maxPlayers) + ruleIdx;
+	return ((aiInterface->getTimer() + phaseOffset) % testIntervalFrames) == 0;
+}
+
 // ==================== state requests ====================
 
 int Ai::getCountOfType(const UnitType *ut){
-    int count= 0;
-	for(int i=0; i<aiInterface->getMyUnitCount(); ++i){
-		if(ut == aiInterface->getMyUnit(i)->getType()){
-			count++;
-		}
-	}
-    return count;
+	return aiInterface->getMyUnitCountOfType(ut);
 }
 
 int Ai::getCountOfClass(UnitClass uc,UnitClass *additionalUnitClassToExcludeFromCount) {
-    int count= 0;
-    for(int i = 0; i < aiInterface->getMyUnitCount(); ++i) {
-		if(aiInterface->getMyUnit(i)->getType()->isOfClass(uc)) {
-			// Skip unit if it ALSO contains the exclusion unit class type
-			if(additionalUnitClassToExcludeFromCount != NULL) {
-				if(aiInterface->getMyUnit(i)->getType()->isOfClass(*additionalUnitClassToExcludeFromCount)) {
-					continue;
-				}
-			}
-            ++count;
-		}
-    }
-    return count;
+	return aiInterface->getMyUnitCountOfClass(uc,additionalUnitClassToExcludeFromCount);
 }
 
 float Ai::getRatioOfClass(UnitClass uc,UnitClass *additionalUnitClassToExcludeFromCount) {
@@ -168,7 +168,14 @@ private:
 	std::map<int,int> factionSwitchTeamRequestCount;
 	int minWarriors;
 
+	// Rules that were due but put off because this frame's time budget
+	// was used up, they run first on the next update
+	std::vector<int> deferredAiRuleList;
+	int64 aiRuleTimeBudgetMicroseconds;
+	int64 deferredAiRuleCount;
+
 	bool getAdjacentUnits(std::map<float, std::map<int, const Unit *> > &signalAdjacentUnits, const Unit *unit);
+	bool isAiRuleDue(int ruleIdx) const;
 
 public: 
 	Ai() {
@@ -190,6 +197,8 @@ public:
 	    startLoc 				 = -1;
 	    randomMinWarriorsReached = false;
 	    minWarriors 			 = 0;
+	    aiRuleTimeBudgetMicroseconds = 0;
+	    deferredAiRuleCount		 = 0;
 	}
     ~Ai();
 
@@ -202,6 +211,7 @@ public:
     int getCountOfType(const UnitType *ut);
 	
     int getMinWarriors() const { return minWarriors; }
+    int64 getDeferredAiRuleCount() const { return deferredAiRuleCount; }
 
 	int getCountOfClass(UnitClass uc,UnitClass *additionalUnitClassToExcludeFromCount=NULL);
 	float getRatioOfClass(UnitClass uc,UnitClass *additionalUnitClassToExcludeFromCount=NULL);
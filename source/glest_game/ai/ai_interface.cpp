@@ -110,7 +110,7 @@ bool AiInterfaceThread::isSignalCompleted(int frameIndex) {
 
 void AiInterfaceThread::signalQuit() {
 	if(this->aiIntf != NULL) {
-		MutexSafeWrapper safeMutex(this->aiIntf->getMutex(),string(__FILE__) + "_" + intToStr(__LINE__));
+		MutexSafeWrapper safeMutex(this->aiIntf->getMutex(),CODE_AT_LINE);
 		this->aiIntf = NULL;
 	}
 
@@ -154,7 +154,7 @@ void AiInterfaceThread::execute() {
             if(executeTask == true) {
 				ExecutingTaskSafeWrapper safeExecutingTaskMutex(this);
 
-				MutexSafeWrapper safeMutex(this->aiIntf->getMutex(),string(__FILE__) + "_" + intToStr(__LINE__));
+				MutexSafeWrapper safeMutex(this->aiIntf->getMutex(),CODE_AT_LINE);
 
 				this->aiIntf->update();
 
@@ -319,7 +319,7 @@ void AiInterface::printLog(int logLevel, const string &s){
     if(isLogLevelEnabled(logLevel) == true) {
 		string logString= "(" + intToStr(factionIndex) + ") " + s;
 
-		MutexSafeWrapper safeMutex(aiMutex,string(__FILE__) + "_" + intToStr(__LINE__));
+		MutexSafeWrapper safeMutex(aiMutex,CODE_AT_LINE);
 		//print log to file
 		if(fp != NULL) {
 			fprintf(fp, "%s\n", logString.c_str());
@@ -595,6 +595,14 @@ int AiInterface::getMyUnitCount() const{
 	return world->getFaction(factionIndex)->getUnitCount();
 }
 
+int AiInterface::getMyUnitCountOfType(const UnitType *ut) const{
+	return world->getFaction(factionIndex)->getCountOfUnitType(ut);
+}
+
+int AiInterface::getMyUnitCountOfClass(UnitClass uc,const UnitClass *additionalUnitClassToExcludeFromCount) const{
+	return world->getFaction(factionIndex)->getCountOfUnitClass(uc,additionalUnitClassToExcludeFromCount);
+}
+
 int AiInterface::getMyUpgradeCount() const{
 	return world->getFaction(factionIndex)->getUpgradeManager()->getUpgradeCount();
 }
@@ -780,9 +788,17 @@ bool AiInterface::getNearestSightedResource(const ResourceType *rt, const Vec2i
 		bool isResourceClose = isResourceNear(pos, rt, resultPos, faction, true);
 
 		// Found a resource
+		Vec2i nearestResourcePos;
 		if(isResourceClose == true || resultPos.x >= 0) {
 			anyResource= true;
 		}
+		// The nearest one by walking distance if this team has seen it,
+		// otherwise look through every explored cell
+		else if(world->getMapPtr()->getNearestResource(pos, rt, nearestResourcePos) == true &&
+				world->getMap()->getSurfaceCell(Map::toSurfCoords(nearestResourcePos))->isExplored(teamIndex) == true) {
+			anyResource= true;
+			resultPos= nearestResourcePos;
+		}
 		else {
 			const Map *map		= world->getMap();
 			for(int i = 0; i < map->getW(); ++i) {
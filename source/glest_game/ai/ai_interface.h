@@ -113,6 +113,7 @@ public:
 	//get
 	int getTimer() const		{return timer;}
 	int getFactionIndex() const	{return factionIndex;}
+	int64 getDeferredAiRuleCount() const	{return ai.getDeferredAiRuleCount();}
 
     //misc
     void printLog(int logLevel, const string &s);
@@ -133,6 +134,8 @@ public:
     Vec2i getStartLocation(int locationIndex);
     int getFactionCount();
     int getMyUnitCount() const;
+    int getMyUnitCountOfType(const UnitType *ut) const;
+    int getMyUnitCountOfClass(UnitClass uc,const UnitClass *additionalUnitClassToExcludeFromCount=NULL) const;
 	int getMyUpgradeCount() const;
     //int onSightUnitCount();
     const Resource *getResource(const ResourceType *rt);
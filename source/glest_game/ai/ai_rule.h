@@ -54,6 +54,7 @@ public:
 
 	virtual int getTestInterval() const= 0;	//in milliseconds
 	virtual string getName() const= 0;
+	virtual bool isDeferrable() const	{return true;}	//can wait a frame when the AI is over its time budget
 
 	virtual bool test()= 0;
 	virtual void execute()= 0;
@@ -167,6 +168,7 @@ public:
 	
 	virtual int getTestInterval() const	{return 1000;}
 	virtual string getName() const		{return "Unit under attack => Order massive attack";}
+	virtual bool isDeferrable() const	{return false;}
 
 	virtual bool test();
 	virtual void execute();
@@ -37,6 +37,7 @@ namespace Glest{ namespace Game{
 Commander::Commander() {
 	this->world					= NULL;
 	this->pauseNetworkCommands 	= false;
+	this->replayCommandListIndex	= 0;
 }
 
 Commander::~Commander() {
@@ -487,20 +488,25 @@ void Commander::signalNetworkUpdate(Game *game) {
 
 bool Commander::getReplayCommandListForFrame(int worldFrameCount) {
 	bool haveReplyCommands = false;
-	if(replayCommandList.empty() == false) {
-		if(SystemFlags::VERBOSE_MODE_ENABLED) printf("worldFrameCount = %d replayCommandList.size() = " MG_SIZE_T_SPECIFIER "\n",worldFrameCount,replayCommandList.size());
+	if(hasReplayCommandListForFrame() == true) {
+		if(SystemFlags::VERBOSE_MODE_ENABLED) printf("worldFrameCount = %d replayCommandList.size() = %d\n",worldFrameCount,getReplayCommandListForFrameCount());
 
+		// Commands are recorded in frame order so only look at the head of the list
 		std::vector<NetworkCommand> replayList;
-		for(unsigned int i = 0; i < replayCommandList.size(); ++i) {
-			std::pair<int,NetworkCommand> &cmd = replayCommandList[i];
-			if(cmd.first <= worldFrameCount) {
-				replayList.push_back(cmd.second);
-				haveReplyCommands = true;
+		for(; replayCommandListIndex < replayCommandList.size(); ++replayCommandListIndex) {
+			std::pair<int,NetworkCommand> &cmd = replayCommandList[replayCommandListIndex];
+			if(cmd.first > worldFrameCount) {
+				break;
 			}
+			replayList.push_back(cmd.second);
+			haveReplyCommands = true;
+		}
+		if(replayCommandListIndex >= replayCommandList.size()) {
+			replayCommandList.clear();
+			replayCommandListIndex = 0;
 		}
-		if(haveReplyCommands == true) {
-			replayCommandList.erase(replayCommandList.begin(),replayCommandList.begin() + replayList.size());
 
+		if(haveReplyCommands == true) {
 			if(SystemFlags::VERBOSE_MODE_ENABLED) printf("worldFrameCount = %d GIVING COMMANDS replayList.size() = " MG_SIZE_T_SPECIFIER "\n",worldFrameCount,replayList.size());
 			for(int i= 0; i < (int)replayList.size(); ++i){
 				giveNetworkCommand(&replayList[i]);
@@ -513,11 +519,11 @@ bool Commander::getReplayCommandListForFrame(int worldFrameCount) {
 }
 
 bool Commander::hasReplayCommandListForFrame() const {
-	return (replayCommandList.empty() == false);
+	return (replayCommandListIndex < replayCommandList.size());
 }
 
 int Commander::getReplayCommandListForFrameCount() const {
-	return (int)replayCommandList.size();
+	return (int)(replayCommandList.size() - replayCommandListIndex);
 }
 
 void Commander::updateNetwork(Game *game) {
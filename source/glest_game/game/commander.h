@@ -54,6 +54,8 @@ private:
 	Chrono perfTimer;
 
 	std::vector<std::pair<int,NetworkCommand> > replayCommandList;
+	// Index of the next replay command to give, replayCommandList is sorted by frame
+	unsigned int replayCommandListIndex;
 
 	bool pauseNetworkCommands;
 
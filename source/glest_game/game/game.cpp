@@ -81,6 +81,7 @@ Game::Game() : ProgramState(NULL) {
 	avgUpdateFps=0;
 	framesToCatchUpAsClient=0;
 	framesToSlowDownAsClient=0;
+	interpolateUnitRendering=false;
 	totalRenderFps=0;
 	renderFps=0;
 	lastRenderFps=0;
@@ -180,6 +181,14 @@ Game::Game() : ProgramState(NULL) {
 		framesNeededToWaitForServerMessage[i]=-1;
 	}
 
+	autoSaveIntervalSeconds = 0;
+	lastAutoSaveTime = 0;
+	autoSaveThread = NULL;
+	autoSaveThreadAccessor = new Mutex(CODE_AT_LINE);
+
+	replayKeyframeIntervalFrames = 0;
+	replayKeyframeMaxCount = 0;
+
 	fadeMusicMilliseconds = Config::getInstance().getInt("GameStartStopFadeSoundMilliseconds",intToStr(fadeMusicMilliseconds).c_str());
 	GAME_STATS_DUMP_INTERVAL = Config::getInstance().getInt("GameStatsDumpIntervalSeconds",intToStr(GAME_STATS_DUMP_INTERVAL).c_str());
 }
@@ -259,6 +268,8 @@ void Game::resetMembers() {
 	lastUpdateFps=0;
 	framesToCatchUpAsClient=0;
 	framesToSlowDownAsClient=0;
+	frameInterpolation.reset(1000000.0 / GameConstants::updateFps);
+	interpolateUnitRendering=Config::getInstance().getBool("InterpolateUnitRendering","true");
 	lastRenderFps=-1;
 	avgUpdateFps=-1;
 	avgRenderFps=-1;
@@ -306,6 +317,12 @@ void Game::resetMembers() {
 	fadeMusicMilliseconds = Config::getInstance().getInt("GameStartStopFadeSoundMilliseconds",intToStr(fadeMusicMilliseconds).c_str());
 	GAME_STATS_DUMP_INTERVAL = Config::getInstance().getInt("GameStatsDumpIntervalSeconds",intToStr(GAME_STATS_DUMP_INTERVAL).c_str());
 
+	autoSaveIntervalSeconds = Config::getInstance().getInt("AutoSaveIntervalMinutes","0") * 60;
+	lastAutoSaveTime = time(NULL);
+
+	replayKeyframeIntervalFrames = Config::getInstance().getInt("ReplayKeyframeIntervalSeconds","300") * GameConstants::updateFps;
+	replayKeyframeMaxCount = Config::getInstance().getInt("ReplayKeyframeMaxCount","3");
+
     Logger &logger= Logger::getInstance();
 	logger.showProgress();
 }
@@ -320,6 +337,8 @@ Game::Game(Program *program, const GameSettings *gameSettings,bool masterserverM
 	videoPlayer = NULL;
 	playingStaticVideo = false;
 	highlightCellTexture = NULL;
+	autoSaveThread = NULL;
+	autoSaveThreadAccessor = new Mutex(CODE_AT_LINE);
 	playerIndexDisconnect=0;
 	updateFpsAvgTest=0;
 	renderFpsAvgTest=0;
@@ -414,6 +433,12 @@ Game::~Game() {
 
 	quitGame();
 
+	cleanupAutoSaveThread();
+	delete autoSaveThreadAccessor;
+	autoSaveThreadAccessor = NULL;
+
+	cleanupReplayKeyframes();
+
 	Object::setStateCallback(NULL);
 	thisGamePtr = NULL;
 	if(originalDisplayMsgCallback != NULL) {
@@ -1001,7 +1026,7 @@ void Game::load() {
 }
 
 void Game::load(int loadTypes) {
-	bool showPerfStats = Config::getInstance().getBool("ShowPerfStats","false");
+	bool showPerfStats = configShowPerfStats.get();
 	Chrono chronoPerf;
 	if(showPerfStats) chronoPerf.start();
 	char perfBuf[8096]="";
@@ -1220,7 +1245,7 @@ void Game::init() {
 }
 
 void Game::init(bool initForPreviewOnly) {
-	bool showPerfStats = Config::getInstance().getBool("ShowPerfStats","false");
+	bool showPerfStats = configShowPerfStats.get();
 	Chrono chronoPerf;
 	if(showPerfStats) chronoPerf.start();
 	char perfBuf[8096]="";
@@ -1400,7 +1425,7 @@ void Game::init(bool initForPreviewOnly) {
 				aiInterfaces[i]= NULL;
 			}
 		}
-		if(Config::getInstance().getBool("EnableNewThreadManager","false") == true) {
+		if(configEnableNewThreadManager.get() == true) {
 			masterController.setSlaves(slaveThreadList);
 		}
 
@@ -1784,7 +1809,7 @@ void Game::update() {
 			currentUIState->update();
 		}
 
-		bool showPerfStats = Config::getInstance().getBool("ShowPerfStats","false");
+		bool showPerfStats = configShowPerfStats.get();
 		Chrono chronoPerf;
 		char perfBuf[8096]="";
 		std::vector<string> perfList;
@@ -2039,7 +2064,7 @@ void Game::update() {
 
 						addPerformanceCount("CalculateNetworkCRCSynchChecks",chronoGamePerformanceCounts.getMillis());
 
-						const bool newThreadManager = Config::getInstance().getBool("EnableNewThreadManager","false");
+						const bool newThreadManager = configEnableNewThreadManager.get();
 						if(newThreadManager == true) {
 							int currentFrameCount = world.getFrameCount();
 							masterController.signalSlaves(&currentFrameCount);
@@ -2281,6 +2306,7 @@ void Game::update() {
 				}
 			}
 		}
+		frameInterpolation.update(world.getFrameCount(),Chrono::getCurMicros());
 
 		if(showPerfStats) {
 			sprintf(perfBuf,"In [%s::%s] Line: %d took msecs: " MG_I64_SPECIFIER "\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__,chronoPerf.getMillis());
@@ -2325,6 +2351,10 @@ void Game::update() {
 
 		addPerformanceCount("ProcessMiscNetwork",chronoGamePerformanceCounts.getMillis());
 
+		// Periodic autosave, taken here so the snapshot is at a frame boundary
+		autoSaveGameIfRequired();
+		captureReplayKeyframeIfRequired();
+
 		// START - Handle joining in progress games
 		if(role == nrServer) {
 
@@ -3175,7 +3205,7 @@ void Game::ReplaceDisconnectedNetworkPlayersWithAI(bool isNetworkGame, NetworkRo
 			}
 		}
 
-		if(newAIPlayerCreated == true && Config::getInstance().getBool("EnableNewThreadManager","false") == true) {
+		if(newAIPlayerCreated == true && configEnableNewThreadManager.get() == true) {
 			bool enableServerControlledAI 	= this->gameSettings.getEnableServerControlledAI();
 
 			masterController.clearSlaves(true);
@@ -3200,6 +3230,17 @@ void Game::updateCamera(){
 	gameCamera.update();
 }
 
+// Units are drawn on by the part of a world frame passed since the world
+// last advanced. value (progress into the next program update) is not
+// used, a program update can advance no world frame or several
+void Game::setUpdateInterpolation(float value) {
+	float interpolation = 0;
+	if(interpolateUnitRendering == true && currentUIState == NULL) {
+		interpolation = frameInterpolation.get(Chrono::getCurMicros());
+	}
+	Renderer::getInstance().setUnitRenderInterpolation(interpolation);
+}
+
 
 // ==================== render ====================
 
@@ -5617,6 +5658,14 @@ string Game::getDebugStats(std::map<int,string> &factionDebugInfo) {
 		str+= "Total unit count: " + intToStr(totalUnitcount) + "\n";
 	}
 
+	int64 deferredAiRuleCount = 0;
+	for(unsigned int i = 0; i < aiInterfaces.size(); ++i) {
+		if(aiInterfaces[i] != NULL) {
+			deferredAiRuleCount += aiInterfaces[i]->getDeferredAiRuleCount();
+		}
+	}
+	str+= "AI rules deferred by time budget: " + intToStr(deferredAiRuleCount) + "\n";
+
 	// resources
 	for(int i = 0; i < world.getFactionCount(); ++i) {
 		string factionInfo = this->gameSettings.getNetworkPlayerName(i);
@@ -6475,8 +6524,7 @@ void Game::toggleTeamColorMarker() {
 }
 
 void Game::addNetworkCommandToReplayList(NetworkCommand* networkCommand, int worldFrameCount) {
-	Config &config= Config::getInstance();
-	if(config.getBool("SaveCommandsForReplay","false") == true) {
+	if(configSaveCommandsForReplay.get() == true) {
 		replayCommandList.push_back(make_pair(worldFrameCount,*networkCommand));
 	}
 }
@@ -6619,7 +6667,7 @@ void Game::saveGame(){
 	config.save();
 }
 
-string Game::saveGame(string name, const string &path) {
+string Game::getSaveGameFilename(string name, const string &path) {
 	Config &config= Config::getInstance();
 	// auto name file if using saved file pattern string
 	if(name == GameConstants::saveGameFilePattern) {
@@ -6657,46 +6705,98 @@ string Game::saveGame(string name, const string &path) {
         }
         saveGameFile = userData + saveGameFile;
 	}
+	return saveGameFile;
+}
+
+string Game::saveGame(string name, const string &path) {
+	Config &config= Config::getInstance();
+	string saveGameFile = getSaveGameFilename(name, path);
 	if(SystemFlags::VERBOSE_MODE_ENABLED) printf("Saving game to [%s]\n",saveGameFile.c_str());
 
-	// This condition will re-play all the commands from a replay file
-	// INSTEAD of saving from a saved game.
-	if(config.getBool("SaveCommandsForReplay","false") == true) {
-		std::map<string,string> mapTagReplacements;
-		XmlTree xmlTreeSaveGame(XML_RAPIDXML_ENGINE);
+	SaveGameSnapshot snapshot;
+	snapshot.saveGameFile 	= saveGameFile;
+	captureSaveGameReplay(snapshot);
+	snapshot.xmlTree 		= createSaveGameXml();
+	writeSaveGameSnapshot(snapshot);
 
-		xmlTreeSaveGame.init("megaglest-saved-game");
-		XmlNode *rootNodeReplay = xmlTreeSaveGame.getRootNode();
+	if(masterserverMode == false) {
+		// take Screenshot
+		string jpgFileName=saveGameFile+".jpg";
+		// menu is already disabled, last rendered screen is still with enabled one. Lets render again:
+		render3d();
+		render2d();
+		Renderer::getInstance().saveScreen(jpgFileName,config.getInt("SaveGameScreenshotWidth","800"),config.getInt("SaveGameScreenshotHeight","600"));
+	}
+
+	return saveGameFile;
+}
 
-		//std::map<string,string> mapTagReplacements;
+// Copies what the replay xml is built from, cheap enough for a frame
+// boundary unlike walking the world
+void Game::captureSaveGameReplay(SaveGameSnapshot &snapshot) {
+	// This condition will re-play all the commands from a replay file
+	// INSTEAD of saving from a saved game.
+	snapshot.saveReplay = configSaveCommandsForReplay.get();
+	if(snapshot.saveReplay == true) {
 		//time_t now = time(NULL);
 		//struct tm *loctime = localtime (&now);
 		struct tm loctime = threadsafe_localtime(systemtime_now());
 		char szBuf[4096]="";
 		strftime(szBuf,4095,"%Y-%m-%d %H:%M:%S",&loctime);
 
+		snapshot.replayTimestamp 			= szBuf;
+		snapshot.replayGameSettings 		= gameSettings;
+		snapshot.replayLastWorldFrameCount 	= world.getFrameCount();
+		snapshot.replayCommandList 			= replayCommandList;
+	}
+}
+
+XmlTree * Game::createSaveGameReplayXml(SaveGameSnapshot &snapshot) {
+	if(snapshot.saveReplay == true) {
+		std::map<string,string> mapTagReplacements;
+		XmlTree *xmlTreeSaveGame = new XmlTree(XML_RAPIDXML_ENGINE);
+
+		xmlTreeSaveGame->init("megaglest-saved-game");
+		XmlNode *rootNodeReplay = xmlTreeSaveGame->getRootNode();
+
 		rootNodeReplay->addAttribute("version",glestVersionString, mapTagReplacements);
-		rootNodeReplay->addAttribute("timestamp",szBuf, mapTagReplacements);
+		rootNodeReplay->addAttribute("timestamp",snapshot.replayTimestamp, mapTagReplacements);
 
 		XmlNode *gameNodeReplay = rootNodeReplay->addChild("Game");
-		gameSettings.saveGame(gameNodeReplay);
+		snapshot.replayGameSettings.saveGame(gameNodeReplay);
 
-		gameNodeReplay->addAttribute("LastWorldFrameCount",intToStr(world.getFrameCount()), mapTagReplacements);
+		gameNodeReplay->addAttribute("LastWorldFrameCount",intToStr(snapshot.replayLastWorldFrameCount), mapTagReplacements);
 
-		for(unsigned int i = 0; i < replayCommandList.size(); ++i) {
-			std::pair<int,NetworkCommand> &cmd = replayCommandList[i];
+		for(unsigned int i = 0; i < snapshot.replayCommandList.size(); ++i) {
+			std::pair<int,NetworkCommand> &cmd = snapshot.replayCommandList[i];
 			XmlNode *networkCommandNode = cmd.second.saveGame(gameNodeReplay);
 			networkCommandNode->addAttribute("worldFrameCount",intToStr(cmd.first), mapTagReplacements);
 		}
 
-		string replayFile = saveGameFile + ".replay";
-		if(SystemFlags::VERBOSE_MODE_ENABLED) printf("Saving game replay commands to [%s]\n",replayFile.c_str());
-		xmlTreeSaveGame.save(replayFile);
+		// Keyframes newer than the snapshot can't be in the list yet when it
+		// is written right away, skip them when written later
+		static string mutexOwnerId = string(extractFileFromDirectoryPath(__FILE__).c_str()) + string("_") + intToStr(__LINE__);
+		MutexSafeWrapper safeMutex(autoSaveThreadAccessor,mutexOwnerId);
+		for(unsigned int i = 0; i < replayKeyframeList.size(); ++i) {
+			std::pair<int,XmlTree *> &keyframe = replayKeyframeList[i];
+			if(keyframe.first > snapshot.replayLastWorldFrameCount) {
+				continue;
+			}
+			XmlNode *keyframeNode = gameNodeReplay->addChild("Keyframe");
+			keyframeNode->addAttribute("worldFrameCount",intToStr(keyframe.first), mapTagReplacements);
+			keyframeNode->addChildCopy(keyframe.second->getRootNode());
+		}
+		safeMutex.ReleaseLock();
+
+		return xmlTreeSaveGame;
 	}
+	return NULL;
+}
 
-	XmlTree xmlTree;
-	xmlTree.init("megaglest-saved-game");
-	XmlNode *rootNode = xmlTree.getRootNode();
+XmlTree * Game::createSaveGameXml() {
+	XmlTree *xmlTree = new XmlTree();
+	xmlTree->init("megaglest-saved-game");
+	XmlNode *rootNode = xmlTree->getRootNode();
 
 	std::map<string,string> mapTagReplacements;
 	//time_t now = time(NULL);
@@ -6854,18 +6954,179 @@ string Game::saveGame(string name, const string &path) {
 
 	gameNode->addAttribute("disableSpeedChange",intToStr(disableSpeedChange), mapTagReplacements);
 
-	xmlTree.save(saveGameFile);
+	return xmlTree;
+}
 
-	if(masterserverMode == false) {
-		// take Screenshot
-		string jpgFileName=saveGameFile+".jpg";
-		// menu is already disabled, last rendered screen is still with enabled one. Lets render again:
-		render3d();
-		render2d();
-		Renderer::getInstance().saveScreen(jpgFileName,config.getInt("SaveGameScreenshotWidth","800"),config.getInt("SaveGameScreenshotHeight","600"));
+void Game::writeSaveGameSnapshot(SaveGameSnapshot &snapshot) {
+	if(snapshot.xmlTreeReplay == NULL) {
+		snapshot.xmlTreeReplay = createSaveGameReplayXml(snapshot);
 	}
+	if(snapshot.xmlTreeReplay != NULL) {
+		string replayFile = snapshot.saveGameFile + ".replay";
+		if(SystemFlags::VERBOSE_MODE_ENABLED) printf("Saving game replay commands to [%s]\n",replayFile.c_str());
+		snapshot.xmlTreeReplay->save(replayFile);
 
-	return saveGameFile;
+		delete snapshot.xmlTreeReplay;
+		snapshot.xmlTreeReplay = NULL;
+	}
+	if(snapshot.xmlTree != NULL) {
+		snapshot.xmlTree->save(snapshot.saveGameFile);
+
+		delete snapshot.xmlTree;
+		snapshot.xmlTree = NULL;
+	}
+}
+
+void Game::autoSaveGameIfRequired() {
+	if(autoSaveIntervalSeconds <= 0 || gameStarted == false ||
+		gameOver == true || paused == true) {
+		return;
+	}
+	if(difftime((long int)time(NULL),lastAutoSaveTime) < autoSaveIntervalSeconds) {
+		return;
+	}
+	lastAutoSaveTime = time(NULL);
+
+	// Only autosave games that could also be saved manually
+	if(gameSettings.isNetworkGame() == true && gameSettings.getScenario() == "") {
+		return;
+	}
+
+	if(autoSaveThread == NULL) {
+		static string mutexOwnerId = string(extractFileFromDirectoryPath(__FILE__).c_str()) + string("_") + intToStr(__LINE__);
+		autoSaveThread = new SimpleTaskThread(this,0,100);
+		autoSaveThread->setUniqueID(mutexOwnerId);
+		autoSaveThread->start();
+	}
+
+	Chrono chrono;
+	chrono.start();
+
+	// Capture the synchronized world state at this frame boundary. Building
+	// the world xml tree walks the whole world and still costs a frame
+	// here, the replay xml and the disk writes happen on autoSaveThread
+	SaveGameSnapshot snapshot;
+	snapshot.saveGameFile 	= getSaveGameFilename(GameConstants::saveGameFileAutoSave);
+	captureSaveGameReplay(snapshot);
+	snapshot.xmlTree 		= createSaveGameXml();
+
+	static string mutexOwnerId = string(extractFileFromDirectoryPath(__FILE__).c_str()) + string("_") + intToStr(__LINE__);
+	MutexSafeWrapper safeMutex(autoSaveThreadAccessor,mutexOwnerId);
+	// If the disk is slower than the autosave interval only keep the newest snapshot
+	for(std::list<SaveGameSnapshot>::iterator iter = autoSaveQueue.begin();
+		iter != autoSaveQueue.end(); ++iter) {
+		delete iter->xmlTreeReplay;
+		delete iter->xmlTree;
+	}
+	autoSaveQueue.clear();
+	autoSaveQueue.push_back(snapshot);
+	safeMutex.ReleaseLock();
+
+	addPerformanceCount("ProcessAutoSaveSnapshot",chrono.getMillis());
+	if(SystemFlags::VERBOSE_MODE_ENABLED) printf("Queued autosave snapshot [%s] took msecs: " MG_I64_SPECIFIER "\n",snapshot.saveGameFile.c_str(),chrono.getMillis());
+}
+
+void Game::simpleTask(BaseThread *callingThread,void *userdata) {
+	// This code reads save game snapshots from a queue and saves them to disk
+	SaveGameSnapshot snapshot;
+	static string mutexOwnerId = string(extractFileFromDirectoryPath(__FILE__).c_str()) + string("_") + intToStr(__LINE__);
+	MutexSafeWrapper safeMutex(autoSaveThreadAccessor,mutexOwnerId);
+	if(autoSaveQueue.empty() == false) {
+		snapshot = autoSaveQueue.front();
+		autoSaveQueue.pop_front();
+	}
+	safeMutex.ReleaseLock();
+
+	if(snapshot.xmlTree != NULL) {
+		if(SystemFlags::getSystemSettingType(SystemFlags::debugSystem).enabled) SystemFlags::OutputDebug(SystemFlags::debugSystem,"In [%s::%s Line %d] about to save [%s]\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__,snapshot.saveGameFile.c_str());
+
+		// Write to a temp file first so a crash while saving never leaves
+		// behind a truncated autosave
+		string finalSaveGameFile = snapshot.saveGameFile;
+		snapshot.saveGameFile += ".tmp";
+		writeSaveGameSnapshot(snapshot);
+
+		if(fileExists(finalSaveGameFile + ".replay") == true) {
+			removeFile(finalSaveGameFile + ".replay");
+		}
+		if(fileExists(snapshot.saveGameFile + ".replay") == true) {
+			renameFile(snapshot.saveGameFile + ".replay", finalSaveGameFile + ".replay");
+		}
+		if(fileExists(finalSaveGameFile) == true) {
+			removeFile(finalSaveGameFile);
+		}
+		renameFile(snapshot.saveGameFile, finalSaveGameFile);
+	}
+}
+
+void Game::cleanupAutoSaveThread() {
+	if(autoSaveThread != NULL) {
+		autoSaveThread->signalQuit();
+		if(autoSaveThread->shutdownAndWait() == true) {
+			delete autoSaveThread;
+		}
+		autoSaveThread = NULL;
+	}
+
+	// Flush any snapshot the thread did not get to so an autosave is never lost
+	static string mutexOwnerId = string(extractFileFromDirectoryPath(__FILE__).c_str()) + string("_") + intToStr(__LINE__);
+	for(;;) {
+		MutexSafeWrapper safeMutex(autoSaveThreadAccessor,mutexOwnerId);
+		bool pendingSnapshots = (autoSaveQueue.empty() == false);
+		safeMutex.ReleaseLock();
+
+		if(pendingSnapshots == false) {
+			break;
+		}
+		simpleTask(NULL,NULL);
+	}
+}
+
+void Game::captureReplayKeyframeIfRequired() {
+	if(replayKeyframeIntervalFrames <= 0 || replayKeyframeMaxCount <= 0 ||
+		gameStarted == false || gameOver == true) {
+		return;
+	}
+	// Keyframes are only useful next to the recorded commands, and are
+	// never taken while a replay is still being played back
+	if(commander.hasReplayCommandListForFrame() == true ||
+		configSaveCommandsForReplay.get() == false) {
+		return;
+	}
+	int frameCount = world.getFrameCount();
+	if(frameCount <= 0 || (replayKeyframeList.empty() == false &&
+		frameCount - replayKeyframeList.back().first < replayKeyframeIntervalFrames)) {
+		return;
+	}
+	if(replayKeyframeList.empty() == true && frameCount < replayKeyframeIntervalFrames) {
+		return;
+	}
+
+	Chrono chrono;
+	chrono.start();
+
+	// Like an autosave this walks the whole world on the game thread, so
+	// each keyframe costs one hitch of that length (ProcessReplayKeyframe)
+	XmlTree *keyframe = createSaveGameXml();
+
+	static string mutexOwnerId = string(extractFileFromDirectoryPath(__FILE__).c_str()) + string("_") + intToStr(__LINE__);
+	MutexSafeWrapper safeMutex(autoSaveThreadAccessor,mutexOwnerId);
+	replayKeyframeList.push_back(make_pair(frameCount,keyframe));
+	while((int)replayKeyframeList.size() > replayKeyframeMaxCount) {
+		delete replayKeyframeList.front().second;
+		replayKeyframeList.erase(replayKeyframeList.begin());
+	}
+	safeMutex.ReleaseLock();
+
+	addPerformanceCount("ProcessReplayKeyframe",chrono.getMillis());
+	if(SystemFlags::VERBOSE_MODE_ENABLED) printf("Captured replay keyframe for frame %d took msecs: " MG_I64_SPECIFIER "\n",frameCount,chrono.getMillis());
+}
+
+void Game::cleanupReplayKeyframes() {
+	for(unsigned int i = 0; i < replayKeyframeList.size(); ++i) {
+		delete replayKeyframeList[i].second;
+	}
+	replayKeyframeList.clear();
 }
 
 void Game::loadGame(string name,Program *programPtr,bool isMasterserverMode,const GameSettings *joinGameSettings) {
@@ -6911,12 +7172,36 @@ void Game::loadGame(string name,Program *programPtr,bool isMasterserverMode,cons
 		//newGameSettings.loadGame(gameNode);
 		//if(SystemFlags::VERBOSE_MODE_ENABLED) printf("Game settings loaded\n");
 
-		NetworkManager &networkManager= NetworkManager::getInstance();
-		networkManager.end();
-		networkManager.init(nrServer,true);
+		int lastWorldFrameCount = gameNode->getAttribute("LastWorldFrameCount")->getIntValue();
+
+		// Resume from the newest keyframe instead of simulating from frame 0
+		const XmlNode *keyframeNode = NULL;
+		int keyframeWorldFrameCount = -1;
+		vector<XmlNode *> keyframeNodeList = gameNode->getChildList("Keyframe");
+		for(unsigned int i = 0; i < keyframeNodeList.size(); ++i) {
+			XmlNode *node = keyframeNodeList[i];
+			int worldFrameCount = node->getAttribute("worldFrameCount")->getIntValue();
+			if(worldFrameCount > keyframeWorldFrameCount && worldFrameCount <= lastWorldFrameCount &&
+				node->hasChild("megaglest-saved-game") == true) {
+				keyframeNode = node->getChild("megaglest-saved-game");
+				keyframeWorldFrameCount = worldFrameCount;
+			}
+		}
 
-		Game *newGame = new Game(programPtr, &newGameSettingsReplay, isMasterserverMode);
-		newGame->lastworldFrameCountForReplay = gameNode->getAttribute("LastWorldFrameCount")->getIntValue();
+		Game *newGame = NULL;
+		if(keyframeNode != NULL) {
+			if(SystemFlags::VERBOSE_MODE_ENABLED) printf("Loading replay from keyframe at frame %d of %d\n",keyframeWorldFrameCount,lastWorldFrameCount);
+
+			newGame = createGameFromSaveNode(keyframeNode, programPtr, isMasterserverMode, NULL, false);
+		}
+		else {
+			NetworkManager &networkManager= NetworkManager::getInstance();
+			networkManager.end();
+			networkManager.init(nrServer,true);
+
+			newGame = new Game(programPtr, &newGameSettingsReplay, isMasterserverMode);
+		}
+		newGame->lastworldFrameCountForReplay = lastWorldFrameCount;
 
 		vector<XmlNode *> networkCommandNodeList = gameNode->getChildList("NetworkCommand");
 		if(SystemFlags::VERBOSE_MODE_ENABLED) printf("networkCommandNodeList.size() = " MG_SIZE_T_SPECIFIER "\n",networkCommandNodeList.size());
@@ -6925,7 +7210,14 @@ void Game::loadGame(string name,Program *programPtr,bool isMasterserverMode,cons
 			int worldFrameCount = node->getAttribute("worldFrameCount")->getIntValue();
 			NetworkCommand command;
 			command.loadGame(node);
-			newGame->commander.addToReplayCommandList(command,worldFrameCount);
+			// Commands already applied in the keyframe are kept so the
+			// replay history stays complete when saved again
+			if(worldFrameCount <= keyframeWorldFrameCount) {
+				newGame->replayCommandList.push_back(make_pair(worldFrameCount,command));
+			}
+			else {
+				newGame->commander.addToReplayCommandList(command,worldFrameCount);
+			}
 		}
 
 		programPtr->setState(newGame);
@@ -6960,6 +7252,15 @@ void Game::loadGame(string name,Program *programPtr,bool isMasterserverMode,cons
 
 	if(SystemFlags::VERBOSE_MODE_ENABLED) printf("Found saved game version that matches your application version: [%s] --> [%s]\n",gameVer.c_str(),glestVersionString.c_str());
 
+	Game *newGame = createGameFromSaveNode(rootNode, programPtr, isMasterserverMode, joinGameSettings);
+	if(SystemFlags::VERBOSE_MODE_ENABLED) printf("Starting Game ...\n");
+	programPtr->setState(newGame);
+}
+
+Game * Game::createGameFromSaveNode(const XmlNode *rootNode,Program *programPtr,bool isMasterserverMode,const GameSettings *joinGameSettings,bool startPaused) {
+	Lang &lang= Lang::getInstance();
+	string gameVer = rootNode->getAttribute("version")->getValue();
+
 	XmlNode *gameNode = rootNode->getChild("Game");
 	GameSettings newGameSettings;
 	if(joinGameSettings != NULL) {
@@ -7052,7 +7353,8 @@ void Game::loadGame(string name,Program *programPtr,bool isMasterserverMode,cons
 		newGame->paused = gameNode->getAttribute("paused")->getIntValue() != 0;
 	}else{
 		//newGame->paused = gameNode->getAttribute("paused")->getIntValue() != 0;
-		newGame->paused = true;
+		// A replay resumed from a keyframe keeps playing
+		newGame->paused = startPaused;
 	}
 	if(newGame->paused) newGame->console.addLine(lang.getString("GamePaused"));
 	//bool gameOver;
@@ -7179,8 +7481,7 @@ void Game::loadGame(string name,Program *programPtr,bool isMasterserverMode,cons
 
 	const XmlNode *worldNode = gameNode->getChild("World");
 	newGame->world.loadGame(worldNode);
-	if(SystemFlags::VERBOSE_MODE_ENABLED) printf("Starting Game ...\n");
-	programPtr->setState(newGame);
+	return newGame;
 }
 
 }}//end namespace
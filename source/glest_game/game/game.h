@@ -18,6 +18,7 @@
 #endif
 
 #include <vector>
+#include <list>
 #include "gui.h"
 #include "game_camera.h"
 #include "world.h"
@@ -29,11 +30,13 @@
 #include "network_interface.h"
 #include "data_types.h"
 #include "selection.h"
+#include "interpolation.h"
 #include "leak_dumper.h"
 
 using std::vector;
 using namespace Shared::Platform;
 using namespace Shared::PlatformCommon;
+using Shared::Graphics::FrameInterpolation;
 
 namespace Shared { namespace Graphics {
 	class VideoPlayer;
@@ -54,13 +57,38 @@ enum LoadGameItem {
 	lgt_All				= (lgt_FactionPreview | lgt_TileSet | lgt_TechTree | lgt_Map | lgt_Scenario)
 };
 
+// =====================================================
+// 	class SaveGameSnapshot
+//
+///	Save game captured on the game thread, written to disk
+///	later (possibly by another thread). The world xml tree is
+///	built when captured, the replay xml only from copied data
+///	by the thread that writes it
+// =====================================================
+class SaveGameSnapshot {
+public:
+	string saveGameFile;
+	XmlTree *xmlTree;
+	XmlTree *xmlTreeReplay;
+
+	bool saveReplay;
+	string replayTimestamp;
+	GameSettings replayGameSettings;
+	int replayLastWorldFrameCount;
+	std::vector<std::pair<int,NetworkCommand> > replayCommandList;
+
+	SaveGameSnapshot() : xmlTree(NULL), xmlTreeReplay(NULL),
+		saveReplay(false), replayLastWorldFrameCount(0) {}
+};
+
 // =====================================================
 // 	class Game
 //
 //	Main game class
 // =====================================================
 class Game: public ProgramState, public FileCRCPreCacheThreadCallbackInterface,
-            public CustomInputCallbackInterface, public ClientLagCallbackInterface {
+            public CustomInputCallbackInterface, public ClientLagCallbackInterface,
+            public SimpleTaskCallbackInterface {
 public:
 	static const float highlightTime;
 
@@ -90,6 +118,10 @@ private:
 	int updateFps, lastUpdateFps, avgUpdateFps;
 	int framesToCatchUpAsClient;
 	int framesToSlowDownAsClient;
+	// How far into the next world frame the world is, for drawing units
+	// between updates
+	FrameInterpolation frameInterpolation;
+	bool interpolateUnitRendering;
 	int receivedTooEarlyInFrames[GameConstants::networkSmoothInterval];
 	int framesNeededToWaitForServerMessage[GameConstants::networkSmoothInterval];
 	int totalRenderFps, renderFps, lastRenderFps, avgRenderFps,currentAvgRenderFpsTotal;
@@ -219,6 +251,19 @@ private:
 	bool networkPauseGameForLaggedClientsRequested;
 	bool networkResumeGameForLaggedClientsRequested;
 
+	int autoSaveIntervalSeconds;
+	time_t lastAutoSaveTime;
+	SimpleTaskThread *autoSaveThread;
+	Mutex *autoSaveThreadAccessor;
+	std::list<SaveGameSnapshot> autoSaveQueue;
+
+	// In memory world snapshots embedded in the replay file so loading a
+	// replay resumes from the newest keyframe instead of frame 0. Guarded
+	// by autoSaveThreadAccessor since autoSaveThread reads them
+	int replayKeyframeIntervalFrames;
+	int replayKeyframeMaxCount;
+	std::vector<std::pair<int,XmlTree *> > replayKeyframeList;
+
 public:
 	Game();
     Game(Program *program, const GameSettings *gameSettings, bool masterserverMode);
@@ -284,6 +329,7 @@ public:
     virtual void init(bool initForPreviewOnly);
 	virtual void update();
 	virtual void updateCamera();
+	virtual void setUpdateInterpolation(float value);
 	virtual void render();
 	virtual void tick();
 
@@ -333,6 +379,7 @@ public:
 	void stopAllVideo();
 
 	string saveGame(string name, const string &path="saved/");
+	virtual void simpleTask(BaseThread *callingThread,void *userdata);
 	static void loadGame(string name,Program *programPtr,bool isMasterserverMode, const GameSettings *joinGameSettings=NULL);
 
 	void addNetworkCommandToReplayList(NetworkCommand* networkCommand,int worldFrameCount);
@@ -414,6 +461,17 @@ private:
 	void initCamera(Map *map);
 
 	virtual bool clientLagHandler(int slotIndex,bool networkPauseGameForLaggedClients);
+
+	string getSaveGameFilename(string name, const string &path="saved/");
+	XmlTree * createSaveGameXml();
+	void captureSaveGameReplay(SaveGameSnapshot &snapshot);
+	XmlTree * createSaveGameReplayXml(SaveGameSnapshot &snapshot);
+	void writeSaveGameSnapshot(SaveGameSnapshot &snapshot);
+	void autoSaveGameIfRequired();
+	void cleanupAutoSaveThread();
+	void captureReplayKeyframeIfRequired();
+	void cleanupReplayKeyframes();
+	static Game * createGameFromSaveNode(const XmlNode *rootNode,Program *programPtr,bool isMasterserverMode,const GameSettings *joinGameSettings,bool startPaused=true);
 };
 
 }}//end namespace
@@ -174,6 +174,7 @@ public:
 	static const char *saveNetworkGameFileClient;
 	static const char *saveGameFileDefault;
 	static const char *saveGameFileAutoTestDefault;
+	static const char *saveGameFileAutoSave;
 	static const char *saveGameFilePattern;
 
 	// VC++ Chokes on init of non integral static types
@@ -180,6 +180,7 @@ void TimerTriggerEvent::loadGame(const XmlNode *rootNode) {
 ScriptManager* ScriptManager::thisScriptManager		= NULL;
 const int ScriptManager::messageWrapCount			= 35;
 const int ScriptManager::displayTextWrapCount		= 64;
+const int ScriptManager::cellTriggerEventBucketSize	= 16;
 
 ScriptManager::ScriptManager() {
 	world = NULL;
@@ -228,6 +229,7 @@ void ScriptManager::init(World* world, GameCamera *gameCamera, const XmlNode *ro
 	//printf("In [%s::%s Line: %d]\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__);
 	currentEventId = 1;
 	CellTriggerEventList.clear();
+	clearCellTriggerEventIndex();
 	TimerTriggerEventList.clear();
 
 	//printf("In [%s::%s Line: %d]\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__);
@@ -663,8 +665,17 @@ void ScriptManager::onCellTriggerEvent(Unit *movingUnit) {
 	if(movingUnit != NULL) {
 		//ScenarioInfo scenarioInfoStart = world->getScenario()->getInfo();
 
-		for(std::map<int,CellTriggerEvent>::iterator iterMap = CellTriggerEventList.begin();
-				iterMap != CellTriggerEventList.end(); ++iterMap) {
+		// Only visit the triggers the index says can fire for this unit, in
+		// event id order which is the order of CellTriggerEventList
+		std::set<int> candidateEventIds;
+		getCellTriggerEventCandidates(movingUnit, candidateEventIds);
+
+		for(std::set<int>::iterator iterCandidate = candidateEventIds.begin();
+				iterCandidate != candidateEventIds.end(); ++iterCandidate) {
+			std::map<int,CellTriggerEvent>::iterator iterMap = CellTriggerEventList.find(*iterCandidate);
+			if(iterMap == CellTriggerEventList.end()) {
+				continue;
+			}
 			CellTriggerEvent &event = iterMap->second;
 
 			if(SystemFlags::getSystemSettingType(SystemFlags::debugLUA).enabled) SystemFlags::OutputDebug(SystemFlags::debugLUA,"In [%s::%s Line: %d] movingUnit = %d, event.type = %d, movingUnit->getPos() = %s, event.sourceId = %d, event.destId = %d, event.destPos = %s\n",
@@ -858,6 +869,7 @@ void ScriptManager::onCellTriggerEvent(Unit *movingUnit) {
 
 								currentCellTriggeredEventAreaEntryUnitId = movingUnit->getId();
 								event.eventStateInfo[movingUnit->getId()] = Vec2i(x,y).getString();
+								cellTriggerEventsByAreaUnit[movingUnit->getId()].insert(iterMap->first);
 							}
 						}
 					}
@@ -889,6 +901,10 @@ void ScriptManager::onCellTriggerEvent(Unit *movingUnit) {
 						currentCellTriggeredEventAreaExitUnitId = movingUnit->getId();
 
 						event.eventStateInfo.erase(movingUnit->getId());
+						cellTriggerEventsByAreaUnit[movingUnit->getId()].erase(iterMap->first);
+						if(cellTriggerEventsByAreaUnit[movingUnit->getId()].empty() == true) {
+							cellTriggerEventsByAreaUnit.erase(movingUnit->getId());
+						}
 					}
 				}
 			}
@@ -904,6 +920,10 @@ void ScriptManager::onCellTriggerEvent(Unit *movingUnit) {
 
 				luaScript.beginCall("cellTriggerEvent");
 				luaScript.endCall();
+
+				// The script may have registered new triggers or moved the
+				// unit, pick up any later triggers that now apply
+				getCellTriggerEventCandidates(movingUnit, candidateEventIds);
 			}
 
 //			ScenarioInfo scenarioInfoEnd = world->getScenario()->getInfo();
@@ -1233,8 +1253,7 @@ int ScriptManager::registerCellTriggerEventForUnitToUnit(int sourceUnitId, int d
 	trigger.sourceId = sourceUnitId;
 	trigger.destId = destUnitId;
 
-	int eventId = currentEventId++;
-	CellTriggerEventList[eventId] = trigger;
+	int eventId = registerCellTriggerEvent(trigger);
 
 	if(SystemFlags::getSystemSettingType(SystemFlags::debugLUA).enabled) SystemFlags::OutputDebug(SystemFlags::debugLUA,"In [%s::%s Line: %d] Unit: %d will trigger cell event when reaching unit: %d, eventId = %d\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__,sourceUnitId,destUnitId,eventId);
 
@@ -1247,8 +1266,7 @@ int ScriptManager::registerCellTriggerEventForUnitToLocation(int sourceUnitId, c
 	trigger.sourceId = sourceUnitId;
 	trigger.destPos = pos;
 
-	int eventId = currentEventId++;
-	CellTriggerEventList[eventId] = trigger;
+	int eventId = registerCellTriggerEvent(trigger);
 
 	if(SystemFlags::getSystemSettingType(SystemFlags::debugLUA).enabled) SystemFlags::OutputDebug(SystemFlags::debugLUA,"In [%s::%s Line: %d] Unit: %d will trigger cell event when reaching pos: %s, eventId = %d\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__,sourceUnitId,pos.getString().c_str(),eventId);
 
@@ -1264,8 +1282,7 @@ int ScriptManager::registerCellAreaTriggerEventForUnitToLocation(int sourceUnitI
 	trigger.destPosEnd.x = pos.z;
 	trigger.destPosEnd.y = pos.w;
 
-	int eventId = currentEventId++;
-	CellTriggerEventList[eventId] = trigger;
+	int eventId = registerCellTriggerEvent(trigger);
 
 	if(SystemFlags::getSystemSettingType(SystemFlags::debugLUA).enabled) SystemFlags::OutputDebug(SystemFlags::debugLUA,"In [%s::%s Line: %d] Unit: %d will trigger cell event when reaching pos: %s, eventId = %d\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__,sourceUnitId,pos.getString().c_str(),eventId);
 
@@ -1278,8 +1295,7 @@ int ScriptManager::registerCellTriggerEventForFactionToUnit(int sourceFactionId,
 	trigger.sourceId = sourceFactionId;
 	trigger.destId = destUnitId;
 
-	int eventId = currentEventId++;
-	CellTriggerEventList[eventId] = trigger;
+	int eventId = registerCellTriggerEvent(trigger);
 
 	if(SystemFlags::getSystemSettingType(SystemFlags::debugLUA).enabled) SystemFlags::OutputDebug(SystemFlags::debugLUA,"In [%s::%s Line: %d] Faction: %d will trigger cell event when reaching unit: %d, eventId = %d\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__,sourceFactionId,destUnitId,eventId);
 
@@ -1292,8 +1308,7 @@ int ScriptManager::registerCellTriggerEventForFactionToLocation(int sourceFactio
 	trigger.sourceId = sourceFactionId;
 	trigger.destPos = pos;
 
-	int eventId = currentEventId++;
-	CellTriggerEventList[eventId] = trigger;
+	int eventId = registerCellTriggerEvent(trigger);
 
 	if(SystemFlags::getSystemSettingType(SystemFlags::debugLUA).enabled) SystemFlags::OutputDebug(SystemFlags::debugLUA,"In [%s::%s Line: %d]Faction: %d will trigger cell event when reaching pos: %s, eventId = %d\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__,sourceFactionId,pos.getString().c_str(),eventId);
 
@@ -1309,8 +1324,7 @@ int ScriptManager::registerCellAreaTriggerEventForFactionToLocation(int sourceFa
 	trigger.destPosEnd.x = pos.z;
 	trigger.destPosEnd.y = pos.w;
 
-	int eventId = currentEventId++;
-	CellTriggerEventList[eventId] = trigger;
+	int eventId = registerCellTriggerEvent(trigger);
 
 	if(SystemFlags::getSystemSettingType(SystemFlags::debugLUA).enabled) SystemFlags::OutputDebug(SystemFlags::debugLUA,"In [%s::%s Line: %d]Faction: %d will trigger cell event when reaching pos: %s, eventId = %d\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__,sourceFactionId,pos.getString().c_str(),eventId);
 
@@ -1326,14 +1340,163 @@ int ScriptManager::registerCellAreaTriggerEvent(const Vec4i &pos) {
 	trigger.destPosEnd.x = pos.z;
 	trigger.destPosEnd.y = pos.w;
 
-	int eventId = currentEventId++;
-	CellTriggerEventList[eventId] = trigger;
+	int eventId = registerCellTriggerEvent(trigger);
 
 	if(SystemFlags::getSystemSettingType(SystemFlags::debugLUA).enabled) SystemFlags::OutputDebug(SystemFlags::debugLUA,"In [%s::%s Line: %d] trigger cell event when reaching pos: %s, eventId = %d\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__,pos.getString().c_str(),eventId);
 
 	return eventId;
 }
 
+int ScriptManager::registerCellTriggerEvent(const CellTriggerEvent &trigger) {
+	int eventId = currentEventId++;
+	CellTriggerEventList[eventId] = trigger;
+	addCellTriggerEventToIndex(eventId, trigger);
+	return eventId;
+}
+
+void ScriptManager::eraseCellTriggerEvent(int eventId) {
+	std::map<int,CellTriggerEvent>::iterator iterFind = CellTriggerEventList.find(eventId);
+	if(iterFind != CellTriggerEventList.end()) {
+		removeCellTriggerEventFromIndex(eventId, iterFind->second);
+		CellTriggerEventList.erase(iterFind);
+	}
+}
+
+// Position triggers are indexed by the buckets of cells a unit can stand on
+// and still touch the trigger area, for a unit of size 1 that is the area itself
+bool ScriptManager::getCellTriggerEventBucketRange(const CellTriggerEvent &event, Vec2i &bucketStart, Vec2i &bucketEnd) const {
+	Vec2i areaStart = event.destPos;
+	Vec2i areaEnd = event.destPos;
+	if(event.type == ctet_UnitAreaPos || event.type == ctet_FactionAreaPos ||
+		event.type == ctet_AreaPos) {
+		areaEnd = event.destPosEnd;
+	}
+	if(areaEnd.x < areaStart.x || areaEnd.y < areaStart.y) {
+		return false;
+	}
+	bucketStart = Vec2i(max(areaStart.x,0) / cellTriggerEventBucketSize, max(areaStart.y,0) / cellTriggerEventBucketSize);
+	bucketEnd = Vec2i(max(areaEnd.x,0) / cellTriggerEventBucketSize, max(areaEnd.y,0) / cellTriggerEventBucketSize);
+	return true;
+}
+
+void ScriptManager::addCellTriggerEventToIndex(int eventId, const CellTriggerEvent &event) {
+	switch(event.type) {
+		case ctet_Unit:
+		case ctet_UnitPos:
+		case ctet_UnitAreaPos:
+			cellTriggerEventsBySourceUnit[event.sourceId].insert(eventId);
+			break;
+		case ctet_Faction:
+			cellTriggerEventsBySourceFaction[event.sourceId].insert(eventId);
+			break;
+		case ctet_FactionPos:
+		case ctet_FactionAreaPos:
+		case ctet_AreaPos:
+			{
+			Vec2i bucketStart;
+			Vec2i bucketEnd;
+			if(getCellTriggerEventBucketRange(event, bucketStart, bucketEnd) == true) {
+				for(int x = bucketStart.x; x <= bucketEnd.x; ++x) {
+					for(int y = bucketStart.y; y <= bucketEnd.y; ++y) {
+						cellTriggerEventsByBucket[Vec2i(x,y)].insert(eventId);
+					}
+				}
+			}
+			}
+			break;
+	}
+
+	for(std::map<int,string>::const_iterator iterMap = event.eventStateInfo.begin();
+		iterMap != event.eventStateInfo.end(); ++iterMap) {
+		cellTriggerEventsByAreaUnit[iterMap->first].insert(eventId);
+	}
+}
+
+void ScriptManager::removeCellTriggerEventFromIndex(int eventId, const CellTriggerEvent &event) {
+	switch(event.type) {
+		case ctet_Unit:
+		case ctet_UnitPos:
+		case ctet_UnitAreaPos:
+			cellTriggerEventsBySourceUnit[event.sourceId].erase(eventId);
+			if(cellTriggerEventsBySourceUnit[event.sourceId].empty() == true) {
+				cellTriggerEventsBySourceUnit.erase(event.sourceId);
+			}
+			break;
+		case ctet_Faction:
+			cellTriggerEventsBySourceFaction[event.sourceId].erase(eventId);
+			if(cellTriggerEventsBySourceFaction[event.sourceId].empty() == true) {
+				cellTriggerEventsBySourceFaction.erase(event.sourceId);
+			}
+			break;
+		case ctet_FactionPos:
+		case ctet_FactionAreaPos:
+		case ctet_AreaPos:
+			{
+			Vec2i bucketStart;
+			Vec2i bucketEnd;
+			if(getCellTriggerEventBucketRange(event, bucketStart, bucketEnd) == true) {
+				for(int x = bucketStart.x; x <= bucketEnd.x; ++x) {
+					for(int y = bucketStart.y; y <= bucketEnd.y; ++y) {
+						Vec2i bucket(x,y);
+						cellTriggerEventsByBucket[bucket].erase(eventId);
+						if(cellTriggerEventsByBucket[bucket].empty() == true) {
+							cellTriggerEventsByBucket.erase(bucket);
+						}
+					}
+				}
+			}
+			}
+			break;
+	}
+
+	for(std::map<int,string>::const_iterator iterMap = event.eventStateInfo.begin();
+		iterMap != event.eventStateInfo.end(); ++iterMap) {
+		cellTriggerEventsByAreaUnit[iterMap->first].erase(eventId);
+		if(cellTriggerEventsByAreaUnit[iterMap->first].empty() == true) {
+			cellTriggerEventsByAreaUnit.erase(iterMap->first);
+		}
+	}
+}
+
+void ScriptManager::clearCellTriggerEventIndex() {
+	cellTriggerEventsBySourceUnit.clear();
+	cellTriggerEventsBySourceFaction.clear();
+	cellTriggerEventsByBucket.clear();
+	cellTriggerEventsByAreaUnit.clear();
+}
+
+void ScriptManager::getCellTriggerEventCandidates(Unit *movingUnit, std::set<int> &candidateEventIds) const {
+	std::map<int,std::set<int> >::const_iterator iterFind = cellTriggerEventsBySourceUnit.find(movingUnit->getId());
+	if(iterFind != cellTriggerEventsBySourceUnit.end()) {
+		candidateEventIds.insert(iterFind->second.begin(),iterFind->second.end());
+	}
+	iterFind = cellTriggerEventsBySourceFaction.find(movingUnit->getFactionIndex());
+	if(iterFind != cellTriggerEventsBySourceFaction.end()) {
+		candidateEventIds.insert(iterFind->second.begin(),iterFind->second.end());
+	}
+	// Area triggers the unit is currently inside of, so leaving is detected
+	iterFind = cellTriggerEventsByAreaUnit.find(movingUnit->getId());
+	if(iterFind != cellTriggerEventsByAreaUnit.end()) {
+		candidateEventIds.insert(iterFind->second.begin(),iterFind->second.end());
+	}
+
+	if(cellTriggerEventsByBucket.empty() == false) {
+		// A unit at pos touches a trigger cell within its size up and left of pos
+		Vec2i pos = movingUnit->getPos();
+		int unitSize = movingUnit->getType()->getSize();
+		Vec2i bucketStart(max(pos.x - unitSize + 1,0) / cellTriggerEventBucketSize, max(pos.y - unitSize + 1,0) / cellTriggerEventBucketSize);
+		Vec2i bucketEnd(max(pos.x,0) / cellTriggerEventBucketSize, max(pos.y,0) / cellTriggerEventBucketSize);
+		for(int x = bucketStart.x; x <= bucketEnd.x; ++x) {
+			for(int y = bucketStart.y; y <= bucketEnd.y; ++y) {
+				std::map<Vec2i,std::set<int> >::const_iterator iterBucket = cellTriggerEventsByBucket.find(Vec2i(x,y));
+				if(iterBucket != cellTriggerEventsByBucket.end()) {
+					candidateEventIds.insert(iterBucket->second.begin(),iterBucket->second.end());
+				}
+			}
+		}
+	}
+}
+
 int ScriptManager::getCellTriggerEventCount(int eventId) {
 	int result = 0;
 	if(CellTriggerEventList.find(eventId) != CellTriggerEventList.end()) {
@@ -1346,7 +1509,7 @@ int ScriptManager::getCellTriggerEventCount(int eventId) {
 void ScriptManager::unregisterCellTriggerEvent(int eventId) {
 	if(CellTriggerEventList.find(eventId) != CellTriggerEventList.end()) {
 		if(inCellTriggerEvent == false) {
-			CellTriggerEventList.erase(eventId);
+			eraseCellTriggerEvent(eventId);
 		}
 		else {
 			unRegisterCellTriggerEventList.push_back(eventId);
@@ -1357,7 +1520,7 @@ void ScriptManager::unregisterCellTriggerEvent(int eventId) {
 		if(unRegisterCellTriggerEventList.empty() == false) {
 			for(int i = 0; i < (int)unRegisterCellTriggerEventList.size(); ++i) {
 				int delayedEventId = unRegisterCellTriggerEventList[i];
-				CellTriggerEventList.erase(delayedEventId);
+				eraseCellTriggerEvent(delayedEventId);
 			}
 			unRegisterCellTriggerEventList.clear();
 		}
@@ -4269,7 +4432,9 @@ void ScriptManager::loadGame(const XmlNode *rootNode) {
 		XmlNode *node = cellTriggerEventListNodeList[i];
 		CellTriggerEvent event;
 		event.loadGame(node);
-		CellTriggerEventList[node->getAttribute("key")->getIntValue()] = event;
+		int eventId = node->getAttribute("key")->getIntValue();
+		CellTriggerEventList[eventId] = event;
+		addCellTriggerEventToIndex(eventId, event);
 	}
 
 //	std::map<int,TimerTriggerEvent> TimerTriggerEventList;
@@ -23,6 +23,7 @@
 #include "components.h"
 #include "game_constants.h"
 #include <map>
+#include <set>
 #include "xml_parser.h"
 #include "randomgen.h"
 #include "leak_dumper.h"
@@ -211,6 +212,13 @@ private:
 	bool inCellTriggerEvent;
 	std::vector<int> unRegisterCellTriggerEventList;
 
+	// Lookup indexes over CellTriggerEventList so a moving unit only
+	// evaluates the triggers that can fire for it
+	std::map<int,std::set<int> > cellTriggerEventsBySourceUnit;
+	std::map<int,std::set<int> > cellTriggerEventsBySourceFaction;
+	std::map<Vec2i,std::set<int> > cellTriggerEventsByBucket;
+	std::map<int,std::set<int> > cellTriggerEventsByAreaUnit;
+
 	bool registeredDayNightEvent;
 	int lastDayNightTriggerStatus;
 
@@ -229,6 +237,7 @@ private:
 private:
 	static const int messageWrapCount;
 	static const int displayTextWrapCount;
+	static const int cellTriggerEventBucketSize;
 
 public:
 
@@ -266,6 +275,15 @@ public:
 private:
 	string wrapString(const string &str, int wrapCount);
 
+	//cell trigger event indexes
+	int registerCellTriggerEvent(const CellTriggerEvent &trigger);
+	void eraseCellTriggerEvent(int eventId);
+	bool getCellTriggerEventBucketRange(const CellTriggerEvent &event, Vec2i &bucketStart, Vec2i &bucketEnd) const;
+	void addCellTriggerEventToIndex(int eventId, const CellTriggerEvent &event);
+	void removeCellTriggerEventFromIndex(int eventId, const CellTriggerEvent &event);
+	void clearCellTriggerEventIndex();
+	void getCellTriggerEventCandidates(Unit *movingUnit, std::set<int> &candidateEventIds) const;
+
 	//wrappers, commands
 	void networkShowMessageForFaction(const string &text, const string &header,int factionIndex);
 	void networkShowMessageForTeam(const string &text, const string &header,int teamIndex);
@@ -80,6 +80,7 @@ const char *GameConstants::saveNetworkGameFileClientCompressed 	= "megaglest-sav
 
 const char *GameConstants::saveGameFileDefault 			= "megaglest-saved.xml";
 const char *GameConstants::saveGameFileAutoTestDefault 	= "megaglest-auto-saved_%s.xml";
+const char *GameConstants::saveGameFileAutoSave 			= "megaglest-autosave.xml";
 const char *GameConstants::saveGameFilePattern 			= "megaglest-saved_%s.xml";
 
 const char *Config::glest_ini_filename                  = "glest.ini";
@@ -103,6 +104,16 @@ map<string,string> Config::customRuntimeProperties;
 const string defaultNotFoundValue = "~~NOT FOUND~~";
 
 map<ConfigType,Config> Config::configList;
+SDL_atomic_t Config::propertyGeneration;
+
+ConfigBool configShowPerfStats("ShowPerfStats","false");
+ConfigBool configEnableNewThreadManager("EnableNewThreadManager","false");
+ConfigBool configAdaptiveLagCheck("NetworkAdaptiveLagCheck","true");
+ConfigBool configFramePacing("FramePacing","true");
+ConfigBool configEnableFrustrumCache("EnableFrustrumCache","false");
+ConfigBool configDebugGameSynchUI("DebugGameSynchUI","false");
+ConfigBool configDisableWaterSounds("DisableWaterSounds","false");
+ConfigBool configSaveCommandsForReplay("SaveCommandsForReplay","false");
 
 Config::Config() {
 	fileLoaded.first 			= false;
@@ -335,6 +346,10 @@ void Config::CopyAll(Config *src, Config *dest) {
 	dest->fileLoaded	= src->fileLoaded;
 }
 
+void Config::invalidateCachedValues() {
+	SDL_AtomicAdd(&propertyGeneration,1);
+}
+
 void Config::reload() {
 	if(SystemFlags::VERBOSE_MODE_ENABLED) if(SystemFlags::getSystemSettingType(SystemFlags::debugSystem).enabled) SystemFlags::OutputDebug(SystemFlags::debugSystem,"In [%s::%s Line: %d]\n",__FILE__,__FUNCTION__,__LINE__);
 
@@ -345,6 +360,7 @@ void Config::reload() {
 
 	Config &oldconfig = configList.find(type.first)->second;
 	CopyAll(&newconfig, &oldconfig);
+	invalidateCachedValues();
 
 	if(SystemFlags::VERBOSE_MODE_ENABLED) if(SystemFlags::getSystemSettingType(SystemFlags::debugSystem).enabled) SystemFlags::OutputDebug(SystemFlags::debugSystem,"In [%s::%s Line: %d]\n",__FILE__,__FUNCTION__,__LINE__);
 }
@@ -597,55 +613,57 @@ SDL_Keycode Config::getSDLKey(const char *key) const {
 void Config::setInt(const string &key, int value, bool tempBuffer) {
 	if(tempBuffer == true) {
 		tempProperties.setInt(key, value);
-		return;
 	}
-	if(fileLoaded.second == true) {
+	else if(fileLoaded.second == true) {
 		properties.second.setInt(key, value);
-		return;
 	}
-	properties.first.setInt(key, value);
+	else {
+		properties.first.setInt(key, value);
+	}
+
+	invalidateCachedValues();
 }
 
 void Config::setBool(const string &key, bool value, bool tempBuffer) {
 	if(tempBuffer == true) {
 		tempProperties.setBool(key, value);
-		return;
 	}
-
-	if(fileLoaded.second == true) {
+	else if(fileLoaded.second == true) {
 		properties.second.setBool(key, value);
-		return;
+	}
+	else {
+		properties.first.setBool(key, value);
 	}
 
-	properties.first.setBool(key, value);
+	invalidateCachedValues();
 }
 
 void Config::setFloat(const string &key, float value, bool tempBuffer) {
 	if(tempBuffer == true) {
 		tempProperties.setFloat(key, value);
-		return;
 	}
-
-	if(fileLoaded.second == true) {
+	else if(fileLoaded.second == true) {
 		properties.second.setFloat(key, value);
-		return;
+	}
+	else {
+		properties.first.setFloat(key, value);
 	}
 
-	properties.first.setFloat(key, value);
+	invalidateCachedValues();
 }
 
 void Config::setString(const string &key, const string &value, bool tempBuffer) {
 	if(tempBuffer == true) {
 		tempProperties.setString(key, value);
-		return;
 	}
-
-	if(fileLoaded.second == true) {
+	else if(fileLoaded.second == true) {
 		properties.second.setString(key, value);
-		return;
+	}
+	else {
+		properties.first.setString(key, value);
 	}
 
-	properties.first.setString(key, value);
+	invalidateCachedValues();
 }
 
 vector<pair<string,string> > Config::getPropertiesFromContainer(const Properties &propertiesObj) const {
@@ -700,6 +718,7 @@ void Config::setUserProperties(const vector<pair<string,string> > &valueList) {
 		const pair<string,string> &nameValuePair = valueList[idx];
 		propertiesObj.setString(nameValuePair.first,nameValuePair.second);
 	}
+	invalidateCachedValues();
 }
 
 string Config::getFileName(bool userFilename) const {
@@ -19,6 +19,7 @@
 
 #include "properties.h"
 #include <vector>
+#include <cstring>
 #include "game_constants.h"
 #include <SDL.h>
 #include "leak_dumper.h"
@@ -60,6 +61,10 @@ private:
 
     static map<string,string> customRuntimeProperties;
 
+    // Bumped whenever any property changes so ConfigValue handles know
+    // when their cached value is stale
+    static SDL_atomic_t propertyGeneration;
+
 public:
 
     static const char *glestkeys_ini_filename;
@@ -77,6 +82,7 @@ protected:
 	Config(std::pair<ConfigType,ConfigType> type, std::pair<string,string> file, std::pair<bool,bool> fileMustExist,string custom_path="");
 	bool tryCustomPath(std::pair<ConfigType,ConfigType> &type, std::pair<string,string> &file, string custom_path);
 	static void CopyAll(Config *src,Config *dest);
+	static void invalidateCachedValues();
 	vector<pair<string,string> > getPropertiesFromContainer(const Properties &propertiesObj) const;
 	static bool replaceFileWithLocalFile(const vector<string> &dirList, string fileNamePart, string &resultToReplace);
 
@@ -124,8 +130,99 @@ public:
 	static string findValidLocalFileFromPath(string fileName);
 
 	static string getMapPath(const string &mapName, string scenarioDir="", bool errorOnNotFound=true);
+
+	static inline int getPropertyGeneration() { return SDL_AtomicGet(&propertyGeneration); }
 };
 
+// =====================================================
+// 	class ConfigValue
+//
+//	Typed handle to a main game config property. The value
+//	is parsed on first use and only re-read after Config
+//	changes (set*, reload), so reading it in per frame code
+//	is two atomic loads. Handles are shared by every thread,
+//	declare each one once below with the same key and default
+//	the code would otherwise pass to Config::getXXX.
+// =====================================================
+
+template<typename T>
+class ConfigValue {
+private:
+	const char *key;
+	const char *defaultValueIfNotFound;
+	SDL_atomic_t value;
+	SDL_atomic_t generation;
+	SDL_SpinLock refreshLock;
+
+	T readValue(const Config &config) const;
+	static int encodeValue(T value);
+	static T decodeValue(int value);
+
+public:
+	ConfigValue(const char *key, const char *defaultValueIfNotFound=NULL) :
+		key(key), defaultValueIfNotFound(defaultValueIfNotFound), refreshLock(0) {
+		SDL_AtomicSet(&value,0);
+		SDL_AtomicSet(&generation,-1);
+	}
+
+	inline T get() {
+		int currentGeneration = Config::getPropertyGeneration();
+		if(SDL_AtomicGet(&generation) == currentGeneration) {
+			return decodeValue(SDL_AtomicGet(&value));
+		}
+
+		// The value is read after currentGeneration so it is never older
+		// than the generation stored with it
+		SDL_AtomicLock(&refreshLock);
+		T result = readValue(Config::getInstance());
+		SDL_AtomicSet(&value,encodeValue(result));
+		SDL_AtomicSet(&generation,currentGeneration);
+		SDL_AtomicUnlock(&refreshLock);
+		return result;
+	}
+
+	inline const char * getKey() const { return key; }
+};
+
+template<> inline bool ConfigValue<bool>::readValue(const Config &config) const {
+	return config.getBool(key,defaultValueIfNotFound);
+}
+template<> inline int ConfigValue<int>::readValue(const Config &config) const {
+	return config.getInt(key,defaultValueIfNotFound);
+}
+template<> inline float ConfigValue<float>::readValue(const Config &config) const {
+	return config.getFloat(key,defaultValueIfNotFound);
+}
+
+template<> inline int ConfigValue<bool>::encodeValue(bool value) { return (value == true ? 1 : 0); }
+template<> inline bool ConfigValue<bool>::decodeValue(int value) { return (value != 0); }
+template<> inline int ConfigValue<int>::encodeValue(int value) { return value; }
+template<> inline int ConfigValue<int>::decodeValue(int value) { return value; }
+template<> inline int ConfigValue<float>::encodeValue(float value) {
+	int result = 0;
+	memcpy(&result,&value,sizeof(result));
+	return result;
+}
+template<> inline float ConfigValue<float>::decodeValue(int value) {
+	float result = 0;
+	memcpy(&result,&value,sizeof(result));
+	return result;
+}
+
+typedef ConfigValue<bool> ConfigBool;
+typedef ConfigValue<int> ConfigInt;
+typedef ConfigValue<float> ConfigFloat;
+
+// Settings read every frame
+extern ConfigBool configShowPerfStats;
+extern ConfigBool configEnableNewThreadManager;
+extern ConfigBool configAdaptiveLagCheck;
+extern ConfigBool configFramePacing;
+extern ConfigBool configEnableFrustrumCache;
+extern ConfigBool configDebugGameSynchUI;
+extern ConfigBool configDisableWaterSounds;
+extern ConfigBool configSaveCommandsForReplay;
+
 }}//end namespace
 
 #endif
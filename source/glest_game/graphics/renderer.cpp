@@ -201,6 +201,8 @@ Renderer::Renderer() : BaseRenderer(), saveScreenShotThreadAccessor(new Mutex(CO
 	quadCache.clearFrustumData();
 
 	lastRenderFps=MIN_FPS_NORMAL_RENDERING;
+	minimapTextureRevision=0;
+	unitRenderInterpolation=0;
 	shadowsOffDueToMinRender=false;
 	shadowMapHandle=0;
 	shadowMapHandleValid=false;
@@ -1227,11 +1229,11 @@ bool Renderer::ExtractFrustum(VisibleQuadContainerCache &quadCacheItem) {
 //   }
 
    // Check the frustum cache
-   const bool useFrustumCache = Config::getInstance().getBool("EnableFrustrumCache","false");
+   const bool useFrustumCache = configEnableFrustrumCache.get();
    pair<vector<float>,vector<float> > lookupKey;
    if(useFrustumCache == true) {
 	   lookupKey = make_pair(proj,modl);
-	   map<pair<vector<float>,vector<float> >, vector<vector<float> > >::iterator iterFind = quadCacheItem.frustumDataCache.find(lookupKey);
+	   map<pair<vector<float>,vector<float> >, Frustum >::iterator iterFind = quadCacheItem.frustumDataCache.find(lookupKey);
 	   if(iterFind != quadCacheItem.frustumDataCache.end()) {
 		   if(SystemFlags::VERBOSE_MODE_ENABLED) printf("\nCalc Frustum found in cache\n");
 
@@ -1247,158 +1249,14 @@ bool Renderer::ExtractFrustum(VisibleQuadContainerCache &quadCacheItem) {
    }
 
    if(quadCacheItem.proj != proj || quadCacheItem.modl != modl) {
-   //if(frustumChanged == true) {
 	   frustumChanged = true;
-	   vector<vector<float> > &frustum = quadCacheItem.frustumData;
-	   //assert(frustum.size() == 6);
-	   //assert(frustum[0].size() == 4);
-
 	   quadCacheItem.proj = proj;
 	   quadCacheItem.modl = modl;
 
-	   float   clip[16];
-	   float   t=0;
-
-	   /* Combine the two matrices (multiply projection by modelview) */
-	   clip[ 0] = modl[ 0] * proj[ 0] + modl[ 1] * proj[ 4] + modl[ 2] * proj[ 8] + modl[ 3] * proj[12];
-	   clip[ 1] = modl[ 0] * proj[ 1] + modl[ 1] * proj[ 5] + modl[ 2] * proj[ 9] + modl[ 3] * proj[13];
-	   clip[ 2] = modl[ 0] * proj[ 2] + modl[ 1] * proj[ 6] + modl[ 2] * proj[10] + modl[ 3] * proj[14];
-	   clip[ 3] = modl[ 0] * proj[ 3] + modl[ 1] * proj[ 7] + modl[ 2] * proj[11] + modl[ 3] * proj[15];
-
-	   clip[ 4] = modl[ 4] * proj[ 0] + modl[ 5] * proj[ 4] + modl[ 6] * proj[ 8] + modl[ 7] * proj[12];
-	   clip[ 5] = modl[ 4] * proj[ 1] + modl[ 5] * proj[ 5] + modl[ 6] * proj[ 9] + modl[ 7] * proj[13];
-	   clip[ 6] = modl[ 4] * proj[ 2] + modl[ 5] * proj[ 6] + modl[ 6] * proj[10] + modl[ 7] * proj[14];
-	   clip[ 7] = modl[ 4] * proj[ 3] + modl[ 5] * proj[ 7] + modl[ 6] * proj[11] + modl[ 7] * proj[15];
-
-	   clip[ 8] = modl[ 8] * proj[ 0] + modl[ 9] * proj[ 4] + modl[10] * proj[ 8] + modl[11] * proj[12];
-	   clip[ 9] = modl[ 8] * proj[ 1] + modl[ 9] * proj[ 5] + modl[10] * proj[ 9] + modl[11] * proj[13];
-	   clip[10] = modl[ 8] * proj[ 2] + modl[ 9] * proj[ 6] + modl[10] * proj[10] + modl[11] * proj[14];
-	   clip[11] = modl[ 8] * proj[ 3] + modl[ 9] * proj[ 7] + modl[10] * proj[11] + modl[11] * proj[15];
-
-	   clip[12] = modl[12] * proj[ 0] + modl[13] * proj[ 4] + modl[14] * proj[ 8] + modl[15] * proj[12];
-	   clip[13] = modl[12] * proj[ 1] + modl[13] * proj[ 5] + modl[14] * proj[ 9] + modl[15] * proj[13];
-	   clip[14] = modl[12] * proj[ 2] + modl[13] * proj[ 6] + modl[14] * proj[10] + modl[15] * proj[14];
-	   clip[15] = modl[12] * proj[ 3] + modl[13] * proj[ 7] + modl[14] * proj[11] + modl[15] * proj[15];
-
-	   /* Extract the numbers for the RIGHT plane */
-	   frustum[0][0] = clip[ 3] - clip[ 0];
-	   frustum[0][1] = clip[ 7] - clip[ 4];
-	   frustum[0][2] = clip[11] - clip[ 8];
-	   frustum[0][3] = clip[15] - clip[12];
-
-	   if(SystemFlags::VERBOSE_MODE_ENABLED) printf("\nCalc Frustum #%da: [%f][%f][%f][%f]\n",0,frustum[0][0],frustum[0][1],frustum[0][2],frustum[0][3]);
-
-	   /* Normalize the result */
-	   t = std::sqrt( frustum[0][0] * frustum[0][0] + frustum[0][1] * frustum[0][1] + frustum[0][2] * frustum[0][2] );
-	   if(t != 0.0) {
-		   frustum[0][0] /= t;
-		   frustum[0][1] /= t;
-		   frustum[0][2] /= t;
-		   frustum[0][3] /= t;
-
-		   if(SystemFlags::VERBOSE_MODE_ENABLED) printf("\nCalc Frustum #%db: [%f][%f][%f][%f] t = %f\n",0,frustum[0][0],frustum[0][1],frustum[0][2],frustum[0][3],t);
-	   }
-
-	   /* Extract the numbers for the LEFT plane */
-	   frustum[1][0] = clip[ 3] + clip[ 0];
-	   frustum[1][1] = clip[ 7] + clip[ 4];
-	   frustum[1][2] = clip[11] + clip[ 8];
-	   frustum[1][3] = clip[15] + clip[12];
-
-	   if(SystemFlags::VERBOSE_MODE_ENABLED) printf("\nCalc Frustum #%da: [%f][%f][%f][%f]\n",1,frustum[1][0],frustum[1][1],frustum[1][2],frustum[1][3]);
-
-	   /* Normalize the result */
-	   t = std::sqrt( frustum[1][0] * frustum[1][0] + frustum[1][1] * frustum[1][1] + frustum[1][2] * frustum[1][2] );
-	   if(t != 0.0) {
-		   frustum[1][0] /= t;
-		   frustum[1][1] /= t;
-		   frustum[1][2] /= t;
-		   frustum[1][3] /= t;
-
-		   if(SystemFlags::VERBOSE_MODE_ENABLED) printf("\nCalc Frustum #%db: [%f][%f][%f][%f] t = %f\n",1,frustum[1][0],frustum[1][1],frustum[1][2],frustum[1][3],t);
-	   }
-
-	   /* Extract the BOTTOM plane */
-	   frustum[2][0] = clip[ 3] + clip[ 1];
-	   frustum[2][1] = clip[ 7] + clip[ 5];
-	   frustum[2][2] = clip[11] + clip[ 9];
-	   frustum[2][3] = clip[15] + clip[13];
-
-	   if(SystemFlags::VERBOSE_MODE_ENABLED) printf("\nCalc Frustum #%da: [%f][%f][%f][%f]\n",2,frustum[2][0],frustum[2][1],frustum[2][2],frustum[2][3]);
-
-	   /* Normalize the result */
-
-	   t = std::sqrt( frustum[2][0] * frustum[2][0] + frustum[2][1] * frustum[2][1] + frustum[2][2] * frustum[2][2] );
-	   if(t != 0.0) {
-		   frustum[2][0] /= t;
-		   frustum[2][1] /= t;
-		   frustum[2][2] /= t;
-		   frustum[2][3] /= t;
-
-		   if(SystemFlags::VERBOSE_MODE_ENABLED) printf("\nCalc Frustum #%db: [%f][%f][%f][%f] t = %f\n",2,frustum[2][0],frustum[2][1],frustum[2][2],frustum[2][3],t);
-	   }
-
-	   /* Extract the TOP plane */
-	   frustum[3][0] = clip[ 3] - clip[ 1];
-	   frustum[3][1] = clip[ 7] - clip[ 5];
-	   frustum[3][2] = clip[11] - clip[ 9];
-	   frustum[3][3] = clip[15] - clip[13];
-
-	   if(SystemFlags::VERBOSE_MODE_ENABLED) printf("\nCalc Frustum #%da: [%f][%f][%f][%f]\n",3,frustum[3][0],frustum[3][1],frustum[3][2],frustum[3][3]);
-
-	   /* Normalize the result */
-
-	   t = std::sqrt( frustum[3][0] * frustum[3][0] + frustum[3][1] * frustum[3][1] + frustum[3][2] * frustum[3][2] );
-	   if(t != 0.0) {
-		   frustum[3][0] /= t;
-		   frustum[3][1] /= t;
-		   frustum[3][2] /= t;
-		   frustum[3][3] /= t;
-
-		   if(SystemFlags::VERBOSE_MODE_ENABLED) printf("\nCalc Frustum #%db: [%f][%f][%f][%f] t = %f\n",3,frustum[3][0],frustum[3][1],frustum[3][2],frustum[3][3],t);
-	   }
+	   Frustum &frustum = quadCacheItem.frustumData;
+	   frustum.extract(&proj[0], &modl[0]);
 
-	   /* Extract the FAR plane */
-	   frustum[4][0] = clip[ 3] - clip[ 2];
-	   frustum[4][1] = clip[ 7] - clip[ 6];
-	   frustum[4][2] = clip[11] - clip[10];
-	   frustum[4][3] = clip[15] - clip[14];
-
-	   if(SystemFlags::VERBOSE_MODE_ENABLED) printf("\nCalc Frustum #%da: [%f][%f][%f][%f]\n",4,frustum[4][0],frustum[4][1],frustum[4][2],frustum[4][3]);
-
-	   /* Normalize the result */
-
-	   t = std::sqrt( frustum[4][0] * frustum[4][0] + frustum[4][1] * frustum[4][1] + frustum[4][2] * frustum[4][2] );
-
-	   if(t != 0.0) {
-		   frustum[4][0] /= t;
-		   frustum[4][1] /= t;
-		   frustum[4][2] /= t;
-		   frustum[4][3] /= t;
-
-		   if(SystemFlags::VERBOSE_MODE_ENABLED) printf("\nCalc Frustum #%db: [%f][%f][%f][%f] t = %f\n",4,frustum[4][0],frustum[4][1],frustum[4][2],frustum[4][3],t);
-	   }
-
-	   /* Extract the NEAR plane */
-	   frustum[5][0] = clip[ 3] + clip[ 2];
-	   frustum[5][1] = clip[ 7] + clip[ 6];
-	   frustum[5][2] = clip[11] + clip[10];
-	   frustum[5][3] = clip[15] + clip[14];
-
-	   if(SystemFlags::VERBOSE_MODE_ENABLED) printf("\nCalc Frustum #%da: [%f][%f][%f][%f]\n",5,frustum[5][0],frustum[5][1],frustum[5][2],frustum[5][3]);
-
-	   /* Normalize the result */
-
-	   t = std::sqrt( frustum[5][0] * frustum[5][0] + frustum[5][1] * frustum[5][1] + frustum[5][2] * frustum[5][2] );
-
-	   if(t != 0.0) {
-		   frustum[5][0] /= t;
-		   frustum[5][1] /= t;
-		   frustum[5][2] /= t;
-		   frustum[5][3] /= t;
-
-		   if(SystemFlags::VERBOSE_MODE_ENABLED) printf("\nCalc Frustum #%db: [%f][%f][%f][%f] t = %f\n",5,frustum[5][0],frustum[5][1],frustum[5][2],frustum[5][3],t);
-	   }
+	   if(SystemFlags::VERBOSE_MODE_ENABLED) printf("\nCalc Frustum:\n%s",frustum.toString().c_str());
 
 	   if(useFrustumCache == true) {
 		   quadCacheItem.frustumDataCache[lookupKey] = frustum;
@@ -1432,29 +1290,8 @@ bool Renderer::ExtractFrustum(VisibleQuadContainerCache &quadCacheItem) {
 //	return true;
 //}
 
-bool Renderer::CubeInFrustum(vector<vector<float> > &frustum, float x, float y, float z, float size ) {
-   unsigned int p=0;
-
-   for( p = 0; p < frustum.size(); p++ ) {
-      if( frustum[p][0] * (x - size) + frustum[p][1] * (y - size) + frustum[p][2] * (z - size) + frustum[p][3] > 0 )
-         continue;
-      if( frustum[p][0] * (x + size) + frustum[p][1] * (y - size) + frustum[p][2] * (z - size) + frustum[p][3] > 0 )
-         continue;
-      if( frustum[p][0] * (x - size) + frustum[p][1] * (y + size) + frustum[p][2] * (z - size) + frustum[p][3] > 0 )
-         continue;
-      if( frustum[p][0] * (x + size) + frustum[p][1] * (y + size) + frustum[p][2] * (z - size) + frustum[p][3] > 0 )
-         continue;
-      if( frustum[p][0] * (x - size) + frustum[p][1] * (y - size) + frustum[p][2] * (z + size) + frustum[p][3] > 0 )
-         continue;
-      if( frustum[p][0] * (x + size) + frustum[p][1] * (y - size) + frustum[p][2] * (z + size) + frustum[p][3] > 0 )
-         continue;
-      if( frustum[p][0] * (x - size) + frustum[p][1] * (y + size) + frustum[p][2] * (z + size) + frustum[p][3] > 0 )
-         continue;
-      if( frustum[p][0] * (x + size) + frustum[p][1] * (y + size) + frustum[p][2] * (z + size) + frustum[p][3] > 0 )
-         continue;
-      return false;
-   }
-   return true;
+bool Renderer::CubeInFrustum(const Frustum &frustum, float x, float y, float z, float size ) {
+	return frustum.cubeInFrustum(x, y, z, size);
 }
 
 void Renderer::computeVisibleQuad() {
@@ -1472,13 +1309,7 @@ void Renderer::computeVisibleQuad() {
 			visibleQuad.p[2].x,visibleQuad.p[2].y,
 			visibleQuad.p[3].x,visibleQuad.p[3].y);
 
-		for(unsigned int i = 0; i < quadCache.frustumData.size(); ++i) {
-			printf("\nFrustum #%u [" MG_SIZE_T_SPECIFIER "]: ",i,quadCache.frustumData.size());
-			vector<float> &frustumDataInner = quadCache.frustumData[i];
-			for(unsigned int j = 0; j < frustumDataInner.size(); ++j) {
-				printf("[%f]",quadCache.frustumData[i][j]);
-			}
-		}
+		printf("\n%s",quadCache.frustumData.toString().c_str());
 
 		printf("\nEND\n");
 	}
@@ -5172,7 +5003,7 @@ void Renderer::renderTeamColorCircle(){
 		for(int visibleUnitIndex = 0;
 							visibleUnitIndex < (int)qCache.visibleQuadUnitList.size(); ++visibleUnitIndex) {
 				Unit *unit = qCache.visibleQuadUnitList[visibleUnitIndex];
-				Vec3f currVec= unit->getCurrVectorFlat();
+				Vec3f currVec= unit->getRenderVectorFlat(unitRenderInterpolation);
 				Vec3f color=unit->getFaction()->getTexture()->getPixmapConst()->getPixel3f(0,0);
 				glColor4f(color.x, color.y, color.z, 0.7f);
 				renderSelectionCircle(currVec, unit->getType()->getSize(), 0.8f, 0.05f);
@@ -5227,7 +5058,7 @@ void Renderer::renderSpecialHighlightUnits(std::map<int,HighlightSpecialUnitInfo
 
 					glColor4f(color.x, color.y, color.z, alpha);
 
-					Vec3f currVec= unit->getCurrVectorFlat();
+					Vec3f currVec= unit->getRenderVectorFlat(unitRenderInterpolation);
 					renderSelectionCircle(currVec, unit->getType()->getSize(), radius, thickness);
 				}
 		}
@@ -5252,7 +5083,7 @@ void Renderer::renderTeamColorPlane(){
 				visibleUnitIndex < (int)qCache.visibleQuadUnitList.size(); ++visibleUnitIndex){
 			Unit *unit = qCache.visibleQuadUnitList[visibleUnitIndex];
 			if( unit->isAlive()){
-				Vec3f currVec= unit->getCurrVectorFlat();
+				Vec3f currVec= unit->getRenderVectorFlat(unitRenderInterpolation);
 				renderTeamColorEffect(currVec,visibleUnitIndex,unit->getType()->getSize(),
 						unit->getFaction()->getTexture()->getPixmapConst()->getPixel3f(0,0),texture);
 			}
@@ -5373,7 +5204,7 @@ void Renderer::renderUnits(bool airUnits, const int renderFps) {
 			glPushMatrix();
 
 			//translate
-			Vec3f currVec= unit->getCurrVectorFlat();
+			Vec3f currVec= unit->getRenderVectorFlat(unitRenderInterpolation);
 			glTranslatef(currVec.x, currVec.y, currVec.z);
 
 			//rotate
@@ -5390,7 +5221,7 @@ void Renderer::renderUnits(bool airUnits, const int renderFps) {
 			//dead alpha
 			const SkillType *st= unit->getCurrSkill();
 			if(st->getClass() == scDie && static_cast<const DieSkillType*>(st)->getFade()) {
-				float alpha= 1.0f - unit->getAnimProgressAsFloat();
+				float alpha= 1.0f - unit->getRenderAnimProgressAsFloat(unitRenderInterpolation);
 				glDisable(GL_COLOR_MATERIAL);
 				glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT_AND_DIFFUSE, Vec4f(1.0f, 1.0f, 1.0f, alpha).ptr());
 			}
@@ -5405,7 +5236,7 @@ void Renderer::renderUnits(bool airUnits, const int renderFps) {
 			//printf("Rendering model [%d - %s]\n[%s]\nCamera [%s]\nDistance: %f\n",unit->getId(),unit->getType()->getName().c_str(),unit->getCurrVector().getString().c_str(),this->gameCamera->getPos().getString().c_str(),this->gameCamera->getPos().dist(unit->getCurrVector()));
 
 			//if(this->gameCamera->getPos().dist(unit->getCurrVector()) <= SKIP_INTERPOLATION_DISTANCE) {
-				model->updateInterpolationData(unit->getAnimProgressAsFloat(), unit->isAlive() && !unit->isAnimProgressBound());
+				model->updateInterpolationData(unit->getRenderAnimProgressAsFloat(unitRenderInterpolation), unit->isAlive() && !unit->isAnimProgressBound());
 			//}
 
 			modelRenderer->render(model);
@@ -5545,7 +5376,7 @@ void Renderer::renderMorphEffects(){
 							initialized=true;
 						}
 
-						Vec3f currVec= unit->getCurrVectorFlat();
+						Vec3f currVec= unit->getRenderVectorFlat(unitRenderInterpolation);
 						currVec=Vec3f(currVec.x,currVec.y+0.3f,currVec.z);
 						if(mType->getField() == fAir && unit->getType()->getField()== fLand) {
 							currVec=Vec3f(currVec.x,currVec.y+game->getWorld()->getTileset()->getAirHeight(),currVec.z);
@@ -5599,7 +5430,7 @@ void Renderer::renderSelectionEffects(int healthbarMode) {
 		const Unit *unit= selection->getUnit(i);
 		if(unit != NULL) {
 			//translate
-			Vec3f currVec= unit->getCurrVectorFlat();
+			Vec3f currVec= unit->getRenderVectorFlat(unitRenderInterpolation);
 			currVec.y+= 0.3f;
 
 			//selection circle
@@ -5680,7 +5511,7 @@ void Renderer::renderSelectionEffects(int healthbarMode) {
 						int findUnitId = effect.currentAttackBoostUnits[i];
 						Unit *affectedUnit = game->getWorld()->findUnitById(findUnitId);
 						if(affectedUnit != NULL) {
-							Vec3f currVecBoost = affectedUnit->getCurrVectorFlat();
+							Vec3f currVecBoost = affectedUnit->getRenderVectorFlat(unitRenderInterpolation);
 							currVecBoost.y += 0.3f;
 
 							renderSelectionCircle(currVecBoost, affectedUnit->getType()->getSize(), 1.f);
@@ -5695,7 +5526,7 @@ void Renderer::renderSelectionEffects(int healthbarMode) {
 				map->clampPos(pos);
 
 				Vec3f arrowTarget= Vec3f(pos.x, map->getCell(pos)->getHeight(), pos.y);
-				renderArrow(unit->getCurrVectorFlat(), arrowTarget, Vec3f(0.f, 0.f, 1.f), 0.3f);
+				renderArrow(unit->getRenderVectorFlat(unitRenderInterpolation), arrowTarget, Vec3f(0.f, 0.f, 1.f), 0.3f);
 			}
 		}
 	}
@@ -5735,7 +5566,7 @@ void Renderer::renderSelectionEffects(int healthbarMode) {
 					Vec3f arrowTarget;
 					Command *c= unit->getCurrCommand();
 					if(c->getUnit() != NULL) {
-						arrowTarget= c->getUnit()->getCurrVectorFlat();
+						arrowTarget= c->getUnit()->getRenderVectorFlat(unitRenderInterpolation);
 					}
 					else {
 						Vec2i pos= c->getPos();
@@ -5744,7 +5575,7 @@ void Renderer::renderSelectionEffects(int healthbarMode) {
 						arrowTarget= Vec3f(pos.x, map->getCell(pos)->getHeight(), pos.y);
 					}
 
-					renderArrow(unit->getCurrVectorFlat(), arrowTarget, arrowColor, 0.3f);
+					renderArrow(unit->getRenderVectorFlat(unitRenderInterpolation), arrowTarget, arrowColor, 0.3f);
 				}
 			}
 		}
@@ -5763,7 +5594,7 @@ void Renderer::renderSelectionEffects(int healthbarMode) {
 				glColor4f(1.f, 0.f, 0.f, highlight);
 			}
 
-			Vec3f v= unit->getCurrVectorFlat();
+			Vec3f v= unit->getRenderVectorFlat(unitRenderInterpolation);
 			v.y+= 0.3f;
 			renderSelectionCircle(v, unit->getType()->getSize(), 0.5f+0.4f*highlight );
 		}
@@ -5871,7 +5702,7 @@ void Renderer::renderHealthBars(int healthbarMode){
 					}
 				}
 
-				Vec3f currVec= unit->getCurrVectorFlat();
+				Vec3f currVec= unit->getRenderVectorFlat(unitRenderInterpolation);
 				if(healthbarheight==-100.0f) {
 					currVec.y+=unit->getType()->getHeight();
 				} else {
@@ -6110,6 +5941,15 @@ void Renderer::renderMinimap(){
 	glActiveTexture(baseTexUnit);
 	glBindTexture(GL_TEXTURE_2D, static_cast<const Texture2DGl*>(minimap->getTexture())->getHandle());
 
+	// Terrain or objects changed since the last upload
+	if(minimapTextureRevision != minimap->getTextureRevision()) {
+		glTexSubImage2D(
+			GL_TEXTURE_2D, 0, 0, 0,
+			pixmap->getW(), pixmap->getH(),
+			GL_RGB, GL_UNSIGNED_BYTE, pixmap->getPixels());
+		minimapTextureRevision= minimap->getTextureRevision();
+	}
+
 	glColor4f(0.5f, 0.5f, 0.5f, 0.2f);
 
 	glBegin(GL_TRIANGLE_STRIP);
@@ -6255,7 +6095,7 @@ void Renderer::renderMinimap(){
 	VisibleQuadContainerCache &qCache = getQuadCache();
 	std::vector<Unit *> visibleUnitList = qCache.visibleUnitList;
 
-	const bool showAllUnitsInMinimap = Config::getInstance().getBool("DebugGameSynchUI","false");
+	const bool showAllUnitsInMinimap = configDebugGameSynchUI.get();
 	if(showAllUnitsInMinimap == true) {
 		visibleUnitList.clear();
 
@@ -7892,7 +7732,7 @@ vector<Unit *> Renderer::renderUnitsFast(bool renderingShadows, bool colorPickin
 				glPushMatrix();
 
 				//translate
-				Vec3f currVec= unit->getCurrVectorFlat();
+				Vec3f currVec= unit->getRenderVectorFlat(unitRenderInterpolation);
 				glTranslatef(currVec.x, currVec.y, currVec.z);
 
 				//rotate
@@ -7903,7 +7743,7 @@ vector<Unit *> Renderer::renderUnitsFast(bool renderingShadows, bool colorPickin
 				//if(this->gameCamera->getPos().dist(unit->getCurrVector()) <= SKIP_INTERPOLATION_DISTANCE) {
 
 					// ***MV don't think this is needed below 2013/01/11
-					model->updateInterpolationVertices(unit->getAnimProgressAsFloat(), unit->isAlive() && !unit->isAnimProgressBound());
+					model->updateInterpolationVertices(unit->getRenderAnimProgressAsFloat(unitRenderInterpolation), unit->isAlive() && !unit->isAnimProgressBound());
 
 				//}
 
@@ -9172,16 +9012,30 @@ VisibleQuadContainerCache & Renderer::getQuadCache(	bool updateOnDirtyFrame,
 			worldToScreenPosCache.clear();
 			//}
 
-			// Unit calculations
+			// Unit calculations, the frustum test is done for all units at once
+			if(VisibleQuadContainerCache::enableFrustumCalcs == true) {
+				unitCullBatch.clear();
+				for(int i = 0; i < world->getFactionCount(); ++i) {
+					const Faction *faction = world->getFaction(i);
+					for(int j = 0; j < faction->getUnitCount(); ++j) {
+						Unit *unit= faction->getUnit(j);
+						Vec3f unitPos = unit->getCurrMidHeightVector();
+						unitCullBatch.add(unitPos.x, unitPos.y, unitPos.z, unit->getType()->getRenderSize());
+					}
+				}
+				unitCullBatch.cull(quadCache.frustumData);
+			}
+
+			int unitCullIndex = 0;
 			for(int i = 0; i < world->getFactionCount(); ++i) {
 				const Faction *faction = world->getFaction(i);
-				for(int j = 0; j < faction->getUnitCount(); ++j) {
+				for(int j = 0; j < faction->getUnitCount(); ++j, ++unitCullIndex) {
 					Unit *unit= faction->getUnit(j);
 
 					bool unitCheckedForRender = false;
 					if(VisibleQuadContainerCache::enableFrustumCalcs == true) {
 						//bool insideQuad 	= PointInFrustum(quadCache.frustumData, unit->getCurrVector().x, unit->getCurrVector().y, unit->getCurrVector().z );
-						bool insideQuad 	= CubeInFrustum(quadCache.frustumData, unit->getCurrMidHeightVector().x, unit->getCurrMidHeightVector().y, unit->getCurrMidHeightVector().z, unit->getType()->getRenderSize());
+						bool insideQuad 	= unitCullBatch.isVisible(unitCullIndex);
 						bool renderInMap 	= world->toRenderUnit(unit);
 						if(insideQuad == false || renderInMap == false) {
 							unit->setVisible(false);
@@ -9267,43 +9121,52 @@ VisibleQuadContainerCache & Renderer::getQuadCache(	bool updateOnDirtyFrame,
 				}
 				quadCache.clearNonVolatileCacheData();
 
-				//int loops1=0;
-				PosQuadIterator pqi(map,visibleQuad, Map::cellScale);
-				while(pqi.next()) {
-					const Vec2i &pos= pqi.getPos();
-					if(map->isInside(pos)) {
-						//loops1++;
-						const Vec2i &mapPos = Map::toSurfCoords(pos);
-
-						//quadCache.visibleCellList.push_back(mapPos);
+				// Only the map buckets overlapping the view are visited instead
+				// of every cell in the visible quad
+				Rect2i visibleRect = visibleQuad.computeBoundingRect();
+				Rect2i visibleSurfaceRect(	visibleRect.p[0].x / Map::cellScale,
+											visibleRect.p[0].y / Map::cellScale,
+											visibleRect.p[1].x / Map::cellScale,
+											visibleRect.p[1].y / Map::cellScale);
+				objectCellList.clear();
+				map->getObjectCellsInRect(visibleSurfaceRect, objectCellList);
+
+				objectCullBatch.clear();
+				for(int objectIndex = (int)objectCellList.size() - 1; objectIndex >= 0; --objectIndex) {
+					const Vec2i &mapPos = objectCellList[objectIndex];
+					if(visibleQuad.isInside(mapPos * Map::cellScale) == false) {
+						objectCellList[objectIndex] = objectCellList.back();
+						objectCellList.pop_back();
+					}
+				}
+				if(VisibleQuadContainerCache::enableFrustumCalcs == true) {
+					for(int objectIndex = 0; objectIndex < (int)objectCellList.size(); ++objectIndex) {
+						Object *o = map->getSurfaceCell(objectCellList[objectIndex])->getObject();
+						objectCullBatch.add(o->getPos().x, o->getPos().y, o->getPos().z, 1);
+					}
+					objectCullBatch.cull(quadCache.frustumData);
+				}
 
-						SurfaceCell *sc = map->getSurfaceCell(mapPos);
-						Object *o = sc->getObject();
+				for(int objectIndex = 0; objectIndex < (int)objectCellList.size(); ++objectIndex) {
+					const Vec2i &mapPos = objectCellList[objectIndex];
+					SurfaceCell *sc = map->getSurfaceCell(mapPos);
+					Object *o = sc->getObject();
 
-						if(VisibleQuadContainerCache::enableFrustumCalcs == true) {
-							if(o != NULL) {
-								//bool insideQuad 	= PointInFrustum(quadCache.frustumData, o->getPos().x, o->getPos().y, o->getPos().z );
-								bool insideQuad 	= CubeInFrustum(quadCache.frustumData, o->getPos().x, o->getPos().y, o->getPos().z, 1);
-								if(insideQuad == false) {
-									o->setVisible(false);
-									continue;
-								}
-							}
+					if(VisibleQuadContainerCache::enableFrustumCalcs == true) {
+						if(objectCullBatch.isVisible(objectIndex) == false) {
+							o->setVisible(false);
+							continue;
 						}
+					}
 
-                        bool cellExplored = world->showWorldForPlayer(world->getThisFactionIndex());
-                        if(cellExplored == false) {
-                            cellExplored = sc->isExplored(world->getThisTeamIndex());
-                        }
-
-						bool isExplored = (cellExplored == true && o != NULL);
-						//bool isVisible = (sc->isVisible(world->getThisTeamIndex()) && o != NULL);
-						bool isVisible = true;
+					bool cellExplored = world->showWorldForPlayer(world->getThisFactionIndex());
+					if(cellExplored == false) {
+						cellExplored = sc->isExplored(world->getThisTeamIndex());
+					}
 
-						if(isExplored == true && isVisible == true) {
-							quadCache.visibleObjectList.push_back(o);
-							o->setVisible(true);
-						}
+					if(cellExplored == true) {
+						quadCache.visibleObjectList.push_back(o);
+						o->setVisible(true);
 					}
 				}
 
@@ -9315,64 +9178,53 @@ VisibleQuadContainerCache & Renderer::getQuadCache(	bool updateOnDirtyFrame,
 
 				const Rect2i mapBounds(0, 0, map->getSurfaceW()-1, map->getSurfaceH()-1);
 				Quad2i scaledQuad = visibleQuad / Map::cellScale;
+				scaledCellList.clear();
 				PosQuadIterator pqis(map,scaledQuad);
 				while(pqis.next()) {
 					const Vec2i &pos= pqis.getPos();
 					if(mapBounds.isInside(pos)) {
-						//loops2++;
-						if(VisibleQuadContainerCache::enableFrustumCalcs == false) {
-							quadCache.visibleScaledCellList.push_back(pos);
-
-							if(markedCells.empty() == false) {
-								if(markedCells.find(pos) != markedCells.end()) {
-									//printf("#1 ******** VISIBLE SCALED CELL FOUND in marked list pos [%s] markedCells.size() = " MG_SIZE_T_SPECIFIER "\n",pos.getString().c_str(),markedCells.size());
-								//if(markedCells.empty() == false) {
-									//SurfaceCell *sc = map->getSurfaceCell(pos);
-									//quadCache.visibleScaledCellToScreenPosList[pos]=computeScreenPosition(sc->getVertex());
-									updateMarkedCellScreenPosQuadCache(pos);
-								}
-								else {
-									//printf("#1 VISIBLE SCALED CELL NOT FOUND in marked list pos [%s] markedCells.size() = " MG_SIZE_T_SPECIFIER "\n",pos.getString().c_str(),markedCells.size());
-								}
-							}
-						}
-						else {
-							//bool insideQuad = false;
-
-							//if( !insideQuad) {
-								SurfaceCell *sc = map->getSurfaceCell(pos.x, pos.y);
-								bool insideQuad = CubeInFrustum(quadCache.frustumData, sc->getVertex().x, sc->getVertex().y, sc->getVertex().z, 0);
-							//}
-							if( !insideQuad) {
-								SurfaceCell *sc = map->getSurfaceCell(pos.x+1, pos.y);
-								insideQuad = CubeInFrustum(quadCache.frustumData, sc->getVertex().x, sc->getVertex().y, sc->getVertex().z, 0);
-							}
-							if( !insideQuad) {
-								SurfaceCell *sc = map->getSurfaceCell(pos.x, pos.y+1);
-								insideQuad = CubeInFrustum(quadCache.frustumData, sc->getVertex().x, sc->getVertex().y, sc->getVertex().z, 0);
-							}
-							if( !insideQuad) {
-								SurfaceCell *sc = map->getSurfaceCell(pos.x+1, pos.y+1);
-								insideQuad = CubeInFrustum(quadCache.frustumData, sc->getVertex().x, sc->getVertex().y, sc->getVertex().z, 0);
-							}
+						scaledCellList.push_back(pos);
+					}
+				}
 
-							if(insideQuad == true) {
-								quadCache.visibleScaledCellList.push_back(pos);
-
-								if(markedCells.empty() == false) {
-									if(markedCells.find(pos) != markedCells.end()) {
-										//printf("#2 ******** VISIBLE SCALED CELL FOUND in marked list pos [%s] markedCells.size() = " MG_SIZE_T_SPECIFIER "\n",pos.getString().c_str(),markedCells.size());
-									//if(markedCells.empty() == false) {
-										//quadCache.visibleScaledCellToScreenPosList[pos]=computeScreenPosition(sc->getVertex());
-										updateMarkedCellScreenPosQuadCache(pos);
-									}
-									else {
-										//printf("#2 VISIBLE SCALED CELL NOT FOUND in marked list pos [%s] markedCells.size() = " MG_SIZE_T_SPECIFIER "\n",pos.getString().c_str(),markedCells.size());
-									}
-								}
-							}
+				// A cell is visible when any of its four corners is, all the
+				// corners are tested in one batch
+				if(VisibleQuadContainerCache::enableFrustumCalcs == true) {
+					scaledCellCullBatch.clear();
+					for(int cellIndex = 0; cellIndex < (int)scaledCellList.size(); ++cellIndex) {
+						const Vec2i &pos = scaledCellList[cellIndex];
+						const int nextX = min(pos.x + 1, mapBounds.p[1].x);
+						const int nextY = min(pos.y + 1, mapBounds.p[1].y);
+						const Vec3f &vertex1 = map->getSurfaceCell(pos.x, pos.y)->getVertex();
+						const Vec3f &vertex2 = map->getSurfaceCell(nextX, pos.y)->getVertex();
+						const Vec3f &vertex3 = map->getSurfaceCell(pos.x, nextY)->getVertex();
+						const Vec3f &vertex4 = map->getSurfaceCell(nextX, nextY)->getVertex();
+						scaledCellCullBatch.add(vertex1.x, vertex1.y, vertex1.z, 0);
+						scaledCellCullBatch.add(vertex2.x, vertex2.y, vertex2.z, 0);
+						scaledCellCullBatch.add(vertex3.x, vertex3.y, vertex3.z, 0);
+						scaledCellCullBatch.add(vertex4.x, vertex4.y, vertex4.z, 0);
+					}
+					scaledCellCullBatch.cull(quadCache.frustumData);
+				}
+
+				for(int cellIndex = 0; cellIndex < (int)scaledCellList.size(); ++cellIndex) {
+					const Vec2i &pos = scaledCellList[cellIndex];
+					if(VisibleQuadContainerCache::enableFrustumCalcs == true) {
+						const int cornerIndex = cellIndex * 4;
+						bool insideQuad =	scaledCellCullBatch.isVisible(cornerIndex) ||
+											scaledCellCullBatch.isVisible(cornerIndex + 1) ||
+											scaledCellCullBatch.isVisible(cornerIndex + 2) ||
+											scaledCellCullBatch.isVisible(cornerIndex + 3);
+						if(insideQuad == false) {
+							continue;
 						}
 					}
+
+					quadCache.visibleScaledCellList.push_back(pos);
+					if(markedCells.empty() == false &&
+						markedCells.find(pos) != markedCells.end()) {
+						updateMarkedCellScreenPosQuadCache(pos);
+					}
 				}
 				//printf("Frame # = %d loops2 = %d\n",world->getFrameCount(),loops2);
 			}
@@ -38,6 +38,7 @@
 #include "base_renderer.h"
 #include "simple_threads.h"
 #include "video_player.h"
+#include "frustum.h"
 
 #ifdef DEBUG_RENDERING_ENABLED
 #	define IF_DEBUG_EDITION(x) x
@@ -150,7 +151,7 @@ public:
 		visibleScaledCellList.reserve(500);
 	}
 	inline void clearFrustumData() {
-		frustumData = vector<vector<float> >(6,vector<float>(4,0));
+		frustumData.clear();
 		proj = vector<float>(16,0);
 		modl = vector<float>(16,0);
 		frustumDataCache.clear();
@@ -165,10 +166,10 @@ public:
 	std::map<Vec2i,Vec3f> visibleScaledCellToScreenPosList;
 
 	static bool enableFrustumCalcs;
-	vector<vector<float> > frustumData;
+	Frustum frustumData;
 	vector<float> proj;
 	vector<float> modl;
-	map<pair<vector<float>,vector<float> >, vector<vector<float> > > frustumDataCache;
+	map<pair<vector<float>,vector<float> >, Frustum > frustumDataCache;
 
 };
 
@@ -324,6 +325,13 @@ private:
 	float smoothedRenderFps;
 	bool shadowsOffDueToMinRender;
 
+	// Minimap terrain texture revision last uploaded to GL
+	int minimapTextureRevision;
+
+	// World updates passed since the last one ran, units are drawn moved
+	// on by this much so rendering stays smooth between updates
+	float unitRenderInterpolation;
+
 	std::vector<std::pair<ParticleSystem *, ResourceScope> > deferredParticleSystems;
 
 	SimpleTaskThread *saveScreenShotThread;
@@ -332,6 +340,13 @@ private:
 
 	std::map<Vec3f,Vec3f> worldToScreenPosCache;
 
+	// Scratch state for building the visible sets in getQuadCache
+	FrustumCullBatch unitCullBatch;
+	FrustumCullBatch objectCullBatch;
+	FrustumCullBatch scaledCellCullBatch;
+	std::vector<Vec2i> objectCellList;
+	std::vector<Vec2i> scaledCellList;
+
 	//bool masterserverMode;
 
 	std::map<uint32,VisibleQuadContainerVBOCache > mapSurfaceVBOCache;
@@ -429,7 +444,7 @@ private:
 	bool ExtractFrustum(VisibleQuadContainerCache &quadCacheItem);
 	//bool PointInFrustum(vector<vector<float> > &frustum, float x, float y, float z );
 	//bool SphereInFrustum(vector<vector<float> > &frustum,  float x, float y, float z, float radius);
-	bool CubeInFrustum(vector<vector<float> > &frustum, float x, float y, float z, float size );
+	bool CubeInFrustum(const Frustum &frustum, float x, float y, float z, float size );
 
 private:
 	Renderer();
@@ -661,6 +676,9 @@ public:
 
 	void setProgram(Program *program) { this->program = program; }
 
+	void setUnitRenderInterpolation(float value) { this->unitRenderInterpolation = value; }
+	float getUnitRenderInterpolation() const { return this->unitRenderInterpolation; }
+
 	void setupRenderForVideo();
 	virtual void renderVideoLoading(int progressPercent);
 
@@ -1631,6 +1631,14 @@ void setupLogging(Config &config, bool haveSpecialOutputCommandLineOption) {
     SystemFlags::getSystemSettingType(SystemFlags::debugSound).enabled  		= config.getBool("DebugSound","false");
     SystemFlags::getSystemSettingType(SystemFlags::debugError).enabled  		= config.getBool("DebugError","true");
 
+    // Lets busy categories stay on in production without flooding the log
+    SystemFlags::getSystemSettingType(SystemFlags::debugSystem).maxEntriesPerSecond      	= config.getInt("DebugModeMaxEntriesPerSecond","0");
+    SystemFlags::getSystemSettingType(SystemFlags::debugNetwork).maxEntriesPerSecond     	= config.getInt("DebugNetworkMaxEntriesPerSecond","0");
+    SystemFlags::getSystemSettingType(SystemFlags::debugPerformance).maxEntriesPerSecond 	= config.getInt("DebugPerformanceMaxEntriesPerSecond","0");
+    SystemFlags::getSystemSettingType(SystemFlags::debugWorldSynch).maxEntriesPerSecond  	= config.getInt("DebugWorldSynchMaxEntriesPerSecond","0");
+    SystemFlags::getSystemSettingType(SystemFlags::debugUnitCommands).maxEntriesPerSecond  	= config.getInt("DebugUnitCommandsMaxEntriesPerSecond","0");
+    SystemFlags::getSystemSettingType(SystemFlags::debugPathFinder).maxEntriesPerSecond  	= config.getInt("DebugPathFinderMaxEntriesPerSecond","0");
+
     string userData = config.getString("UserData_Root","");
     if(userData != "") {
     	endPathWithSlash(userData);
@@ -4650,6 +4658,15 @@ int glestMain(int argc, char** argv) {
         }
 	    setCRCCacheFilePath(crcCachePath);
 
+	    if(config.getBool("TextureDecodedCache","true") == true) {
+	    	string pixmapCachePath = crcCachePath + "pixmaps/";
+	        if(isdir(pixmapCachePath.c_str()) == false) {
+	        	createDirectoryPaths(pixmapCachePath);
+	        }
+	        Pixmap2D::setDecodedCacheFolder(pixmapCachePath);
+	        Pixmap2D::purgeDecodedCache((uint64)config.getInt("TextureDecodedCacheMaxMegabytes","512") * 1024 * 1024);
+	    }
+
 	    string savedGamePath = userData + "saved/";
         if(isdir(savedGamePath.c_str()) == false) {
         	createDirectoryPaths(savedGamePath);
@@ -4902,6 +4919,8 @@ int glestMain(int argc, char** argv) {
 
         // Set some statics based on ini entries
 		SystemFlags::ENABLE_THREADED_LOGGING = config.getBool("ThreadedLogging","true");
+		MutexContentionProfiler::setEnabled(config.getBool("EnableMutexContentionProfiling","false"));
+		ParticleManager::setUpdateThreadCount(config.getInt("ParticleUpdateThreads","0"));
 		FontGl::setDefault_fontType(config.getString("DefaultFont",FontGl::getDefault_fontType().c_str()));
 		UPNP_Tools::isUPNP = !config.getBool("DisableUPNP","false");
 		Texture::useTextureCompression = config.getBool("EnableTextureCompression","false");
@@ -186,6 +186,7 @@ Program::Program() : msgBox("Program", "msgBox") {
 	this->window = NULL;
 	this->shutdownApplicationEnabled = false;
 	this->skipRenderFrameCount = 0;
+	this->lastRenderMicros = 0;
 	this->messageBoxIsSystemError = false;
 	this->programStateOldSystemError = NULL;
 	this->programState= NULL;
@@ -409,7 +410,7 @@ void Program::loopWorker() {
 
 	Chrono chronoPerformanceCounts;
 
-	bool showPerfStats = Config::getInstance().getBool("ShowPerfStats","false");
+	bool showPerfStats = configShowPerfStats.get();
 	Chrono chronoPerf;
 	char perfBuf[8096]="";
 	std::vector<string> perfList;
@@ -448,6 +449,8 @@ void Program::loopWorker() {
 
     chronoPerformanceCounts.start();
 
+    lastRenderMicros = Chrono::getCurMicros();
+    programState->setUpdateInterpolation(updateTimer.getIntervalProgress());
     programState->render();
 
     programState->addPerformanceCount(ProgramState::MAIN_PROGRAM_RENDER_KEY,chronoPerformanceCounts.getMillis());
@@ -538,6 +541,11 @@ void Program::loopWorker() {
 		}
 		updateCount++;
 	}
+	if(updateCount > 0 && prevState == this->programState) {
+		// How late the first world update of this loop ran against its deadline
+		programState->addPerformanceCount("updateTimer deadline late",updateTimer.getLastLateMicros() / 1000);
+		if(SystemFlags::getSystemSettingType(SystemFlags::debugPerformance).enabled) SystemFlags::OutputDebug(SystemFlags::debugPerformance,"In [%s::%s Line: %d] update deadline late micros: " MG_I64_SPECIFIER ", updateCount = %d\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__,updateTimer.getLastLateMicros(),updateCount);
+	}
 	if(SystemFlags::getSystemSettingType(SystemFlags::debugPerformance).enabled && chrono.getMillis() > 0) SystemFlags::OutputDebug(SystemFlags::debugPerformance,"In [%s::%s] Line: %d AFTER programState->update took msecs: %lld ==============> MAIN LOOP BODY LOGIC, updateCount = %d\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__,chrono.getMillis(),updateCount);
 	if(SystemFlags::getSystemSettingType(SystemFlags::debugPerformance).enabled && chrono.getMillis() > 0) chrono.start();
 
@@ -572,6 +580,10 @@ void Program::loopWorker() {
 
 	}
 
+	if(prevState == this->programState) {
+		sleepUntilNextDeadline();
+	}
+
 	if(showPerfStats && chronoPerf.getMillis() >= 100) {
 		for(unsigned int x = 0; x < perfList.size(); ++x) {
 			printf("%s",perfList[x].c_str());
@@ -581,6 +593,42 @@ void Program::loopWorker() {
 	if(SystemFlags::getSystemSettingType(SystemFlags::debugPerformance).enabled) SystemFlags::OutputDebug(SystemFlags::debugPerformance,"In [%s::%s Line: %d] ------------------------------- MAIN LOOP END, stats: loop took msecs: %lld -------------------------------\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__,chronoLoop.getMillis());
 }
 
+// Sleep until the next render, camera or world update is due instead of
+// running empty loops. The render deadline comes from the same fps cap
+// ProgramState::canRender uses.
+void Program::sleepUntilNextDeadline() {
+	if(configFramePacing.get() == false || programState == NULL) {
+		return;
+	}
+
+	int maxFPSCap = Config::getInstance().getInt("RenderFPSCap","500");
+	if(GlobalStaticFlags::getIsNonGraphicalModeEnabled() == true) {
+		maxFPSCap = Config::getInstance().getInt("RenderFPSCapHeadless","250");
+	}
+	if(maxFPSCap <= 0) {
+		return;
+	}
+
+	int64 sleepMicros = (1000000 / maxFPSCap) - (Chrono::getCurMicros() - lastRenderMicros);
+	sleepMicros = min(sleepMicros,updateTimer.getMicrosUntilNextTime());
+	sleepMicros = min(sleepMicros,updateCameraTimer.getMicrosUntilNextTime());
+
+	// The OS sleeps in whole milliseconds, anything shorter is left to the
+	// next loop rather than spun away
+	if(sleepMicros >= 1000) {
+		int64 sleepMillis = sleepMicros / 1000;
+		int64 sleepStartMicros = Chrono::getCurMicros();
+		sleep((int)sleepMillis);
+		int64 oversleptMicros = Chrono::getCurMicros() - sleepStartMicros - sleepMillis * 1000;
+		if(oversleptMicros < 0) {
+			oversleptMicros = 0;
+		}
+
+		programState->addPerformanceCount("Frame pacing oversleep",oversleptMicros / 1000);
+		if(SystemFlags::getSystemSettingType(SystemFlags::debugPerformance).enabled) SystemFlags::OutputDebug(SystemFlags::debugPerformance,"In [%s::%s Line: %d] frame pacing slept millis: " MG_I64_SPECIFIER " overslept micros: " MG_I64_SPECIFIER "\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__,sleepMillis,oversleptMicros);
+	}
+}
+
 void Program::resize(SizeState sizeState){
 
 	switch(sizeState){
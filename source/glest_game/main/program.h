@@ -79,6 +79,7 @@ public:
 	virtual void render();
 	virtual void update();
 	virtual void updateCamera(){};
+	virtual void setUpdateInterpolation(float value){};
 	virtual void tick();
 	virtual void init(){};
 	virtual void load(){};
@@ -157,6 +158,7 @@ private:
 
     GraphicMessageBox msgBox;
     int skipRenderFrameCount;
+    int64 lastRenderMicros;
 
     bool messageBoxIsSystemError;
     ProgramState *programStateOldSystemError;
@@ -202,6 +204,7 @@ public:
 
 	void loop();
 	void loopWorker();
+	void sleepUntilNextDeadline();
 	void resize(SizeState sizeState);
 	void showMessage(const char *msg);
 	bool isMessageShowing();
@@ -102,6 +102,9 @@ MenuStateConnectedGame::MenuStateConnectedGame(Program *program, MainMenu *mainM
     getMissingTechtreeFromFTPServer				= "";
     getMissingTechtreeFromFTPServerLastPrompted	= 0;
     getMissingTechtreeFromFTPServerInProgress	= false;
+    getMismatchedTechtreeFromFTPServer			= "";
+    getMismatchedTechtreeFromFTPServerLastPrompted	= 0;
+    techtreeDeltaInProgress						= "";
 
     getInProgressSavedGameFromFTPServer			  = "";
     getInProgressSavedGameFromFTPServerInProgress = false;
@@ -1108,7 +1111,7 @@ void MenuStateConnectedGame::simpleTask(BaseThread *callingThread,void *userdata
 
     if(SystemFlags::VERBOSE_MODE_ENABLED) printf("In [%s::%s Line %d]\n",__FILE__,__FUNCTION__,__LINE__);
 
-    MutexSafeWrapper safeMutex(callingThread->getMutexThreadObjectAccessor(),string(__FILE__) + "_" + intToStr(__LINE__));
+    MutexSafeWrapper safeMutex(callingThread->getMutexThreadObjectAccessor(),CODE_AT_LINE);
 	tilesetListRemote.clear();
 	Tokenize(tilesetsMetaData,tilesetListRemote,"\n");
 	safeMutex.ReleaseLock(true);
@@ -1306,18 +1309,18 @@ void MenuStateConnectedGame::mouseClick(int x, int y, MouseButton mouseButton){
                     	if(button == 0 && ftpMessageBox.getButtonCount() == 3) {
 							string mapName = getMissingMapFromFTPServer;
 
-							MutexSafeWrapper safeMutexThread((modHttpServerThread != NULL ? modHttpServerThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+							MutexSafeWrapper safeMutexThread((modHttpServerThread != NULL ? modHttpServerThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
 							string mapURL = mapCacheList[mapName].url;
 							safeMutexThread.ReleaseLock();
 
 							if(ftpClientThread != NULL) ftpClientThread->addMapToRequests(mapName,mapURL);
-                    		MutexSafeWrapper safeMutexFTPProgress((ftpClientThread != NULL ? ftpClientThread->getProgressMutex() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+                    		MutexSafeWrapper safeMutexFTPProgress((ftpClientThread != NULL ? ftpClientThread->getProgressMutex() : NULL),CODE_AT_LINE);
                     		fileFTPProgressList[getMissingMapFromFTPServer] = pair<int,string>(0,"");
                     		safeMutexFTPProgress.ReleaseLock();
                     	}
                     	else {
                     		ftpClientThread->addMapToRequests(getMissingMapFromFTPServer);
-                    		MutexSafeWrapper safeMutexFTPProgress((ftpClientThread != NULL ? ftpClientThread->getProgressMutex() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+                    		MutexSafeWrapper safeMutexFTPProgress((ftpClientThread != NULL ? ftpClientThread->getProgressMutex() : NULL),CODE_AT_LINE);
                     		fileFTPProgressList[getMissingMapFromFTPServer] = pair<int,string>(0,"");
                     		safeMutexFTPProgress.ReleaseLock();
                     	}
@@ -1344,18 +1347,18 @@ void MenuStateConnectedGame::mouseClick(int x, int y, MouseButton mouseButton){
                     	if(button == 0 && ftpMessageBox.getButtonCount() == 3) {
     						string tilesetName = getMissingTilesetFromFTPServer;
 
-    						MutexSafeWrapper safeMutexThread((modHttpServerThread != NULL ? modHttpServerThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+    						MutexSafeWrapper safeMutexThread((modHttpServerThread != NULL ? modHttpServerThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
     						string tilesetURL = tilesetCacheList[tilesetName].url;
     						safeMutexThread.ReleaseLock();
 
     						if(ftpClientThread != NULL) ftpClientThread->addTilesetToRequests(tilesetName,tilesetURL);
-                    		MutexSafeWrapper safeMutexFTPProgress((ftpClientThread != NULL ? ftpClientThread->getProgressMutex() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+                    		MutexSafeWrapper safeMutexFTPProgress((ftpClientThread != NULL ? ftpClientThread->getProgressMutex() : NULL),CODE_AT_LINE);
                     		fileFTPProgressList[getMissingTilesetFromFTPServer] = pair<int,string>(0,"");
                     		safeMutexFTPProgress.ReleaseLock();
                     	}
                     	else {
 							ftpClientThread->addTilesetToRequests(getMissingTilesetFromFTPServer);
-							MutexSafeWrapper safeMutexFTPProgress((ftpClientThread != NULL ? ftpClientThread->getProgressMutex() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+							MutexSafeWrapper safeMutexFTPProgress((ftpClientThread != NULL ? ftpClientThread->getProgressMutex() : NULL),CODE_AT_LINE);
 							fileFTPProgressList[getMissingTilesetFromFTPServer] = pair<int,string>(0,"");
 							safeMutexFTPProgress.ReleaseLock();
                     	}
@@ -1382,21 +1385,55 @@ void MenuStateConnectedGame::mouseClick(int x, int y, MouseButton mouseButton){
                     	if(button == 0 && ftpMessageBox.getButtonCount() == 3) {
     						string techName = getMissingTechtreeFromFTPServer;
 
-    						MutexSafeWrapper safeMutexThread((modHttpServerThread != NULL ? modHttpServerThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+    						MutexSafeWrapper safeMutexThread((modHttpServerThread != NULL ? modHttpServerThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
     						string techURL = techCacheList[techName].url;
     						safeMutexThread.ReleaseLock();
 
     						if(ftpClientThread != NULL) ftpClientThread->addTechtreeToRequests(techName,techURL);
-                    		MutexSafeWrapper safeMutexFTPProgress((ftpClientThread != NULL ? ftpClientThread->getProgressMutex() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+                    		MutexSafeWrapper safeMutexFTPProgress((ftpClientThread != NULL ? ftpClientThread->getProgressMutex() : NULL),CODE_AT_LINE);
                     		fileFTPProgressList[getMissingTechtreeFromFTPServer] = pair<int,string>(0,"");
                     		safeMutexFTPProgress.ReleaseLock();
                     	}
                     	else {
 							ftpClientThread->addTechtreeToRequests(getMissingTechtreeFromFTPServer);
-							MutexSafeWrapper safeMutexFTPProgress((ftpClientThread != NULL ? ftpClientThread->getProgressMutex() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+							MutexSafeWrapper safeMutexFTPProgress((ftpClientThread != NULL ? ftpClientThread->getProgressMutex() : NULL),CODE_AT_LINE);
 							fileFTPProgressList[getMissingTechtreeFromFTPServer] = pair<int,string>(0,"");
 							safeMutexFTPProgress.ReleaseLock();
                     	}
+                    }
+			    }
+			    else if(ftpMissingDataType == ftpmsg_MismatchedTechtree) {
+                    getMissingTechtreeFromFTPServerInProgress = true;
+
+    		    	Lang &lang= Lang::getInstance();
+    		    	const vector<string> languageList = clientInterface->getGameSettings()->getUniqueNetworkPlayerLanguages();
+    		    	for(unsigned int i = 0; i < languageList.size(); ++i) {
+						char szMsg[8096]="";
+						if(lang.hasString("DataMismatchedTechtreeNowDownloading",languageList[i]) == true) {
+							snprintf(szMsg,8096,lang.getString("DataMismatchedTechtreeNowDownloading",languageList[i]).c_str(),getHumanPlayerName().c_str(),getMismatchedTechtreeFromFTPServer.c_str());
+						}
+						else {
+							snprintf(szMsg,8096,"Player: %s is attempting to update the techtree: %s",getHumanPlayerName().c_str(),getMismatchedTechtreeFromFTPServer.c_str());
+						}
+						bool localEcho = lang.isLanguageLocal(languageList[i]);
+						clientInterface->sendTextMessage(szMsg,-1, localEcho,languageList[i]);
+    		    	}
+
+                    if(ftpClientThread != NULL) {
+                    	string techName = getMismatchedTechtreeFromFTPServer;
+                    	const vector<string> &changedFiles = clientInterface->getTechMismatchChangedFiles();
+                    	const vector<string> &removedFiles = clientInterface->getTechMismatchRemovedFiles();
+                    	if(clientInterface->getTechMismatchNeedsFullDownload() == false &&
+                    		(changedFiles.empty() == false || removedFiles.empty() == false)) {
+                    		techtreeDeltaInProgress = techName;
+                    		ftpClientThread->addTechtreeFilesToRequests(techName,changedFiles,removedFiles);
+                    	}
+                    	else {
+                    		ftpClientThread->addTechtreeToRequests(techName);
+                    	}
+						MutexSafeWrapper safeMutexFTPProgress((ftpClientThread != NULL ? ftpClientThread->getProgressMutex() : NULL),CODE_AT_LINE);
+						fileFTPProgressList[techName] = pair<int,string>(0,"");
+						safeMutexFTPProgress.ReleaseLock();
                     }
 			    }
 			}
@@ -1432,6 +1469,9 @@ void MenuStateConnectedGame::mouseClick(int x, int y, MouseButton mouseButton){
             getMissingMapFromFTPServerLastPrompted		= 0;
             getMissingTilesetFromFTPServerLastPrompted	= 0;
             getMissingTechtreeFromFTPServerLastPrompted	= 0;
+            getMismatchedTechtreeFromFTPServer			= "";
+            getMismatchedTechtreeFromFTPServerLastPrompted	= 0;
+            techtreeDeltaInProgress						= "";
 
             ClientInterface *clientInterface = networkManager.getClientInterface();
             if(clientInterface == NULL) {
@@ -2812,7 +2852,7 @@ void MenuStateConnectedGame::render() {
 		renderer.renderLabel(&labelAllowNativeLanguageTechtree);
 		renderer.renderCheckBox(&checkBoxAllowNativeLanguageTechtree);
 
-        MutexSafeWrapper safeMutexFTPProgress((ftpClientThread != NULL ? ftpClientThread->getProgressMutex() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+        MutexSafeWrapper safeMutexFTPProgress((ftpClientThread != NULL ? ftpClientThread->getProgressMutex() : NULL),CODE_AT_LINE);
 
         // !!! START TEMP MV
         //renderer.renderButton(&buttonCancelDownloads);
@@ -3024,7 +3064,7 @@ void MenuStateConnectedGame::update() {
 
 				if(clientInterface->isConnected() && clientInterface->getJoinGameInProgress() == false &&
 					pingCount >= MAX_PING_LAG_COUNT && clientInterface->getLastPingLag() >= (GameConstants::networkPingInterval * MAX_PING_LAG_COUNT)) {
-					MutexSafeWrapper safeMutexFTPProgress((ftpClientThread != NULL ? ftpClientThread->getProgressMutex() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+					MutexSafeWrapper safeMutexFTPProgress((ftpClientThread != NULL ? ftpClientThread->getProgressMutex() : NULL),CODE_AT_LINE);
 					if(fileFTPProgressList.empty() == true) {
 						Lang &lang= Lang::getInstance();
 						const vector<string> languageList = displayedGamesettings.getUniqueNetworkPlayerLanguages();
@@ -3064,7 +3104,7 @@ void MenuStateConnectedGame::update() {
             	displayedGamesettings.getMap() != "") {
                 Config &config = Config::getInstance();
 
-                MutexSafeWrapper safeMutexFTPProgress(ftpClientThread != NULL ? ftpClientThread->getProgressMutex() : NULL,string(__FILE__) + "_" + intToStr(__LINE__));
+                MutexSafeWrapper safeMutexFTPProgress(ftpClientThread != NULL ? ftpClientThread->getProgressMutex() : NULL,CODE_AT_LINE);
 
                 uint32 tilesetCRC = lastCheckedCRCTilesetValue;
                 if(lastCheckedCRCTilesetName != displayedGamesettings.getTileset() &&
@@ -3434,6 +3474,43 @@ void MenuStateConnectedGame::update() {
                 if(clientInterface->getNetworkGameDataSynchCheckOkTech() == false) {
                     label = label + " techtree";
 
+                    // Offer to fetch the host's copy of a techtree that differs,
+                    // only the changed files when nothing but xml differs
+                    const vector<string> &changedFiles = clientInterface->getTechMismatchChangedFiles();
+                    const vector<string> &removedFiles = clientInterface->getTechMismatchRemovedFiles();
+                    bool needsFullDownload = clientInterface->getTechMismatchNeedsFullDownload();
+                    string techName = clientInterface->getGameSettings()->getTech();
+                    if(ftpClientThread != NULL && getMissingTechtreeFromFTPServerInProgress == false &&
+                    	ftpMessageBox.getEnabled() == false &&
+                    	(needsFullDownload == true || changedFiles.empty() == false || removedFiles.empty() == false) &&
+                    	(getMismatchedTechtreeFromFTPServer != techName ||
+                    	 difftime(time(NULL),getMismatchedTechtreeFromFTPServerLastPrompted) > REPROMPT_DOWNLOAD_SECONDS)) {
+                    	getMismatchedTechtreeFromFTPServerLastPrompted = time(NULL);
+                    	getMismatchedTechtreeFromFTPServer = techName;
+
+                    	char szBuf[8096]="";
+                    	if(needsFullDownload == true) {
+                    		if(lang.hasString("DownloadMismatchedTechtreeQuestion") == true) {
+                    			snprintf(szBuf,8096,lang.getString("DownloadMismatchedTechtreeQuestion").c_str(),techName.c_str());
+                    		}
+                    		else {
+                    			snprintf(szBuf,8096,"Your techtree %s differs from the host's, download it again?",techName.c_str());
+                    		}
+                    	}
+                    	else {
+                    		if(lang.hasString("UpdateMismatchedTechtreeQuestion") == true) {
+                    			snprintf(szBuf,8096,lang.getString("UpdateMismatchedTechtreeQuestion").c_str(),techName.c_str(),(int)(changedFiles.size() + removedFiles.size()));
+                    		}
+                    		else {
+                    			snprintf(szBuf,8096,"Your techtree %s differs from the host's, update the %d changed files?",techName.c_str(),(int)(changedFiles.size() + removedFiles.size()));
+                    		}
+                    	}
+
+                    	ftpMessageBox.init(lang.getString("Yes"),lang.getString("NoDownload"));
+                    	ftpMissingDataType = ftpmsg_MismatchedTechtree;
+                    	showFTPMessageBox(szBuf, lang.getString("Question"), false);
+                    }
+
                     if(updateDataSynchDetailText == true &&
                     	clientInterface->getReceivedDataSynchCheck()) {
 
@@ -3622,7 +3699,7 @@ void MenuStateConnectedGame::update() {
 				if(SystemFlags::getSystemSettingType(SystemFlags::debugPerformance).enabled && chrono.getMillis() > 0) SystemFlags::OutputDebug(SystemFlags::debugPerformance,"In [%s::%s Line: %d] took msecs: %lld\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__,chrono.getMillis());
 				if(SystemFlags::getSystemSettingType(SystemFlags::debugPerformance).enabled && chrono.getMillis() > 0) chrono.start();
 
-				MutexSafeWrapper safeMutexFTPProgress((ftpClientThread != NULL ? ftpClientThread->getProgressMutex() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+				MutexSafeWrapper safeMutexFTPProgress((ftpClientThread != NULL ? ftpClientThread->getProgressMutex() : NULL),CODE_AT_LINE);
 				if(readyToJoinInProgressGame == false) {
 					if(getInProgressSavedGameFromFTPServer == "") {
 
@@ -4292,7 +4369,7 @@ void MenuStateConnectedGame::FTPClient_CallbackEvent(string itemName,
             }
             //if(SystemFlags::VERBOSE_MODE_ENABLED) printf("Got FTP Callback for [%s] current file [%s] fileProgress = %d [now = %f, total = %f]\n",itemName.c_str(),stats->currentFilename.c_str(), fileProgress,stats->download_now,stats->download_total);
 
-            MutexSafeWrapper safeMutexFTPProgress((ftpClientThread != NULL ? ftpClientThread->getProgressMutex() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+            MutexSafeWrapper safeMutexFTPProgress((ftpClientThread != NULL ? ftpClientThread->getProgressMutex() : NULL),CODE_AT_LINE);
             pair<int,string> lastProgress;
             std::map<string,pair<int,string> >::iterator iterFind = fileFTPProgressList.find(itemName);
             if(iterFind == fileFTPProgressList.end()) {
@@ -4361,7 +4438,7 @@ void MenuStateConnectedGame::FTPClient_CallbackEvent(string itemName,
         getMissingMapFromFTPServerInProgress = false;
         if(SystemFlags::VERBOSE_MODE_ENABLED) printf("Got FTP Callback for [%s] result = %d [%s]\n",itemName.c_str(),result.first,result.second.c_str());
 
-        MutexSafeWrapper safeMutexFTPProgress((ftpClientThread != NULL ? ftpClientThread->getProgressMutex() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+        MutexSafeWrapper safeMutexFTPProgress((ftpClientThread != NULL ? ftpClientThread->getProgressMutex() : NULL),CODE_AT_LINE);
         fileFTPProgressList.erase(itemName);
         safeMutexFTPProgress.ReleaseLock();
 
@@ -4436,7 +4513,7 @@ void MenuStateConnectedGame::FTPClient_CallbackEvent(string itemName,
         getMissingTilesetFromFTPServerInProgress = false;
         if(SystemFlags::VERBOSE_MODE_ENABLED) printf("Got FTP Callback for [%s] result = %d [%s]\n",itemName.c_str(),result.first,result.second.c_str());
 
-        MutexSafeWrapper safeMutexFTPProgress((ftpClientThread != NULL ? ftpClientThread->getProgressMutex() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+        MutexSafeWrapper safeMutexFTPProgress((ftpClientThread != NULL ? ftpClientThread->getProgressMutex() : NULL),CODE_AT_LINE);
         fileFTPProgressList.erase(itemName);
         safeMutexFTPProgress.ReleaseLock(true);
 
@@ -4527,9 +4604,11 @@ void MenuStateConnectedGame::FTPClient_CallbackEvent(string itemName,
     }
     else if(type == ftp_cct_Techtree) {
         getMissingTechtreeFromFTPServerInProgress = false;
+        bool deltaUpdate = (techtreeDeltaInProgress != "" && techtreeDeltaInProgress == itemName);
+        techtreeDeltaInProgress = "";
         if(SystemFlags::VERBOSE_MODE_ENABLED) printf("Got FTP Callback for [%s] result = %d [%s]\n",itemName.c_str(),result.first,result.second.c_str());
 
-        MutexSafeWrapper safeMutexFTPProgress((ftpClientThread != NULL ? ftpClientThread->getProgressMutex() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+        MutexSafeWrapper safeMutexFTPProgress((ftpClientThread != NULL ? ftpClientThread->getProgressMutex() : NULL),CODE_AT_LINE);
         fileFTPProgressList.erase(itemName);
         safeMutexFTPProgress.ReleaseLock(true);
 
@@ -4565,6 +4644,7 @@ void MenuStateConnectedGame::FTPClient_CallbackEvent(string itemName,
             const string filterFileExt  = ".xml";
             clearFolderTreeContentsCheckSum(paths, pathSearchString, filterFileExt);
             clearFolderTreeContentsCheckSumList(paths, pathSearchString, filterFileExt);
+            clearFolderTreeContentsCheckSumList(paths, pathSearchString, "");
 
             // Refresh CRC
 			if(gameSettings != NULL && itemName == gameSettings->getTech() &&
@@ -4617,13 +4697,24 @@ void MenuStateConnectedGame::FTPClient_CallbackEvent(string itemName,
 	    	sleep(1);
 
             console.addLine(result.second,true);
+
+            // A partial update that failed left the old files in place, fetch
+            // the whole techtree instead
+            if(deltaUpdate == true && ftpClientThread != NULL &&
+            	result.first != ftp_crt_HOST_NOT_ACCEPTING) {
+            	getMissingTechtreeFromFTPServerInProgress = true;
+            	ftpClientThread->addTechtreeToRequests(itemName);
+            	safeMutexFTPProgress.Lock();
+            	fileFTPProgressList[itemName] = pair<int,string>(0,"");
+            	safeMutexFTPProgress.ReleaseLock();
+            }
         }
     }
     else if(type == ftp_cct_TempFile) {
     	getInProgressSavedGameFromFTPServerInProgress = false;
         if(SystemFlags::VERBOSE_MODE_ENABLED) printf("Got FTP Callback for [%s] result = %d [%s]\n",itemName.c_str(),result.first,result.second.c_str());
 
-        MutexSafeWrapper safeMutexFTPProgress((ftpClientThread != NULL ? ftpClientThread->getProgressMutex() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+        MutexSafeWrapper safeMutexFTPProgress((ftpClientThread != NULL ? ftpClientThread->getProgressMutex() : NULL),CODE_AT_LINE);
         //fileFTPProgressList.erase(itemName);
         std::map<string,pair<int,string> >::iterator iterFind = fileFTPProgressList.find(itemName);
         if(iterFind == fileFTPProgressList.end()) {
@@ -4799,7 +4890,7 @@ void MenuStateConnectedGame::setupUIFromGameSettings(GameSettings *gameSettings,
 					snprintf(szBuf,8096,"%s %s ?",lang.getString("DownloadMissingTilesetQuestion").c_str(),gameSettings->getTileset().c_str());
 
 					// Is the item in the mod center?
-					MutexSafeWrapper safeMutexThread((modHttpServerThread != NULL ? modHttpServerThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+					MutexSafeWrapper safeMutexThread((modHttpServerThread != NULL ? modHttpServerThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
 					if(tilesetCacheList.find(getMissingTilesetFromFTPServer) == tilesetCacheList.end()) {
 						ftpMessageBox.init(lang.getString("Yes"),lang.getString("NoDownload"));
 					}
@@ -4872,7 +4963,7 @@ void MenuStateConnectedGame::setupUIFromGameSettings(GameSettings *gameSettings,
 					snprintf(szBuf,8096,"%s %s ?",lang.getString("DownloadMissingTechtreeQuestion").c_str(),gameSettings->getTech().c_str());
 
 					// Is the item in the mod center?
-					MutexSafeWrapper safeMutexThread((modHttpServerThread != NULL ? modHttpServerThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+					MutexSafeWrapper safeMutexThread((modHttpServerThread != NULL ? modHttpServerThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
 					if(techCacheList.find(getMissingTechtreeFromFTPServer) == techCacheList.end()) {
 						ftpMessageBox.init(lang.getString("Yes"),lang.getString("NoDownload"));
 					}
@@ -4961,7 +5052,7 @@ void MenuStateConnectedGame::setupUIFromGameSettings(GameSettings *gameSettings,
 					snprintf(szBuf,8096,"%s %s ?",lang.getString("DownloadMissingMapQuestion").c_str(),currentMap.c_str());
 
 					// Is the item in the mod center?
-					MutexSafeWrapper safeMutexThread((modHttpServerThread != NULL ? modHttpServerThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+					MutexSafeWrapper safeMutexThread((modHttpServerThread != NULL ? modHttpServerThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
 					if(mapCacheList.find(getMissingMapFromFTPServer) == mapCacheList.end()) {
 						ftpMessageBox.init(lang.getString("Yes"),lang.getString("NoDownload"));
 					}
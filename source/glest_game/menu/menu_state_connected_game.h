@@ -43,7 +43,8 @@ enum FTPMessageType {
     ftpmsg_MissingNone,
 	ftpmsg_MissingMap,
 	ftpmsg_MissingTileset,
-	ftpmsg_MissingTechtree
+	ftpmsg_MissingTechtree,
+	ftpmsg_MismatchedTechtree
 };
 
 // ===============================
@@ -194,6 +195,10 @@ private:
     bool getMissingTechtreeFromFTPServerInProgress;
     time_t getMissingTechtreeFromFTPServerLastPrompted;
 
+    string getMismatchedTechtreeFromFTPServer;
+    time_t getMismatchedTechtreeFromFTPServerLastPrompted;
+    string techtreeDeltaInProgress;
+
     string getInProgressSavedGameFromFTPServer;
     bool getInProgressSavedGameFromFTPServerInProgress;
     bool readyToJoinInProgressGame;
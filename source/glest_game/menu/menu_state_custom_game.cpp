@@ -1150,8 +1150,8 @@ void MenuStateCustomGame::mouseClick(int x, int y, MouseButton mouseButton) {
 
 				soundRenderer.playFx(coreData.getClickSoundA());
 
-				MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
-				MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+				MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
+				MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
 				needToBroadcastServerSettings = false;
 				needToRepublishToMasterserver = false;
 				lastNetworkPing               = time(NULL);
@@ -1177,8 +1177,8 @@ void MenuStateCustomGame::mouseClick(int x, int y, MouseButton mouseButton) {
 			else if(listBoxMap.mouseClick(x, y,advanceToItemStartingWith)){
 				if(SystemFlags::getSystemSettingType(SystemFlags::debugSystem).enabled) SystemFlags::OutputDebug(SystemFlags::debugSystem,"%s\n", getCurrentMapFile().c_str());
 
-				MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
-				MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+				MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
+				MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
 
 				loadMapInfo(Config::getMapPath(getCurrentMapFile(),"",false), &mapInfo, true);
 				labelMapInfo.setText(mapInfo.desc);
@@ -1196,8 +1196,8 @@ void MenuStateCustomGame::mouseClick(int x, int y, MouseButton mouseButton) {
 				}
 			}
 			else if (checkBoxAdvanced.getValue() == 1 && listBoxFogOfWar.mouseClick(x, y)) {
-				MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
-				MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+				MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
+				MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
 
 				cleanupMapPreviewTexture();
 				if(checkBoxPublishServer.getValue() == true) {
@@ -1210,8 +1210,8 @@ void MenuStateCustomGame::mouseClick(int x, int y, MouseButton mouseButton) {
 				}
 			}
 			else if (checkBoxAdvanced.getValue() == 1 && checkBoxAllowObservers.mouseClick(x, y)) {
-				MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
-				MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+				MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
+				MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
 
 				if(checkBoxPublishServer.getValue() == true) {
 					needToRepublishToMasterserver = true;
@@ -1225,8 +1225,8 @@ void MenuStateCustomGame::mouseClick(int x, int y, MouseButton mouseButton) {
 				}
 			}
 			else if (checkBoxAllowInGameJoinPlayer.mouseClick(x, y)) {
-				MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
-				MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+				MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
+				MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
 
 				if(checkBoxPublishServer.getValue() == true) {
 					needToRepublishToMasterserver = true;
@@ -1241,8 +1241,8 @@ void MenuStateCustomGame::mouseClick(int x, int y, MouseButton mouseButton) {
 				serverInterface->setAllowInGameConnections(checkBoxAllowInGameJoinPlayer.getValue() == true);
 			}
 			else if (checkBoxAdvanced.getValue() == 1 && checkBoxAllowTeamUnitSharing.mouseClick(x, y)) {
-				MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
-				MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+				MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
+				MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
 
 
 				if(checkBoxPublishServer.getValue() == true) {
@@ -1255,8 +1255,8 @@ void MenuStateCustomGame::mouseClick(int x, int y, MouseButton mouseButton) {
 				}
 			}
 			else if (checkBoxAdvanced.getValue() == 1 && checkBoxAllowTeamResourceSharing.mouseClick(x, y)) {
-				MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
-				MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+				MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
+				MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
 
 
 				if(checkBoxPublishServer.getValue() == true) {
@@ -1269,8 +1269,8 @@ void MenuStateCustomGame::mouseClick(int x, int y, MouseButton mouseButton) {
 				}
 			}
 			else if (checkBoxAllowNativeLanguageTechtree.mouseClick(x, y)) {
-				MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
-				MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+				MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
+				MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
 
 				if(checkBoxPublishServer.getValue() == true) {
 					needToRepublishToMasterserver = true;
@@ -1283,8 +1283,8 @@ void MenuStateCustomGame::mouseClick(int x, int y, MouseButton mouseButton) {
 				}
 			}
 			else if (checkBoxAdvanced.getValue() == 1 && checkBoxEnableSwitchTeamMode.mouseClick(x, y)) {
-				MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
-				MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+				MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
+				MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
 
 				if(checkBoxPublishServer.getValue() == true) {
 					needToRepublishToMasterserver = true;
@@ -1297,8 +1297,8 @@ void MenuStateCustomGame::mouseClick(int x, int y, MouseButton mouseButton) {
 				}
 			}
 			else if (checkBoxAdvanced.getValue() == 1 && listBoxAISwitchTeamAcceptPercent.getEnabled() && listBoxAISwitchTeamAcceptPercent.mouseClick(x, y)) {
-				MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
-				MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+				MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
+				MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
 
 				if(checkBoxPublishServer.getValue() == true) {
 					needToRepublishToMasterserver = true;
@@ -1311,8 +1311,8 @@ void MenuStateCustomGame::mouseClick(int x, int y, MouseButton mouseButton) {
 				}
 			}
 			else if (checkBoxAdvanced.getValue() == 1 && listBoxFallbackCpuMultiplier.getEditable() == true && listBoxFallbackCpuMultiplier.mouseClick(x, y)) {
-				MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
-				MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+				MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
+				MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
 
 				if(checkBoxPublishServer.getValue() == true) {
 					needToRepublishToMasterserver = true;
@@ -1327,8 +1327,8 @@ void MenuStateCustomGame::mouseClick(int x, int y, MouseButton mouseButton) {
 			else if (checkBoxAdvanced.mouseClick(x, y)) {
 			}
 			else if(listBoxTileset.mouseClick(x, y,advanceToItemStartingWith)) {
-				MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
-				MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+				MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
+				MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
 
 				if(checkBoxPublishServer.getValue() == true) {
 					needToRepublishToMasterserver = true;
@@ -1342,8 +1342,8 @@ void MenuStateCustomGame::mouseClick(int x, int y, MouseButton mouseButton) {
 				}
 			}
 			else if(listBoxMapFilter.mouseClick(x, y)){
-				MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
-				MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+				MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
+				MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
 
 				switchToNextMapGroup(listBoxMapFilter.getSelectedItemIndex()-oldListBoxMapfilterIndex);
 
@@ -1367,8 +1367,8 @@ void MenuStateCustomGame::mouseClick(int x, int y, MouseButton mouseButton) {
 			else if(listBoxTechTree.mouseClick(x, y,advanceToItemStartingWith)){
 				reloadFactions(listBoxTechTree.getItemCount() <= 1,(checkBoxScenario.getValue() == true ? scenarioFiles[listBoxScenario.getSelectedItemIndex()] : ""));
 
-				MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
-				MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+				MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
+				MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
 
 				if(checkBoxPublishServer.getValue() == true) {
 					needToRepublishToMasterserver = true;
@@ -1381,8 +1381,8 @@ void MenuStateCustomGame::mouseClick(int x, int y, MouseButton mouseButton) {
 				}
 			}
 			else if(checkBoxPublishServer.mouseClick(x, y) && checkBoxPublishServer.getEditable()) {
-				MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
-				MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+				MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
+				MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
 
 				needToRepublishToMasterserver = true;
 				soundRenderer.playFx(coreData.getClickSoundC());
@@ -1394,8 +1394,8 @@ void MenuStateCustomGame::mouseClick(int x, int y, MouseButton mouseButton) {
 				setActiveInputLabel(&labelGameName);
 			}
 			else if(checkBoxAdvanced.getValue() == 1 && checkBoxNetworkPauseGameForLaggedClients.mouseClick(x, y)) {
-				MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
-				MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+				MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
+				MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
 
 				if(checkBoxPublishServer.getValue() == true) {
 					needToRepublishToMasterserver = true;
@@ -1413,8 +1413,8 @@ void MenuStateCustomGame::mouseClick(int x, int y, MouseButton mouseButton) {
 			}
 			else {
 				for(int i = 0; i < mapInfo.players; ++i) {
-					MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
-					MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+					MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
+					MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
 
 					// set multiplier
 					if(listBoxRMultiplier[i].mouseClick(x, y)) {
@@ -1710,8 +1710,8 @@ void MenuStateCustomGame::loadGameSettings(const std::string &fileName) {
 	ServerInterface* serverInterface= NetworkManager::getInstance().getServerInterface();
 	serverInterface->setGameSettings(&gameSettings,false);
 
-	MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
-	MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+	MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
+	MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
 
 	if(checkBoxPublishServer.getValue() == true) {
 		needToRepublishToMasterserver = true;
@@ -1775,8 +1775,8 @@ void MenuStateCustomGame::PlayNow(bool saveGame) {
 		return;
 	}
 
-	MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
-	MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+	MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
+	MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
 
 	if(saveGame == true) {
 		saveGameSettingsToFile(SAVED_GAME_FILENAME);
@@ -2438,8 +2438,8 @@ void MenuStateCustomGame::update() {
 	//sleep(200);
 	// END
 
-	MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
-	MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+	MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
+	MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
 
 	try {
 		if(serverInitError == true) {
@@ -2816,7 +2816,7 @@ void MenuStateCustomGame::update() {
 			if(this->headlessServerMode == true && hasOneNetworkSlotOpen == false) {
 				bool anyoneConnected = false;
 				for(int i= 0; i < mapInfo.players; ++i) {
-					MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+					MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
 
 					ServerInterface* serverInterface= NetworkManager::getInstance().getServerInterface();
 					ConnectionSlot *slot = serverInterface->getSlot(i,true);
@@ -3095,7 +3095,7 @@ void MenuStateCustomGame::publishToMasterserver() {
 	Config &config= Config::getInstance();
 	//string serverinfo="";
 
-	MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+	MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
 
 	publishToServerInfo.clear();
 
@@ -3217,14 +3217,14 @@ void MenuStateCustomGame::simpleTaskForMasterServer(BaseThread *callingThread) {
     try {
         //printf("-=-=-=-=- IN MenuStateCustomGame simpleTask - A\n");
 
-        MutexSafeWrapper safeMutexThreadOwner(callingThread->getMutexThreadOwnerValid(),string(__FILE__) + "_" + intToStr(__LINE__));
+        MutexSafeWrapper safeMutexThreadOwner(callingThread->getMutexThreadOwnerValid(),CODE_AT_LINE);
         if(callingThread->getQuitStatus() == true || safeMutexThreadOwner.isValidMutex() == false) {
             return;
         }
 
         //printf("-=-=-=-=- IN MenuStateCustomGame simpleTask - B\n");
 
-        MutexSafeWrapper safeMutex(callingThread->getMutexThreadObjectAccessor(),string(__FILE__) + "_" + intToStr(__LINE__));
+        MutexSafeWrapper safeMutex(callingThread->getMutexThreadObjectAccessor(),CODE_AT_LINE);
         bool republish                                  = (needToRepublishToMasterserver == true  && publishToServerInfo.empty() == false);
         needToRepublishToMasterserver                   = false;
         std::map<string,string> newPublishToServerInfo  = publishToServerInfo;
@@ -3273,7 +3273,7 @@ void MenuStateCustomGame::simpleTaskForMasterServer(BaseThread *callingThread) {
             std::string serverInfo = SystemFlags::getHTTP(request,handle);
             //SystemFlags::cleanupHTTP(&handle);
 
-            MutexSafeWrapper safeMutexThreadOwner2(callingThread->getMutexThreadOwnerValid(),string(__FILE__) + "_" + intToStr(__LINE__));
+            MutexSafeWrapper safeMutexThreadOwner2(callingThread->getMutexThreadOwnerValid(),CODE_AT_LINE);
             if(callingThread->getQuitStatus() == true || safeMutexThreadOwner2.isValidMutex() == false) {
                 return;
             }
@@ -3338,14 +3338,14 @@ void MenuStateCustomGame::simpleTaskForClients(BaseThread *callingThread) {
     try {
         //printf("-=-=-=-=- IN MenuStateCustomGame simpleTask - A\n");
 
-        MutexSafeWrapper safeMutexThreadOwner(callingThread->getMutexThreadOwnerValid(),string(__FILE__) + "_" + intToStr(__LINE__));
+        MutexSafeWrapper safeMutexThreadOwner(callingThread->getMutexThreadOwnerValid(),CODE_AT_LINE);
         if(callingThread->getQuitStatus() == true || safeMutexThreadOwner.isValidMutex() == false) {
             return;
         }
 
         //printf("-=-=-=-=- IN MenuStateCustomGame simpleTask - B\n");
 
-        MutexSafeWrapper safeMutex(callingThread->getMutexThreadObjectAccessor(),string(__FILE__) + "_" + intToStr(__LINE__));
+        MutexSafeWrapper safeMutex(callingThread->getMutexThreadObjectAccessor(),CODE_AT_LINE);
         bool broadCastSettings                          = needToBroadcastServerSettings;
 
         //printf("simpleTask broadCastSettings = %d\n",broadCastSettings);
@@ -3374,7 +3374,7 @@ void MenuStateCustomGame::simpleTaskForClients(BaseThread *callingThread) {
         //printf("-=-=-=-=- IN MenuStateCustomGame simpleTask - D\n");
 
         if(broadCastSettings == true) {
-            MutexSafeWrapper safeMutexThreadOwner2(callingThread->getMutexThreadOwnerValid(),string(__FILE__) + "_" + intToStr(__LINE__));
+            MutexSafeWrapper safeMutexThreadOwner2(callingThread->getMutexThreadOwnerValid(),CODE_AT_LINE);
             if(callingThread->getQuitStatus() == true || safeMutexThreadOwner2.isValidMutex() == false) {
                 return;
             }
@@ -3411,7 +3411,7 @@ void MenuStateCustomGame::simpleTaskForClients(BaseThread *callingThread) {
         //printf("-=-=-=-=- IN MenuStateCustomGame simpleTask - E\n");
 
         if(needPing == true) {
-            MutexSafeWrapper safeMutexThreadOwner2(callingThread->getMutexThreadOwnerValid(),string(__FILE__) + "_" + intToStr(__LINE__));
+            MutexSafeWrapper safeMutexThreadOwner2(callingThread->getMutexThreadOwnerValid(),CODE_AT_LINE);
             if(callingThread->getQuitStatus() == true || safeMutexThreadOwner2.isValidMutex() == false) {
                 return;
             }
@@ -4484,8 +4484,8 @@ bool MenuStateCustomGame::textInput(std::string text) {
 	if(activeInputLabel != NULL) {
 		bool handled = textInputEditLabel(text, &activeInputLabel);
 		if(handled == true && &labelGameName != activeInputLabel) {
-			MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
-			MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+			MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
+			MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
 
 			if(hasNetworkGameSettings() == true) {
 				needToSetChangedGameSettings = true;
@@ -4509,8 +4509,8 @@ void MenuStateCustomGame::keyDown(SDL_KeyboardEvent key) {
 	if(activeInputLabel != NULL) {
 		bool handled = keyDownEditLabel(key, &activeInputLabel);
 		if(handled == true) {
-			MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
-			MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+			MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
+			MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
 
 	        if(hasNetworkGameSettings() == true) {
 	            needToSetChangedGameSettings = true;
@@ -4568,8 +4568,8 @@ void MenuStateCustomGame::keyPress(SDL_KeyboardEvent c) {
 	if(activeInputLabel != NULL) {
 		bool handled = keyPressEditLabel(c, &activeInputLabel);
 		if(handled == true && &labelGameName != activeInputLabel) {
-			MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
-			MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+			MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
+			MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
 
 			if(hasNetworkGameSettings() == true) {
 				needToSetChangedGameSettings = true;
@@ -4892,8 +4892,8 @@ void MenuStateCustomGame::processScenario() {
 			updateControlers();
 			updateNetworkSlots();
 
-			MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
-			MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),string(__FILE__) + "_" + intToStr(__LINE__));
+			MutexSafeWrapper safeMutex((publishToMasterserverThread != NULL ? publishToMasterserverThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
+			MutexSafeWrapper safeMutexCLI((publishToClientsThread != NULL ? publishToClientsThread->getMutexThreadObjectAccessor() : NULL),CODE_AT_LINE);
 
 			if(checkBoxPublishServer.getValue() == true) {
 				needToRepublishToMasterserver = true;
@@ -223,6 +223,9 @@ ClientInterface::ClientInterface() : GameNetworkInterface() {
 	networkGameDataSynchCheckOkTech 	= false;
 	this->setNetworkGameDataSynchCheckTechMismatchReport("");
 	this->setReceivedDataSynchCheck(false);
+	techMismatchChangedFiles.clear();
+	techMismatchRemovedFiles.clear();
+	techMismatchNeedsFullDownload = false;
 }
 
 void ClientInterface::shutdownNetworkCommandListThread(MutexSafeWrapper &safeMutexWrapper) {
@@ -525,6 +528,61 @@ std::string ClientInterface::getServerIpAddress() {
 	return this->ip.getString();
 }
 
+// Works out which techtree files to fetch from the host so a slightly
+// different local copy can be patched instead of downloaded again whole
+void ClientInterface::updateTechMismatchFiles(NetworkMessageSynchNetworkGameData &networkMessageSynchNetworkGameData,
+		const vector<std::pair<string,uint32> > &vctFileList, const string &scenarioDir) {
+	techMismatchChangedFiles.clear();
+	techMismatchRemovedFiles.clear();
+	techMismatchNeedsFullDownload = false;
+
+	Config &config = Config::getInstance();
+	if(config.getBool("NetworkDeltaContentSync","true") == false || scenarioDir != "") {
+		return;
+	}
+	if(vctFileList.empty() == true ||
+		networkMessageSynchNetworkGameData.getTechCRCFileCount() == 0) {
+		return;
+	}
+
+	// Only xml files are listed by the host, the rest of the techtree is
+	// compared through one CRC
+	string techPathSearchString = "/" + networkMessageSynchNetworkGameData.getTech() + "/*";
+	vector<std::pair<string,uint32> > contentFileList = getFolderTreeContentsCheckSumListRecursively(
+			config.getPathListForType(ptTechs,scenarioDir), techPathSearchString, "", NULL);
+
+	// Only the user data copy of a techtree is ever replaced, one that is
+	// partly in the main data folder is left alone
+	vector<string> techPaths = config.getPathListForType(ptTechs);
+	if(techPaths.size() < 2) {
+		return;
+	}
+	string userTechPath = techPaths[1];
+	endPathWithSlash(userTechPath);
+	userTechPath += networkMessageSynchNetworkGameData.getTech() + "/";
+	for(unsigned int index = 0; index < contentFileList.size(); ++index) {
+		if(StartsWith(contentFileList[index].first,userTechPath) == false) {
+			return;
+		}
+	}
+
+	// Patching the xml files would leave a mix of both versions when models,
+	// textures or sounds differ too, or when the host's list was cut short
+	uint32 techContentCRC = getFolderTreeContentsCheckSumExcluding(contentFileList, techPaths,
+			networkMessageSynchNetworkGameData.getTech(), ".xml");
+	if(techContentCRC != networkMessageSynchNetworkGameData.getTechContentCRC() ||
+		networkMessageSynchNetworkGameData.getTechCRCFileListComplete() == false) {
+		techMismatchNeedsFullDownload = true;
+		return;
+	}
+
+	vector<std::pair<string,uint32> > remoteFileList = networkMessageSynchNetworkGameData.getTechCRCFileCheckSumList();
+	techMismatchChangedFiles = getFolderTreeContentsCheckSumListMismatches(vctFileList,
+			remoteFileList, techPaths, networkMessageSynchNetworkGameData.getTech(), &techMismatchRemovedFiles);
+
+	if(SystemFlags::getSystemSettingType(SystemFlags::debugNetwork).enabled) SystemFlags::OutputDebug(SystemFlags::debugNetwork,"In [%s::%s Line: %d] techtree [%s] changed files: %d removed files: %d\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__,networkMessageSynchNetworkGameData.getTech().c_str(),(int)techMismatchChangedFiles.size(),(int)techMismatchRemovedFiles.size());
+}
+
 void ClientInterface::updateLobby() {
 	Chrono chrono;
 	if(SystemFlags::getSystemSettingType(SystemFlags::debugPerformance).enabled) chrono.start();
@@ -712,6 +770,9 @@ void ClientInterface::updateLobby() {
             	networkGameDataSynchCheckOkTech     = false;
                 this->setNetworkGameDataSynchCheckTechMismatchReport("");
                 this->setReceivedDataSynchCheck(false);
+                techMismatchChangedFiles.clear();
+                techMismatchRemovedFiles.clear();
+                techMismatchNeedsFullDownload = false;
 
 				uint32 tilesetCRC 	= 0;
 				uint32 techCRC	 	= 0;
@@ -756,6 +817,8 @@ void ClientInterface::updateLobby() {
 						string report = networkMessageSynchNetworkGameData.getTechCRCFileMismatchReport(vctFileList);
 						this->setNetworkGameDataSynchCheckTechMismatchReport(report);
 
+						updateTechMismatchFiles(networkMessageSynchNetworkGameData, vctFileList, scenarioDir);
+
 					}
 					if(SystemFlags::getSystemSettingType(SystemFlags::debugNetwork).enabled) SystemFlags::OutputDebug(SystemFlags::debugNetwork,"In [%s::%s] techCRC info, local = %d, remote = %d, networkMessageSynchNetworkGameData.getTech() = [%s]\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,techCRC,networkMessageSynchNetworkGameData.getTechCRC(),networkMessageSynchNetworkGameData.getTech().c_str());
 
@@ -84,6 +84,13 @@ private:
 	string serverUUID;
 	string serverPlatform;
 
+	// Techtree files that differ from the host, relative to the techtree
+	// folder, and local files the host does not have. When more than the
+	// xml files differ the techtree has to be downloaded whole instead
+	vector<string> techMismatchChangedFiles;
+	vector<string> techMismatchRemovedFiles;
+	bool techMismatchNeedsFullDownload;
+
 	ClientInterfaceThread *networkCommandListThread;
 
 	Mutex *networkCommandListThreadAccessor;
@@ -176,6 +183,9 @@ public:
 	virtual string getHumanPlayerName(int index=-1);
 	virtual int getHumanPlayerIndex() const {return playerIndex;}
 	int getServerFTPPort() const { return serverFTPPort; }
+	const vector<string> & getTechMismatchChangedFiles() const { return techMismatchChangedFiles; }
+	const vector<string> & getTechMismatchRemovedFiles() const { return techMismatchRemovedFiles; }
+	bool getTechMismatchNeedsFullDownload() const { return techMismatchNeedsFullDownload; }
 
 	int getSessionKey() const { return sessionKey; }
 	bool isMasterServerAdminOverride();
@@ -197,6 +207,8 @@ protected:
 	void updateFrame(int *checkFrame);
 	void shutdownNetworkCommandListThread(MutexSafeWrapper &safeMutexWrapper);
 	bool getNetworkCommand(int frameCount, int currentCachedPendingCommandsIndex);
+	void updateTechMismatchFiles(NetworkMessageSynchNetworkGameData &networkMessageSynchNetworkGameData,
+			const vector<std::pair<string,uint32> > &vctFileList, const string &scenarioDir);
 
 	void close(bool lockMutex);
 };
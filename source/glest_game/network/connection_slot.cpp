@@ -359,7 +359,6 @@ ConnectionSlot::ConnectionSlot(ServerInterface* serverInterface, int playerIndex
 	this->mutexSocket 						= new Mutex(CODE_AT_LINE);
 	this->socket 							= NULL;
 	this->mutexCloseConnection 				= new Mutex(CODE_AT_LINE);
-	this->mutexPendingNetworkCommandList 	= new Mutex(CODE_AT_LINE);
 	this->socketSynchAccessor 				= new Mutex(CODE_AT_LINE);
     this->connectedRemoteIPAddress 			= 0;
 	this->sessionKey 						= 0;
@@ -451,9 +450,6 @@ ConnectionSlot::~ConnectionSlot() {
 	delete socketSynchAccessor;
 	socketSynchAccessor = NULL;
 
-	delete mutexPendingNetworkCommandList;
-	mutexPendingNetworkCommandList = NULL;
-
 	delete mutexCloseConnection;
 	mutexCloseConnection = NULL;
 
@@ -583,9 +579,7 @@ void ConnectionSlot::update(bool checkForNewClients,int lockedSlotIndex) {
 						this->receivedNetworkGameStatus = false;
 						this->gotIntro = false;
 
-						MutexSafeWrapper safeMutexSlot1(mutexPendingNetworkCommandList,CODE_AT_LINE);
-						this->vctPendingNetworkCommandList.clear();
-						safeMutexSlot1.ReleaseLock();
+						serverInterface->discardNetworkCommandsFromClient(playerIndex);
 
 						this->currentFrameCount = 0;
 						this->currentLagCount = 0;
@@ -818,11 +812,10 @@ void ConnectionSlot::update(bool checkForNewClients,int lockedSlotIndex) {
 
 									if(SystemFlags::getSystemSettingType(SystemFlags::debugNetwork).enabled) SystemFlags::OutputDebug(SystemFlags::debugNetwork,"In [%s::%s Line: %d] currentFrameCount = %d\n",__FILE__,__FUNCTION__,__LINE__,currentFrameCount);
 
-									MutexSafeWrapper safeMutexSlot(mutexPendingNetworkCommandList,CODE_AT_LINE);
 									for(int i = 0; i < networkMessageCommandList.getCommandCount(); ++i) {
-										vctPendingNetworkCommandList.push_back(*networkMessageCommandList.getCommand(i));
+										serverInterface->queueNetworkCommandFromClient(playerIndex,*networkMessageCommandList.getCommand(i));
 									}
-									//printf("Got commands from client frame: %d count: %d\n",currentFrameCount,vctPendingNetworkCommandList.size());
+									//printf("Got commands from client frame: %d count: %d\n",currentFrameCount,networkMessageCommandList.getCommandCount());
 
 									//printf("#2 Server slot got currentFrameCount = %d\n",currentFrameCount);
 								}
@@ -1493,6 +1486,9 @@ void ConnectionSlot::close() {
 	this->ready							= false;
 	this->connectedTime 				= 0;
 
+	// Whatever this client sent but the game thread did not take yet goes
+	serverInterface->discardNetworkCommandsFromClient(playerIndex);
+
 	if(this->slotThreadWorker != NULL) {
 		if(SystemFlags::getSystemSettingType(SystemFlags::debugNetwork).enabled) SystemFlags::OutputDebug(SystemFlags::debugNetwork,"In [%s::%s Line: %d]\n",__FILE__,__FUNCTION__,__LINE__);
         this->slotThreadWorker->setAllEventsCompleted();
@@ -1561,26 +1557,6 @@ string ConnectionSlot::getHumanPlayerName(int index) {
 	return serverInterface->getHumanPlayerName(index);
 }
 
-vector<NetworkCommand> ConnectionSlot::getPendingNetworkCommandList(bool clearList) {
-	vector<NetworkCommand> ret;
-	MutexSafeWrapper safeMutexSlot(mutexPendingNetworkCommandList,CODE_AT_LINE);
-    if(vctPendingNetworkCommandList.empty() == false) {
-    	ret = vctPendingNetworkCommandList;
-		if(clearList == true) {
-			vctPendingNetworkCommandList.clear();
-		}
-    }
-
-    return ret;
-}
-
-//void ConnectionSlot::clearPendingNetworkCommandList() {
-//	MutexSafeWrapper safeMutexSlot(mutexPendingNetworkCommandList,CODE_AT_LINE);
-//	if(vctPendingNetworkCommandList.empty() == false) {
-//		vctPendingNetworkCommandList.clear();
-//	}
-//}
-
 bool ConnectionSlot::hasValidSocketId() {
     bool result = false;
     MutexSafeWrapper safeMutexSlot(mutexSocket,CODE_AT_LINE);
@@ -140,8 +140,6 @@ private:
 
 	Mutex *mutexCloseConnection;
 
-	Mutex *mutexPendingNetworkCommandList;
-	vector<NetworkCommand> vctPendingNetworkCommandList;
 	ConnectionSlotThread* slotThreadWorker;
 	int currentFrameCount;
 	int currentLagCount;
@@ -221,9 +219,6 @@ public:
 	std::vector<std::string> getThreadErrorList() const { return threadErrorList; }
 	void clearThreadErrorList() { threadErrorList.clear(); }
 
-	vector<NetworkCommand> getPendingNetworkCommandList(bool clearList=false);
-	//void clearPendingNetworkCommandList();
-
 	void signalUpdate(ConnectionSlotEvent *event);
 	bool updateCompleted(ConnectionSlotEvent *event);
 
@@ -407,11 +407,11 @@ void GameNetworkInterface::requestCommand(const NetworkCommand *networkCommand,
 	Mutex *mutex = getServerSynchAccessor();
 
     if(insertAtStart == false) {
-    	MutexSafeWrapper safeMutex(mutex,string(__FILE__) + "_" + intToStr(__LINE__));
+    	MutexSafeWrapper safeMutex(mutex,CODE_AT_LINE);
         requestedCommands.push_back(*networkCommand);
     }
     else {
-    	MutexSafeWrapper safeMutex(mutex,string(__FILE__) + "_" + intToStr(__LINE__));
+    	MutexSafeWrapper safeMutex(mutex,CODE_AT_LINE);
         requestedCommands.insert(requestedCommands.begin(),*networkCommand);
     }
 }
@@ -2264,18 +2264,27 @@ NetworkMessageSynchNetworkGameData::NetworkMessageSynchNetworkGameData(const Gam
 
 	if(SystemFlags::getSystemSettingType(SystemFlags::debugNetwork).enabled) SystemFlags::OutputDebug(SystemFlags::debugNetwork,"In [%s::%s Line: %d] data.techCRC = %d, [%s]\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__, data.header.techCRC,gameSettings->getTech().c_str());
 
+	vector<string> techPaths = config.getPathListForType(ptTechs,scenarioDir);
 	vector<std::pair<string,uint32> > vctFileList;
-	vctFileList = getFolderTreeContentsCheckSumListRecursively(config.getPathListForType(ptTechs,scenarioDir),string("/") + gameSettings->getTech() + string("/*"), ".xml",&vctFileList);
+	vctFileList = getFolderTreeContentsCheckSumListRecursively(techPaths,string("/") + gameSettings->getTech() + string("/*"), ".xml",&vctFileList);
 	data.header.techCRCFileCount = min((int)vctFileList.size(),(int)maxFileCRCCount);
 
 	if(SystemFlags::getSystemSettingType(SystemFlags::debugNetwork).enabled) SystemFlags::OutputDebug(SystemFlags::debugNetwork,"In [%s::%s Line: %d] vctFileList.size() = %d, maxFileCRCCount = %d\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__, vctFileList.size(),maxFileCRCCount);
 
 	for(int idx =0; idx < (int)data.header.techCRCFileCount; ++idx) {
 		const std::pair<string,uint32> &fileInfo = vctFileList[idx];
-		data.detail.techCRCFileList[idx] = fileInfo.first;
+		// Sent relative to the techs folder, the install roots differ per host
+		data.detail.techCRCFileList[idx] = getFolderTreeRootRelativePath(fileInfo.first, techPaths);
 		data.detail.techCRCFileCRCList[idx] = fileInfo.second;
 	}
 
+	// Lets a client tell whether patching the xml files above is enough
+	data.header.techContentCRC = 0;
+	if(config.getBool("NetworkDeltaContentSync","true") == true) {
+		vector<std::pair<string,uint32> > vctContentFileList = getFolderTreeContentsCheckSumListRecursively(techPaths,string("/") + gameSettings->getTech() + string("/*"), "", NULL);
+		data.header.techContentCRC = getFolderTreeContentsCheckSumExcluding(vctContentFileList, techPaths, gameSettings->getTech(), ".xml");
+	}
+
     //map
     Checksum checksum;
     string file = Config::getMapPath(gameSettings->getMap(),scenarioDir,false);
@@ -2285,6 +2294,14 @@ NetworkMessageSynchNetworkGameData::NetworkMessageSynchNetworkGameData(const Gam
 	if(SystemFlags::getSystemSettingType(SystemFlags::debugNetwork).enabled) SystemFlags::OutputDebug(SystemFlags::debugNetwork,"In [%s::%s Line: %d] data.mapCRC = %d, [%s]\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__, data.header.mapCRC,gameSettings->getMap().c_str());
 }
 
+vector<std::pair<string,uint32> > NetworkMessageSynchNetworkGameData::getTechCRCFileCheckSumList() const {
+	vector<std::pair<string,uint32> > result;
+	for(int idx = 0; idx < (int)data.header.techCRCFileCount && idx < maxFileCRCCount; ++idx) {
+		result.push_back(std::pair<string,uint32>(data.detail.techCRCFileList[idx].getString(),data.detail.techCRCFileCRCList[idx]));
+	}
+	return result;
+}
+
 string NetworkMessageSynchNetworkGameData::getTechCRCFileMismatchReport(vector<std::pair<string,uint32> > &vctFileList) {
 	string result = "Techtree: [" + data.header.tech.getString() + "] Filecount local: " + intToStr(vctFileList.size()) + " remote: " + intToStr(data.header.techCRCFileCount) + "\n";
 	if(vctFileList.size() <= 0) {
@@ -2294,6 +2311,8 @@ string NetworkMessageSynchNetworkGameData::getTechCRCFileMismatchReport(vector<s
 		result = result + "Remote player has no files.\n";
 	}
 	else {
+		// The host lists its files relative to the techs folder
+		vector<string> techPaths = Config::getInstance().getPathListForType(ptTechs);
 		for(int idx = 0; idx < (int)vctFileList.size(); ++idx) {
 			std::pair<string,uint32> &fileInfo = vctFileList[idx];
 			bool fileFound = false;
@@ -2301,7 +2320,7 @@ string NetworkMessageSynchNetworkGameData::getTechCRCFileMismatchReport(vector<s
 			for(int j = 0; j < (int)data.header.techCRCFileCount; ++j) {
 				string networkFile = data.detail.techCRCFileList[j].getString();
 				uint32 &networkFileCRC = data.detail.techCRCFileCRCList[j];
-				if(fileInfo.first == networkFile) {
+				if(getFolderTreeRootRelativePath(fileInfo.first, techPaths) == networkFile) {
 					fileFound = true;
 					remoteCRC = networkFileCRC;
 					break;
@@ -2323,7 +2342,7 @@ string NetworkMessageSynchNetworkGameData::getTechCRCFileMismatchReport(vector<s
 			uint32 localCRC = 0;
 			for(int idx = 0; idx < (int)vctFileList.size(); ++idx) {
 				std::pair<string,uint32> &fileInfo = vctFileList[idx];
-				if(networkFile == fileInfo.first) {
+				if(networkFile == getFolderTreeRootRelativePath(fileInfo.first, techPaths)) {
 					fileFound = true;
 					localCRC = fileInfo.second;
 					break;
@@ -2342,7 +2361,7 @@ string NetworkMessageSynchNetworkGameData::getTechCRCFileMismatchReport(vector<s
 }
 
 const char * NetworkMessageSynchNetworkGameData::getPackedMessageFormatHeader() const {
-	return "c255s255s255sLLLL";
+	return "c255s255s255sLLLLL";
 }
 
 unsigned int NetworkMessageSynchNetworkGameData::getPackedSizeHeader() {
@@ -2359,7 +2378,8 @@ unsigned int NetworkMessageSynchNetworkGameData::getPackedSizeHeader() {
 				packedData.header.mapCRC,
 				packedData.header.tilesetCRC,
 				packedData.header.techCRC,
-				packedData.header.techCRCFileCount);
+				packedData.header.techCRCFileCount,
+				packedData.header.techContentCRC);
 		delete [] buf;
 	}
 	return result;
@@ -2373,7 +2393,8 @@ void NetworkMessageSynchNetworkGameData::unpackMessageHeader(unsigned char *buf)
 			&data.header.mapCRC,
 			&data.header.tilesetCRC,
 			&data.header.techCRC,
-			&data.header.techCRCFileCount);
+			&data.header.techCRCFileCount,
+			&data.header.techContentCRC);
 }
 
 unsigned char * NetworkMessageSynchNetworkGameData::packMessageHeader() {
@@ -2386,7 +2407,8 @@ unsigned char * NetworkMessageSynchNetworkGameData::packMessageHeader() {
 			data.header.mapCRC,
 			data.header.tilesetCRC,
 			data.header.techCRC,
-			data.header.techCRCFileCount);
+			data.header.techCRCFileCount,
+			data.header.techContentCRC);
 
 	return buf;
 }
@@ -2542,6 +2564,7 @@ void NetworkMessageSynchNetworkGameData::toEndianHeader() {
 		data.header.tilesetCRC = Shared::PlatformByteOrder::toCommonEndian(data.header.tilesetCRC);
 		data.header.techCRC = Shared::PlatformByteOrder::toCommonEndian(data.header.techCRC);
 		data.header.techCRCFileCount = Shared::PlatformByteOrder::toCommonEndian(data.header.techCRCFileCount);
+		data.header.techContentCRC = Shared::PlatformByteOrder::toCommonEndian(data.header.techContentCRC);
 	}
 }
 void NetworkMessageSynchNetworkGameData::fromEndianHeader() {
@@ -2552,6 +2575,7 @@ void NetworkMessageSynchNetworkGameData::fromEndianHeader() {
 		data.header.tilesetCRC = Shared::PlatformByteOrder::fromCommonEndian(data.header.tilesetCRC);
 		data.header.techCRC = Shared::PlatformByteOrder::fromCommonEndian(data.header.techCRC);
 		data.header.techCRCFileCount = Shared::PlatformByteOrder::fromCommonEndian(data.header.techCRCFileCount);
+		data.header.techContentCRC = Shared::PlatformByteOrder::fromCommonEndian(data.header.techContentCRC);
 	}
 }
 
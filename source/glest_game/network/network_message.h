@@ -610,6 +610,9 @@ private:
 		uint32 techCRC;
 
 		uint32 techCRCFileCount;
+		// Everything in the techtree that is not xml, the file list only
+		// covers the xml files
+		uint32 techContentCRC;
 	};
 
 	static const int32 HeaderSize = sizeof(DataHeader);
@@ -670,10 +673,14 @@ public:
 	uint32 getMapCRC() const		{return data.header.mapCRC;}
 	uint32 getTilesetCRC() const	{return data.header.tilesetCRC;}
 	uint32 getTechCRC() const	{return data.header.techCRC;}
+	uint32 getTechContentCRC() const	{return data.header.techContentCRC;}
 
 	uint32 getTechCRCFileCount() const {return data.header.techCRCFileCount;}
 	const NetworkString<maxStringSize> * getTechCRCFileList() const {return &data.detail.techCRCFileList[0];}
 	const uint32 * getTechCRCFileCRCList() const {return data.detail.techCRCFileCRCList;}
+	// The host stops listing files once maxFileCRCCount is reached
+	bool getTechCRCFileListComplete() const {return data.header.techCRCFileCount < (uint32)maxFileCRCCount;}
+	vector<std::pair<string,uint32> > getTechCRCFileCheckSumList() const;
 
 	string getTechCRCFileMismatchReport(vector<std::pair<string,uint32> > &vctFileList);
 };
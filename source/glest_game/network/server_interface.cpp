@@ -54,6 +54,13 @@ const int MAX_SLOT_THREAD_WAIT_TIME_MILLISECONDS			= 1500;
 const int MASTERSERVER_HEARTBEAT_GAME_STATUS_SECONDS 		= 30;
 
 const int MAX_EMPTY_NETWORK_COMMAND_LIST_BROADCAST_INTERVAL_MILLISECONDS = 4000;
+const int MIN_EMPTY_NETWORK_COMMAND_LIST_BROADCAST_INTERVAL_MILLISECONDS = 500;
+// Samples needed before a client's lag estimate is trusted
+const int MIN_CLIENT_LAG_ESTIMATE_SAMPLES 					= 8;
+
+// Upper bound in millis of each command latency bucket, the last one
+// takes everything slower
+const int64 COMMAND_LATENCY_BUCKET_MILLIS[ServerInterface::commandLatencyBucketCount] = { 1, 2, 5, 10, 20, 50, 100, -1 };
 
 ServerInterface::ServerInterface(bool publishEnabled, ClientLagCallbackInterface *clientLagCallbackInterface) : GameNetworkInterface() {
 	if(SystemFlags::getSystemSettingType(SystemFlags::debugNetwork).enabled) SystemFlags::OutputDebug(SystemFlags::debugNetwork,"In [%s::%s Line: %d]\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__);
@@ -69,6 +76,11 @@ ServerInterface::ServerInterface(bool publishEnabled, ClientLagCallbackInterface
 
 	for(int index = 0; index < GameConstants::maxPlayers; ++index) {
 		slotAccessorMutexes[index] 		= new Mutex(CODE_AT_LINE);
+		SDL_AtomicSet(&slotCommandGenerations[index],0);
+		for(int bucket = 0; bucket < commandLatencyBucketCount; ++bucket) {
+			commandLatencyHistogram[index][bucket] = 0;
+		}
+		clientLagEstimates[index].slotGeneration	= 0;
 	}
 	masterServerThreadAccessor 			= new Mutex(CODE_AT_LINE);
 	textMessageQueueThreadAccessor 		= new Mutex(CODE_AT_LINE);
@@ -725,6 +737,22 @@ std::pair<bool,bool> ServerInterface::clientLagCheck(ConnectionSlot *connectionS
 
 				double clientLagTime 	= difftime((long int)time(NULL),connectionSlot->getLastReceiveCommandListTime());
 
+				// With a settled estimate a one off spike is not enough to pause
+				// the game, while a lag that is heading past the limit is warned
+				// about before it gets there. A client that stopped advancing is
+				// judged on its real lag, the smoothed one would trail the stall
+				double pauseLagCount	= clientLagCount;
+				double warnLagCount		= clientLagCount;
+				double predictedLagMillis = getPredictedClientLagMillis(connectionSlot->getPlayerIndex());
+				if(predictedLagMillis >= 0 && gameSettings.getNetworkFramePeriod() > 0) {
+					double networkFrameMillis	= gameSettings.getNetworkFramePeriod() * 1000.0 / GameConstants::updateFps;
+					double predictedLagCount	= predictedLagMillis / networkFrameMillis;
+					if(isClientStalled(connectionSlot->getPlayerIndex()) == false) {
+						pauseLagCount	= min(clientLagCount,predictedLagCount);
+					}
+					warnLagCount	= max(clientLagCount,predictedLagCount);
+				}
+
 				if(this->getCurrentFrameCount() > 0) {
 					if(SystemFlags::getSystemSettingType(SystemFlags::debugNetwork).enabled) SystemFlags::OutputDebug(SystemFlags::debugNetwork,"In [%s::%s Line: %d] playerIndex = %d, clientLag = %f, clientLagCount = %f, this->getCurrentFrameCount() = %d, connectionSlot->getCurrentFrameCount() = %d, clientLagTime = %f\n",
 																		 extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__,
@@ -752,7 +780,7 @@ std::pair<bool,bool> ServerInterface::clientLagCheck(ConnectionSlot *connectionS
 				//printf("skipNetworkBroadCast [%d] clientLagCount [%f][%f][%f] clientLagTime [%f][%f][%f]\n",skipNetworkBroadCast,clientLagCount,(maxFrameCountLagAllowed * warnFrameCountLagPercent),maxFrameCountLagAllowed,clientLagTime,(maxClientLagTimeAllowed * warnFrameCountLagPercent),maxClientLagTimeAllowed);
 
 				// New lag check
-				if((maxFrameCountLagAllowed > 0 && clientLagCount > maxFrameCountLagAllowed) ||
+				if((maxFrameCountLagAllowed > 0 && pauseLagCount > maxFrameCountLagAllowed) ||
 					(maxClientLagTimeAllowed > 0 && clientLagTime > maxClientLagTimeAllowed) ||
 					(maxFrameCountLagAllowedEver > 0 && clientLagCount > maxFrameCountLagAllowedEver) ||
 					( maxClientLagTimeAllowedEver > 0 && clientLagTime > maxClientLagTimeAllowedEver)) {
@@ -802,7 +830,7 @@ std::pair<bool,bool> ServerInterface::clientLagCheck(ConnectionSlot *connectionS
 				}
 				// New lag check warning
 				else if((maxFrameCountLagAllowed > 0 && warnFrameCountLagPercent > 0 &&
-						 clientLagCount > (maxFrameCountLagAllowed * warnFrameCountLagPercent)) ||
+						 warnLagCount > (maxFrameCountLagAllowed * warnFrameCountLagPercent)) ||
 						(maxClientLagTimeAllowed > 0 && warnFrameCountLagPercent > 0 &&
 						 clientLagTime > (maxClientLagTimeAllowed * warnFrameCountLagPercent)) ) {
 
@@ -904,7 +932,7 @@ void ServerInterface::signalClientsToRecieveData(std::map<PLATFORM_SOCKET,bool>
 	//printf("====================================In [%s::%s Line: %d]\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__);
 
 	//printf("Signal clients get new data\n");
-	const bool newThreadManager = Config::getInstance().getBool("EnableNewThreadManager","false");
+	const bool newThreadManager = configEnableNewThreadManager.get();
 	if(newThreadManager == true) {
 		masterController.clearSlaves(true);
 		std::vector<SlaveThreadControllerInterface *> slaveThreadList;
@@ -1080,7 +1108,7 @@ void ServerInterface::checkForCompletedClients(std::map<int,bool> & mapSlotSigna
 
 	if(SystemFlags::getSystemSettingType(SystemFlags::debugNetwork).enabled) SystemFlags::OutputDebug(SystemFlags::debugNetwork,"In [%s::%s Line: %d]\n",__FILE__,__FUNCTION__,__LINE__);
 
-	const bool newThreadManager = Config::getInstance().getBool("EnableNewThreadManager","false");
+	const bool newThreadManager = configEnableNewThreadManager.get();
 	if(newThreadManager == true) {
 		checkForCompletedClientsUsingThreadManager(mapSlotSignalledList, errorMsgList);
 	}
@@ -1267,23 +1295,73 @@ void ServerInterface::checkForLaggingClients(std::map<int,bool> &mapSlotSignalle
 	}
 }
 
+// Called from the ConnectionSlotThreads
+void ServerInterface::queueNetworkCommandFromClient(int slotIndex, const NetworkCommand &command) {
+	ClientNetworkCommand clientCommand;
+	clientCommand.command			= command;
+	clientCommand.slotIndex			= slotIndex;
+	clientCommand.slotGeneration	= SDL_AtomicGet(&slotCommandGenerations[slotIndex]);
+	clientCommand.arrivalMicros		= Chrono::getCurMicros();
+	clientNetworkCommands.push(clientCommand);
+}
+
+void ServerInterface::discardNetworkCommandsFromClient(int slotIndex) {
+	SDL_AtomicAdd(&slotCommandGenerations[slotIndex],1);
+}
+
 void ServerInterface::executeNetworkCommandsFromClients() {
 	if(gameHasBeenInitiated == true) {
-		for(int index = 0; exitServer == false && index < GameConstants::maxPlayers; ++index) {
-			MutexSafeWrapper safeMutexSlot(slotAccessorMutexes[index],CODE_AT_LINE_X(index));
-			ConnectionSlot* connectionSlot= slots[index];
-			if(connectionSlot != NULL && connectionSlot->isConnected() == true) {
-				vector<NetworkCommand> pendingList = connectionSlot->getPendingNetworkCommandList(true);
-				if(pendingList.empty() == false) {
-					for(int idx = 0; exitServer == false && idx < (int)pendingList.size(); ++idx) {
-						NetworkCommand &cmd = pendingList[idx];
-						this->requestCommand(&cmd);
-					}
-					//printf("Executed: %d commands from slot: %d\n",pendingList.size(),index);
+		int64 nowMicros = Chrono::getCurMicros();
+		ClientNetworkCommand clientCommand;
+		while(exitServer == false && clientNetworkCommands.pop(clientCommand) == true) {
+			// The client disconnected or the slot was reused since it arrived
+			if(clientCommand.slotGeneration != SDL_AtomicGet(&slotCommandGenerations[clientCommand.slotIndex])) {
+				continue;
+			}
+
+			int64 latencyMillis = (nowMicros - clientCommand.arrivalMicros) / 1000;
+			int bucket = 0;
+			for(; bucket < commandLatencyBucketCount - 1; ++bucket) {
+				if(latencyMillis < COMMAND_LATENCY_BUCKET_MILLIS[bucket]) {
+					break;
 				}
 			}
+			commandLatencyHistogram[clientCommand.slotIndex][bucket]++;
+
+			this->requestCommand(&clientCommand.command);
+		}
+	}
+}
+
+// Median and 95th percentile bucket of the time commands waited between
+// arriving from the client and being executed
+string ServerInterface::getCommandLatencyStats(int slotIndex) const {
+	int64 total = 0;
+	for(int bucket = 0; bucket < commandLatencyBucketCount; ++bucket) {
+		total += commandLatencyHistogram[slotIndex][bucket];
+	}
+	if(total == 0) {
+		return "";
+	}
+
+	string percentiles[2];
+	const int64 percentileCounts[2] = { (total + 1) / 2, (total * 95 + 99) / 100 };
+	for(int index = 0; index < 2; ++index) {
+		int64 count = 0;
+		for(int bucket = 0; bucket < commandLatencyBucketCount; ++bucket) {
+			count += commandLatencyHistogram[slotIndex][bucket];
+			if(count >= percentileCounts[index]) {
+				if(COMMAND_LATENCY_BUCKET_MILLIS[bucket] < 0) {
+					percentiles[index] = ">" + intToStr(COMMAND_LATENCY_BUCKET_MILLIS[bucket - 1]);
+				}
+				else {
+					percentiles[index] = "<" + intToStr(COMMAND_LATENCY_BUCKET_MILLIS[bucket]);
+				}
+				break;
+			}
 		}
 	}
+	return ", cmds = " + intToStr(total) + " wait p50 " + percentiles[0] + "ms p95 " + percentiles[1] + "ms";
 }
 
 void ServerInterface::dispatchPendingChatMessages(std::vector <string> &errorMsgList) {
@@ -1672,8 +1750,83 @@ void ServerInterface::update() {
 	}
 }
 
+// Samples how long ago the server broadcast the newest keyframe each client
+// has reported back, smoothed the way TCP smooths round trip times
+void ServerInterface::updateClientLagEstimates(int64 nowMicros) {
+	for(int index = 0; exitServer == false && index < GameConstants::maxPlayers; ++index) {
+		MutexSafeWrapper safeMutexSlot(slotAccessorMutexes[index],CODE_AT_LINE_X(index));
+		ConnectionSlot *connectionSlot = slots[index];
+		if(connectionSlot == NULL || connectionSlot->isConnected() == false ||
+			connectionSlot->getConnectHasHandshaked() == false) {
+			continue;
+		}
+		int clientFrameCount = connectionSlot->getCurrentFrameCount();
+		safeMutexSlot.ReleaseLock();
+
+		ClientLagEstimate &clientLagEstimate = clientLagEstimates[index];
+		int slotGeneration = SDL_AtomicGet(&slotCommandGenerations[index]);
+		if(clientLagEstimate.slotGeneration != slotGeneration) {
+			clientLagEstimate.estimate.clear();
+			clientLagEstimate.slotGeneration = slotGeneration;
+		}
+		if(clientFrameCount <= 0) {
+			continue;
+		}
+
+		int64 broadcastMicros = keyframeHistory.getBroadcastMicros(clientFrameCount);
+		if(broadcastMicros < 0) {
+			continue;
+		}
+		clientLagEstimate.estimate.addSample(clientFrameCount,(nowMicros - broadcastMicros) / 1000.0);
+	}
+}
+
+// Upper bound of a client's lag, -1 until enough samples came in or when
+// adaptive lag checks are disabled
+double ServerInterface::getPredictedClientLagMillis(int index) const {
+	if(index < 0 || index >= GameConstants::maxPlayers ||
+		configAdaptiveLagCheck.get() == false) {
+		return -1;
+	}
+	const ClientLagEstimate &clientLagEstimate = clientLagEstimates[index];
+	if(clientLagEstimate.estimate.getSampleCount() < MIN_CLIENT_LAG_ESTIMATE_SAMPLES ||
+		clientLagEstimate.slotGeneration != SDL_AtomicGet(&slotCommandGenerations[index])) {
+		return -1;
+	}
+	return clientLagEstimate.estimate.getPredictedMillis();
+}
+
+// Whether the client stopped advancing over the last few keyframes
+bool ServerInterface::isClientStalled(int index) const {
+	if(index < 0 || index >= GameConstants::maxPlayers) {
+		return false;
+	}
+	const ClientLagEstimate &clientLagEstimate = clientLagEstimates[index];
+	return (clientLagEstimate.slotGeneration == SDL_AtomicGet(&slotCommandGenerations[index]) &&
+			clientLagEstimate.estimate.isStalled() == true);
+}
+
+int64 ServerInterface::getEmptyCommandListBroadcastMillis() const {
+	double slowestLagMillis = -1;
+	for(int index = 0; index < GameConstants::maxPlayers; ++index) {
+		slowestLagMillis = max(slowestLagMillis,getPredictedClientLagMillis(index));
+	}
+	if(slowestLagMillis < 0) {
+		return MAX_EMPTY_NETWORK_COMMAND_LIST_BROADCAST_INTERVAL_MILLISECONDS;
+	}
+	return max((int64)MIN_EMPTY_NETWORK_COMMAND_LIST_BROADCAST_INTERVAL_MILLISECONDS,
+			   min((int64)MAX_EMPTY_NETWORK_COMMAND_LIST_BROADCAST_INTERVAL_MILLISECONDS,(int64)slowestLagMillis));
+}
+
 void ServerInterface::updateKeyframe(int frameCount) {
 	currentFrameCount = frameCount;
+
+	// While the game is paused the same keyframe is sent again on every
+	// update, only a new one is recorded and sampled against
+	int64 nowMicros = Chrono::getCurMicros();
+	if(keyframeHistory.add(frameCount,nowMicros) == true) {
+		updateClientLagEstimates(nowMicros);
+	}
 	if(SystemFlags::getSystemSettingType(SystemFlags::debugNetwork).enabled) SystemFlags::OutputDebug(SystemFlags::debugNetwork,"In [%s::%s Line: %d] currentFrameCount = %d, requestedCommands.size() = %d\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__,currentFrameCount,requestedCommands.size());
 
 	NetworkMessageCommandList networkMessageCommandList(frameCount);
@@ -1718,10 +1871,10 @@ void ServerInterface::updateKeyframe(int frameCount) {
 				sendBroadcastMessage = true;
 			}
 			// Auto pause is enabled due to client lagging, only send empty command
-			// broadcasts every MAX_EMPTY_NETWORK_COMMAND_LIST_BROADCAST_INTERVAL_MILLISECONDS
+			// broadcasts as often as the slowest client can take them
 			else if(this->getClientsAutoPausedDueToLag() == true &&
 					(lastBroadcastCommandsTimer.isStarted() == false ||
-					 lastBroadcastCommandsTimer.getMillis() >= MAX_EMPTY_NETWORK_COMMAND_LIST_BROADCAST_INTERVAL_MILLISECONDS)) {
+					 lastBroadcastCommandsTimer.getMillis() >= getEmptyCommandListBroadcastMillis())) {
 
 				sendBroadcastMessage = true;
 			}
@@ -2287,6 +2440,12 @@ string ServerInterface::getNetworkStatus() {
 				char szBuf[8096]="";
 				snprintf(szBuf,8096,", lag = %d [%.2f]",clientLagCount,lastClientCommandListTimeLag);
 				str += connectionSlot->getName() + " [" + connectionSlot->getUUID() + "] " + string(szBuf);
+				const LagEstimate &estimate = clientLagEstimates[index].estimate;
+				if(estimate.getSampleCount() > 0) {
+					snprintf(szBuf,8096,", keyframe lag = %.0fms +/- %.0fms",estimate.getLagMillis(),estimate.getJitterMillis());
+					str += szBuf;
+				}
+				str += getCommandLatencyStats(index);
 			}
 		}
 		else {
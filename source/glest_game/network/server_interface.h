@@ -22,10 +22,13 @@
 #include "network_interface.h"
 #include "connection_slot.h"
 #include "socket.h"
+#include "lag_estimator.h"
 #include "leak_dumper.h"
 
 using std::vector;
 using Shared::Platform::ServerSocket;
+using Shared::Util::LagEstimate;
+using Shared::Util::KeyframeHistory;
 
 namespace Shared {  namespace PlatformCommon {  class FTPServerThread;  }}
 
@@ -50,6 +53,24 @@ public:
     string targetLanguage;
 };
 
+class ClientNetworkCommand {
+public:
+    NetworkCommand command;
+    int slotIndex;
+    int slotGeneration;
+    int64 arrivalMicros;
+};
+
+// Keyframe lag of the client in a slot, dropped when the slot changes hands
+class ClientLagEstimate {
+public:
+    LagEstimate estimate;
+    int slotGeneration;
+};
+
+public:
+	static const int commandLatencyBucketCount = 8;
+
 private:
 	ConnectionSlot* slots[GameConstants::maxPlayers];
 	Mutex *slotAccessorMutexes[GameConstants::maxPlayers];
@@ -113,6 +134,19 @@ private:
 	Chrono lastBroadcastCommandsTimer;
 	ClientLagCallbackInterface *clientLagCallbackInterface;
 
+	// Commands from every ConnectionSlotThread, drained by the game thread
+	LockFreeQueue<ClientNetworkCommand> clientNetworkCommands;
+	// Bumped when a slot disconnects so its queued commands are dropped
+	mutable SDL_atomic_t slotCommandGenerations[GameConstants::maxPlayers];
+	// Time from arrival to execution of each slot's commands, only touched
+	// by the game thread
+	int64 commandLatencyHistogram[GameConstants::maxPlayers][commandLatencyBucketCount];
+
+	// When each recent keyframe was broadcast, and how far behind that each
+	// client reports back, only touched by the game thread
+	KeyframeHistory keyframeHistory;
+	ClientLagEstimate clientLagEstimates[GameConstants::maxPlayers];
+
 public:
 	ServerInterface(bool publishEnabled, ClientLagCallbackInterface *clientLagCallbackInterface);
 	virtual ~ServerInterface();
@@ -147,6 +181,10 @@ public:
 
     void queueTextMessage(const string & text, int teamIndex, bool echoLocal, string targetLanguage);
 
+    void queueNetworkCommandFromClient(int slotIndex, const NetworkCommand &command);
+    void discardNetworkCommandsFromClient(int slotIndex);
+    string getCommandLatencyStats(int slotIndex) const;
+
     virtual void sendMarkCellMessage(Vec2i targetPos, int factionIndex, string note,int playerIndex);
     void sendMarkCellMessage(Vec2i targetPos, int factionIndex, string note, int playerIndex, int lockedSlotIndex);
 
@@ -274,6 +312,10 @@ private:
 	void checkForAutoPauseForLaggingClient(int index,
 			ConnectionSlot* connectionSlot);
 	void checkForAutoResumeForLaggingClients();
+	void updateClientLagEstimates(int64 nowMicros);
+	double getPredictedClientLagMillis(int index) const;
+	bool isClientStalled(int index) const;
+	int64 getEmptyCommandListBroadcastMillis() const;
 
 protected:
     void signalClientsToRecieveData(std::map<PLATFORM_SOCKET,bool> & socketTriggeredList, std::map<int,ConnectionSlotEvent> & eventList, std::map<int,bool> & mapSlotSignalledList);
@@ -39,6 +39,12 @@ SoundRenderer::SoundRenderer() : mutex(new Mutex(CODE_AT_LINE)) {
 	Config &config= Config::getInstance();
 	runThreadSafe = config.getBool("ThreadedSoundStream","true");
 
+	// Static sounds are decoded on first play and shared by file, the least
+	// recently played ones are released above this size
+	SoundSampleCache &soundSampleCache = SoundSampleCache::getInstance();
+	soundSampleCache.setMaxResidentBytes((uint64)config.getInt("SoundSampleCacheMaxMegabytes","64") * 1024 * 1024);
+	soundSampleCache.setPrefetchEnabled(config.getBool("SoundSamplePrefetch","false"));
+
 	if(SystemFlags::getSystemSettingType(SystemFlags::debugSystem).enabled) SystemFlags::OutputDebug(SystemFlags::debugSystem,"In [%s::%s Line: %d] runThreadSafe = %d\n",__FILE__,__FUNCTION__,__LINE__,runThreadSafe);
 }
 
@@ -55,7 +61,7 @@ bool SoundRenderer::init(Window *window) {
 	cleanup();
 	stopAllSounds();
 
-    MutexSafeWrapper safeMutex(NULL,string(__FILE__) + "_" + intToStr(__LINE__));
+    MutexSafeWrapper safeMutex(NULL,CODE_AT_LINE);
 	if(runThreadSafe == true) {
 	    safeMutex.setMutex(mutex);
 	}
@@ -81,7 +87,7 @@ void SoundRenderer::cleanup() {
 
     if(SystemFlags::getSystemSettingType(SystemFlags::debugSystem).enabled) SystemFlags::OutputDebug(SystemFlags::debugSystem,"In [%s::%s %d]\n",__FILE__,__FUNCTION__,__LINE__);
 
-    MutexSafeWrapper safeMutex(NULL,string(__FILE__) + "_" + intToStr(__LINE__));
+    MutexSafeWrapper safeMutex(NULL,CODE_AT_LINE);
 	if(runThreadSafe == true) {
 	    safeMutex.setMutex(mutex);
 	}
@@ -124,13 +130,18 @@ SoundRenderer &SoundRenderer::getInstance() {
 
 void SoundRenderer::update() {
     if(wasInitOk() == true && soundPlayer != NULL) {
-        MutexSafeWrapper safeMutex(NULL,string(__FILE__) + "_" + intToStr(__LINE__));
+        MutexSafeWrapper safeMutex(NULL,CODE_AT_LINE);
     	if(runThreadSafe == true) {
     	    safeMutex.setMutex(mutex);
     	}
 		if(soundPlayer) {
 			soundPlayer->updateStreams();
 		}
+		safeMutex.ReleaseLock();
+
+		// Decode queued static sounds a little at a time, this runs on the
+		// sound thread when ThreadedSoundStream is on
+		SoundSampleCache::getInstance().decodePendingPrefetches(1);
     }
 }
 
@@ -141,7 +152,7 @@ void SoundRenderer::playMusic(StrSound *strSound) {
 		strSound->setVolume(musicVolume);
 		strSound->restart();
 		if(soundPlayer != NULL) {
-	        MutexSafeWrapper safeMutex(NULL,string(__FILE__) + "_" + intToStr(__LINE__));
+	        MutexSafeWrapper safeMutex(NULL,CODE_AT_LINE);
             if(runThreadSafe == true) {
                 safeMutex.setMutex(mutex);
             }
@@ -161,7 +172,7 @@ void SoundRenderer::setMusicVolume(StrSound *strSound) {
 
 void SoundRenderer::stopMusic(StrSound *strSound) {
     if(soundPlayer != NULL) {
-        MutexSafeWrapper safeMutex(NULL,string(__FILE__) + "_" + intToStr(__LINE__));
+        MutexSafeWrapper safeMutex(NULL,CODE_AT_LINE);
     	if(runThreadSafe == true) {
     	    safeMutex.setMutex(mutex);
     	}
@@ -190,7 +201,7 @@ void SoundRenderer::playFx(StaticSound *staticSound, Vec3f soundPos, Vec3f camPo
 			staticSound->setVolume(correctedVol);
 
 			if(soundPlayer != NULL) {
-		        MutexSafeWrapper safeMutex(NULL,string(__FILE__) + "_" + intToStr(__LINE__));
+		        MutexSafeWrapper safeMutex(NULL,CODE_AT_LINE);
                 if(runThreadSafe == true) {
                     safeMutex.setMutex(mutex);
                 }
@@ -207,7 +218,7 @@ void SoundRenderer::playFx(StaticSound *staticSound, bool force) {
 	if(staticSound!=NULL){
 		staticSound->setVolume(fxVolume);
 		if(soundPlayer != NULL) {
-	        MutexSafeWrapper safeMutex(NULL,string(__FILE__) + "_" + intToStr(__LINE__));
+	        MutexSafeWrapper safeMutex(NULL,CODE_AT_LINE);
             if(runThreadSafe == true) {
                 safeMutex.setMutex(mutex);
             }
@@ -225,7 +236,7 @@ void SoundRenderer::playAmbient(StrSound *strSound) {
 	if(strSound != NULL) {
 		strSound->setVolume(ambientVolume);
 		if(soundPlayer != NULL) {
-	        MutexSafeWrapper safeMutex(NULL,string(__FILE__) + "_" + intToStr(__LINE__));
+	        MutexSafeWrapper safeMutex(NULL,CODE_AT_LINE);
             if(runThreadSafe == true) {
                 safeMutex.setMutex(mutex);
             }
@@ -239,7 +250,7 @@ void SoundRenderer::playAmbient(StrSound *strSound) {
 
 void SoundRenderer::stopAmbient(StrSound *strSound) {
     if(soundPlayer != NULL) {
-        MutexSafeWrapper safeMutex(NULL,string(__FILE__) + "_" + intToStr(__LINE__));
+        MutexSafeWrapper safeMutex(NULL,CODE_AT_LINE);
     	if(runThreadSafe == true) {
     	    safeMutex.setMutex(mutex);
     	}
@@ -254,7 +265,7 @@ void SoundRenderer::stopAmbient(StrSound *strSound) {
 
 void SoundRenderer::stopAllSounds(int64 fadeOff) {
     if(soundPlayer != NULL) {
-        MutexSafeWrapper safeMutex(NULL,string(__FILE__) + "_" + intToStr(__LINE__));
+        MutexSafeWrapper safeMutex(NULL,CODE_AT_LINE);
     	if(runThreadSafe == true) {
     	    safeMutex.setMutex(mutex);
     	}
@@ -29,6 +29,7 @@ namespace Glest{ namespace Game{
 
 using ::Shared::Sound::StrSound;
 using ::Shared::Sound::StaticSound;
+using ::Shared::Sound::SoundSampleCache;
 using ::Shared::Sound::SoundPlayer;
 using ::Shared::Graphics::Vec3f;
 using namespace ::Shared::PlatformCommon;
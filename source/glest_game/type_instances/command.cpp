@@ -17,6 +17,7 @@
 #include "unit_type.h"
 #include "faction.h"
 #include "world.h"
+#include "object_pool.h"
 #include "leak_dumper.h"
 
 using namespace Shared::Util;
@@ -26,6 +27,35 @@ namespace Glest{ namespace Game{
 // =====================================================
 // 	class Command
 // =====================================================
+
+// Never deleted, commands still queued on units can be freed during
+// static destruction at exit
+static ObjectPool & getCommandPool() {
+	static ObjectPool *commandPool = new ObjectPool("Command",sizeof(Command),512);
+	return *commandPool;
+}
+
+#ifndef SL_LEAK_DUMP
+void * Command::operator new(size_t bytes) {
+	if(bytes != sizeof(Command)) {
+		return ::operator new(bytes);
+	}
+	return getCommandPool().allocate();
+}
+
+void Command::operator delete(void *ptr, size_t bytes) {
+	if(bytes != sizeof(Command)) {
+		::operator delete(ptr);
+		return;
+	}
+	getCommandPool().deallocate(ptr);
+}
+#endif
+
+string Command::getPoolStats() {
+	return getCommandPool().getStats();
+}
+
 Command::Command() : unitRef() {
     this->commandType= NULL;
 	unitType= NULL;
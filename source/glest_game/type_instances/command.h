@@ -63,6 +63,14 @@ public:
     Command(const CommandType *ct, const Vec2i &pos, const UnitType *unitType, CardinalDir facing); 
 
     virtual ~Command() {}
+
+#ifndef SL_LEAK_DUMP
+    // Commands are recycled through a pool, leak dump builds keep the
+    // global allocator so every command is still tracked with file and line
+    static void * operator new(size_t bytes);
+    static void operator delete(void *ptr, size_t bytes);
+#endif
+    static string getPoolStats();
     //get
 	inline const CommandType *getCommandType() const	{return commandType;}
 	inline Vec2i getPos() const						{return pos;}
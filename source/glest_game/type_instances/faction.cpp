@@ -156,7 +156,7 @@ bool CommandGroupUnitSorter::compare(const Unit *l, const Unit *r) {
 }
 
 void Faction::sortUnitsByCommandGroups() {
-	MutexSafeWrapper safeMutex(unitsMutex,string(__FILE__) + "_" + intToStr(__LINE__));
+	MutexSafeWrapper safeMutex(unitsMutex,CODE_AT_LINE);
 	//printf("====== sortUnitsByCommandGroups for faction # %d [%s] unitCount = %d\n",this->getIndex(),this->getType()->getName().c_str(),units.size());
 	//for(unsigned int i = 0; i < units.size(); ++i) {
 	//	printf("%d / %d [%p] <>",i,units.size(),&units[i]);
@@ -363,6 +363,10 @@ void FactionThread::execute() {
 				//printf("In [%s::%s Line: %d]\n",__FILE__,__FUNCTION__,__LINE__);
 
 				codeLocation = "9";
+				// The synch log records every unit's needToUpdate result so
+				// only skip idle units when it is off
+				const bool skipIdleUnits = (SystemFlags::getSystemSettingType(SystemFlags::debugWorldSynch).enabled == false);
+				int skippedUnitCount = 0;
 				int unitCount = this->faction->getUnitCount();
 				for(int j = 0; j < unitCount; ++j) {
 					codeLocation = "10";
@@ -371,6 +375,11 @@ void FactionThread::execute() {
 						throw megaglest_runtime_error("unit == NULL");
 					}
 
+					if(skipIdleUnits == true && unit->hasThreadedCommandWork() == false) {
+						skippedUnitCount++;
+						continue;
+					}
+
 					codeLocation = "11";
 					int64 elapsed1 = 0;
 					if(minorDebugPerformance) elapsed1 = chrono.getMillis();
@@ -424,6 +433,8 @@ void FactionThread::execute() {
 					}
 				}
 
+				this->faction->addSkippedUnitUpdates(skippedUnitCount);
+
 				codeLocation = "17";
 				if(minorDebugPerformance && chrono.getMillis() >= 1) printf("Faction [%d - %s] threaded updates on frame: %d for [%d] units took [%lld] msecs\n",faction->getStartLocationIndex(),faction->getType()->getName(false).c_str(),currentTriggeredFrameIndex,faction->getUnitPathfindingListCount(),(long long int)chrono.getMillis());
 
@@ -485,6 +496,7 @@ void Faction::init() {
 	cachingDisabled=false;
 	factionDisconnectHandled=false;
 	workerThread = NULL;
+	skippedUnitUpdateCount = 0;
 
 	world=NULL;
 	scriptManager=NULL;
@@ -525,9 +537,13 @@ Faction::~Faction() {
 		workerThread = NULL;
 	}
 
-	MutexSafeWrapper safeMutex(unitsMutex,string(__FILE__) + "_" + intToStr(__LINE__));
+	MutexSafeWrapper safeMutex(unitsMutex,CODE_AT_LINE);
 	deleteValues(units.begin(), units.end());
 	units.clear();
+	unitTypeCountList.clear();
+	unitConsumableTypeList.clear();
+	consumableBalanceList.clear();
+	storeUnitList.clear();
 
 	safeMutex.ReleaseLock();
 
@@ -552,9 +568,13 @@ void Faction::end() {
 		workerThread = NULL;
 	}
 
-	MutexSafeWrapper safeMutex(unitsMutex,string(__FILE__) + "_" + intToStr(__LINE__));
+	MutexSafeWrapper safeMutex(unitsMutex,CODE_AT_LINE);
 	deleteValues(units.begin(), units.end());
 	units.clear();
+	unitTypeCountList.clear();
+	unitConsumableTypeList.clear();
+	consumableBalanceList.clear();
+	storeUnitList.clear();
 
 	safeMutex.ReleaseLock();
 
@@ -587,6 +607,34 @@ void Faction::notifyUnitTypeChange(const Unit *unit, const UnitType *newType) {
 		if(newType != NULL && newType->isMobile() == true) {
 			mobileUnitListCache[unit->getId()] = unit;
 		}
+
+		// Units are only counted once they have been added to the faction
+		MutexSafeWrapper safeMutex(unitsMutex,CODE_AT_LINE);
+		UnitMap::iterator iterFind = unitMap.find(unit->getId());
+		if(iterFind != unitMap.end()) {
+			unitTypeCountList[unit->getType()]--;
+			if(newType != NULL) {
+				unitTypeCountList[newType]++;
+			}
+
+			// A morph can gain or lose the ability to store, the store list
+			// keeps the units list order
+			bool wasStore = (unit->getType()->getStoredResourceCount() > 0);
+			bool isStore = (newType != NULL && newType->getStoredResourceCount() > 0);
+			if(wasStore == true && isStore == false) {
+				storeUnitList.erase(std::remove(storeUnitList.begin(),storeUnitList.end(),iterFind->second),storeUnitList.end());
+			}
+			else if(wasStore == false && isStore == true) {
+				std::vector<Unit *>::iterator insertAt = storeUnitList.begin();
+				for(unsigned int i = 0; i < units.size() && units[i] != unit; ++i) {
+					if(insertAt != storeUnitList.end() && *insertAt == units[i]) {
+						++insertAt;
+					}
+				}
+				storeUnitList.insert(insertAt,iterFind->second);
+			}
+		}
+		safeMutex.ReleaseLock();
 	}
 }
 
@@ -629,6 +677,58 @@ int Faction::getAIBehaviorStaticOverideValue(AIBehaviorStaticValueCategory type)
 	return factionType->getAIBehaviorStaticOverideValue(type);
 }
 
+void Faction::refreshUnitConsumableBalance(const Unit *unit) {
+	if(unit == NULL) {
+		return;
+	}
+
+	// Only operative units in the units list pay their consumable costs.
+	// Check the list first, units still being constructed are not in it yet
+	// and their skill is not set up
+	const UnitType *contributingType = NULL;
+	if(unitMap.find(unit->getId()) != unitMap.end() &&
+		unit->isOperative() == true) {
+		contributingType = unit->getType();
+	}
+
+	std::map<int,const UnitType *>::iterator iterFind = unitConsumableTypeList.find(unit->getId());
+	const UnitType *currentType = (iterFind != unitConsumableTypeList.end() ? iterFind->second : NULL);
+	if(currentType == contributingType) {
+		return;
+	}
+
+	applyConsumableCosts(currentType, 1);
+	applyConsumableCosts(contributingType, -1);
+
+	if(contributingType != NULL) {
+		unitConsumableTypeList[unit->getId()] = contributingType;
+	}
+	else {
+		unitConsumableTypeList.erase(iterFind);
+	}
+}
+
+void Faction::applyConsumableCosts(const UnitType *unitType, int sign) {
+	if(unitType == NULL) {
+		return;
+	}
+	for(int index = 0; index < unitType->getCostCount(); ++index) {
+		const Resource *resource = unitType->getCost(index);
+		if(resource != NULL && resource->getType() != NULL &&
+			resource->getType()->getClass() == rcConsumable) {
+			consumableBalanceList[resource->getType()] += sign * resource->getAmount();
+		}
+	}
+}
+
+int Faction::getConsumableBalance(const ResourceType *rt) const {
+	std::map<const ResourceType *,int>::const_iterator iterFind = consumableBalanceList.find(rt);
+	if(iterFind != consumableBalanceList.end()) {
+		return iterFind->second;
+	}
+	return 0;
+}
+
 void Faction::addUnitToMovingList(int unitId) {
 	unitsMovingList[unitId] = getWorld()->getFrameCount();
 }
@@ -961,6 +1061,34 @@ int Faction::getCountForMaxUnitCount(const UnitType *unitType) const{
 	return count;
 }
 
+// The AI threads read the counts while the game thread adds units, so the
+// map is only touched under unitsMutex
+int Faction::getCountOfUnitType(const UnitType *unitType) const {
+	MutexSafeWrapper safeMutex(unitsMutex,CODE_AT_LINE);
+	std::map<const UnitType *,int>::const_iterator iterFind = unitTypeCountList.find(unitType);
+	if(iterFind != unitTypeCountList.end()) {
+		return iterFind->second;
+	}
+	return 0;
+}
+
+int Faction::getCountOfUnitClass(UnitClass unitClass,const UnitClass *additionalUnitClassToExcludeFromCount) const {
+	int count = 0;
+	MutexSafeWrapper safeMutex(unitsMutex,CODE_AT_LINE);
+	for(std::map<const UnitType *,int>::const_iterator iterMap = unitTypeCountList.begin();
+		iterMap != unitTypeCountList.end(); ++iterMap) {
+		const UnitType *unitType = iterMap->first;
+		if(unitType->isOfClass(unitClass) == true) {
+			// Skip unit types that ALSO contain the exclusion unit class type
+			if(additionalUnitClassToExcludeFromCount != NULL &&
+				unitType->isOfClass(*additionalUnitClassToExcludeFromCount) == true) {
+				continue;
+			}
+			count += iterMap->second;
+		}
+	}
+	return count;
+}
 
 bool Faction::reqsOk(const CommandType *ct) const {
 	assert(ct != NULL);
@@ -1337,13 +1465,18 @@ Unit *Faction::findUnit(int id) const {
 }
 
 void Faction::addUnit(Unit *unit) {
-	MutexSafeWrapper safeMutex(unitsMutex,string(__FILE__) + "_" + intToStr(__LINE__));
+	MutexSafeWrapper safeMutex(unitsMutex,CODE_AT_LINE);
 	units.push_back(unit);
 	unitMap[unit->getId()] = unit;
+	unitTypeCountList[unit->getType()]++;
+	refreshUnitConsumableBalance(unit);
+	if(unit->getType()->getStoredResourceCount() > 0) {
+		storeUnitList.push_back(unit);
+	}
 }
 
 void Faction::removeUnit(Unit *unit){
-	MutexSafeWrapper safeMutex(unitsMutex,string(__FILE__) + "_" + intToStr(__LINE__));
+	MutexSafeWrapper safeMutex(unitsMutex,CODE_AT_LINE);
 
 	assert(units.size()==unitMap.size());
 
@@ -1352,6 +1485,9 @@ void Faction::removeUnit(Unit *unit){
 		if(units[i]->getId() == unitId) {
 			units.erase(units.begin()+i);
 			unitMap.erase(unitId);
+			unitTypeCountList[unit->getType()]--;
+			refreshUnitConsumableBalance(unit);
+			storeUnitList.erase(std::remove(storeUnitList.begin(),storeUnitList.end(),unit),storeUnitList.end());
 			assert(units.size() == unitMap.size());
 			return;
 		}
@@ -187,8 +187,29 @@ private:
 	std::map<int,const Unit *> mobileUnitListCache;
 	std::map<int,const Unit *> beingBuiltUnitListCache;
 
+	// Live count of the units in the units list per unit type, kept up to
+	// date on add, remove and morph so AI queries don't scan every unit.
+	// Guarded by unitsMutex
+	std::map<const UnitType *,int> unitTypeCountList;
+
+	// Running consumable totals of all operative units, each unit remembers
+	// the type whose costs it currently contributes so create, death, build
+	// completion and morph only adjust the totals by that one unit
+	std::map<int,const UnitType *> unitConsumableTypeList;
+	std::map<const ResourceType *,int> consumableBalanceList;
+
+	void applyConsumableCosts(const UnitType *unitType, int sign);
+
+	// Units whose type can store any resource, in the same order as the
+	// units list so lookups over them match a scan over all units
+	std::vector<Unit *> storeUnitList;
+
 	std::map<std::string, bool> resourceTypeCostCache;
 
+	// Units the worker thread passed over because updateUnitCommand would
+	// have had nothing to precache for them
+	int64 skippedUnitUpdateCount;
+
 public:
 	Faction();
 	~Faction();
@@ -205,6 +226,10 @@ public:
 	void notifyUnitAliveStatusChange(const Unit *unit);
 	void notifyUnitTypeChange(const Unit *unit, const UnitType *newType);
 	void notifyUnitSkillTypeChange(const Unit *unit, const SkillType *newType);
+	void refreshUnitConsumableBalance(const Unit *unit);
+	int getConsumableBalance(const ResourceType *rt) const;
+	inline int getStoreUnitCount() const				{return (int)storeUnitList.size();}
+	inline Unit *getStoreUnit(int i) const				{return storeUnitList[i];}
 	bool hasAliveUnits(bool filterMobileUnits, bool filterBuiltUnits) const;
 
 	inline void addWorldSynchThreadedLogList(const string &data) {
@@ -296,6 +321,9 @@ public:
 	}
 	inline Mutex * getUnitMutex() {return unitsMutex;}
 
+	inline int64 getSkippedUnitUpdateCount() const				{return skippedUnitUpdateCount;}
+	inline void addSkippedUnitUpdates(int count)				{skippedUnitUpdateCount += count;}
+
 	inline const UpgradeManager *getUpgradeManager() const		{return &upgradeManager;}
 	inline const Texture2D *getTexture() const					{return texture;}
 	inline int getStartLocationIndex() const					{return startLocationIndex;}
@@ -321,6 +349,8 @@ public:
 	bool reqsOk(const RequirableType *rt) const;
 	bool reqsOk(const CommandType *ct) const;
     int getCountForMaxUnitCount(const UnitType *unitType) const;
+	int getCountOfUnitType(const UnitType *unitType) const;
+	int getCountOfUnitClass(UnitClass unitClass,const UnitClass *additionalUnitClassToExcludeFromCount=NULL) const;
 
 	//diplomacy
 	bool isAlly(const Faction *faction);
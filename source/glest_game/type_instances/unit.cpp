@@ -26,6 +26,7 @@
 #include "game.h"
 #include "socket.h"
 #include "sound_renderer.h"
+#include "interpolation.h"
 
 #include "leak_dumper.h"
 
@@ -530,11 +531,11 @@ Unit::Unit(int id, UnitPathInterface *unitpath, const Vec2i &pos,
 #endif
 
 	mutexCommands = new Mutex(CODE_AT_LINE);
+	synchLog = new UnitSynchLogData();
 	changedActiveCommand = false;
 	lastChangedActiveCommandFrame = 0;
 	changedActiveCommandFrame = 0;
 
-	lastSynchDataString="";
 	modelFacing = CardinalDir(CardinalDir::NORTH);
 	lastStuckFrame = 0;
 	lastStuckPos = Vec2i(0,0);
@@ -547,10 +548,10 @@ Unit::Unit(int id, UnitPathInterface *unitpath, const Vec2i &pos,
 	causeOfDeath = ucodNone;
 	pathfindFailedConsecutiveFrameCount = 0;
 
-	lastSynchDataString = "";
-	lastFile = "";
-	lastLine = 0;
-	lastSource = "";
+	synchLog->lastSynchDataString = "";
+	synchLog->lastFile = "";
+	synchLog->lastLine = 0;
+	synchLog->lastSource = "";
 
 	targetRotationZ=.0f;
 	targetRotationX=.0f;
@@ -558,6 +559,8 @@ Unit::Unit(int id, UnitPathInterface *unitpath, const Vec2i &pos,
 	rotationX=.0f;
 
 	this->fire= NULL;
+	this->currSkill= NULL;
+	this->alive= false;
     this->unitPath = unitpath;
     this->unitPath->setMap(map);
 
@@ -608,6 +611,7 @@ Unit::Unit(int id, UnitPathInterface *unitpath, const Vec2i &pos,
 
 	lastPos= pos;
     progress= 0;
+    lastProgress= 0;
 	this->lastAnimProgress= 0;
 	this->animProgress= 0;
     progress2= 0;
@@ -717,6 +721,9 @@ Unit::~Unit() {
 	delete mutexCommands;
 	mutexCommands=NULL;
 
+	delete synchLog;
+	synchLog=NULL;
+
 #ifdef LEAK_CHECK_UNITS
 	Unit::mapMemoryList.erase(this);
 #endif
@@ -756,11 +763,13 @@ ParticleSystem * Unit::getFire() const	{
 void Unit::setType(const UnitType *newType) {
 	this->faction->notifyUnitTypeChange(this, newType);
 	this->type = newType;
+	this->faction->refreshUnitConsumableBalance(this);
 }
 
 void Unit::setAlive(bool value) {
 	this->alive = value;
 	this->faction->notifyUnitAliveStatusChange(this);
+	this->faction->refreshUnitConsumableBalance(this);
 }
 
 #ifdef LEAK_CHECK_UNITS
@@ -788,32 +797,32 @@ bool Unit::isNetworkCRCEnabled() {
 }
 
 void Unit::clearNetworkCRCDecHpList() {
-	if(networkCRCDecHpList.empty() == false) {
-		networkCRCDecHpList.clear();
+	if(synchLog->networkCRCDecHpList.empty() == false) {
+		synchLog->networkCRCDecHpList.clear();
 	}
 }
 void Unit::clearParticleInfo() {
-	if(networkCRCParticleInfoList.empty() == false) {
-		networkCRCParticleInfoList.clear();
+	if(synchLog->networkCRCParticleInfoList.empty() == false) {
+		synchLog->networkCRCParticleInfoList.clear();
 	}
 }
 
 void Unit::addNetworkCRCDecHp(string info) {
 	if(isNetworkCRCEnabled() == true) {
-		networkCRCDecHpList.push_back(info);
+		synchLog->networkCRCDecHpList.push_back(info);
 	}
 }
 
 void Unit::logParticleInfo(string info) {
 	if(isNetworkCRCEnabled() == true) {
-		networkCRCParticleInfoList.push_back(info);
+		synchLog->networkCRCParticleInfoList.push_back(info);
 	}
 }
 string Unit::getParticleInfo() const {
 	string result = "";
-	if(networkCRCParticleInfoList.empty() == false) {
-		for(unsigned int index = 0; index < networkCRCParticleInfoList.size(); ++index) {
-			result += networkCRCParticleInfoList[index] + "|";
+	if(synchLog->networkCRCParticleInfoList.empty() == false) {
+		for(unsigned int index = 0; index < synchLog->networkCRCParticleInfoList.size(); ++index) {
+			result += synchLog->networkCRCParticleInfoList[index] + "|";
 		}
 	}
 	return result;
@@ -1346,6 +1355,7 @@ void Unit::setCurrSkill(const SkillType *currSkill) {
 	if(faction != NULL) faction->notifyUnitSkillTypeChange(this, currSkill);
 	const SkillType *original_skill = this->currSkill;
 	this->currSkill= currSkill;
+	if(faction != NULL) faction->refreshUnitConsumableBalance(this);
 
 	if(original_skill != this->currSkill) {
 		//printf("File: %s line: %d\n",extractFileFromDirectoryPath(__FILE__).c_str(),__LINE__);
@@ -1703,14 +1713,34 @@ float Unit::getProgressAsFloat() const {
 }
 
 Vec3f Unit::getVectorFlat(const Vec2i &lastPosValue, const Vec2i &curPosValue) const {
+	return getVectorFlat(lastPosValue, curPosValue, getProgressAsFloat());
+}
+
+// Where the unit is drawn, interpolation is how far (0 to 1) the world is
+// into its next frame. Movement keeps going at the speed of the last frame
+// but never past the target cell.
+Vec3f Unit::getRenderVectorFlat(float interpolation) const {
+	if(interpolation <= 0.f || currSkill->getClass() != scMove) {
+		return getCurrVectorFlat();
+	}
+	float lastProgressAsFloat = static_cast<float>(lastProgress) / static_cast<float>(PROGRESS_SPEED_MULTIPLIER);
+	return getVectorFlat(lastPos, pos, extrapolateProgress(getProgressAsFloat(), lastProgressAsFloat, interpolation));
+}
+
+float Unit::getRenderAnimProgressAsFloat(float interpolation) const {
+	if(isAnimProgressBound() == true) {
+		return getAnimProgressAsFloat();
+	}
+	return extrapolateProgress(getAnimProgressAsFloat(), getLastAnimProgressAsFloat(), interpolation);
+}
+
+Vec3f Unit::getVectorFlat(const Vec2i &lastPosValue, const Vec2i &curPosValue, float progressAsFloat) const {
     Vec3f v;
 
     float y1= computeHeight(lastPosValue);
     float y2= computeHeight(curPosValue);
 
     if(currSkill->getClass() == scMove) {
-    	float progressAsFloat = getProgressAsFloat();
-
         v.x = lastPosValue.x + progressAsFloat * (curPosValue.x - lastPosValue.x);
         v.z = lastPosValue.y + progressAsFloat * (curPosValue.y - lastPosValue.y);
 		v.y = y1 + progressAsFloat * (y2-y1);
@@ -2316,6 +2346,20 @@ bool Unit::needToUpdate() {
 	return return_value;
 }
 
+// The faction worker thread only precaches pathfinding for the current
+// command, units that are dying or whose command never pathfinds would
+// run through updateUnitCommand without touching anything
+bool Unit::hasThreadedCommandWork() const {
+	if(currSkill == NULL || currSkill->getClass() == scDie) {
+		return false;
+	}
+	const Command *command = getCurrCommand();
+	if(command == NULL || command->getCommandType() == NULL) {
+		return false;
+	}
+	return command->getCommandType()->usesPathfinder();
+}
+
 int64 Unit::getDiagonalFactor() {
 	//speed modifier
 	int64 diagonalFactor= PROGRESS_SPEED_MULTIPLIER;
@@ -2391,7 +2435,7 @@ int64 Unit::getUpdatedProgress(int64 currentProgress, int64 updateFPS, int64 spe
 		char szBuf[8096]="";
 		snprintf(szBuf,8095,"currentProgress = " MG_I64_SPECIFIER " updateFPS = " MG_I64_SPECIFIER " speed = " MG_I64_SPECIFIER " diagonalFactor = " MG_I64_SPECIFIER " heightFactor = " MG_I64_SPECIFIER " speedDenominator = " MG_I64_SPECIFIER " progressIncrease = " MG_I64_SPECIFIER " [" MG_I64_SPECIFIER "] height [%f] airHeight [%f] cellUnitHeight [%d] cellObjectHeight [%d] skill [%s] pos [%s] lastpos [%s]",
 				currentProgress,updateFPS,speed,diagonalFactor,heightFactor,speedDenominator,progressIncrease,((speed * diagonalFactor * heightFactor) / speedDenominator),height,airHeight,cellUnitHeight,cellObjectHeight,(currSkill != NULL ? currSkill->getName().c_str() : "none"),pos.getString().c_str(),lastPos.getString().c_str());
-		networkCRCLogInfo = szBuf;
+		synchLog->networkCRCLogInfo = szBuf;
 
 		//printf("%s\n",szBuf);
 	}
@@ -2455,8 +2499,9 @@ void Unit::updateAttackBoostProgress(const Game* game) {
 			UnitUpdater *unitUpdater = this->game->getWorld()->getUnitUpdater();
 
 			const AttackBoost *attackBoost = currSkill->getAttackBoost();
-			vector<Unit *> candidates = unitUpdater->findUnitsInRange(this,
-					attackBoost->radius);
+			ScratchVector<Unit *> candidateList(unitUpdater->getUnitListScratchPool());
+			vector<Unit *> &candidates = candidateList.get();
+			unitUpdater->findUnitsInRange(this,attackBoost->radius,candidates);
 
 			if(debugBoost) printf("Line: %d candidates unit size: " MG_SIZE_T_SPECIFIER " attackBoost: %s\n",__LINE__,candidates.size(),attackBoost->getDesc(false).c_str());
 			for (unsigned int i = 0; i < candidates.size(); ++i) {
@@ -2515,7 +2560,9 @@ void Unit::updateAttackBoostProgress(const Game* game) {
 			UnitUpdater *unitUpdater = this->game->getWorld()->getUnitUpdater();
 
 			const AttackBoost *attackBoost = currSkill->getAttackBoost();
-			vector<Unit *> candidates = unitUpdater->findUnitsInRange(this,attackBoost->radius);
+			ScratchVector<Unit *> candidateList(unitUpdater->getUnitListScratchPool());
+			vector<Unit *> &candidates = candidateList.get();
+			unitUpdater->findUnitsInRange(this,attackBoost->radius,candidates);
 			vector<int> candidateValidIdList;
 			candidateValidIdList.reserve(candidates.size());
 
@@ -2686,6 +2733,7 @@ bool Unit::update() {
 	if(animProgress==0){
 		AnimCycleStarts();
 	}
+	lastProgress = progress;
 	progress = getUpdatedProgress(progress,
 			GameConstants::updateFps,
 			speed, diagonalFactor, heightFactor);
@@ -4519,13 +4567,13 @@ void Unit::logSynchDataCommon(string file,int line,string source,bool threadedMo
 				random.getLastNumber(),
 				(unitPath != NULL ? unitPath->toString().c_str() : "NULL"));
 
-	    if( lastSynchDataString != string(szBuf) ||
-	    	lastFile != file ||
-	    	lastLine != line ||
-	    	lastSource != source) {
-	    	lastSynchDataString = string(szBuf);
-	    	lastFile = file;
-	    	lastSource = source;
+	    if( synchLog->lastSynchDataString != string(szBuf) ||
+	    	synchLog->lastFile != file ||
+	    	synchLog->lastLine != line ||
+	    	synchLog->lastSource != source) {
+	    	synchLog->lastSynchDataString = string(szBuf);
+	    	synchLog->lastFile = file;
+	    	synchLog->lastSource = source;
 
 	    	char szBufDataText[8096]="";
 	    	snprintf(szBufDataText,8096,"----------------------------------- START [FRAME %d UNIT: %d - %s] ------------------------------------------------\n",getFrameCount(),this->id,this->getType()->getName(false).c_str());
@@ -4727,9 +4775,9 @@ bool Unit::showTranslatedTechTree() const {
 
 string Unit::getNetworkCRCDecHpList() const {
 	string result = "";
-	if(networkCRCDecHpList.empty() == false) {
-		for(unsigned int index = 0; index < networkCRCDecHpList.size(); ++index) {
-			result += networkCRCDecHpList[index] + " ";
+	if(synchLog->networkCRCDecHpList.empty() == false) {
+		for(unsigned int index = 0; index < synchLog->networkCRCDecHpList.size(); ++index) {
+			result += synchLog->networkCRCDecHpList[index] + " ";
 		}
 	}
 	return result;
@@ -4761,7 +4809,7 @@ std::string Unit::toString(bool crcMode) const {
 	result += " deadCount = " + intToStr(this->deadCount);
 	result += " progress = " + intToStr(this->progress);
 	result += "\n";
-	result += "networkCRCLogInfo = " + networkCRCLogInfo;
+	result += "networkCRCLogInfo = " + synchLog->networkCRCLogInfo;
 	result += "\n";
 	if(crcMode == false) {
 		result += " lastAnimProgress = " + intToStr(this->lastAnimProgress);
@@ -4865,10 +4913,10 @@ std::string Unit::toString(bool crcMode) const {
 	if(attackParticleSystems.empty() == false) {
 		result += "attackParticleSystems count = " + intToStr(attackParticleSystems.size()) + "\n";
 	}
-	if(networkCRCParticleLogInfo != "") {
-		result += "networkCRCParticleLogInfo = " + networkCRCParticleLogInfo + "\n";
+	if(synchLog->networkCRCParticleLogInfo != "") {
+		result += "networkCRCParticleLogInfo = " + synchLog->networkCRCParticleLogInfo + "\n";
 	}
-	if(networkCRCDecHpList.empty() == false) {
+	if(synchLog->networkCRCDecHpList.empty() == false) {
 		result += "getNetworkCRCDecHpList() = " + getNetworkCRCDecHpList() + "\n";
 	}
 
@@ -5094,13 +5142,13 @@ void Unit::saveGame(XmlNode *rootNode) {
 	unitNode->addAttribute("modelFacing",intToStr(modelFacing), mapTagReplacements);
 
 //	std::string lastSynchDataString;
-	unitNode->addAttribute("lastSynchDataString",lastSynchDataString, mapTagReplacements);
+	unitNode->addAttribute("lastSynchDataString",synchLog->lastSynchDataString, mapTagReplacements);
 //	std::string lastFile;
-	unitNode->addAttribute("lastFile",lastFile, mapTagReplacements);
+	unitNode->addAttribute("lastFile",synchLog->lastFile, mapTagReplacements);
 //	int lastLine;
-	unitNode->addAttribute("lastLine",intToStr(lastLine), mapTagReplacements);
+	unitNode->addAttribute("lastLine",intToStr(synchLog->lastLine), mapTagReplacements);
 //	std::string lastSource;
-	unitNode->addAttribute("lastSource",lastSource, mapTagReplacements);
+	unitNode->addAttribute("lastSource",synchLog->lastSource, mapTagReplacements);
 //	int lastRenderFrame;
 	unitNode->addAttribute("lastRenderFrame",intToStr(lastRenderFrame), mapTagReplacements);
 //	bool visible;
@@ -5900,8 +5948,8 @@ Checksum Unit::getCRC() {
 		}
 	}
 
-	if(this->networkCRCParticleLogInfo != "") {
-		crcForUnit.addString(this->networkCRCParticleLogInfo);
+	if(synchLog->networkCRCParticleLogInfo != "") {
+		crcForUnit.addString(synchLog->networkCRCParticleLogInfo);
 	}
 
 	return crcForUnit;
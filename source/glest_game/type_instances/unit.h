@@ -332,6 +332,28 @@ public:
 	virtual void loadGame(const XmlNode *rootNode, Unit *unit, World *world);
 };
 
+// ===============================
+// 	class UnitSynchLogData
+//
+///	Synch and network CRC debug text for a unit, kept out of the Unit
+/// object so the per frame fields stay on fewer cache lines
+// ===============================
+
+class UnitSynchLogData {
+public:
+	UnitSynchLogData() : lastLine(0) {}
+
+	std::string lastSynchDataString;
+	std::string lastFile;
+	int32 lastLine;
+	std::string lastSource;
+
+	string networkCRCLogInfo;
+	string networkCRCParticleLogInfo;
+	vector<string> networkCRCDecHpList;
+	vector<string> networkCRCParticleInfoList;
+};
+
 class Unit : public BaseColorPickEntity, ValueCheckerVault, public ParticleOwner {
 private:
     typedef list<Command*> Commands;
@@ -356,6 +378,8 @@ public:
 #endif
 
 private:
+	// Fields read or written by the per frame unit update, grouped at the
+	// start of the object so a pass over the units touches few cache lines
 	const int32 id;
 	int32 hp;
 	int32 ep;
@@ -363,26 +387,32 @@ private:
 	int32 deadCount;
     //float progress;			//between 0 and 1
     int64 progress;			//between 0 and 1
+    int64 lastProgress;		//progress before the last update, only used for rendering
 	int64 lastAnimProgress;	//between 0 and 1
 	int64 animProgress;		//between 0 and 1
-	float highlight;
 	int32 progress2;
-	int32 kills;
-	int32 enemyKills;
-	bool morphFieldsBlocked;
-	int oldTotalSight;
 
-	UnitReference targetRef;
+	// Read by getUpdateProgress every frame, keep next to progress
+	bool changedActiveCommand;
+	uint32 lastChangedActiveCommandFrame;
+	uint32 changedActiveCommandFrame;
+
+    bool toBeUndertaken;
+	bool alive;
+
+	const UnitType *type;
+    const ResourceType *loadType;
+    const SkillType *currSkill;
+    Faction *faction;
+	Map *map;
 
 	Field currField;
     Field targetField;
-	const Level *level;
 
     Vec2i pos;
 	Vec2i lastPos;
     Vec2i targetPos;		//absolute target pos
 	Vec3f targetVec;
-	Vec2i meetingPos;
 
 	float lastRotation;		//in degrees
 	float targetRotation;
@@ -392,26 +422,34 @@ private:
 	float rotationZ;
 	float rotationX;
 
+    Commands commands;
+	Mutex *mutexCommands;
+	UnitReference targetRef;
+	UnitPathInterface *unitPath;
+
+	int32 lastModelIndexForCurrSkillType;
+	int32 animationRandomCycleCount;
+	float highlight;
+
+	// Everything below is only touched by commands, rendering, saved games
+	// or debug logging
+	int32 kills;
+	int32 enemyKills;
+	bool morphFieldsBlocked;
+	int oldTotalSight;
+
+	const Level *level;
+	Vec2i meetingPos;
+
 	const UnitType *preMorph_type;
-    const UnitType *type;
-    const ResourceType *loadType;
-    const SkillType *currSkill;
-    int32 lastModelIndexForCurrSkillType;
-    int32 animationRandomCycleCount;
 
-    bool toBeUndertaken;
-	bool alive;
 	bool showUnitParticles;
 
-    Faction *faction;
 	ParticleSystem *fire;
 	TotalUpgrade totalUpgrade;
-	Map *map;
 
-	UnitPathInterface *unitPath;
 	WaypointPath waypointPath;
 
-    Commands commands;
 	Observers observers;
 	vector<UnitParticleSystem*> unitParticleSystems;
 	vector<UnitParticleSystemType*> queuedUnitParticleSystemTypes;
@@ -425,10 +463,6 @@ private:
 
 	CardinalDir modelFacing;
 
-	std::string lastSynchDataString;
-	std::string lastFile;
-	int32 lastLine;
-	std::string lastSource;
 	int32 lastRenderFrame;
 	bool visible;
 
@@ -466,15 +500,9 @@ private:
 
 	std::vector<UnitAttackBoostEffect *> currentAttackBoostEffects;
 
-	Mutex *mutexCommands;
-
 	//static Mutex mutexDeletedUnits;
 	//static std::map<void *,bool> deletedUnits;
 
-	bool changedActiveCommand;
-	uint32 lastChangedActiveCommandFrame;
-	uint32 changedActiveCommandFrame;
-
 	int32 lastAttackerUnitId;
 	int32 lastAttackedUnitId;
 	CauseOfDeathType causeOfDeath;
@@ -493,10 +521,7 @@ private:
 
 	Vec2i lastHarvestedResourcePos;
 
-	string networkCRCLogInfo;
-	string networkCRCParticleLogInfo;
-	vector<string> networkCRCDecHpList;
-	vector<string> networkCRCParticleInfoList;
+	UnitSynchLogData *synchLog;
 
 public:
     Unit(int id, UnitPathInterface *path, const Vec2i &pos, const UnitType *type, Faction *faction, Map *map, CardinalDir placeFacing);
@@ -534,6 +559,7 @@ public:
     //inline int getAnimProgress() const				{return animProgress;}
     inline float getLastAnimProgressAsFloat() const	{return static_cast<float>(lastAnimProgress) / ANIMATION_SPEED_MULTIPLIER;}
     inline float getAnimProgressAsFloat() const		{return static_cast<float>(animProgress) / ANIMATION_SPEED_MULTIPLIER;}
+    float getRenderAnimProgressAsFloat(float interpolation) const;
 
     inline float getHightlight() const					{return highlight;}
     inline int getProgress2() const					{return progress2;}
@@ -644,6 +670,8 @@ public:
 	Vec3f getCurrBurnVector() const;
 	Vec3f getCurrVectorFlat() const;
 	Vec3f getVectorFlat(const Vec2i &lastPosValue, const Vec2i &curPosValue) const;
+	Vec3f getVectorFlat(const Vec2i &lastPosValue, const Vec2i &curPosValue, float progressAsFloat) const;
+	Vec3f getRenderVectorFlat(float interpolation) const;
 
     //command related
 	bool anyCommand(bool validateCommandtype=false) const;
@@ -762,6 +790,7 @@ public:
 
 	std::string toString(bool crcMode=false) const;
 	bool needToUpdate();
+	bool hasThreadedCommandWork() const;
 	float getProgressAsFloat() const;
 	int64 getUpdateProgress();
 	int64 getDiagonalFactor();
@@ -804,7 +833,7 @@ public:
 
 	virtual void end(ParticleSystem *particleSystem);
 	virtual void logParticleInfo(string info);
-	void setNetworkCRCParticleLogInfo(string networkCRCParticleLogInfo) { this->networkCRCParticleLogInfo = networkCRCParticleLogInfo; }
+	void setNetworkCRCParticleLogInfo(const string &info) { synchLog->networkCRCParticleLogInfo = info; }
 	void clearParticleInfo();
 	void addNetworkCRCDecHp(string info);
 	void clearNetworkCRCDecHpList();
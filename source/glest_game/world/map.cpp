@@ -337,8 +337,9 @@ void SurfaceCell::loadGame(const XmlNode *rootNode, int index, World *world) {
 
 const int Map::cellScale= 2;
 const int Map::mapScale= 2;
+const int Map::objectBucketSize= 16;
 
-Map::Map() {
+Map::Map() : resourceDistanceFieldAccessor(CODE_AT_LINE) {
 	cells= NULL;
 	surfaceCells= NULL;
 	startLocations= NULL;
@@ -355,6 +356,8 @@ Map::Map() {
 	surfaceSize=(surfaceW * surfaceH);
 	maxPlayers=0;
 	maxMapHeight=0;
+	objectBucketW=0;
+	objectBucketH=0;
 }
 
 Map::~Map() {
@@ -573,6 +576,7 @@ void Map::init(Tileset *tileset) {
 	computeInterpolatedHeights();
 	computeNearSubmerged();
 	computeCellColors();
+	computeObjectBuckets();
 }
 
 
@@ -617,16 +621,9 @@ bool Map::isResourceNear(int frameIndex,const Vec2i &pos, const ResourceType *rt
 							if(unit == NULL ||
 								(distanceFromUnit < 0 || unit->getCenteredPos().dist(resPos) <= distanceFromUnit)) {
 
-								bool isResourceNextToUnit = (resourceClickPos == NULL);
-								for(int i1 = -size; isResourceNextToUnit == false && i1 <= size; ++i1) {
-									for(int j1 = -size; j1 <= size; ++j1) {
-										Vec2i resPos1 = Vec2i(pos.x + i1, pos.y + j1);
-										if(resPos == resPos1) {
-											isResourceNextToUnit = true;
-											break;
-										}
-									}
-								}
+								// Within the same square around the unit that the loop above walks
+								bool isResourceNextToUnit = (resourceClickPos == NULL ||
+										(abs(resPos.x - pos.x) <= size && abs(resPos.y - pos.y) <= size));
 								if(isResourceNextToUnit == true) {
 									if(resourceClickPos != NULL) {
 										distanceFromClick = resourceClickPos->dist(resPos);
@@ -1776,6 +1773,113 @@ void Map::computeCellColors(){
 	}
 }
 
+void Map::computeObjectBuckets() {
+	objectBucketW = (surfaceW + objectBucketSize - 1) / objectBucketSize;
+	objectBucketH = (surfaceH + objectBucketSize - 1) / objectBucketSize;
+	objectBuckets.clear();
+	objectBuckets.resize(objectBucketW * objectBucketH);
+
+	for(int j = 0; j < surfaceH; ++j) {
+		for(int i = 0; i < surfaceW; ++i) {
+			if(getSurfaceCell(i, j)->getObject() != NULL) {
+				int bucketIndex = (j / objectBucketSize) * objectBucketW + (i / objectBucketSize);
+				objectBuckets[bucketIndex].push_back(Vec2i(i, j));
+			}
+		}
+	}
+}
+
+void Map::getObjectCellsInRect(const Rect2i &surfaceRect, std::vector<Vec2i> &result) const {
+	if(objectBuckets.empty() == true) {
+		return;
+	}
+
+	int minX = max(min(surfaceRect.p[0].x, surfaceRect.p[1].x), 0);
+	int minY = max(min(surfaceRect.p[0].y, surfaceRect.p[1].y), 0);
+	int maxX = min(max(surfaceRect.p[0].x, surfaceRect.p[1].x), surfaceW - 1);
+	int maxY = min(max(surfaceRect.p[0].y, surfaceRect.p[1].y), surfaceH - 1);
+	if(minX > maxX || minY > maxY) {
+		return;
+	}
+
+	for(int bucketY = minY / objectBucketSize; bucketY <= maxY / objectBucketSize; ++bucketY) {
+		for(int bucketX = minX / objectBucketSize; bucketX <= maxX / objectBucketSize; ++bucketX) {
+			const std::vector<Vec2i> &bucket = objectBuckets[bucketY * objectBucketW + bucketX];
+			for(unsigned int index = 0; index < bucket.size(); ++index) {
+				const Vec2i &pos = bucket[index];
+				if(pos.x >= minX && pos.x <= maxX && pos.y >= minY && pos.y <= maxY &&
+					getSurfaceCell(pos)->getObject() != NULL) {
+					result.push_back(pos);
+				}
+			}
+		}
+	}
+}
+
+bool Map::isDistanceFieldCellBlocked(int surfaceIndex) const {
+	const SurfaceCell *sc = &surfaceCells[surfaceIndex];
+	return sc->isFree() == false || getDeepSubmerged(sc) == true;
+}
+
+//returns the resource of the given type that is the shortest walk away from pos,
+//of those as close the one with the lowest surface cell index
+bool Map::getNearestResource(const Vec2i &pos, const ResourceType *rt, Vec2i &resourcePos, int *distance) {
+	Vec2i surfPos = toSurfCoords(pos);
+	if(rt == NULL || isInsideSurface(surfPos) == false) {
+		return false;
+	}
+
+	MutexSafeWrapper safeMutex(&resourceDistanceFieldAccessor,CODE_AT_LINE);
+	DistanceField &field = resourceDistanceFields[rt];
+	if(field.isBuilt() == false) {
+		std::vector<int> sources;
+		for(int i = 0; i < getSurfaceW() * getSurfaceH(); ++i) {
+			const Resource *r = surfaceCells[i].getResource();
+			if(r != NULL && r->getType() == rt) {
+				sources.push_back(i);
+			}
+		}
+		field.build(this, getSurfaceW(), getSurfaceH(), sources);
+	}
+
+	int surfaceIndex = surfPos.y * getSurfaceW() + surfPos.x;
+	int nearestResource = field.getNearestSource(surfaceIndex);
+	if(nearestResource < 0) {
+		return false;
+	}
+	const Resource *r = surfaceCells[nearestResource].getResource();
+	if(r == NULL || r->getType() != rt) {
+		return false;
+	}
+
+	resourcePos = r->getPos();
+	if(distance != NULL) {
+		*distance = field.getDistance(surfaceIndex);
+	}
+	return true;
+}
+
+// Must be called once the resource object has been deleted
+void Map::onResourceDepleted(const Vec2i &pos, const ResourceType *rt) {
+	Vec2i surfPos = toSurfCoords(pos);
+	if(isInsideSurface(surfPos) == false) {
+		return;
+	}
+
+	int surfaceIndex = surfPos.y * getSurfaceW() + surfPos.x;
+	MutexSafeWrapper safeMutex(&resourceDistanceFieldAccessor,CODE_AT_LINE);
+	for(std::map<const ResourceType *,DistanceField>::iterator iterMap = resourceDistanceFields.begin();
+		iterMap != resourceDistanceFields.end(); ++iterMap) {
+		// The cell is walkable now, which can shorten paths to other resources too
+		if(iterMap->first == rt) {
+			iterMap->second.removeSource(this, surfaceIndex);
+		}
+		else {
+			iterMap->second.openCell(this, surfaceIndex);
+		}
+	}
+}
+
 void Map::saveGame(XmlNode *rootNode) const {
 	std::map<string,string> mapTagReplacements;
 	XmlNode *mapNode = rootNode->addChild("Map");
@@ -1972,6 +2076,11 @@ void Map::loadGame(const XmlNode *rootNode, World *world) {
 
     computeNormals();
 	computeInterpolatedHeights();
+
+	// Rebuilt on first use from the loaded resources, which gives the same
+	// field as one repaired through the game
+	MutexSafeWrapper safeMutex(&resourceDistanceFieldAccessor,CODE_AT_LINE);
+	resourceDistanceFields.clear();
 }
 
 // =====================================================
@@ -28,6 +28,7 @@
 #include "unit_type.h"
 #include "command.h"
 #include "checksum.h"
+#include "distance_field.h"
 #include "leak_dumper.h"
 
 
@@ -40,6 +41,8 @@ using Shared::Graphics::Vec4f;
 using Shared::Graphics::Vec2f;
 using Shared::Graphics::Vec2i;
 using Shared::Graphics::Texture2D;
+using Shared::Util::DistanceField;
+using Shared::Util::DistanceFieldCellsInterface;
 
 class Tileset;
 class Unit;
@@ -208,7 +211,7 @@ public:
 	std::map<Vec2i,std::map<Vec2i,bool> > cachedCanMoveSoonList;
 };
 
-class Map {
+class Map : public DistanceFieldCellsInterface {
 public:
 	static const int cellScale;	//number of cells per surfaceCell
 	static const int mapScale;	//horizontal scale of surface
@@ -233,6 +236,19 @@ private:
 	float maxMapHeight;
 	string mapFile;
 
+	// Surface cells that hold an object, grouped in square buckets so the
+	// renderer only visits the buckets a view overlaps. Objects are only
+	// placed while loading, removed ones are skipped when queried.
+	static const int objectBucketSize;
+	int objectBucketW;
+	int objectBucketH;
+	std::vector<std::vector<Vec2i> > objectBuckets;
+
+	// Walking distance to the nearest resource of each type over the
+	// surface cells, the AI threads query them
+	Mutex resourceDistanceFieldAccessor;
+	std::map<const ResourceType *,DistanceField> resourceDistanceFields;
+
 private:
 	Map(Map&);
 	void operator=(Map&);
@@ -616,6 +632,12 @@ public:
 
 	string getMapFile() const { return mapFile; }
 
+	void getObjectCellsInRect(const Rect2i &surfaceRect, std::vector<Vec2i> &result) const;
+
+	virtual bool isDistanceFieldCellBlocked(int surfaceIndex) const;
+	bool getNearestResource(const Vec2i &pos, const ResourceType *rt, Vec2i &resourcePos, int *distance=NULL);
+	void onResourceDepleted(const Vec2i &pos, const ResourceType *rt);
+
 	void saveGame(XmlNode *rootNode) const;
 	void loadGame(const XmlNode *rootNode,World *world);
 
@@ -624,6 +646,7 @@ private:
 	void smoothSurface(Tileset *tileset);
 	void computeNearSubmerged();
 	void computeCellColors();
+	void computeObjectBuckets();
     void putUnitCellsPrivate(Unit *unit, const Vec2i &pos, const UnitType *ut, bool isMorph, bool threaded);
 };
 
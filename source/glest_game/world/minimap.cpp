@@ -31,6 +31,8 @@ namespace Glest{ namespace Game{
 
 const float Minimap::exploredAlpha= 0.5f;
 
+static const uint8 fowExploredByte= static_cast<uint8>(0.5f * 255.f);
+
 Minimap::Minimap() {
 	fowPixmap0= NULL;
 	fowPixmap1= NULL;
@@ -42,6 +44,8 @@ Minimap::Minimap() {
 	gameSettings= NULL;
 	tex=NULL;
 	fowTex=NULL;
+	fowBlendDone= false;
+	textureRevision= 0;
 }
 
 void Minimap::init(int w, int h, const World *world, bool fogOfWar) {
@@ -71,20 +75,14 @@ void Minimap::init(int w, int h, const World *world, bool fogOfWar) {
 
 		if(SystemFlags::getSystemSettingType(SystemFlags::debugSystem).enabled) SystemFlags::OutputDebug(SystemFlags::debugSystem,"In [%s::%s Line: %d]\n",__FILE__,__FUNCTION__,__LINE__);
 
-		fowPixmap0->setPixels(&f,1);
+		memset(fowPixmap0->getPixels(),0,fowPixmap0->getPixelByteCount());
+		memset(fowPixmap1->getPixels(),0,fowPixmap1->getPixelByteCount());
 		if((this->gameSettings->getFlagTypes1() & ft1_show_map_resources) == ft1_show_map_resources) {
-			f = 0.f;
-			fowPixmap1->setPixels(&f,1);
-			f = 0.5f;
 			for (int y=1; y < scaledH - 1; ++y) {
-				for (int x=1; x < scaledW - 1; ++x) {
-					fowPixmap1->setPixel(x, y, &f,1);
-				}
+				memset(fowPixmap1->getPixels() + y * potW + 1,fowExploredByte,scaledW - 2);
 			}
 		}
-		else {
-			fowPixmap1->setPixels(&f,1);
-		}
+		markFowDirtyAll();
 	}
 
 	if(SystemFlags::getSystemSettingType(SystemFlags::debugSystem).enabled) SystemFlags::OutputDebug(SystemFlags::debugSystem,"In [%s::%s Line: %d]\n",__FILE__,__FUNCTION__,__LINE__);
@@ -139,21 +137,28 @@ void Minimap::incFowTextureAlphaSurface(const Vec2i sPos, float alpha,
 	if(fowPixmap1) {
 		assert(sPos.x < fowPixmap1->getW() && sPos.y < fowPixmap1->getH());
 
-		if(fowPixmap1->getPixelf(sPos.x, sPos.y) < alpha){
-			fowPixmap1->setPixel(sPos.x, sPos.y, alpha);
+		const uint8 alphaByte = static_cast<uint8>(alpha * 255.f);
+		const int index = sPos.y * fowPixmap1->getW() + sPos.x;
+
+		uint8 *pixels1 = fowPixmap1->getPixels();
+		if(pixels1[index] < alphaByte) {
+			pixels1[index] = alphaByte;
 		}
 
 		if(fowPixmap1Copy != NULL && isIncrementalUpdate == true) {
-			if(fowPixmap1Copy->getPixelf(sPos.x, sPos.y) < alpha){
-				fowPixmap1Copy->setPixel(sPos.x, sPos.y, alpha);
+			uint8 *pixels1Copy = fowPixmap1Copy->getPixels();
+			if(pixels1Copy[index] < alphaByte) {
+				pixels1Copy[index] = alphaByte;
 			}
 		}
+		fowWrittenRect.add(sPos.x, sPos.y);
 	}
 }
 
 void Minimap::copyFowTexAlphaSurface() {
 	if(fowPixmap1_default != NULL && fowPixmap1 != NULL) {
 		fowPixmap1_default->copy(fowPixmap1);
+		fowAlphaSurfaceRect= fowWrittenRect;
 	}
 	if(fowPixmap1Copy_default != NULL && fowPixmap1Copy != NULL) {
 		fowPixmap1Copy_default->copy(fowPixmap1Copy);
@@ -162,6 +167,7 @@ void Minimap::copyFowTexAlphaSurface() {
 void Minimap::restoreFowTexAlphaSurface() {
 	if(fowPixmap1 != NULL && fowPixmap1_default != NULL) {
 		fowPixmap1->copy(fowPixmap1_default);
+		fowWrittenRect.add(fowAlphaSurfaceRect);
 	}
 	if(fowPixmap1Copy != NULL && fowPixmap1Copy_default != NULL) {
 		fowPixmap1Copy->copy(fowPixmap1Copy_default);
@@ -171,6 +177,7 @@ void Minimap::restoreFowTexAlphaSurface() {
 void Minimap::setFogOfWar(bool value) {
 	fogOfWar = value;
 	resetFowTex();
+	markFowDirtyAll();
 }
 
 void Minimap::copyFowTex() {
@@ -188,6 +195,7 @@ void Minimap::restoreFowTex() {
 	if(fowPixmap1 != NULL && fowPixmap1Copy != NULL) {
 		fowPixmap1->copy(fowPixmap1Copy);
 	}
+	markFowDirtyAll();
 }
 
 void Minimap::resetFowTex() {
@@ -196,104 +204,148 @@ void Minimap::resetFowTex() {
 		fowPixmap0= fowPixmap1;
 		fowPixmap1= tmpPixmap;
 
+		// Unless the last blend reached fowPixmap1, whatever it covered
+		// may still lag behind what is now fowPixmap0
+		if(fowBlendDone == true) {
+			fowBlendCarryRect.clear();
+		}
+		else {
+			fowBlendCarryRect.add(fowWrittenRect);
+			fowBlendCarryRect.add(fowWrittenRectPrevious[0]);
+			fowBlendCarryRect.add(fowWrittenRectPrevious[1]);
+		}
+		fowBlendDone= false;
+		fowWrittenRectPrevious[1]= fowWrittenRectPrevious[0];
+		fowWrittenRectPrevious[0]= fowWrittenRect;
+		fowWrittenRect.clear();
+
 		// Could turn off ONLY fog of war by setting below to false
 		bool overridefogOfWarValue = fogOfWar;
 
-		for(int indexPixelWidth = 0;
-				indexPixelWidth < fowTex->getPixmap()->getW();
-				++indexPixelWidth){
-			for(int indexPixelHeight = 0;
-					indexPixelHeight < fowTex->getPixmap()->getH();
-					++indexPixelHeight){
-				if ((fogOfWar == false && overridefogOfWarValue == false)) {
-					//(gameSettings->getFlagTypes1() & ft1_show_map_resources) != ft1_show_map_resources) {
-					//printf("Line: %d\n",__LINE__);
-
-					float p0 = fowPixmap0->getPixelf(indexPixelWidth, indexPixelHeight);
-					float p1 = fowPixmap1->getPixelf(indexPixelWidth, indexPixelHeight);
-					if (p0 > p1) {
-						fowPixmap1->setPixel(indexPixelWidth, indexPixelHeight, p0);
-					}
-					else {
-						fowPixmap1->setPixel(indexPixelWidth, indexPixelHeight, p1);
-					}
-				}
-				else if((fogOfWar && overridefogOfWarValue) ||
-					(gameSettings->getFlagTypes1() & ft1_show_map_resources) == ft1_show_map_resources) {
-					//printf("Line: %d\n",__LINE__);
-
-					float p0= fowPixmap0->getPixelf(indexPixelWidth, indexPixelHeight);
-					float p1= fowPixmap1->getPixelf(indexPixelWidth, indexPixelHeight);
-
-					if(p1 > exploredAlpha) {
-						fowPixmap1->setPixel(indexPixelWidth, indexPixelHeight, exploredAlpha);
-					}
-					if(p0 > p1) {
-						fowPixmap1->setPixel(indexPixelWidth, indexPixelHeight, p0);
-					}
-				}
-				else {
-					//printf("Line: %d\n",__LINE__);
-					fowPixmap1->setPixel(indexPixelWidth, indexPixelHeight, 1.f);
-				}
-			}
+		uint8 *pixels1 = fowPixmap1->getPixels();
+		const uint8 *pixels0 = fowPixmap0->getPixels();
+		std::size_t pixelCount = fowPixmap1->getPixelByteCount();
+
+		if ((fogOfWar == false && overridefogOfWarValue == false)) {
+			pixelsMax(pixels1, pixels0, pixelCount);
 		}
+		else if((fogOfWar && overridefogOfWarValue) ||
+			(gameSettings->getFlagTypes1() & ft1_show_map_resources) == ft1_show_map_resources) {
+			pixelsMaxOrLimit(pixels1, pixels0, fowExploredByte, pixelCount);
+		}
+		else {
+			memset(pixels1, 255, pixelCount);
+			markFowDirtyAll();
+		}
+	}
+}
+
+void Minimap::markFowDirtyAll() {
+	if(fowPixmap1 != NULL) {
+		fowWrittenRect.setAll(fowPixmap1->getW(), fowPixmap1->getH());
+		fowWrittenRectPrevious[0]= fowWrittenRect;
+		fowWrittenRectPrevious[1]= fowWrittenRect;
+		fowBlendCarryRect= fowWrittenRect;
+		fowBlendDone= false;
 	}
 }
 
 void Minimap::updateFowTex(float t) {
 	if(fowTex && fowPixmap0 && fowPixmap1) {
-		for(int indexPixelWidth = 0;
-				indexPixelWidth < fowPixmap0->getW();
-				++indexPixelWidth){
-			for(int indexPixelHeight = 0;
-					indexPixelHeight < fowPixmap0->getH();
-					++indexPixelHeight){
-				float p1 = fowPixmap1->getPixelf(indexPixelWidth, indexPixelHeight);
-				float p2 = fowTex->getPixmap()->getPixelf(indexPixelWidth, indexPixelHeight);
-				if(p1 != p2) {
-					float p0 = fowPixmap0->getPixelf(indexPixelWidth, indexPixelHeight);
-					fowTex->getPixmap()->setPixel(indexPixelWidth, indexPixelHeight, p0+(t*(p1-p0)));
-				}
+		PixmapRect rect= fowBlendCarryRect;
+		rect.add(fowWrittenRect);
+		rect.add(fowWrittenRectPrevious[0]);
+		rect.add(fowWrittenRectPrevious[1]);
+
+		const int tFixed = static_cast<int>(clamp(t, 0.f, 1.f) * 256.f);
+		if(rect.isEmpty() == false) {
+			const int w = fowPixmap1->getW();
+			const int count = rect.maxX - rect.minX + 1;
+			uint8 *pixelsTex = fowTex->getPixmap()->getPixels();
+			for(int y = rect.minY; y <= rect.maxY; ++y) {
+				std::size_t offset = y * w + rect.minX;
+				pixelsBlend(pixelsTex + offset, fowPixmap0->getPixels() + offset,
+						fowPixmap1->getPixels() + offset, count, tFixed);
 			}
 		}
+		if(tFixed >= 256) {
+			fowBlendDone= true;
+		}
 	}
 }
 
 // ==================== PRIVATE ====================
 
 void Minimap::computeTexture(const World *world) {
+	if(tex) {
+		const Pixmap2D *pixmap= tex->getPixmap();
+		std::size_t texelCount= pixmap->getW() * pixmap->getH();
+		textureObjectTypes.assign(texelCount,(const ObjectType *) NULL);
+		textureHeights.assign(texelCount,0.f);
+
+		for(int j=0; j < pixmap->getH(); ++j){
+			for(int i=0; i < pixmap->getW(); ++i){
+				computeTextureCell(world, i, j);
+			}
+		}
+	}
+}
 
-	Vec3f color;
+void Minimap::computeTextureCell(const World *world, int i, int j) {
 	const Map *map= world->getMap();
+	SurfaceCell *sc= map->getSurfaceCell(i, j);
+	Pixmap2D *pixmap= tex->getPixmap();
 
-	if(tex) {
-		tex->getPixmap()->setPixels(Vec4f(1.f, 1.f, 1.f, 0.1f).ptr(),tex->getPixmap()->getComponents());
-
-		for(int j=0; j<tex->getPixmap()->getH(); ++j){
-			for(int i=0; i<tex->getPixmap()->getW(); ++i){
-				SurfaceCell *sc= map->getSurfaceCell(i, j);
-
-				if(sc->getObject()==NULL || sc->getObject()->getType()==NULL){
-					const Pixmap2D *p= world->getTileset()->getSurfPixmap(sc->getSurfaceType(), 0);
-					color= p->getPixel3f(p->getW()/2, p->getH()/2);
-					color= color * static_cast<float>(sc->getVertex().y/6.f);
-
-					if(sc->getVertex().y<= world->getMap()->getWaterLevel()){
-						color+= Vec3f(0.5f, 0.5f, 1.0f);
-					}
-
-					if(color.x>1.f) color.x=1.f;
-					if(color.y>1.f) color.y=1.f;
-					if(color.z>1.f) color.z=1.f;
-				}
-				else{
-					color= sc->getObject()->getType()->getColor();
-				}
-				tex->getPixmap()->setPixel(i, j, color);
+	const ObjectType *objectType= (sc->getObject() != NULL ? sc->getObject()->getType() : NULL);
+	std::size_t texelIndex= j * pixmap->getW() + i;
+	textureObjectTypes[texelIndex]= objectType;
+	textureHeights[texelIndex]= sc->getVertex().y;
+
+	Vec3f color;
+	if(objectType == NULL){
+		const Pixmap2D *p= world->getTileset()->getSurfPixmap(sc->getSurfaceType(), 0);
+		color= p->getPixel3f(p->getW()/2, p->getH()/2);
+		color= color * static_cast<float>(sc->getVertex().y/6.f);
+
+		if(sc->getVertex().y<= map->getWaterLevel()){
+			color+= Vec3f(0.5f, 0.5f, 1.0f);
+		}
+
+		if(color.x>1.f) color.x=1.f;
+		if(color.y>1.f) color.y=1.f;
+		if(color.z>1.f) color.z=1.f;
+	}
+	else{
+		color= objectType->getColor();
+	}
+	pixmap->setPixel(i, j, color);
+}
+
+void Minimap::updateTexture(const World *world) {
+	if(tex == NULL || textureObjectTypes.empty() == true) {
+		return;
+	}
+
+	const Map *map= world->getMap();
+	const Pixmap2D *pixmap= tex->getPixmap();
+	bool changed= false;
+	for(int j=0; j < pixmap->getH(); ++j){
+		for(int i=0; i < pixmap->getW(); ++i){
+			const SurfaceCell *sc= map->getSurfaceCell(i, j);
+			const ObjectType *objectType= (sc->getObject() != NULL ? sc->getObject()->getType() : NULL);
+			std::size_t texelIndex= j * pixmap->getW() + i;
+			if(textureObjectTypes[texelIndex] != objectType ||
+				textureHeights[texelIndex] != sc->getVertex().y) {
+				computeTextureCell(world, i, j);
+				changed= true;
 			}
 		}
 	}
+
+	// The renderer re-uploads the texture when the revision moves
+	if(changed == true) {
+		textureRevision++;
+	}
 }
 
 void Minimap::saveGame(XmlNode *rootNode) {
@@ -322,6 +374,7 @@ void Minimap::loadGame(const XmlNode *rootNode) {
 			int pixelIndex = fowPixmap1Node->getAttribute("index")->getIntValue();
 			fowPixmap1->getPixels()[pixelIndex] = fowPixmap1Node->getAttribute("pixel")->getIntValue();
 		}
+		markFowDirtyAll();
 	}
 }
 
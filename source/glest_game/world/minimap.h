@@ -17,6 +17,7 @@
     #include <winsock.h>
 #endif
 
+#include <vector>
 #include "pixmap.h"
 #include "texture.h"
 #include "xml_parser.h"
@@ -28,11 +29,13 @@ using Shared::Graphics::Vec4f;
 using Shared::Graphics::Vec3f;
 using Shared::Graphics::Vec2i;
 using Shared::Graphics::Pixmap2D;
+using Shared::Graphics::PixmapRect;
 using Shared::Graphics::Texture2D;
 using Shared::Xml::XmlNode;
 
 class World;
 class GameSettings;
+class ObjectType;
 
 enum ExplorationState{
     esNotExplored,
@@ -60,6 +63,23 @@ private:
 	bool fogOfWar;
 	const GameSettings *gameSettings;
 
+	// Texels of fowPixmap1 written by computeFow in this pass and the two
+	// before it. A texel settles two resetFowTex calls after its last
+	// write, so outside these fowPixmap0 and fowPixmap1 agree
+	PixmapRect fowWrittenRect;
+	PixmapRect fowWrittenRectPrevious[2];
+	// Texels of fowTex that may still lag behind fowPixmap0
+	PixmapRect fowBlendCarryRect;
+	bool fowBlendDone;
+	// What was written when the alpha surface was cached
+	PixmapRect fowAlphaSurfaceRect;
+
+	// What each terrain texel was last computed from, so updateTexture
+	// only recolors cells whose object or height changed
+	std::vector<const ObjectType *> textureObjectTypes;
+	std::vector<float> textureHeights;
+	int textureRevision;
+
 private:
 	static const float exploredAlpha;
 
@@ -70,11 +90,13 @@ public:
 
 	const Texture2D *getFowTexture() const	{return fowTex;}
 	const Texture2D *getTexture() const		{return tex;}
+	int getTextureRevision() const			{return textureRevision;}
 
 	void incFowTextureAlphaSurface(const Vec2i sPos, float alpha, bool isIncrementalUpdate=false);
 	void resetFowTex();
 	void updateFowTex(float t);
 	void setFogOfWar(bool value);
+	void updateTexture(const World *world);
 
 	void copyFowTex();
 	void restoreFowTex();
@@ -87,6 +109,8 @@ public:
 
 private:
 	void computeTexture(const World *world);
+	void computeTextureCell(const World *world, int i, int j);
+	void markFowDirtyAll();
 };
 
 }}//end namespace
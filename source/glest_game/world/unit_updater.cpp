@@ -99,7 +99,7 @@ UnitUpdater::~UnitUpdater() {
 	delete pathFinder;
 	pathFinder = NULL;
 
-	MutexSafeWrapper safeMutex(mutexAttackWarnings,string(__FILE__) + "_" + intToStr(__LINE__));
+	MutexSafeWrapper safeMutex(mutexAttackWarnings,CODE_AT_LINE);
 	while(attackWarnings.empty() == false) {
 		AttackWarningData* awd = attackWarnings.back();
 		attackWarnings.pop_back();
@@ -314,7 +314,7 @@ bool UnitUpdater::updateUnit(Unit *unit) {
 
 			//play water sound
 			if(map->getCell(unit->getPos())->getHeight() < map->getWaterLevel() && unit->getCurrField() == fLand) {
-				if(Config::getInstance().getBool("DisableWaterSounds","false") == false) {
+				if(configDisableWaterSounds.get() == false) {
 					soundRenderer.playFx(
 						CoreData::getInstance().getWaterSound(),
 						unit->getCurrMidHeightVector(),
@@ -1015,7 +1015,9 @@ void UnitUpdater::unitBeingAttacked(std::pair<bool,Unit *> &result, const Unit *
 		distToUnit = *currentDistToUnit;
 	}
 	if(ast != NULL) {
-		vector<Unit*> enemies = enemyUnitsOnRange(unit,ast);
+		ScratchVector<Unit *> enemyList(unitListScratchPool);
+		vector<Unit*> &enemies = enemyList.get();
+		enemyUnitsOnRange(unit,ast,enemies);
 		for(unsigned j = 0; j < enemies.size(); ++j) {
 			Unit *enemy = enemies[j];
 
@@ -1828,8 +1830,9 @@ void UnitUpdater::updateHarvest(Unit *unit, int frameIndex) {
 
 							//if resource exausted, then delete it and stop
 							if (sc->decAmount(1)) {
-								//const ResourceType *rt = r->getType();
+								const ResourceType *depletedType = sc->getResource()->getType();
 								sc->deleteResource();
+								map->onResourceDepleted(unitTargetPos, depletedType);
 								world->removeResourceTargetFromCache(unitTargetPos);
 
 								switch(this->game->getGameSettings()->getPathFinderType()) {
@@ -2847,7 +2850,7 @@ bool UnitUpdater::findCachedCellsEnemies(Vec2i center, int range, int size, vect
 										 const AttackSkillType *ast, const Unit *unit,
 										 const Unit *commandTarget) {
 	bool result = false;
-	MutexSafeWrapper safeMutex(mutexUnitRangeCellsLookupItemCache,string(__FILE__) + "_" + intToStr(__LINE__));
+	MutexSafeWrapper safeMutex(mutexUnitRangeCellsLookupItemCache,CODE_AT_LINE);
 	std::map<Vec2i, std::map<int, std::map<int, UnitRangeCellsLookupItem > > >::iterator iterFind = UnitRangeCellsLookupItemCache.find(center);
 
 	if(iterFind != UnitRangeCellsLookupItemCache.end()) {
@@ -2931,8 +2934,8 @@ bool UnitUpdater::unitOnRange(Unit *unit, int range, Unit **rangedPtr,
 	bool result=false;
 
 	try {
-	vector<Unit*> enemies;
-    enemies.reserve(100);
+	ScratchVector<Unit *> enemyList(unitListScratchPool);
+	vector<Unit*> &enemies = enemyList.get();
 
 	//we check command target
 	const Unit *commandTarget = NULL;
@@ -2973,7 +2976,7 @@ bool UnitUpdater::unitOnRange(Unit *unit, int range, Unit **rangedPtr,
 
 		// Ok update our caches with the latest info
 		if(cacheItem.rangeCellList.empty() == false) {
-			MutexSafeWrapper safeMutex(mutexUnitRangeCellsLookupItemCache,string(__FILE__) + "_" + intToStr(__LINE__));
+			MutexSafeWrapper safeMutex(mutexUnitRangeCellsLookupItemCache,CODE_AT_LINE);
 
 			UnitRangeCellsLookupItemCache[center][size][range] = cacheItem;
 		}
@@ -3075,7 +3078,7 @@ bool UnitUpdater::unitOnRange(Unit *unit, int range, Unit **rangedPtr,
 			float nearestDistance		= 0.f;
 
 
-			MutexSafeWrapper safeMutex(mutexAttackWarnings,string(__FILE__) + "_" + intToStr(__LINE__));
+			MutexSafeWrapper safeMutex(mutexAttackWarnings,CODE_AT_LINE);
 			for(int i = (int)attackWarnings.size() - 1; i >= 0; --i) {
 				if(world->getFrameCount() - attackWarnings[i]->lastFrameCount > 200) { //after 200 frames attack break we warn again
 					AttackWarningData *toDelete =attackWarnings[i];
@@ -3124,7 +3127,7 @@ bool UnitUpdater::unitOnRange(Unit *unit, int range, Unit **rangedPtr,
 	    		awd->attackPosition.x=enemyFloatCenter.x;
 	    		awd->attackPosition.y=enemyFloatCenter.y;
 
-				MutexSafeWrapper safeMutex(mutexAttackWarnings,string(__FILE__) + "_" + intToStr(__LINE__));
+				MutexSafeWrapper safeMutex(mutexAttackWarnings,CODE_AT_LINE);
 	    		attackWarnings.push_back(awd);
 
 	    		if(world->getAttackWarningsEnabled() == true) {
@@ -3157,10 +3160,7 @@ bool UnitUpdater::unitOnRange(Unit *unit, int range, Unit **rangedPtr,
 
 
 //if the unit has any enemy on range
-vector<Unit*> UnitUpdater::enemyUnitsOnRange(const Unit *unit,const AttackSkillType *ast) {
-	vector<Unit*> enemies;
-	enemies.reserve(100);
-
+void UnitUpdater::enemyUnitsOnRange(const Unit *unit,const AttackSkillType *ast, vector<Unit*> &enemies) {
 	try {
 
 
@@ -3208,7 +3208,7 @@ vector<Unit*> UnitUpdater::enemyUnitsOnRange(const Unit *unit,const AttackSkillT
 
 		// Ok update our caches with the latest info
 		if(cacheItem.rangeCellList.empty() == false) {
-			MutexSafeWrapper safeMutex(mutexUnitRangeCellsLookupItemCache,string(__FILE__) + "_" + intToStr(__LINE__));
+			MutexSafeWrapper safeMutex(mutexUnitRangeCellsLookupItemCache,CODE_AT_LINE);
 
 			UnitRangeCellsLookupItemCache[center][size][range] = cacheItem;
 		}
@@ -3229,8 +3229,6 @@ vector<Unit*> UnitUpdater::enemyUnitsOnRange(const Unit *unit,const AttackSkillT
 		SystemFlags::OutputDebug(SystemFlags::debugError,szBuf);
 		throw megaglest_runtime_error(szBuf);
 	}
-
-	return enemies;
 }
 
 
@@ -3264,9 +3262,8 @@ void UnitUpdater::findUnitsForCell(Cell *cell, vector<Unit*> &units) {
 	}
 }
 
-vector<Unit*> UnitUpdater::findUnitsInRange(const Unit *unit, int radius) {
+void UnitUpdater::findUnitsInRange(const Unit *unit, int radius, vector<Unit*> &units) {
 	int range = radius;
-	vector<Unit*> units;
 
 	//aux vars
 	int size 			= unit->getType()->getSize();
@@ -3288,8 +3285,6 @@ vector<Unit*> UnitUpdater::findUnitsInRange(const Unit *unit, int radius) {
 			}
 		}
 	}
-
-	return units;
 }
 
 string UnitUpdater::getUnitRangeCellsLookupItemCacheStats() {
@@ -3300,7 +3295,7 @@ string UnitUpdater::getUnitRangeCellsLookupItemCacheStats() {
 	int rangeCount = 0;
 	int rangeCountCellCount = 0;
 
-	MutexSafeWrapper safeMutex(mutexUnitRangeCellsLookupItemCache,string(__FILE__) + "_" + intToStr(__LINE__));
+	MutexSafeWrapper safeMutex(mutexUnitRangeCellsLookupItemCache,CODE_AT_LINE);
 	for(std::map<Vec2i, std::map<int, std::map<int, UnitRangeCellsLookupItem > > >::iterator iterMap1 = UnitRangeCellsLookupItemCache.begin();
 		iterMap1 != UnitRangeCellsLookupItemCache.end(); ++iterMap1) {
 		posCount++;
@@ -21,10 +21,13 @@
 #include "particle.h"
 #include "randomgen.h"
 #include "command.h"
+#include "object_pool.h"
 #include "leak_dumper.h"
 
 using Shared::Graphics::ParticleObserver;
 using Shared::Util::RandomGen;
+using Shared::Util::ScratchVectorPool;
+using Shared::Util::ScratchVector;
 
 namespace Glest{ namespace Game{
 
@@ -84,6 +87,10 @@ private:
 	float attackWarnRange;
 	AttackWarnings attackWarnings;
 
+	// Reusable result lists for range queries, shared by the main and
+	// faction worker threads
+	ScratchVectorPool<Unit *> unitListScratchPool;
+
 	Mutex *mutexUnitRangeCellsLookupItemCache;
 	std::map<Vec2i, std::map<int, std::map<int, UnitRangeCellsLookupItem > > > UnitRangeCellsLookupItemCache;
 	//std::map<int,ExploredCellsLookupKey> ExploredCellsLookupItemCacheTimer;
@@ -125,10 +132,11 @@ public:
 	inline unsigned int getAttackWarningCount() const { return (unsigned int)attackWarnings.size(); }
 	std::pair<bool,Unit *> unitBeingAttacked(const Unit *unit);
 	void unitBeingAttacked(std::pair<bool,Unit *> &result, const Unit *unit, const AttackSkillType *ast,float *currentDistToUnit=NULL);
-	vector<Unit*> enemyUnitsOnRange(const Unit *unit,const AttackSkillType *ast);
+	void enemyUnitsOnRange(const Unit *unit,const AttackSkillType *ast, vector<Unit*> &enemies);
 	void findEnemiesForCell(const Vec2i pos, int size, int sightRange, const Faction *faction, vector<Unit*> &enemies, bool attackersOnly) const;
 
-	vector<Unit*> findUnitsInRange(const Unit *unit, int radius);
+	void findUnitsInRange(const Unit *unit, int radius, vector<Unit*> &units);
+	inline ScratchVectorPool<Unit *> & getUnitListScratchPool() { return unitListScratchPool; }
 
 	string getUnitRangeCellsLookupItemCacheStats();
 
@@ -573,7 +573,7 @@ void World::updateAllTilesetObjects() {
 }
 
 void World::updateAllFactionUnits() {
-	bool showPerfStats = Config::getInstance().getBool("ShowPerfStats","false");
+	bool showPerfStats = configShowPerfStats.get();
 	Chrono chronoPerf;
 	if(showPerfStats) chronoPerf.start();
 	char perfBuf[8096]="";
@@ -616,7 +616,7 @@ void World::updateAllFactionUnits() {
 	Chrono chrono;
 	chrono.start();
 
-	const bool newThreadManager = Config::getInstance().getBool("EnableNewThreadManager","false");
+	const bool newThreadManager = configEnableNewThreadManager.get();
 	if(newThreadManager == true) {
 		masterController.signalSlaves(&frameCount);
 		bool slavesCompleted = masterController.waitTillSlavesTrigger(20000);
@@ -736,7 +736,7 @@ void World::updateAllFactionUnits() {
 		totalUnitsProcessed += unitCountUpdated;
 
 		if(showPerfStats) {
-			sprintf(perfBuf,"In [%s::%s] Line: %d took msecs: " MG_I64_SPECIFIER " faction: %d / %d unitCount = %d unitCountUpdated = %d unitCountStuck = %d\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__,chronoPerf.getMillis(),i+1,factionCount,unitCount,unitCountUpdated,unitCountStuck);
+			sprintf(perfBuf,"In [%s::%s] Line: %d took msecs: " MG_I64_SPECIFIER " faction: %d / %d unitCount = %d unitCountUpdated = %d unitCountStuck = %d skippedUnitUpdates = " MG_I64_SPECIFIER "\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__,chronoPerf.getMillis(),i+1,factionCount,unitCount,unitCountUpdated,unitCountStuck,faction->getSkippedUnitUpdateCount());
 			perfList.push_back(perfBuf);
 
 			for(std::map<CommandClass,int>::iterator iterMap = mapCommandCount.begin();
@@ -826,7 +826,7 @@ void World::update() {
 
 	if(SystemFlags::getSystemSettingType(SystemFlags::debugSystem).enabled) SystemFlags::OutputDebug(SystemFlags::debugSystem,"In [%s::%s Line: %d]\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__);
 
-	bool showPerfStats = Config::getInstance().getBool("ShowPerfStats","false");
+	bool showPerfStats = configShowPerfStats.get();
 	Chrono chronoPerf;
 	char perfBuf[8096]="";
 	std::vector<string> perfList;
@@ -964,7 +964,7 @@ bool World::canTickWorld() const {
 }
 
 void World::tick() {
-	bool showPerfStats = Config::getInstance().getBool("ShowPerfStats","false");
+	bool showPerfStats = configShowPerfStats.get();
 	Chrono chronoPerf;
 	char perfBuf[8096]="";
 	std::vector<string> perfList;
@@ -995,6 +995,13 @@ void World::tick() {
 		if(this->game) this->game->addPerformanceCount("minimap.updateFowTex",chronoGamePerformanceCounts.getMillis());
 	}
 
+	// Recolor minimap texels for harvested or placed objects
+	if(this->game) chronoGamePerformanceCounts.start();
+
+	minimap.updateTexture(this);
+
+	if(this->game) this->game->addPerformanceCount("minimap.updateTexture",chronoGamePerformanceCounts.getMillis());
+
 	if(showPerfStats) {
 		sprintf(perfBuf,"In [%s::%s] Line: %d took msecs: " MG_I64_SPECIFIER "\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__,chronoPerf.getMillis());
 		perfList.push_back(perfBuf);
@@ -1027,7 +1034,8 @@ void World::tick() {
 	//compute resources balance
 	if(this->game) chronoGamePerformanceCounts.start();
 
-	std::map<const UnitType *, std::map<const ResourceType *, const Resource *> > resourceCostCache;
+	// Factions keep running totals of the consumable costs of their
+	// operative units so this no longer depends on the unit count
 	factionCount = getFactionCount();
 	for(int factionIndex = 0; factionIndex < factionCount; ++factionIndex) {
 		Faction *faction = getFaction(factionIndex);
@@ -1039,33 +1047,7 @@ void World::tick() {
 
 			//if consumable
 			if(rt != NULL && rt->getClass() == rcConsumable) {
-
-				int balance= 0;
-				for(int unitIndex = 0;
-						unitIndex < faction->getUnitCount(); ++unitIndex) {
-
-					//if unit operative and has this cost
-					const Unit *unit = faction->getUnit(unitIndex);
-					if(unit != NULL && unit->isOperative()) {
-
-						const UnitType *ut = unit->getType();
-						const Resource *resource = NULL;
-						std::map<const UnitType *, std::map<const ResourceType *, const Resource *> >::iterator iterFind = resourceCostCache.find(ut);
-						if(iterFind != resourceCostCache.end() &&
-								iterFind->second.find(rt) != iterFind->second.end()) {
-
-							resource = iterFind->second.find(rt)->second;
-						}
-						else {
-							resource = ut->getCost(rt);
-							resourceCostCache[ut][rt] = resource;
-						}
-						if(resource != NULL) {
-							balance -= resource->getAmount();
-						}
-					}
-				}
-				faction->setResourceBalance(rt, balance);
+				faction->setResourceBalance(rt, faction->getConsumableBalance(rt));
 			}
 		}
 	}
@@ -1214,8 +1196,11 @@ Unit *World::nearestStore(const Vec2i &pos, int factionIndex, const ResourceType
     	throw megaglest_runtime_error("factionIndex >= getFactionCount()");
     }
 
-    for(int i=0; i < getFaction(factionIndex)->getUnitCount(); ++i) {
-		Unit *u= getFaction(factionIndex)->getUnit(i);
+    // Only units that can store something, in unit list order so ties
+    // resolve the same way as a scan over every unit
+    Faction *faction = getFaction(factionIndex);
+    for(int i=0; i < faction->getStoreUnitCount(); ++i) {
+		Unit *u= faction->getStoreUnit(i);
 		if(u != NULL) {
 			float tmpDist= u->getPos().dist(pos);
 			if(tmpDist < currDist &&  u->getType() != NULL && u->getType()->getStore(rt) > 0 && u->isOperative()) {
@@ -2081,7 +2066,7 @@ void World::initFactionTypes(GameSettings *gs) {
 		}
 	}
 
-	if(Config::getInstance().getBool("EnableNewThreadManager","false") == true) {
+	if(configEnableNewThreadManager.get() == true) {
 		std::vector<SlaveThreadControllerInterface *> slaveThreadList;
 		for(unsigned int i = 0; i < factions.size(); ++i) {
 			Faction *faction = factions[i];
@@ -2102,7 +2087,7 @@ void World::initFactionTypes(GameSettings *gs) {
 
 		//printf("**LOAD World thisFactionIndex = %d\n",thisFactionIndex);
 
-		MutexSafeWrapper safeMutex(mutexFactionNextUnitId,string(__FILE__) + "_" + intToStr(__LINE__));
+		MutexSafeWrapper safeMutex(mutexFactionNextUnitId,CODE_AT_LINE);
 	//	std::map<int,int> mapFactionNextUnitId;
 //		for(std::map<int,int>::iterator iterMap = mapFactionNextUnitId.begin();
 //				iterMap != mapFactionNextUnitId.end(); ++iterMap) {
@@ -2727,7 +2712,7 @@ const GameSettings * World::getGameSettings() const {
 // Calculates the unit unit ID for each faction
 //
 int World::getNextUnitId(Faction *faction)	{
-	MutexSafeWrapper safeMutex(mutexFactionNextUnitId,string(__FILE__) + "_" + intToStr(__LINE__));
+	MutexSafeWrapper safeMutex(mutexFactionNextUnitId,CODE_AT_LINE);
 	if(mapFactionNextUnitId.find(faction->getIndex()) == mapFactionNextUnitId.end()) {
 		mapFactionNextUnitId[faction->getIndex()] = faction->getIndex() * 100000;
 	}
@@ -3015,6 +3000,12 @@ std::string World::DumpWorldToLog(bool consoleBasicInfoOnly) const {
 			}
 		}
 
+		if(MutexContentionProfiler::isEnabled() == true) {
+			logFile << MutexContentionProfiler::getStats() << std::endl;
+		}
+
+		logFile << ObjectPool::getAllStats() << std::endl;
+
 		logFile.close();
 #if defined(WIN32) && !defined(__MINGW32__)
 		if(fp) {
@@ -3075,7 +3066,7 @@ void World::saveGame(XmlNode *rootNode) {
 	worldNode->addAttribute("frameCount",intToStr(frameCount), mapTagReplacements);
 //	//int nextUnitId;
 //	Mutex mutexFactionNextUnitId;
-	MutexSafeWrapper safeMutex(mutexFactionNextUnitId,string(__FILE__) + "_" + intToStr(__LINE__));
+	MutexSafeWrapper safeMutex(mutexFactionNextUnitId,CODE_AT_LINE);
 //	std::map<int,int> mapFactionNextUnitId;
 	for(std::map<int,int>::iterator iterMap = mapFactionNextUnitId.begin();
 			iterMap != mapFactionNextUnitId.end(); ++iterMap) {
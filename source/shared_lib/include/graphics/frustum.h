@@ -0,0 +1,98 @@
+// ==============================================================
+//	This file is part of Glest Shared Library (www.glest.org)
+//
+//	Copyright (C) 2001-2008 Martiño Figueroa
+//
+//	You can redistribute this code and/or modify it under
+//	the terms of the GNU General Public License as published
+//	by the Free Software Foundation; either version 2 of the
+//	License, or (at your option) any later version
+// ==============================================================
+
+#ifndef _SHARED_GRAPHICS_FRUSTUM_H_
+#define _SHARED_GRAPHICS_FRUSTUM_H_
+
+#include <string>
+#include <vector>
+#include "leak_dumper.h"
+
+using std::string;
+
+namespace Shared{ namespace Graphics{
+
+// =====================================================
+//	class Frustum
+//
+///	The six clip planes of a view, stored in one flat array. Built from
+/// the projection and modelview matrices so it can be used without a
+/// GL context.
+// =====================================================
+
+class Frustum {
+public:
+	static const int planeCount = 6;
+
+private:
+	// a, b, c, d for the right, left, bottom, top, far and near planes
+	float planes[planeCount * 4];
+	// |a| + |b| + |c| of each plane, scaled by a cube's half size this is
+	// how far its farthest corner reaches past the centre along the normal
+	float planeExtents[planeCount];
+
+	void normalizePlane(int planeIndex);
+
+public:
+	Frustum();
+
+	void clear();
+	void extract(const float *proj, const float *modl);
+
+	inline const float *getPlane(int planeIndex) const { return &planes[planeIndex * 4]; }
+
+	bool cubeInFrustum(float x, float y, float z, float size) const;
+	int cubesInFrustum(const float *x, const float *y, const float *z,
+					   const float *sizes, int count, unsigned char *result) const;
+
+	bool operator==(const Frustum &obj) const;
+	bool operator!=(const Frustum &obj) const { return !(*this == obj); }
+
+	string toString() const;
+};
+
+// =====================================================
+//	class FrustumCullBatch
+//
+///	Collects cube bounds in contiguous arrays and tests them all against
+/// a frustum in one pass. The arrays keep their capacity between frames.
+// =====================================================
+
+class FrustumCullBatch {
+private:
+	std::vector<float> x;
+	std::vector<float> y;
+	std::vector<float> z;
+	std::vector<float> sizes;
+	std::vector<unsigned char> visible;
+	int visibleCount;
+
+public:
+	FrustumCullBatch() : visibleCount(0) {}
+
+	void clear();
+	inline void add(float posX, float posY, float posZ, float size) {
+		x.push_back(posX);
+		y.push_back(posY);
+		z.push_back(posZ);
+		sizes.push_back(size);
+	}
+
+	int cull(const Frustum &frustum);
+
+	inline int size() const							{ return (int)x.size(); }
+	inline int getVisibleCount() const				{ return visibleCount; }
+	inline bool isVisible(int index) const			{ return visible[index] != 0; }
+};
+
+}}//end namespace
+
+#endif
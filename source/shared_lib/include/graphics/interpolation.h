@@ -50,6 +50,35 @@ public:
 	void updateNormals(float t, bool cycle);
 };
 
+// Progress (0 to 1) drawn between world frames: the latest progress carried
+// on at the speed of the last frame for interpolation frames, never past 1
+float extrapolateProgress(float progress, float lastProgress, float interpolation);
+
+// =====================================================
+//	class FrameInterpolation
+//
+///	How far into the next world frame the world is since it last
+///	advanced, timed by how long world frames actually took rather than by
+///	program updates, some of which advance no frame or several
+// =====================================================
+
+class FrameInterpolation {
+private:
+	int lastFrameCount;
+	int lastAdvanceFrames;
+	int64 lastAdvanceMicros;
+	double microsPerFrame;
+
+public:
+	FrameInterpolation();
+
+	void reset(double nominalMicrosPerFrame);
+	void update(int frameCount, int64 nowMicros);
+	float get(int64 nowMicros) const;
+
+	double getMicrosPerFrame() const	{ return microsPerFrame; }
+};
+
 }}//end namespace
 
 #endif
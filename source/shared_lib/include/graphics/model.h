@@ -22,11 +22,13 @@
 #include <memory>
 #include "common_scoped_ptr.h"
 #include "byte_order.h"
+#include "mapped_file.h"
 #include "leak_dumper.h"
 
 using std::string;
 using std::map;
 using std::pair;
+using Shared::PlatformCommon::MappedFile;
 
 namespace Shared { namespace Graphics {
 
@@ -98,6 +100,7 @@ public:
 
 	//maps
 	const Texture2D *getTexture(int i) const	{return textures[i];}
+	string getTextureFile(int i, const string &dir) const;
 
 	//counts
 	uint32 getFrameCount() const			{return frameCount;}
@@ -156,11 +159,11 @@ public:
 								string sourceLoader="",string modelFile="");
 
 	//load
-	void loadV2(int meshIndex, const string &dir, FILE *f, TextureManager *textureManager,
+	void loadV2(int meshIndex, const string &dir, MappedFile *f, TextureManager *textureManager,
 			bool deletePixMapAfterLoad,std::map<string,vector<pair<string, string> > > *loadedFileList=NULL,string sourceLoader="",string modelFile="");
-	void loadV3(int meshIndex, const string &dir, FILE *f, TextureManager *textureManager,
+	void loadV3(int meshIndex, const string &dir, MappedFile *f, TextureManager *textureManager,
 			bool deletePixMapAfterLoad,std::map<string,vector<pair<string, string> > > *loadedFileList=NULL,string sourceLoader="",string modelFile="");
-	void load(int meshIndex, const string &dir, FILE *f, TextureManager *textureManager,bool deletePixMapAfterLoad,std::map<string,vector<pair<string, string> > > *loadedFileList=NULL,string sourceLoader="",string modelFile="");
+	void load(int meshIndex, const string &dir, MappedFile *f, TextureManager *textureManager,bool deletePixMapAfterLoad,std::map<string,vector<pair<string, string> > > *loadedFileList=NULL,string sourceLoader="",string modelFile="");
 	void save(int meshIndex, const string &dir, FILE *f, TextureManager *textureManager,
 			string convertTextureToFormat, std::map<string,int> &textureDeleteList,
 			bool keepsmallest,string modelFile);
@@ -171,7 +174,7 @@ public:
 	void fromEndian();
 
 private:
-	string findAlternateTexture(vector<string> conversionList, string textureFile);
+	static string findAlternateTexture(vector<string> conversionList, string textureFile);
 	void computeTangents();
 
 };
@@ -14,6 +14,7 @@
 
 #include "model.h"
 #include <vector>
+#include <map>
 #include "leak_dumper.h"
 
 using namespace std;
@@ -24,6 +25,9 @@ class TextureManager;
 
 // =====================================================
 //	class ModelManager
+//
+///	Creates models on request and shares one instance between all
+/// requests for the same file, by path or by identical content
 // =====================================================
 
 class ModelManager{
@@ -34,6 +38,21 @@ protected:
 	ModelContainer models;
 	TextureManager *textureManager;
 
+	// The bool is deletePixMapAfterLoad, models loaded with and without
+	// their pixels are not interchangeable
+	std::map<pair<string,bool>,Model*> modelsByPath;
+	// Keyed on the g3d file only, textures are resolved relative to each
+	// model's folder so candidates must also match modelTextureCRCs
+	std::multimap<pair<uint32,bool>,Model*> modelsByContent;
+	std::map<Model*,uint32> modelTextureCRCs;
+	std::map<Model*,int> modelReferenceCounts;
+
+	static uint32 getContentCRC(const string &path);
+	static uint32 getTextureContentCRC(const Model *model, const string &path);
+	Model *findModelByContent(uint32 contentCRC, bool deletePixMapAfterLoad, const string &path);
+	bool releaseModel(Model *model);
+	void recordLoadedFiles(Model *model, const string &path, std::map<string,vector<pair<string, string> > > *loadedFileList, string *sourceLoader);
+
 public:
 	ModelManager();
 	virtual ~ModelManager();
@@ -46,6 +65,8 @@ public:
 	void endLastModel(bool mustExistInList=false);
 
 	void setTextureManager(TextureManager *textureManager)	{this->textureManager= textureManager;}
+
+	int getReferenceCount(Model *model) const;
 };
 
 }}//end namespace
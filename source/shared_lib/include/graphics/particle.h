@@ -38,6 +38,7 @@ class SplashParticleSystem;
 class ParticleRenderer;
 class ModelRenderer;
 class Model;
+class ParticleUpdateThread;
 
 // =====================================================
 //	class Particle
@@ -236,6 +237,10 @@ public:
 	virtual int getChildCount() { return 0; }
 	virtual ParticleSystem* getChild(int i);
 
+	// True when update() only touches this system, so it may run on a
+	// particle update thread alongside other isolated systems
+	virtual bool isUpdateIsolated();
+
 	virtual string toString() const;
 
 	virtual void saveGame(XmlNode *rootNode);
@@ -252,6 +257,30 @@ protected:
 	virtual void initParticle(Particle *p, int particleIndex);
 	virtual void updateParticle(Particle *p);
 	virtual bool deathTest(Particle *p);
+
+	// Updates all alive particles in one pass. Systems overriding
+	// updateParticle or deathTest override this with
+	// updateParticleBatch(this) so the per particle calls are bound
+	// statically instead of going through the vtable each time.
+	virtual void updateParticles();
+
+	template<typename T>
+	inline void updateParticleBatch(T *system) {
+		for(int i= 0; i < aliveParticleCount; ++i) {
+			Particle *p= &particles[i];
+			system->T::updateParticle(p);
+
+			if(system->T::deathTest(p)) {
+				//kill the particle
+				killParticle(p);
+
+				//maintain alive particles at front of the array
+				if(aliveParticleCount > 0) {
+					particles[i]= particles[aliveParticleCount];
+				}
+			}
+		}
+	}
 };
 
 // =====================================================
@@ -271,6 +300,7 @@ public:
 	//virtual
 	virtual void initParticle(Particle *p, int particleIndex);
 	virtual void updateParticle(Particle *p);
+	virtual void updateParticles();
 
 	//set params
 	void setRadius(float radius);
@@ -405,6 +435,7 @@ public:
 	//virtual
 	virtual void initParticle(Particle *p, int particleIndex);
 	virtual void updateParticle(Particle *p);
+	virtual void updateParticles();
 	virtual void update();
 	virtual bool getVisible() const;
 	virtual void fade();
@@ -474,6 +505,7 @@ public:
 
 	virtual void initParticle(Particle *p, int particleIndex);
 	virtual bool deathTest(Particle *p);
+	virtual void updateParticles();
 
 	void setRadius(float radius);
 	void setWind(float windAngle, float windSpeed);
@@ -499,6 +531,7 @@ public:
 
 	virtual void initParticle(Particle *p, int particleIndex);
 	virtual bool deathTest(Particle *p);
+	virtual void updateParticles();
 
 	void setRadius(float radius);
 	void setWind(float windAngle, float windSpeed);
@@ -528,6 +561,7 @@ public:
 	void setGravity(float gravity)				{this->gravity= gravity;}
 	
 	virtual void initParticleSystem() {} // opportunity to do any initialization when the system has been created and all settings set
+	virtual bool isUpdateIsolated() { return false; }
 
 	virtual void saveGame(XmlNode *rootNode);
 	virtual void loadGame(const XmlNode *rootNode);
@@ -584,6 +618,7 @@ public:
 	virtual void update();
 	virtual void initParticle(Particle *p, int particleIndex);
 	virtual void updateParticle(Particle *p);
+	virtual void updateParticles();
 	
 	void setTrajectory(Trajectory trajectory)				{this->trajectory= trajectory;}
 	void setTrajectorySpeed(float trajectorySpeed)			{this->trajectorySpeed= trajectorySpeed;}
@@ -628,6 +663,7 @@ public:
 	virtual void update();
 	virtual void initParticle(Particle *p, int particleIndex);
 	virtual void updateParticle(Particle *p);
+	virtual void updateParticles();
 	
 	virtual void initParticleSystem();
 
@@ -651,8 +687,26 @@ public:
 
 class ParticleManager {
 private:
+	static int updateThreadCount;
+
 	vector<ParticleSystem *> particleSystems;
 
+	vector<ParticleUpdateThread *> updateThreadList;
+	vector<ParticleSystem *> isolatedUpdateList;
+	vector<ParticleSystem *> serialUpdateList;
+
+	void updateParticleSystems(const vector<ParticleSystem *> &updateList);
+	void startUpdateThreads();
+	void stopUpdateThreads();
+
+	// Unit and fire systems are only updated while visible or fading,
+	// checked by type id so the per frame loop does no dynamic_cast
+	static inline bool isVisibilityManagedSystem(const ParticleSystem *ps) {
+		ParticleSystem::ParticleSystemType type= ps->getParticleSystemType();
+		return (type == ParticleSystem::pst_UnitParticleSystem ||
+				type == ParticleSystem::pst_FireParticleSystem);
+	}
+
 public:
 	ParticleManager();
 	~ParticleManager();
@@ -667,6 +721,11 @@ public:
 	bool validateParticleSystemStillExists(ParticleSystem * particleSystem) const;
 	void removeParticleSystemsForParticleOwner(ParticleOwner * particleOwner);
 	bool hasActiveParticleSystem(ParticleSystem::ParticleSystemType type) const;
+
+	// Number of extra threads used to update isolated particle systems,
+	// 0 updates everything on the calling thread
+	static void setUpdateThreadCount(int value)	{ updateThreadCount= value; }
+	static int getUpdateThreadCount()			{ return updateThreadCount; }
 }; 
 
 }}//end namespace
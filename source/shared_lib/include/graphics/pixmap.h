@@ -229,6 +229,17 @@ protected:
 	string path;
 	Checksum crc;
 
+	// CRC of the image file and the component count asked for when it was
+	// loaded, together they identify the decoded pixels
+	uint32 sourceFileCRC;
+	int sourceComponents;
+
+	static string decodedCacheFolder;
+
+	string getDecodedCacheFile(uint32 fileCRC, int requestedComponents) const;
+	bool loadDecodedCache(const string &cacheFile);
+	void saveDecodedCache(const string &cacheFile) const;
+
 public:
 	//constructor & destructor
 	Pixmap2D();
@@ -298,10 +309,50 @@ public:
 
 	Checksum * getCRC() { return &crc; }
 
+	uint32 getSourceFileCRC() const	{ return sourceFileCRC; }
+	int getSourceComponents() const	{ return sourceComponents; }
+
+	static uint32 getFileCRC(const string &path);
+	static void setDecodedCacheFolder(const string &folder);
+	static string getDecodedCacheFolder() { return decodedCacheFolder; }
+	static void purgeDecodedCache(uint64 maxBytes);
+
 private:
 	bool doDimensionsAgree(const Pixmap2D *pixmap);
 };
 
+// =====================================================
+//	class PixmapRect
+//
+///	Inclusive texel bounds of the part of a pixmap that changed
+// =====================================================
+
+class PixmapRect {
+public:
+	int minX;
+	int minY;
+	int maxX;
+	int maxY;
+
+	PixmapRect()					{ clear(); }
+
+	void clear()					{ minX= 0; minY= 0; maxX= -1; maxY= -1; }
+	void setAll(int w, int h)		{ minX= 0; minY= 0; maxX= w - 1; maxY= h - 1; }
+	bool isEmpty() const			{ return maxX < minX || maxY < minY; }
+	void add(int x, int y);
+	void add(const PixmapRect &rect);
+};
+
+// Single component byte kernels, row-major and branch free so each
+// pass is a straight loop the compiler can vectorize
+
+// dest= max(dest, src)
+void pixelsMax(uint8 *dest, const uint8 *src, std::size_t count);
+// dest= src where src > dest, else dest clamped to limit
+void pixelsMaxOrLimit(uint8 *dest, const uint8 *src, uint8 limit, std::size_t count);
+// dest= from + t * (to - from) with t in 1/256 steps, for texels not at to yet
+void pixelsBlend(uint8 *dest, const uint8 *from, const uint8 *to, int count, int tFixed);
+
 // =====================================================
 //	class Pixmap3D
 // =====================================================
@@ -13,10 +13,13 @@
 #define _SHARED_GRAPHICS_TEXTUREMANAGER_H_
 
 #include <vector>
+#include <map>
 #include "texture.h"
 #include "leak_dumper.h"
 
 using std::vector;
+using std::map;
+using std::pair;
 
 namespace Shared{ namespace Graphics{
 
@@ -30,10 +33,19 @@ class TextureManager{
 	
 protected:
 	TextureContainer textures;
+
+	// Textures only get their path once loaded, new ones wait here until
+	// they can be indexed by path and, for 2D textures, by file content
+	TextureContainer unindexedTextures;
+	map<string,Texture*> texturesByPath;
+	map<pair<uint32,int>,Texture2D*> textures2DByContent;
 	
 	Texture::Filter textureFilter;
 	int maxAnisotropy;
 
+	void indexPendingTextures();
+	void unindexTexture(Texture *texture);
+
 public:
 	TextureManager();
 	~TextureManager();
@@ -51,6 +63,7 @@ public:
 	int getMaxAnisotropy() const {return maxAnisotropy;}
 
 	Texture *getTexture(const string &path);
+	Texture2D *getTexture2DByContent(const string &path, int components=-1);
 	Texture1D *newTexture1D();
 	Texture2D *newTexture2D();
 	Texture3D *newTexture3D();
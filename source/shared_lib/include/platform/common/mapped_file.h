@@ -0,0 +1,66 @@
+// ==============================================================
+//	This file is part of Glest Shared Library (www.glest.org)
+//
+//	Copyright (C) 2001-2008 Martiño Figueroa
+//
+//	You can redistribute this code and/or modify it under
+//	the terms of the GNU General Public License as published
+//	by the Free Software Foundation; either version 2 of the
+//	License, or (at your option) any later version
+// ==============================================================
+
+#ifndef _SHARED_PLATFORMCOMMON_MAPPEDFILE_H_
+#define _SHARED_PLATFORMCOMMON_MAPPEDFILE_H_
+
+#include <string>
+#include <cstddef>
+#include "data_types.h"
+#include "leak_dumper.h"
+
+using std::string;
+
+namespace Shared { namespace PlatformCommon {
+
+// =====================================================
+//	class MappedFile
+//
+///	Read only view of a whole file, memory mapped where the platform
+/// allows it and read in one go otherwise. read() and skip() walk it
+/// like fread() and fseek(SEEK_CUR) so binary loaders can parse it in
+/// a single pass without a system call per field.
+// =====================================================
+
+class MappedFile {
+private:
+	const unsigned char *data;
+	size_t size;
+	size_t position;
+	bool opened;
+	bool mapped;
+
+	// Not copyable, the mapping is owned
+	MappedFile(const MappedFile &obj);
+	MappedFile &operator=(const MappedFile &obj);
+
+public:
+	MappedFile();
+	~MappedFile();
+
+	bool open(const string &path);
+	void close();
+
+	bool isOpen() const						{ return opened; }
+	bool isMapped() const					{ return mapped; }
+	const unsigned char *getData() const	{ return data; }
+	size_t getSize() const					{ return size; }
+	size_t getPosition() const				{ return position; }
+
+	// Same contract as fread: returns the number of whole items copied
+	size_t read(void *ptr, size_t itemSize, size_t itemCount);
+	// Same contract as fseek with SEEK_CUR: returns 0 on success
+	int skip(long offset);
+};
+
+}}//end namespace
+
+#endif
@@ -103,8 +103,11 @@ time_t systemtime_now();
 
 class PerformanceTimer {
 private:
-	Uint32 lastTicks;
-	Uint32 updateTicks;
+	// In performance counter units so short intervals like 1000/40 msecs
+	// are not rounded down
+	Uint64 lastTicks;
+	Uint64 updateTicks;
+	Uint64 lastLateTicks;
 
 	int times;			// number of consecutive times
 	int maxTimes;		// maximum number consecutive times
@@ -114,6 +117,9 @@ public:
 
 	bool isTime();
 	void reset();
+	float getIntervalProgress() const;
+	int64 getMicrosUntilNextTime() const;
+	int64 getLastLateMicros() const;
 };
 
 // =====================================================
@@ -122,13 +128,13 @@ public:
 
 class Chrono {
 private:
-	Uint32 startCount;
-	Uint32 accumCount;
-	Uint32 freq;
+	Uint64 startCount;
+	Uint64 accumCount;
+	Uint64 freq;
 	bool stopped;
 
-	Uint32 lastStartCount;
-	Uint32 lastTickCount;
+	Uint64 lastStartCount;
+	Uint64 lastTickCount;
 	int64  lastResult;
 	int64 lastMultiplier;
 	bool lastStopped;
@@ -138,6 +144,7 @@ public:
 	void start();
 	void stop();
 	void reset();
+	int64 getNanos();
 	int64 getMicros();
 	int64 getMillis();
 	int64 getSeconds();
@@ -145,6 +152,9 @@ public:
 	bool isStarted() const;
     static int64 getCurTicks();
     static int64 getCurMillis();
+    static int64 getCurMicros();
+
+    static int64 countsToUnits(Uint64 counts, Uint64 freq, int64 multiplier);
 
 private:
 	int64 queryCounter(int64 multiplier);
@@ -218,6 +228,11 @@ std::pair<string,string> getFolderTreeContentsCheckSumListCacheKey(const string
 void clearFolderTreeContentsCheckSumList(const string &path, const string &filterFileExt);
 vector<std::pair<string,uint32> > getFolderTreeContentsCheckSumListRecursively(const string &path, const string &filterFileExt, vector<std::pair<string,uint32> > *recursiveMap);
 
+string getFolderTreeRootRelativePath(const string &path, const vector<string> &rootPaths);
+string getFolderTreeRelativePath(const string &path, const vector<string> &rootPaths, const string &folderName);
+vector<string> getFolderTreeContentsCheckSumListMismatches(const vector<std::pair<string,uint32> > &localList, const vector<std::pair<string,uint32> > &remoteList, const vector<string> &rootPaths, const string &folderName, vector<string> *localOnlyFiles);
+uint32 getFolderTreeContentsCheckSumExcluding(const vector<std::pair<string,uint32> > &fileList, const vector<string> &rootPaths, const string &folderName, const string &excludeFileExt);
+
 void createDirectoryPaths(string  Path);
 string extractFileFromDirectoryPath(string filename);
 string extractDirectoryPathFromFile(string filename);
@@ -236,6 +251,7 @@ void endPathWithSlash(string &path, bool requireOSSlash=false);
 void trimPathWithStartingSlash(string &path);
 void updatePathClimbingParts(string &path,bool processPreviousDirTokenCheck=true);
 string formatPath(string path);
+string getCanonicalPath(const string &path);
 
 string replaceAllHTMLEntities(string& context);
 string replaceAll(string& context, const string& from, const string& to);
@@ -245,6 +261,7 @@ bool removeFile(string file);
 bool renameFile(string oldFile, string newFile);
 void removeFolder(const string &path);
 off_t getFileSize(string filename);
+time_t getFileModificationTime(string filename);
 bool searchAndReplaceTextInFile(string fileName, string findText, string replaceText, bool simulateOnly);
 void copyFileTo(string fromFileName, string toFileName);
 
@@ -153,18 +153,19 @@ class LogFileThread : public BaseThread
 {
 protected:
 
-    Mutex *mutexLogList;
-	vector<LogFileEntry> logList;
+    // Any thread adds entries, only this thread takes them out
+    LockFreeQueue<LogFileEntry> logQueue;
+    SDL_atomic_t logQueueCount;
 	time_t lastSaveToDisk;
 
-    void saveToDisk(bool forceSaveAll,bool logListAlreadyLocked);
+    void saveToDisk();
     bool checkSaveCurrentLogBufferToDisk();
 
 public:
 	LogFileThread();
 	virtual ~LogFileThread();
     virtual void execute();
-    void addLogEntry(SystemFlags::DebugType type, string logEntry);
+    void addLogEntry(SystemFlags::DebugType type, const string &logEntry);
     std::size_t getLogEntryBufferCount();
     virtual bool canShutdown(bool deleteSelfIfShutdownDelayed=false);
 };
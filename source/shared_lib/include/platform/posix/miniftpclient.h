@@ -63,6 +63,25 @@ public:
     										 void *userdata) = 0;
 };
 
+// =====================================================
+//	class FTPClientFileDeltaRequest
+//
+///	The files of one techtree that differ from the host, the changed
+/// ones are fetched one by one and the local only ones removed
+// =====================================================
+
+class FTPClientFileDeltaRequest {
+public:
+	string itemName;
+	vector<string> changedFiles;
+	vector<string> removedFiles;
+
+	bool operator==(const FTPClientFileDeltaRequest &obj) const {
+		return (itemName == obj.itemName && changedFiles == obj.changedFiles &&
+				removedFiles == obj.removedFiles);
+	}
+};
+
 class FTPClientThread : public BaseThread, public ShellCommandOutputCallbackInterface
 {
 protected:
@@ -83,6 +102,7 @@ protected:
 
     Mutex mutexTechtreeList;
     vector<pair<string,string> > techtreeList;
+    vector<FTPClientFileDeltaRequest> techtreeDeltaList;
 
     Mutex mutexScenarioList;
     vector<pair<string,string> > scenarioList;
@@ -101,6 +121,8 @@ protected:
 
     void getTechtreeFromServer(pair<string,string> techtreeName);
     pair<FTP_Client_ResultType,string> getTechtreeFromServer(pair<string,string> techtreeName, string ftpUser, string ftpUserPassword);
+    void getTechtreeFilesFromServer(FTPClientFileDeltaRequest request);
+    pair<FTP_Client_ResultType,string> getTechtreeFileFromServer(string techtreeName, string relativeFile);
 
     void getScenarioFromServer(pair<string,string> fileName);
     pair<FTP_Client_ResultType,string> getScenarioInternalFromServer(pair<string,string> fileName);
@@ -147,6 +169,7 @@ public:
     void addMapToRequests(string mapFilename,string URL="");
     void addTilesetToRequests(string tileSetName,string URL="");
     void addTechtreeToRequests(string techtreeName,string URL="");
+    void addTechtreeFilesToRequests(string techtreeName,vector<string> changedFiles,vector<string> removedFiles);
     void addScenarioToRequests(string fileName,string URL="");
     void addFileToRequests(string fileName,string URL="");
     void addTempFileToRequests(string fileName,string URL="");
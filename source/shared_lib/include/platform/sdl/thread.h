@@ -27,6 +27,7 @@
 #endif
 
 #include <vector>
+#include <map>
 //#include "leak_dumper.h"
 
 // =====================================================
@@ -116,6 +117,50 @@ private:
 	static int beginExecution(void *param);
 };
 
+// =====================================================
+//	class MutexContentionProfiler
+//
+///	Optional per mutex and per thread lock statistics,
+///	enabled at runtime and dumped on request
+// =====================================================
+
+class MutexContentionStats {
+public:
+	MutexContentionStats() : acquireCount(0), contendedCount(0), waitMicros(0),
+		maxWaitMicros(0), holdMicros(0), maxHoldMicros(0) {}
+
+	int64 acquireCount;
+	int64 contendedCount;
+	int64 waitMicros;
+	int64 maxWaitMicros;
+	int64 holdMicros;
+	int64 maxHoldMicros;
+};
+
+class MutexContentionProfiler {
+private:
+	typedef std::pair<const char *,unsigned long> MutexThreadKey;
+	typedef std::map<MutexThreadKey,MutexContentionStats> MutexContentionStatsList;
+
+	static bool enabled;
+
+	static SDL_mutex * getStatsAccessor();
+	static MutexContentionStatsList & getStatsList();
+	static bool compareByWaitMicros(const std::pair<MutexThreadKey,MutexContentionStats> &a,
+									const std::pair<MutexThreadKey,MutexContentionStats> &b);
+
+public:
+	static inline bool isEnabled() { return enabled; }
+	static void setEnabled(bool value);
+
+	static int64 getMicrosSince(Uint64 counter);
+	static void addAcquire(const char *mutexId, bool contended, int64 waitMicros);
+	static void addHold(const char *mutexId, int64 holdMicros);
+
+	static void clearStats();
+	static string getStats();
+};
+
 // =====================================================
 //	class Mutex
 // =====================================================
@@ -134,19 +179,30 @@ private:
 	int maxRefCount;
 	Shared::PlatformCommon::Chrono *chronoPerf;
 
+	// Interned creation owner id, used as the key for contention stats
+	const char *profileId;
+	Uint64 lockAcquiredCounter;
+
 	bool isStaticMutexListMutex;
 	static auto_ptr<Mutex> mutexMutexList;
 	static vector<Mutex *> mutexList;
 
+	void profiledLock();
+	void profiledUnlock();
+
 public:
-	Mutex(string ownerId="");
+	Mutex(const string &ownerId="");
 	~Mutex();
-	inline void setOwnerId(string ownerId) {
+	inline void setOwnerId(const string &ownerId) {
 		if(this->ownerId != ownerId) {
 			this->ownerId = ownerId;
 		}
 	}
 	inline void p() {
+		if(MutexContentionProfiler::isEnabled() == true) {
+			profiledLock();
+			return;
+		}
 		SDL_LockMutex(mutex);
 		refCount++;
 	}
@@ -156,51 +212,85 @@ public:
 		int result = SDL_TryLockMutex(mutex);
 		if(result == 0) {
 			refCount++;
+			if(refCount == 1 && MutexContentionProfiler::isEnabled() == true) {
+				lockAcquiredCounter = SDL_GetPerformanceCounter();
+				MutexContentionProfiler::addAcquire(profileId,false,0);
+			}
 		}
 		return result;
 	}
 	inline void v() {
+		if(refCount == 1 && lockAcquiredCounter != 0) {
+			profiledUnlock();
+			return;
+		}
 		refCount--;
 		SDL_UnlockMutex(mutex);
 	}
 	inline int getRefCount() const { return refCount; }
 
 	inline SDL_mutex* getMutex() { return mutex; }
+
+	static const char * internOwnerId(const string &ownerId);
 };
 
 class MutexSafeWrapper {
 protected:
 	Mutex *mutex;
+	// Owner ids are only kept when debugging mutexes so locking never
+	// copies a string
+#if defined(DEBUG_MUTEXES) || defined(DEBUG_PERFORMANCE_MUTEXES)
 	string ownerId;
+#endif
 #ifdef DEBUG_PERFORMANCE_MUTEXES
 	Chrono chrono;
 #endif
 
+	inline void initOwnerId(const char *ownerId) {
+#if defined(DEBUG_MUTEXES) || defined(DEBUG_PERFORMANCE_MUTEXES)
+		this->ownerId = (ownerId != NULL ? ownerId : "");
+#endif
+	}
+	inline void initOwnerId(const string &ownerId) {
+#if defined(DEBUG_MUTEXES) || defined(DEBUG_PERFORMANCE_MUTEXES)
+		this->ownerId = ownerId;
+#endif
+	}
+
 public:
 
-	MutexSafeWrapper(Mutex *mutex,string ownerId="") {
+	MutexSafeWrapper(Mutex *mutex,const char *ownerId=NULL) {
 		this->mutex = mutex;
-		if(this->ownerId != ownerId) {
-			this->ownerId = ownerId;
-		}
+		initOwnerId(ownerId);
+		Lock();
+	}
+	MutexSafeWrapper(Mutex *mutex,const string &ownerId) {
+		this->mutex = mutex;
+		initOwnerId(ownerId);
 		Lock();
 	}
 	~MutexSafeWrapper() {
 		ReleaseLock();
 	}
 
-    inline void setMutex(Mutex *mutex,string ownerId="") {
+    inline void setMutex(Mutex *mutex,const char *ownerId=NULL) {
 		this->mutex = mutex;
-		if(this->ownerId != ownerId) {
-			this->ownerId = ownerId;
-		}
+		initOwnerId(ownerId);
 		Lock();
     }
-    inline int setMutexAndTryLock(Mutex *mutex,string ownerId="") {
+    inline void setMutex(Mutex *mutex,const string &ownerId) {
 		this->mutex = mutex;
-		if(this->ownerId != ownerId) {
-			this->ownerId = ownerId;
-		}
+		initOwnerId(ownerId);
+		Lock();
+    }
+    inline int setMutexAndTryLock(Mutex *mutex,const char *ownerId=NULL) {
+		this->mutex = mutex;
+		initOwnerId(ownerId);
+		return this->mutex->TryLock();
+    }
+    inline int setMutexAndTryLock(Mutex *mutex,const string &ownerId) {
+		this->mutex = mutex;
+		initOwnerId(ownerId);
 		return this->mutex->TryLock();
     }
 
@@ -221,9 +311,6 @@ public:
 #endif
 
 			this->mutex->p();
-			if(this->mutex != NULL) {
-				this->mutex->setOwnerId(ownerId);
-			}
 
 #ifdef DEBUG_PERFORMANCE_MUTEXES
 			if(chrono.getMillis() > 5) printf("In [%s::%s Line: %d] MUTEX LOCK took msecs: %lld, this->mutex->getRefCount() = %d ownerId [%s]\n",__FILE__,__FUNCTION__,__LINE__,(long long int)chrono.getMillis(),this->mutex->getRefCount(),ownerId.c_str());
@@ -251,9 +338,6 @@ public:
 #endif
 
 			int result = this->mutex->TryLock(millisecondsToWait);
-			if(result == 0 && this->mutex != NULL) {
-				this->mutex->setOwnerId(ownerId);
-			}
 
 #ifdef DEBUG_PERFORMANCE_MUTEXES
 			if(chrono.getMillis() > 5) printf("In [%s::%s Line: %d] MUTEX LOCK took msecs: %lld, this->mutex->getRefCount() = %d ownerId [%s]\n",__FILE__,__FUNCTION__,__LINE__,(long long int)chrono.getMillis(),this->mutex->getRefCount(),ownerId.c_str());
@@ -335,7 +419,7 @@ public:
 	void UnLockWrite();
 
 	int maxReaders();
-	void setOwnerId(string ownerId) {
+	void setOwnerId(const string &ownerId) {
 		if(this->ownerId != ownerId) {
 			this->ownerId = ownerId;
 		}
@@ -353,37 +437,54 @@ private:
 class ReadWriteMutexSafeWrapper {
 protected:
 	ReadWriteMutex *mutex;
+#if defined(DEBUG_MUTEXES) || defined(DEBUG_PERFORMANCE_MUTEXES)
 	string ownerId;
+#endif
 	bool isReadLock;
 
 #ifdef DEBUG_PERFORMANCE_MUTEXES
 	Chrono chrono;
 #endif
 
+	inline void initOwnerId(const char *ownerId) {
+#if defined(DEBUG_MUTEXES) || defined(DEBUG_PERFORMANCE_MUTEXES)
+		this->ownerId = (ownerId != NULL ? ownerId : "");
+#endif
+	}
+	inline void initOwnerId(const string &ownerId) {
+#if defined(DEBUG_MUTEXES) || defined(DEBUG_PERFORMANCE_MUTEXES)
+		this->ownerId = ownerId;
+#endif
+	}
+
 public:
 
-	ReadWriteMutexSafeWrapper(ReadWriteMutex *mutex,bool isReadLock=true, string ownerId="") {
+	ReadWriteMutexSafeWrapper(ReadWriteMutex *mutex,bool isReadLock=true, const char *ownerId=NULL) {
 		this->mutex = mutex;
-		if(this->isReadLock != isReadLock) {
-			this->isReadLock = isReadLock;
-		}
-		if(this->ownerId != ownerId) {
-			this->ownerId = ownerId;
-		}
+		this->isReadLock = isReadLock;
+		initOwnerId(ownerId);
+		Lock();
+	}
+	ReadWriteMutexSafeWrapper(ReadWriteMutex *mutex,bool isReadLock, const string &ownerId) {
+		this->mutex = mutex;
+		this->isReadLock = isReadLock;
+		initOwnerId(ownerId);
 		Lock();
 	}
 	~ReadWriteMutexSafeWrapper() {
 		ReleaseLock();
 	}
 
-    void setReadWriteMutex(ReadWriteMutex *mutex,bool isReadLock=true,string ownerId="") {
+    void setReadWriteMutex(ReadWriteMutex *mutex,bool isReadLock=true,const char *ownerId=NULL) {
 		this->mutex = mutex;
-		if(this->isReadLock != isReadLock) {
-			this->isReadLock = isReadLock;
-		}
-		if(this->ownerId != ownerId) {
-			this->ownerId = ownerId;
-		}
+		this->isReadLock = isReadLock;
+		initOwnerId(ownerId);
+		Lock();
+    }
+    void setReadWriteMutex(ReadWriteMutex *mutex,bool isReadLock,const string &ownerId) {
+		this->mutex = mutex;
+		this->isReadLock = isReadLock;
+		initOwnerId(ownerId);
 		Lock();
     }
     bool isValidReadWriteMutex() const {
@@ -508,17 +609,15 @@ public:
 class MasterSlaveThreadControllerSafeWrapper {
 protected:
 	MasterSlaveThreadController *master;
-	string ownerId;
 	int waitMilliseconds;
 
 public:
 
-	MasterSlaveThreadControllerSafeWrapper(MasterSlaveThreadController *master, int waitMilliseconds=-1, string ownerId="") {
+	MasterSlaveThreadControllerSafeWrapper(MasterSlaveThreadController *master, int waitMilliseconds=-1, const string &ownerId="") {
 		if(debugMasterSlaveThreadController) printf("In [%s::%s Line: %d]\n",__FILE__,__FUNCTION__,__LINE__);
 
 		this->master = master;
 		this->waitMilliseconds = waitMilliseconds;
-		this->ownerId = ownerId;
 
 		if(debugMasterSlaveThreadController) printf("In [%s::%s Line: %d]\n",__FILE__,__FUNCTION__,__LINE__);
 	}
@@ -535,6 +634,93 @@ public:
 	}
 };
 
+// =====================================================
+//	class LockFreeQueue
+//
+///	Unbounded queue that many threads may push to while one thread pops,
+/// neither side takes a lock. Producers only swap the head pointer, a pop
+/// may briefly see an empty queue while a push is half done.
+// =====================================================
+
+template<typename T>
+class LockFreeQueue {
+private:
+	class Node {
+	public:
+		void *next;
+		T value;
+
+		Node() : next(NULL) {}
+		explicit Node(const T &value) : next(NULL), value(value) {}
+	};
+
+	void *head;		// last pushed node, swapped by the producers
+	Node *tail;		// next node to pop, only used by the consumer
+	Node stub;
+
+	void pushNode(Node *node) {
+		SDL_AtomicSetPtr(&node->next,NULL);
+		Node *prev = static_cast<Node *>(SDL_AtomicSetPtr(&head,node));
+		SDL_AtomicSetPtr(&prev->next,node);
+	}
+
+	// Disallow copying
+	LockFreeQueue(const LockFreeQueue &);
+	LockFreeQueue &operator=(const LockFreeQueue &);
+
+public:
+	LockFreeQueue() : head(&stub), tail(&stub) {}
+	~LockFreeQueue() {
+		T value;
+		while(pop(value) == true) {
+		}
+	}
+
+	// Safe from any thread
+	void push(const T &value) {
+		pushNode(new Node(value));
+	}
+
+	// Only from the single consumer thread
+	bool pop(T &value) {
+		Node *first = tail;
+		Node *next = static_cast<Node *>(SDL_AtomicGetPtr(&first->next));
+		if(first == &stub) {
+			if(next == NULL) {
+				return false;
+			}
+			tail = next;
+			first = next;
+			next = static_cast<Node *>(SDL_AtomicGetPtr(&first->next));
+		}
+		if(next != NULL) {
+			tail = next;
+			value = first->value;
+			delete first;
+			return true;
+		}
+		// A producer swapped the head but has not linked its node yet
+		if(first != SDL_AtomicGetPtr(&head)) {
+			return false;
+		}
+		// Only one node left, put the stub back behind it so it can be taken
+		pushNode(&stub);
+		next = static_cast<Node *>(SDL_AtomicGetPtr(&first->next));
+		if(next != NULL) {
+			tail = next;
+			value = first->value;
+			delete first;
+			return true;
+		}
+		return false;
+	}
+
+	// Only from the single consumer thread
+	bool empty() {
+		return (tail == &stub && SDL_AtomicGetPtr(&stub.next) == NULL);
+	}
+};
+
 }}//end namespace
 
 #endif
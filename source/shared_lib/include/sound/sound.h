@@ -13,7 +13,10 @@
 #define _SHARED_SOUND_SOUND_H_
 
 #include <string>
+#include <map>
+#include <vector>
 #include "sound_file_loader.h" 
+#include "thread.h"
 #include "leak_dumper.h"
 
 using namespace std;
@@ -82,18 +85,101 @@ public:
 
 class StaticSound: public Sound{
 private:
-	int8 * samples;
+	// The samples are owned by the SoundSampleCache, shared with every
+	// other sound loaded from the same file
+	string cacheKey;
 
 public:
 	StaticSound();
 	virtual ~StaticSound();
 
-	int8 *getSamples() const		{return samples;}
+	// Samples returned are pinned in the cache until releaseSamples is
+	// called, StaticSoundSamplesSafeWrapper pairs the two calls
+	int8 *getSamples() const;
+	void releaseSamples() const;
 	
 	void load(const string &path);
 	void close();
 };
 
+// =====================================================
+//	class StaticSoundSamplesSafeWrapper
+// =====================================================
+
+class StaticSoundSamplesSafeWrapper {
+private:
+	const StaticSound *sound;
+	int8 *samples;
+
+public:
+	StaticSoundSamplesSafeWrapper(const StaticSound *sound);
+	~StaticSoundSamplesSafeWrapper();
+
+	int8 *getSamples() const	{return samples;}
+};
+
+// =====================================================
+//	class SoundSampleCache
+//
+///	Decoded samples of static sounds, shared by all sounds loaded from
+/// the same file. Files are only decoded when first played (or by the
+/// prefetch queue) and the least recently played ones are released when
+/// the decoded samples go over the memory cap.
+// =====================================================
+
+class SoundSampleCache {
+private:
+	class SampleEntry {
+	public:
+		SoundInfo info;
+		int8 *samples;
+		int referenceCount;
+		int pinCount;
+		uint64 lastUsed;
+
+		SampleEntry() : samples(NULL), referenceCount(0), pinCount(0), lastUsed(0) {}
+	};
+	typedef std::map<string,SampleEntry> SampleEntryMap;
+
+	Mutex mutex;
+	SampleEntryMap entries;
+	std::vector<string> prefetchQueue;
+
+	uint64 useCounter;
+	uint64 residentBytes;
+	uint64 maxResidentBytes;
+	bool prefetchEnabled;
+
+	int64 hitCount;
+	int64 decodeCount;
+	int64 evictionCount;
+
+	SoundSampleCache();
+	SoundSampleCache(const SoundSampleCache &obj);
+	SoundSampleCache & operator=(const SoundSampleCache &obj);
+
+	static SoundFileLoader * newLoader(const string &path);
+	static int8 * decode(const string &path, const SoundInfo &info);
+	void evictUnused(const string &keepKey);
+
+public:
+	static SoundSampleCache & getInstance();
+	static string getCacheKey(const string &path);
+
+	void addReference(const string &key, SoundInfo *info);
+	void removeReference(const string &key);
+	int8 * getSamples(const string &key);
+	void releaseSamples(const string &key);
+	int decodePendingPrefetches(int maxCount);
+
+	void setMaxResidentBytes(uint64 value);
+	void setPrefetchEnabled(bool value);
+
+	uint64 getResidentBytes();
+	int getEntryCount();
+	string getStats();
+};
+
 // =====================================================
 //	class StrSound
 // =====================================================
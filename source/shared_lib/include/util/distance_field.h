@@ -0,0 +1,79 @@
+// ==============================================================
+//	This file is part of Glest Shared Library (www.glest.org)
+//
+//	Copyright (C) 2001-2008 Martiño Figueroa
+//
+//	You can redistribute this code and/or modify it under
+//	the terms of the GNU General Public License as published
+//	by the Free Software Foundation; either version 2 of the
+//	License, or (at your option) any later version
+// ==============================================================
+
+#ifndef _SHARED_UTIL_DISTANCEFIELD_H_
+#define _SHARED_UTIL_DISTANCEFIELD_H_
+
+#include <vector>
+#include "data_types.h"
+#include "leak_dumper.h"
+
+using namespace Shared::Platform;
+
+namespace Shared{ namespace Util{
+
+// =====================================================
+//	class DistanceFieldCellsInterface
+//
+///	The grid a DistanceField is walked over
+// =====================================================
+
+class DistanceFieldCellsInterface {
+public:
+	virtual ~DistanceFieldCellsInterface() {}
+	virtual bool isDistanceFieldCellBlocked(int cellIndex) const = 0;
+};
+
+// =====================================================
+//	class DistanceField
+//
+///	Walking distance in cells (8 neighbours, every step costs one) from
+///	every cell of a grid to the nearest source cell, going around blocked
+///	cells. Of the sources at the same distance the one with the lowest
+///	cell index is the nearest, so the field only depends on the grid and
+///	its sources, never on the order they were built or repaired in.
+// =====================================================
+
+class DistanceField {
+public:
+	static const uint16 unreachable;
+
+private:
+	int w;
+	int h;
+	std::vector<uint16> distances;
+	// Cell index of the source each cell is nearest to, -1 if none
+	std::vector<int> nearestSources;
+	std::vector<std::vector<int> > buckets;
+
+	bool isCloser(int cellIndex, int distance, int nearestSource) const;
+	void push(int cellIndex, int distance, int nearestSource);
+	void propagate(const DistanceFieldCellsInterface *cells, int startDistance);
+	bool relaxFromNeighbours(const DistanceFieldCellsInterface *cells, int cellIndex);
+
+public:
+	DistanceField();
+
+	void build(const DistanceFieldCellsInterface *cells, int w, int h, const std::vector<int> &sources);
+	void removeSource(const DistanceFieldCellsInterface *cells, int cellIndex);
+	void openCell(const DistanceFieldCellsInterface *cells, int cellIndex);
+	void clear();
+
+	bool isBuilt() const	{ return distances.empty() == false; }
+	int getW() const		{ return w; }
+	int getH() const		{ return h; }
+	int getDistance(int cellIndex) const;
+	int getNearestSource(int cellIndex) const;
+};
+
+}}//end namespace
+
+#endif
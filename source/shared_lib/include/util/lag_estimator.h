@@ -0,0 +1,81 @@
+// ==============================================================
+//	This file is part of Glest Shared Library (www.glest.org)
+//
+//	Copyright (C) 2001-2008 Martiño Figueroa
+//
+//	You can redistribute this code and/or modify it under
+//	the terms of the GNU General Public License as published
+//	by the Free Software Foundation; either version 2 of the
+//	License, or (at your option) any later version
+// ==============================================================
+
+#ifndef _SHARED_UTIL_LAGESTIMATOR_H_
+#define _SHARED_UTIL_LAGESTIMATOR_H_
+
+#include "data_types.h"
+#include "leak_dumper.h"
+
+using namespace Shared::Platform;
+
+namespace Shared{ namespace Util{
+
+// =====================================================
+//	class KeyframeHistory
+//
+///	When each recent keyframe was broadcast, one entry per frame
+// =====================================================
+
+class KeyframeHistory {
+public:
+	static const int historySize = 64;
+
+private:
+	int frames[historySize];
+	int64 micros[historySize];
+	int nextIndex;
+	int lastFrame;
+
+public:
+	KeyframeHistory();
+
+	void clear();
+	bool add(int frameCount, int64 nowMicros);
+	int64 getBroadcastMicros(int frameCount) const;
+	int getLastFrame() const	{ return lastFrame; }
+};
+
+// =====================================================
+//	class LagEstimate
+//
+///	Smoothed time a client trails the keyframe broadcasts, kept like a
+///	TCP round trip estimate, plus whether the client stopped advancing
+// =====================================================
+
+class LagEstimate {
+public:
+	// Samples in a row without the client's frame moving that make a stall
+	static const int stallSampleCount = 2;
+
+private:
+	double lagMillis;
+	double jitterMillis;
+	int sampleCount;
+	int lastClientFrame;
+	int stalledSamples;
+
+public:
+	LagEstimate();
+
+	void clear();
+	void addSample(int clientFrameCount, double sampleMillis);
+
+	double getLagMillis() const		{ return lagMillis; }
+	double getJitterMillis() const	{ return jitterMillis; }
+	int getSampleCount() const		{ return sampleCount; }
+	double getPredictedMillis() const	{ return lagMillis + 4 * jitterMillis; }
+	bool isStalled() const			{ return stalledSamples >= stallSampleCount; }
+};
+
+}}//end namespace
+
+#endif
@@ -0,0 +1,136 @@
+// ==============================================================
+//	This file is part of Glest Shared Library (www.glest.org)
+//
+//	Copyright (C) 2001-2008 Martiño Figueroa
+//
+//	You can redistribute this code and/or modify it under
+//	the terms of the GNU General Public License as published
+//	by the Free Software Foundation; either version 2 of the
+//	License, or (at your option) any later version
+// ==============================================================
+
+#ifndef _SHARED_UTIL_OBJECTPOOL_H_
+#define _SHARED_UTIL_OBJECTPOOL_H_
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include "data_types.h"
+#include "thread.h"
+#include "platform_common.h"
+#include "leak_dumper.h"
+
+using std::string;
+using namespace Shared::Platform;
+
+namespace Shared{ namespace Util{
+
+// =====================================================
+//	class ObjectPool
+//
+///	Fixed size block allocator for objects that are created and
+/// destroyed in large numbers during a game. Blocks are carved out of
+/// larger chunks and recycled through a free list, chunks are only
+/// released when the pool is destroyed.
+// =====================================================
+
+class ObjectPool {
+private:
+	const char *name;
+	std::size_t blockSize;
+	std::size_t blocksPerChunk;
+
+	Mutex mutex;
+	std::vector<void *> chunks;
+	void *freeList;
+
+	int64 liveCount;
+	int64 peakCount;
+	int64 allocationCount;
+
+	void addChunk();
+
+public:
+	ObjectPool(const char *name, std::size_t blockSize, std::size_t blocksPerChunk=256);
+	~ObjectPool();
+
+	void * allocate();
+	void deallocate(void *ptr);
+
+	int64 getLiveCount();
+	int64 getPeakCount();
+	int64 getAllocationCount();
+	std::size_t getChunkCount();
+
+	string getStats();
+	static string getAllStats();
+};
+
+// =====================================================
+//	class ScratchVectorPool
+//
+///	Recycles vectors used for short lived query results so their
+/// capacity is reused instead of reallocated on every call
+// =====================================================
+
+template<typename T>
+class ScratchVectorPool {
+private:
+	Mutex mutex;
+	std::vector<std::vector<T> *> freeList;
+
+public:
+	ScratchVectorPool() : mutex(CODE_AT_LINE) {}
+	~ScratchVectorPool() {
+		for(unsigned int index = 0; index < freeList.size(); ++index) {
+			delete freeList[index];
+		}
+		freeList.clear();
+	}
+
+	std::vector<T> * acquire() {
+		MutexSafeWrapper safeMutex(&mutex,CODE_AT_LINE);
+		if(freeList.empty() == true) {
+			return new std::vector<T>();
+		}
+		std::vector<T> *result = freeList.back();
+		freeList.pop_back();
+		return result;
+	}
+
+	void release(std::vector<T> *list) {
+		list->clear();
+		MutexSafeWrapper safeMutex(&mutex,CODE_AT_LINE);
+		freeList.push_back(list);
+	}
+};
+
+// =====================================================
+//	class ScratchVector
+//
+///	Borrows a vector from a ScratchVectorPool for the current scope
+// =====================================================
+
+template<typename T>
+class ScratchVector {
+private:
+	ScratchVectorPool<T> &pool;
+	std::vector<T> *list;
+
+	ScratchVector(const ScratchVector &obj);
+	ScratchVector & operator=(const ScratchVector &obj);
+
+public:
+	explicit ScratchVector(ScratchVectorPool<T> &pool) : pool(pool) {
+		list = pool.acquire();
+	}
+	~ScratchVector() {
+		pool.release(list);
+	}
+
+	inline std::vector<T> & get() { return *list; }
+};
+
+}}//end namespace
+
+#endif
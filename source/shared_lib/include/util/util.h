@@ -95,6 +95,7 @@ public:
     		this->debugLogFileName	= "";
 			this->fileStreamOwner	= false;
 			this->mutex				= NULL;
+			initRateLimit();
     	}
     	SystemFlagsType(DebugType debugType) {
     		this->debugType 		= debugType;
@@ -103,6 +104,7 @@ public:
     		this->debugLogFileName	= "";
 			this->fileStreamOwner	= false;
 			this->mutex				= NULL;
+			initRateLimit();
     	}
 		~SystemFlagsType() {
 			Close();
@@ -115,8 +117,15 @@ public:
     		this->debugLogFileName	= debugLogFileName;
 			this->fileStreamOwner	= false;
 			this->mutex				= NULL;
+			initRateLimit();
     	}
 
+		void initRateLimit() {
+			this->maxEntriesPerSecond = 0;
+			SDL_AtomicSet(&this->rateLimitSecond,0);
+			SDL_AtomicSet(&this->rateLimitCount,0);
+			SDL_AtomicSet(&this->rateLimitSuppressed,0);
+		}
 		void Close() {
 			if(this->fileStreamOwner == true) {
 				if( this->fileStream != NULL &&
@@ -136,6 +145,13 @@ public:
     	std::string debugLogFileName;
 		bool fileStreamOwner;
 		Mutex *mutex;
+
+		// 0 logs everything, otherwise entries past this many in one second
+		// are only counted
+		int maxEntriesPerSecond;
+		SDL_atomic_t rateLimitSecond;
+		SDL_atomic_t rateLimitCount;
+		SDL_atomic_t rateLimitSuppressed;
 	};
 
 protected:
@@ -210,6 +210,7 @@ public:
 
 
 	XmlNode *addChild(const string &name, const string text = "");
+	XmlNode *addChildCopy(const XmlNode *node);
 	XmlAttribute *addAttribute(const string &name, const string &value, const std::map<string,string> &mapTagReplacementValues);
 	xml_node<>* buildElement(xml_document<> *document) const;
 };
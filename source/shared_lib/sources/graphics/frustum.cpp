@@ -0,0 +1,160 @@
+// ==============================================================
+//	This file is part of Glest Shared Library (www.glest.org)
+//
+//	Copyright (C) 2001-2008 Martiño Figueroa
+//
+//	You can redistribute this code and/or modify it under
+//	the terms of the GNU General Public License as published
+//	by the Free Software Foundation; either version 2 of the
+//	License, or (at your option) any later version
+// ==============================================================
+
+#include "frustum.h"
+
+#include <cmath>
+#include <cstdio>
+#include "leak_dumper.h"
+
+namespace Shared{ namespace Graphics{
+
+// =====================================================
+//	class Frustum
+// =====================================================
+
+Frustum::Frustum() {
+	clear();
+}
+
+void Frustum::clear() {
+	for(int index = 0; index < planeCount * 4; ++index) {
+		planes[index] = 0;
+	}
+	for(int index = 0; index < planeCount; ++index) {
+		planeExtents[index] = 0;
+	}
+}
+
+void Frustum::normalizePlane(int planeIndex) {
+	float *plane = &planes[planeIndex * 4];
+	float t = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+	if(t != 0.0) {
+		plane[0] /= t;
+		plane[1] /= t;
+		plane[2] /= t;
+		plane[3] /= t;
+	}
+	planeExtents[planeIndex] = std::fabs(plane[0]) + std::fabs(plane[1]) + std::fabs(plane[2]);
+}
+
+void Frustum::extract(const float *proj, const float *modl) {
+	float clip[16];
+
+	/* Combine the two matrices (multiply projection by modelview) */
+	for(int row = 0; row < 4; ++row) {
+		for(int col = 0; col < 4; ++col) {
+			clip[row * 4 + col] =	modl[row * 4 + 0] * proj[ 0 + col] +
+									modl[row * 4 + 1] * proj[ 4 + col] +
+									modl[row * 4 + 2] * proj[ 8 + col] +
+									modl[row * 4 + 3] * proj[12 + col];
+		}
+	}
+
+	// Each plane is the fourth column of the clip matrix plus or minus
+	// one of the other three: right, left, bottom, top, far, near
+	const int planeColumn[planeCount]	= { 0, 0, 1, 1, 2, 2 };
+	const float planeSign[planeCount]	= { -1, 1, 1, -1, -1, 1 };
+	for(int planeIndex = 0; planeIndex < planeCount; ++planeIndex) {
+		float *plane = &planes[planeIndex * 4];
+		for(int component = 0; component < 4; ++component) {
+			plane[component] =	clip[component * 4 + 3] +
+								planeSign[planeIndex] * clip[component * 4 + planeColumn[planeIndex]];
+		}
+		normalizePlane(planeIndex);
+	}
+}
+
+bool Frustum::cubeInFrustum(float x, float y, float z, float size) const {
+	for(int planeIndex = 0; planeIndex < planeCount; ++planeIndex) {
+		const float *plane = &planes[planeIndex * 4];
+		// Test the corner farthest along the plane normal, if even that one
+		// is behind the plane the whole cube is
+		float distance = plane[0] * x + plane[1] * y + plane[2] * z + plane[3];
+		if(distance + size * planeExtents[planeIndex] <= 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+int Frustum::cubesInFrustum(const float *x, const float *y, const float *z,
+							const float *sizes, int count, unsigned char *result) const {
+	for(int index = 0; index < count; ++index) {
+		result[index] = 1;
+	}
+
+	// Plane by plane over contiguous arrays without branches so the
+	// compiler can vectorize the inner loop
+	for(int planeIndex = 0; planeIndex < planeCount; ++planeIndex) {
+		const float a = planes[planeIndex * 4 + 0];
+		const float b = planes[planeIndex * 4 + 1];
+		const float c = planes[planeIndex * 4 + 2];
+		const float d = planes[planeIndex * 4 + 3];
+		const float extent = planeExtents[planeIndex];
+		for(int index = 0; index < count; ++index) {
+			float distance = a * x[index] + b * y[index] + c * z[index] + d + sizes[index] * extent;
+			result[index] &= (unsigned char)(distance > 0);
+		}
+	}
+
+	int visibleCount = 0;
+	for(int index = 0; index < count; ++index) {
+		visibleCount += result[index];
+	}
+	return visibleCount;
+}
+
+bool Frustum::operator==(const Frustum &obj) const {
+	for(int index = 0; index < planeCount * 4; ++index) {
+		if(planes[index] != obj.planes[index]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+string Frustum::toString() const {
+	string result = "";
+	for(int planeIndex = 0; planeIndex < planeCount; ++planeIndex) {
+		char szBuf[256]="";
+		snprintf(szBuf,256,"Frustum #%d: [%f][%f][%f][%f]\n",planeIndex,
+				planes[planeIndex * 4 + 0],planes[planeIndex * 4 + 1],
+				planes[planeIndex * 4 + 2],planes[planeIndex * 4 + 3]);
+		result += szBuf;
+	}
+	return result;
+}
+
+// =====================================================
+//	class FrustumCullBatch
+// =====================================================
+
+void FrustumCullBatch::clear() {
+	x.clear();
+	y.clear();
+	z.clear();
+	sizes.clear();
+	visible.clear();
+	visibleCount = 0;
+}
+
+int FrustumCullBatch::cull(const Frustum &frustum) {
+	visible.resize(x.size());
+	visibleCount = 0;
+	if(x.empty() == false) {
+		visibleCount = frustum.cubesInFrustum(&x[0], &y[0], &z[0], &sizes[0],
+											  (int)x.size(), &visible[0]);
+	}
+	return visibleCount;
+}
+
+}}//end namespace
@@ -118,4 +118,63 @@ void InterpolationData::update(const Vec3f* src, Vec3f* &dest, float t, bool cyc
 	}
 }
 
+float extrapolateProgress(float progress, float lastProgress, float interpolation) {
+	if(interpolation <= 0.f || progress <= lastProgress) {
+		return progress;
+	}
+	return min(1.f, progress + (progress - lastProgress) * interpolation);
+}
+
+// =====================================================
+//	class FrameInterpolation
+// =====================================================
+
+FrameInterpolation::FrameInterpolation() {
+	reset(0);
+}
+
+void FrameInterpolation::reset(double nominalMicrosPerFrame) {
+	lastFrameCount		= -1;
+	lastAdvanceFrames	= 0;
+	lastAdvanceMicros	= 0;
+	microsPerFrame		= nominalMicrosPerFrame;
+}
+
+// Called after each program update with the world frame it reached
+void FrameInterpolation::update(int frameCount, int64 nowMicros) {
+	if(lastFrameCount < 0 || frameCount < lastFrameCount) {
+		// First frame seen, or a load went back in time
+		lastFrameCount		= frameCount;
+		lastAdvanceFrames	= 0;
+		lastAdvanceMicros	= nowMicros;
+		return;
+	}
+	if(frameCount == lastFrameCount) {
+		return;
+	}
+
+	int advancedFrames = frameCount - lastFrameCount;
+	if(lastAdvanceFrames > 0 && microsPerFrame > 0) {
+		// One long wait, such as a client holding for a keyframe, only
+		// nudges the time per frame
+		double sampleMicros = static_cast<double>(nowMicros - lastAdvanceMicros) / advancedFrames;
+		sampleMicros = max(microsPerFrame / 2, min(microsPerFrame * 2, sampleMicros));
+		microsPerFrame += (sampleMicros - microsPerFrame) / 4;
+	}
+	lastFrameCount		= frameCount;
+	lastAdvanceFrames	= advancedFrames;
+	lastAdvanceMicros	= nowMicros;
+}
+
+// Part of a world frame passed since the last advance. Held at one frame,
+// as the next advance runs at least one, so drawing never gets ahead of
+// where it lands and never has to jump back
+float FrameInterpolation::get(int64 nowMicros) const {
+	if(lastAdvanceFrames <= 0 || microsPerFrame <= 0) {
+		return 0;
+	}
+	double frames = static_cast<double>(nowMicros - lastAdvanceMicros) / microsPerFrame;
+	return static_cast<float>(max(0.0, min(1.0, frames)));
+}
+
 }}//end namespace 
@@ -409,13 +409,34 @@ string Mesh::findAlternateTexture(vector<string> conversionList, string textureF
 	return result;
 }
 
-void Mesh::loadV2(int meshIndex, const string &dir, FILE *f, TextureManager *textureManager,
+// The file a model in dir loads for texture slot i, "" if it has none
+string Mesh::getTextureFile(int i, const string &dir) const {
+	if(texturePaths[i] == "") {
+		return "";
+	}
+	string texPath= dir;
+	if(texPath != "") {
+		endPathWithSlash(texPath);
+	}
+	texPath += texturePaths[i];
+	if(fileExists(texPath) == false) {
+		vector<string> conversionList;
+		conversionList.push_back("png");
+		conversionList.push_back("jpg");
+		conversionList.push_back("tga");
+		conversionList.push_back("bmp");
+		texPath = findAlternateTexture(conversionList, texPath);
+	}
+	return texPath;
+}
+
+void Mesh::loadV2(int meshIndex, const string &dir, MappedFile *f, TextureManager *textureManager,
 		bool deletePixMapAfterLoad, std::map<string,vector<pair<string, string> > > *loadedFileList,
 		string sourceLoader,string modelFile) {
 	this->textureManager = textureManager;
 	//read header
 	MeshHeaderV2 meshHeader;
-	size_t readBytes = fread(&meshHeader, sizeof(MeshHeaderV2), 1, f);
+	size_t readBytes = f->read(&meshHeader, sizeof(MeshHeaderV2), 1);
 	if(readBytes != 1) {
 		char szBuf[8096]="";
 		snprintf(szBuf,8096,"fread returned wrong size = " MG_SIZE_T_SPECIFIER " on line: %d.",readBytes,__LINE__);
@@ -477,7 +498,16 @@ void Mesh::loadV2(int meshIndex, const string &dir, FILE *f, TextureManager *tex
 				conversionList.push_back("bmp");
 				texPath = findAlternateTexture(conversionList, texPath);
 			}
+			// The same image may ship under another name, share that texture
 			if(fileExists(texPath) == true) {
+				textures[mtDiffuse]= textureManager->getTexture2DByContent(texPath);
+			}
+			if(textures[mtDiffuse] != NULL) {
+				if(loadedFileList) {
+					(*loadedFileList)[texPath].push_back(make_pair(sourceLoader,sourceLoader));
+				}
+			}
+			else if(fileExists(texPath) == true) {
 				if(SystemFlags::VERBOSE_MODE_ENABLED) printf("In [%s::%s Line: %d] v2 model texture [%s] meshIndex = %d modelFile [%s]\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__,texPath.c_str(),meshIndex,modelFile.c_str());
 
 				textures[mtDiffuse]= textureManager->newTexture2D();
@@ -498,7 +528,7 @@ void Mesh::loadV2(int meshIndex, const string &dir, FILE *f, TextureManager *tex
 	}
 
 	//read data
-	readBytes = fread(vertices, sizeof(Vec3f)*frameCount*vertexCount, 1, f);
+	readBytes = f->read(vertices, sizeof(Vec3f)*frameCount*vertexCount, 1);
 	if(readBytes != 1 && (frameCount * vertexCount) != 0) {
 		char szBuf[8096]="";
 		snprintf(szBuf,8096,"fread returned wrong size = " MG_SIZE_T_SPECIFIER " [%u][%u] on line: %d.",readBytes,frameCount,vertexCount,__LINE__);
@@ -506,7 +536,7 @@ void Mesh::loadV2(int meshIndex, const string &dir, FILE *f, TextureManager *tex
 	}
 	fromEndianVecArray<Vec3f>(vertices, frameCount*vertexCount);
 
-	readBytes = fread(normals, sizeof(Vec3f)*frameCount*vertexCount, 1, f);
+	readBytes = f->read(normals, sizeof(Vec3f)*frameCount*vertexCount, 1);
 	if(readBytes != 1 && (frameCount * vertexCount) != 0) {
 		char szBuf[8096]="";
 		snprintf(szBuf,8096,"fread returned wrong size = " MG_SIZE_T_SPECIFIER " [%u][%u] on line: %d.",readBytes,frameCount,vertexCount,__LINE__);
@@ -515,7 +545,7 @@ void Mesh::loadV2(int meshIndex, const string &dir, FILE *f, TextureManager *tex
 	fromEndianVecArray<Vec3f>(normals, frameCount*vertexCount);
 
 	if(textureFlags & (1<<mtDiffuse)) {
-		readBytes = fread(texCoords, sizeof(Vec2f)*vertexCount, 1, f);
+		readBytes = f->read(texCoords, sizeof(Vec2f)*vertexCount, 1);
 		if(readBytes != 1 && vertexCount != 0) {
 			char szBuf[8096]="";
 			snprintf(szBuf,8096,"fread returned wrong size = " MG_SIZE_T_SPECIFIER " [%u][%u] on line: %d.",readBytes,frameCount,vertexCount,__LINE__);
@@ -523,7 +553,7 @@ void Mesh::loadV2(int meshIndex, const string &dir, FILE *f, TextureManager *tex
 		}
 		fromEndianVecArray<Vec2f>(texCoords, vertexCount);
 	}
-	readBytes = fread(&diffuseColor, sizeof(Vec3f), 1, f);
+	readBytes = f->read(&diffuseColor, sizeof(Vec3f), 1);
 	if(readBytes != 1) {
 		char szBuf[8096]="";
 		snprintf(szBuf,8096,"fread returned wrong size = " MG_SIZE_T_SPECIFIER " on line: %d.",readBytes,__LINE__);
@@ -531,7 +561,7 @@ void Mesh::loadV2(int meshIndex, const string &dir, FILE *f, TextureManager *tex
 	}
 	fromEndianVecArray<Vec3f>(&diffuseColor, 1);
 
-	readBytes = fread(&opacity, sizeof(float32), 1, f);
+	readBytes = f->read(&opacity, sizeof(float32), 1);
 	if(readBytes != 1) {
 		char szBuf[8096]="";
 		snprintf(szBuf,8096,"fread returned wrong size = " MG_SIZE_T_SPECIFIER " on line: %d.",readBytes,__LINE__);
@@ -539,13 +569,13 @@ void Mesh::loadV2(int meshIndex, const string &dir, FILE *f, TextureManager *tex
 	}
 	opacity = Shared::PlatformByteOrder::fromCommonEndian(opacity);
 
-	int seek_result = fseek(f, sizeof(Vec4f)*(meshHeader.colorFrameCount-1), SEEK_CUR);
+	int seek_result = f->skip(sizeof(Vec4f)*(meshHeader.colorFrameCount-1));
 	if(seek_result != 0) {
 		char szBuf[8096]="";
 		snprintf(szBuf,8096,"fseek returned failure = %d [%u] on line: %d.",seek_result,indexCount,__LINE__);
 		throw megaglest_runtime_error(szBuf);
 	}
-	readBytes = fread(indices, sizeof(uint32)*indexCount, 1, f);
+	readBytes = f->read(indices, sizeof(uint32)*indexCount, 1);
 	if(readBytes != 1 && indexCount != 0) {
 		char szBuf[8096]="";
 		snprintf(szBuf,8096,"fread returned wrong size = " MG_SIZE_T_SPECIFIER " [%u] on line: %d.",readBytes,indexCount,__LINE__);
@@ -554,7 +584,7 @@ void Mesh::loadV2(int meshIndex, const string &dir, FILE *f, TextureManager *tex
 	Shared::PlatformByteOrder::fromEndianTypeArray<uint32>(indices, indexCount);
 }
 
-void Mesh::loadV3(int meshIndex, const string &dir, FILE *f,
+void Mesh::loadV3(int meshIndex, const string &dir, MappedFile *f,
 		TextureManager *textureManager,bool deletePixMapAfterLoad,
 		std::map<string,vector<pair<string, string> > > *loadedFileList,
 		string sourceLoader,string modelFile) {
@@ -562,7 +592,7 @@ void Mesh::loadV3(int meshIndex, const string &dir, FILE *f,
 
 	//read header
 	MeshHeaderV3 meshHeader;
-	size_t readBytes = fread(&meshHeader, sizeof(MeshHeaderV3), 1, f);
+	size_t readBytes = f->read(&meshHeader, sizeof(MeshHeaderV3), 1);
 	if(readBytes != 1) {
 		char szBuf[8096]="";
 		snprintf(szBuf,8096,"fread returned wrong size = " MG_SIZE_T_SPECIFIER " on line: %d.",readBytes,__LINE__);
@@ -620,7 +650,16 @@ void Mesh::loadV3(int meshIndex, const string &dir, FILE *f,
 				texPath = findAlternateTexture(conversionList, texPath);
 			}
 
+			// The same image may ship under another name, share that texture
 			if(fileExists(texPath) == true) {
+				textures[mtDiffuse]= textureManager->getTexture2DByContent(texPath);
+			}
+			if(textures[mtDiffuse] != NULL) {
+				if(loadedFileList) {
+					(*loadedFileList)[texPath].push_back(make_pair(sourceLoader,sourceLoader));
+				}
+			}
+			else if(fileExists(texPath) == true) {
 				if(SystemFlags::VERBOSE_MODE_ENABLED) printf("In [%s::%s Line: %d] v3 model texture [%s] meshIndex = %d modelFile [%s]\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__,texPath.c_str(),meshIndex,modelFile.c_str());
 
 				textures[mtDiffuse]= textureManager->newTexture2D();
@@ -642,7 +681,7 @@ void Mesh::loadV3(int meshIndex, const string &dir, FILE *f,
 	}
 
 	//read data
-	readBytes = fread(vertices, sizeof(Vec3f)*frameCount*vertexCount, 1, f);
+	readBytes = f->read(vertices, sizeof(Vec3f)*frameCount*vertexCount, 1);
 	if(readBytes != 1 && (frameCount * vertexCount) != 0) {
 		char szBuf[8096]="";
 		snprintf(szBuf,8096,"fread returned wrong size = " MG_SIZE_T_SPECIFIER " [%u][%u] on line: %d.",readBytes,frameCount,vertexCount,__LINE__);
@@ -650,7 +689,7 @@ void Mesh::loadV3(int meshIndex, const string &dir, FILE *f,
 	}
 	fromEndianVecArray<Vec3f>(vertices, frameCount*vertexCount);
 
-	readBytes = fread(normals, sizeof(Vec3f)*frameCount*vertexCount, 1, f);
+	readBytes = f->read(normals, sizeof(Vec3f)*frameCount*vertexCount, 1);
 	if(readBytes != 1 && (frameCount * vertexCount) != 0) {
 		char szBuf[8096]="";
 		snprintf(szBuf,8096,"fread returned wrong size = " MG_SIZE_T_SPECIFIER " [%u][%u] on line: %d.",readBytes,frameCount,vertexCount,__LINE__);
@@ -660,7 +699,7 @@ void Mesh::loadV3(int meshIndex, const string &dir, FILE *f,
 
 	if(textureFlags & (1<<mtDiffuse)) {
 		for(unsigned int i=0; i<meshHeader.texCoordFrameCount; ++i){
-			readBytes = fread(texCoords, sizeof(Vec2f)*vertexCount, 1, f);
+			readBytes = f->read(texCoords, sizeof(Vec2f)*vertexCount, 1);
 			if(readBytes != 1 && vertexCount != 0) {
 				char szBuf[8096]="";
 				snprintf(szBuf,8096,"fread returned wrong size = " MG_SIZE_T_SPECIFIER " [%u][%u] on line: %d.",readBytes,frameCount,vertexCount,__LINE__);
@@ -669,7 +708,7 @@ void Mesh::loadV3(int meshIndex, const string &dir, FILE *f,
 			fromEndianVecArray<Vec2f>(texCoords, vertexCount);
 		}
 	}
-	readBytes = fread(&diffuseColor, sizeof(Vec3f), 1, f);
+	readBytes = f->read(&diffuseColor, sizeof(Vec3f), 1);
 	if(readBytes != 1) {
 		char szBuf[8096]="";
 		snprintf(szBuf,8096,"fread returned wrong size = " MG_SIZE_T_SPECIFIER " on line: %d.",readBytes,__LINE__);
@@ -677,7 +716,7 @@ void Mesh::loadV3(int meshIndex, const string &dir, FILE *f,
 	}
 	fromEndianVecArray<Vec3f>(&diffuseColor, 1);
 
-	readBytes = fread(&opacity, sizeof(float32), 1, f);
+	readBytes = f->read(&opacity, sizeof(float32), 1);
 	if(readBytes != 1) {
 		char szBuf[8096]="";
 		snprintf(szBuf,8096,"fread returned wrong size = " MG_SIZE_T_SPECIFIER " on line: %d.",readBytes,__LINE__);
@@ -685,14 +724,14 @@ void Mesh::loadV3(int meshIndex, const string &dir, FILE *f,
 	}
 	opacity = Shared::PlatformByteOrder::fromCommonEndian(opacity);
 
-	int seek_result = fseek(f, sizeof(Vec4f)*(meshHeader.colorFrameCount-1), SEEK_CUR);
+	int seek_result = f->skip(sizeof(Vec4f)*(meshHeader.colorFrameCount-1));
 	if(seek_result != 0) {
 		char szBuf[8096]="";
 		snprintf(szBuf,8096,"fseek returned failure = %d [%u] on line: %d.",seek_result,indexCount,__LINE__);
 		throw megaglest_runtime_error(szBuf);
 	}
 
-	readBytes = fread(indices, sizeof(uint32)*indexCount, 1, f);
+	readBytes = f->read(indices, sizeof(uint32)*indexCount, 1);
 	if(readBytes != 1 && indexCount != 0) {
 		char szBuf[8096]="";
 		snprintf(szBuf,8096,"fread returned wrong size = " MG_SIZE_T_SPECIFIER " [%u] on line: %d.",readBytes,indexCount,__LINE__);
@@ -722,7 +761,16 @@ Texture2D* Mesh::loadMeshTexture(int meshIndex, int textureIndex,
 			if(SystemFlags::VERBOSE_MODE_ENABLED) printf("In [%s] #2 load texture [%s]\n",__FUNCTION__,textureFile.c_str());
 		}
 
+		// The same image may ship under another name, share that texture
 		if(fileExists(textureFile) == true) {
+			texture = textureManager->getTexture2DByContent(textureFile,textureChannelCount);
+		}
+		if(texture != NULL) {
+			if(loadedFileList) {
+				(*loadedFileList)[textureFile].push_back(make_pair(sourceLoader,sourceLoader));
+			}
+		}
+		else if(fileExists(textureFile) == true) {
 			if(SystemFlags::VERBOSE_MODE_ENABLED) printf("In [%s] #3 load texture [%s] modelFile [%s]\n",__FUNCTION__,textureFile.c_str(),modelFile.c_str());
 			//if(SystemFlags::VERBOSE_MODE_ENABLED) printf("In [%s] texture exists loading [%s]\n",__FUNCTION__,textureFile.c_str());
 
@@ -754,14 +802,14 @@ Texture2D* Mesh::loadMeshTexture(int meshIndex, int textureIndex,
 	return texture;
 }
 
-void Mesh::load(int meshIndex, const string &dir, FILE *f, TextureManager *textureManager,
+void Mesh::load(int meshIndex, const string &dir, MappedFile *f, TextureManager *textureManager,
 				bool deletePixMapAfterLoad,std::map<string,vector<pair<string, string> > > *loadedFileList,
 				string sourceLoader,string modelFile) {
 	this->textureManager = textureManager;
 	
 	//read header
 	MeshHeader meshHeader;
-	size_t readBytes = fread(&meshHeader, sizeof(MeshHeader), 1, f);
+	size_t readBytes = f->read(&meshHeader, sizeof(MeshHeader), 1);
 	if(readBytes != 1) {
 		char szBuf[8096]="";
 		snprintf(szBuf,8096,"fread returned wrong size = " MG_SIZE_T_SPECIFIER " on line: %d.",readBytes,__LINE__);
@@ -806,7 +854,7 @@ void Mesh::load(int meshIndex, const string &dir, FILE *f, TextureManager *textu
 		if(meshHeader.textures & flag) {
 			uint8 cMapPath[mapPathSize+1];
 			memset(&cMapPath[0],0,mapPathSize+1);
-			readBytes = fread(cMapPath, mapPathSize, 1, f);
+			readBytes = f->read(cMapPath, mapPathSize, 1);
 			cMapPath[mapPathSize] = 0;
 			if(readBytes != 1 && mapPathSize != 0) {
 				char szBuf[8096]="";
@@ -819,6 +867,7 @@ void Mesh::load(int meshIndex, const string &dir, FILE *f, TextureManager *textu
 			memset(&mapPathString[0],0,mapPathSize+1);
 			memcpy(&mapPathString[0],reinterpret_cast<char*>(cMapPath),mapPathSize);
 			string mapPath= toLower(mapPathString);
+			texturePaths[i]= mapPath;
 
 			if(SystemFlags::VERBOSE_MODE_ENABLED) printf("mapPath [%s] meshHeader.textures = %d flag = %d (meshHeader.textures & flag) = %d meshIndex = %d i = %d\n",mapPath.c_str(),meshHeader.textures,flag,(meshHeader.textures & flag),meshIndex,i);
 
@@ -837,7 +886,7 @@ void Mesh::load(int meshIndex, const string &dir, FILE *f, TextureManager *textu
 	}
 
 	//read data
-	readBytes = fread(vertices, sizeof(Vec3f)*frameCount*vertexCount, 1, f);
+	readBytes = f->read(vertices, sizeof(Vec3f)*frameCount*vertexCount, 1);
 	if(readBytes != 1 && (frameCount * vertexCount) != 0) {
 		char szBuf[8096]="";
 		snprintf(szBuf,8096,"fread returned wrong size = " MG_SIZE_T_SPECIFIER " [%u][%u] on line: %d.",readBytes,frameCount,vertexCount,__LINE__);
@@ -845,7 +894,7 @@ void Mesh::load(int meshIndex, const string &dir, FILE *f, TextureManager *textu
 	}
 	fromEndianVecArray<Vec3f>(vertices, frameCount*vertexCount);
 
-	readBytes = fread(normals, sizeof(Vec3f)*frameCount*vertexCount, 1, f);
+	readBytes = f->read(normals, sizeof(Vec3f)*frameCount*vertexCount, 1);
 	if(readBytes != 1 && (frameCount * vertexCount) != 0) {
 		char szBuf[8096]="";
 		snprintf(szBuf,8096,"fread returned wrong size = " MG_SIZE_T_SPECIFIER " [%u][%u] on line: %d.",readBytes,frameCount,vertexCount,__LINE__);
@@ -854,7 +903,7 @@ void Mesh::load(int meshIndex, const string &dir, FILE *f, TextureManager *textu
 	fromEndianVecArray<Vec3f>(normals, frameCount*vertexCount);
 
 	if(meshHeader.textures!=0){
-		readBytes = fread(texCoords, sizeof(Vec2f)*vertexCount, 1, f);
+		readBytes = f->read(texCoords, sizeof(Vec2f)*vertexCount, 1);
 		if(readBytes != 1 && vertexCount != 0) {
 			char szBuf[8096]="";
 			snprintf(szBuf,8096,"fread returned wrong size = " MG_SIZE_T_SPECIFIER " [%u][%u] on line: %d.",readBytes,frameCount,vertexCount,__LINE__);
@@ -862,7 +911,7 @@ void Mesh::load(int meshIndex, const string &dir, FILE *f, TextureManager *textu
 		}
 		fromEndianVecArray<Vec2f>(texCoords, vertexCount);
 	}
-	readBytes = fread(indices, sizeof(uint32)*indexCount, 1, f);
+	readBytes = f->read(indices, sizeof(uint32)*indexCount, 1);
 	if(readBytes != 1 && indexCount != 0) {
 		char szBuf[8096]="";
 		snprintf(szBuf,8096,"fread returned wrong size = " MG_SIZE_T_SPECIFIER " [%u] on line: %d.",readBytes,indexCount,__LINE__);
@@ -1194,12 +1243,11 @@ void Model::loadG3d(const string &path, bool deletePixMapAfterLoad,
 		string sourceLoader) {
 
     try{
-#ifdef WIN32
-		FILE *f= _wfopen(utf8_decode(path).c_str(), L"rb");
-#else
-		FILE *f=fopen(path.c_str(),"rb");
-#endif
-		if (f == NULL) {
+		// The file is mapped and parsed in one pass, the meshes copy their
+		// arrays straight out of it
+		MappedFile file;
+		MappedFile *f = &file;
+		if (f->open(path) == false) {
 		    printf("In [%s::%s] cannot load file = [%s]\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,path.c_str());
 			throw megaglest_runtime_error("Error opening g3d model file [" + path + "]",true);
 		}
@@ -1212,9 +1260,8 @@ void Model::loadG3d(const string &path, bool deletePixMapAfterLoad,
 
 		//file header
 		FileHeader fileHeader;
-		size_t readBytes = fread(&fileHeader, sizeof(FileHeader), 1, f);
+		size_t readBytes = f->read(&fileHeader, sizeof(FileHeader), 1);
 		if(readBytes != 1) {
-			fclose(f);
 			char szBuf[8096]="";
 			snprintf(szBuf,8096,"fread returned wrong size = " MG_SIZE_T_SPECIFIER " on line: %d.",readBytes,__LINE__);
 			throw megaglest_runtime_error(szBuf);
@@ -1226,8 +1273,6 @@ void Model::loadG3d(const string &path, bool deletePixMapAfterLoad,
 		memcpy(&fileId[0],reinterpret_cast<char*>(fileHeader.id),3);
 
 		if(strncmp(fileId, "G3D", 3) != 0) {
-			fclose(f);
-			f = NULL;
 		    printf("In [%s::%s] file = [%s] fileheader.id = [%s]\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,path.c_str(),fileId);
 			throw megaglest_runtime_error("Not a valid G3D model",true);
 		}
@@ -1239,7 +1284,7 @@ void Model::loadG3d(const string &path, bool deletePixMapAfterLoad,
 		if(fileHeader.version == 4) {
 			//model header
 			ModelHeader modelHeader;
-			readBytes = fread(&modelHeader, sizeof(ModelHeader), 1, f);
+			readBytes = f->read(&modelHeader, sizeof(ModelHeader), 1);
 			if(readBytes != 1) {
 				char szBuf[8096]="";
 				snprintf(szBuf,8096,"fread returned wrong size = " MG_SIZE_T_SPECIFIER " on line: %d.",readBytes,__LINE__);
@@ -1273,7 +1318,7 @@ void Model::loadG3d(const string &path, bool deletePixMapAfterLoad,
 		}
 		//version 3
 		else if(fileHeader.version == 3) {
-			readBytes = fread(&meshCount, sizeof(meshCount), 1, f);
+			readBytes = f->read(&meshCount, sizeof(meshCount), 1);
 			if(readBytes != 1 && meshCount != 0) {
 				char szBuf[8096]="";
 				snprintf(szBuf,8096,"fread returned wrong size = " MG_SIZE_T_SPECIFIER " [%u] on line: %d.",readBytes,meshCount,__LINE__);
@@ -1300,7 +1345,7 @@ void Model::loadG3d(const string &path, bool deletePixMapAfterLoad,
 		}
 		//version 2
 		else if(fileHeader.version == 2) {
-			readBytes = fread(&meshCount, sizeof(meshCount), 1, f);
+			readBytes = f->read(&meshCount, sizeof(meshCount), 1);
 			if(readBytes != 1 && meshCount != 0) {
 				char szBuf[8096]="";
 				snprintf(szBuf,8096,"fread returned wrong size = " MG_SIZE_T_SPECIFIER " [%u] on line: %d.",readBytes,meshCount,__LINE__);
@@ -1330,7 +1375,7 @@ void Model::loadG3d(const string &path, bool deletePixMapAfterLoad,
 			throw megaglest_runtime_error("Invalid model version: "+ intToStr(fileHeader.version));
 		}
 
-		fclose(f);
+		f->close();
 
 		autoJoinMeshFrames();
     }
@@ -16,11 +16,15 @@
 #include <cstdlib>
 #include <stdexcept>
 #include "util.h"
+#include "checksum.h"
+#include "mapped_file.h"
+#include "platform_common.h"
 #include "platform_util.h"
 #include "leak_dumper.h"
 
 using namespace Shared::Util;
 using namespace Shared::Platform;
+using namespace Shared::PlatformCommon;
 
 namespace Shared{ namespace Graphics{
 
@@ -40,12 +44,142 @@ ModelManager::~ModelManager(){
 	end();
 }
 
+uint32 ModelManager::getContentCRC(const string &path) {
+	MappedFile file;
+	if(file.open(path) == false || file.getSize() == 0) {
+		return 0;
+	}
+	Checksum checksum;
+	checksum.addUInt((uint32)file.getSize());
+	checksum.addBytes(file.getData(), file.getSize());
+	return checksum.getSum();
+}
+
+// Content of the texture files the model would load if read from path
+uint32 ModelManager::getTextureContentCRC(const Model *model, const string &path) {
+	string dir = extractDirectoryPathFromFile(path);
+	Checksum checksum;
+	for(uint32 meshIndex = 0; meshIndex < model->getMeshCount(); ++meshIndex) {
+		const Mesh *mesh = model->getMesh(meshIndex);
+		for(int textureIndex = 0; textureIndex < meshTextureCount; ++textureIndex) {
+			string textureFile = mesh->getTextureFile(textureIndex,dir);
+			checksum.addUInt(textureFile != "" ? getContentCRC(textureFile) : 0);
+		}
+	}
+	return checksum.getSum();
+}
+
+Model *ModelManager::findModelByContent(uint32 contentCRC, bool deletePixMapAfterLoad, const string &path) {
+	pair<uint32,bool> contentKey(contentCRC,deletePixMapAfterLoad);
+	std::multimap<pair<uint32,bool>,Model*>::iterator iterContent = modelsByContent.lower_bound(contentKey);
+	if(iterContent == modelsByContent.end() || iterContent->first != contentKey) {
+		return NULL;
+	}
+
+	uint32 textureCRC = getTextureContentCRC(iterContent->second,path);
+	for(; iterContent != modelsByContent.end() && iterContent->first == contentKey; ++iterContent) {
+		Model *model = iterContent->second;
+		std::map<Model*,uint32>::iterator iterTexture = modelTextureCRCs.find(model);
+		if(iterTexture == modelTextureCRCs.end()) {
+			iterTexture = modelTextureCRCs.insert(make_pair(model,getTextureContentCRC(model,model->getFileName()))).first;
+		}
+		if(iterTexture->second == textureCRC) {
+			return model;
+		}
+	}
+	return NULL;
+}
+
+void ModelManager::recordLoadedFiles(Model *model, const string &path, std::map<string,vector<pair<string, string> > > *loadedFileList, string *sourceLoader) {
+	if(loadedFileList == NULL) {
+		return;
+	}
+
+	// A shared model was not loaded again, still list the files this
+	// request would have loaded so they are not taken as unused
+	string loader = (sourceLoader != NULL ? *sourceLoader : "");
+	string dir = extractDirectoryPathFromFile(path);
+	(*loadedFileList)[path].push_back(make_pair(loader,loader));
+	for(uint32 meshIndex = 0; meshIndex < model->getMeshCount(); ++meshIndex) {
+		const Mesh *mesh = model->getMesh(meshIndex);
+		for(int textureIndex = 0; textureIndex < meshTextureCount; ++textureIndex) {
+			string textureFile = mesh->getTextureFile(textureIndex,dir);
+			if(textureFile != "" && fileExists(textureFile) == true) {
+				(*loadedFileList)[textureFile].push_back(make_pair(loader,loader));
+			}
+		}
+	}
+}
+
 Model *ModelManager::newModel(const string &path,bool deletePixMapAfterLoad,std::map<string,vector<pair<string, string> > > *loadedFileList, string *sourceLoader){
+	pair<string,bool> pathKey(getCanonicalPath(path),deletePixMapAfterLoad);
+	std::map<pair<string,bool>,Model*>::iterator iterPath = modelsByPath.find(pathKey);
+	if(iterPath != modelsByPath.end()) {
+		modelReferenceCounts[iterPath->second]++;
+		recordLoadedFiles(iterPath->second,path,loadedFileList,sourceLoader);
+		return iterPath->second;
+	}
+
+	// The same file copied to another folder, common between factions.
+	// Only shared when the textures next to it have the same content too
+	uint32 contentCRC = getContentCRC(path);
+	pair<uint32,bool> contentKey(contentCRC,deletePixMapAfterLoad);
+	if(contentCRC != 0) {
+		Model *model = findModelByContent(contentCRC,deletePixMapAfterLoad,path);
+		if(model != NULL) {
+			modelsByPath[pathKey] = model;
+			modelReferenceCounts[model]++;
+			recordLoadedFiles(model,path,loadedFileList,sourceLoader);
+			return model;
+		}
+	}
+
 	Model *model= GraphicsInterface::getInstance().getFactory()->newModel(path,textureManager,deletePixMapAfterLoad,loadedFileList,sourceLoader);
 	models.push_back(model);
+
+	modelsByPath[pathKey] = model;
+	if(contentCRC != 0) {
+		modelsByContent.insert(make_pair(contentKey,model));
+	}
+	modelReferenceCounts[model] = 1;
 	return model;
 }
 
+bool ModelManager::releaseModel(Model *model) {
+	std::map<Model*,int>::iterator iterCount = modelReferenceCounts.find(model);
+	if(iterCount != modelReferenceCounts.end() && iterCount->second > 1) {
+		iterCount->second--;
+		return false;
+	}
+	if(iterCount != modelReferenceCounts.end()) {
+		modelReferenceCounts.erase(iterCount);
+	}
+
+	for(std::map<pair<string,bool>,Model*>::iterator iterPath = modelsByPath.begin();
+		iterPath != modelsByPath.end();) {
+		if(iterPath->second == model) {
+			modelsByPath.erase(iterPath++);
+		}
+		else {
+			++iterPath;
+		}
+	}
+	for(std::multimap<pair<uint32,bool>,Model*>::iterator iterContent = modelsByContent.begin();
+		iterContent != modelsByContent.end(); ++iterContent) {
+		if(iterContent->second == model) {
+			modelsByContent.erase(iterContent);
+			break;
+		}
+	}
+	modelTextureCRCs.erase(model);
+	return true;
+}
+
+int ModelManager::getReferenceCount(Model *model) const {
+	std::map<Model*,int>::const_iterator iterCount = modelReferenceCounts.find(model);
+	return (iterCount != modelReferenceCounts.end() ? iterCount->second : 0);
+}
+
 void ModelManager::init(){
 	for(size_t i=0; i<models.size(); ++i){
 		if(models[i] != NULL) {
@@ -63,10 +197,19 @@ void ModelManager::end(){
 		}
 	}
 	models.clear();
+	modelsByPath.clear();
+	modelsByContent.clear();
+	modelTextureCRCs.clear();
+	modelReferenceCounts.clear();
 }
 
 void ModelManager::endModel(Model *model,bool mustExistInList) {
 	if(model != NULL) {
+		// Other users still hold the shared model
+		if(releaseModel(model) == false) {
+			return;
+		}
+
 		bool found = false;
 		for(unsigned int idx = 0; idx < models.size(); idx++) {
 			Model *curModel = models[idx];
@@ -92,6 +235,9 @@ void ModelManager::endLastModel(bool mustExistInList) {
 		found = true;
 		size_t index = models.size()-1;
 		Model *curModel = models[index];
+		if(releaseModel(curModel) == false) {
+			return;
+		}
 		models.erase(models.begin() + index);
 
 		curModel->end();
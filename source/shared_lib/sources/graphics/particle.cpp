@@ -24,6 +24,7 @@
 #include "model.h"
 #include "texture.h"
 #include "platform_util.h"
+#include "base_thread.h"
 #include "leak_dumper.h"
 
 using namespace std;
@@ -206,20 +207,7 @@ void ParticleSystem::update() {
     	particleSystemStartDelay--;
     }
     else if(state != sPause) {
-		for(int i= 0; i < aliveParticleCount; ++i) {
-			updateParticle(&particles[i]);
-
-			if(deathTest(&particles[i])) {
-
-				//kill the particle
-				killParticle(&particles[i]);
-
-				//maintain alive particles at front of the array
-				if(aliveParticleCount > 0) {
-					particles[i]= particles[aliveParticleCount];
-				}
-			}
-		}
+		updateParticles();
 
 		if(state != ParticleSystem::sFade) {
 			emissionState= emissionState + emissionRate;
@@ -325,6 +313,10 @@ ParticleSystem* ParticleSystem::getChild(int i){
 	throw std::out_of_range("ParticleSystem::getChild bad");
 }
 
+bool ParticleSystem::isUpdateIsolated() {
+	return (particleObserver == NULL && getChildCount() == 0);
+}
+
 void ParticleSystem::setVisible(bool visible){
 	this->visible= visible;
 	for(int i=getChildCount()-1; i>=0; i--) {
@@ -626,6 +618,10 @@ bool ParticleSystem::deathTest(Particle *p) {
 	return p->energy <= 0;
 }
 
+void ParticleSystem::updateParticles() {
+	updateParticleBatch(this);
+}
+
 void ParticleSystem::killParticle(Particle *p) {
 	aliveParticleCount--;
 }
@@ -716,6 +712,10 @@ void FireParticleSystem::updateParticle(Particle *p){
 
 }
 
+void FireParticleSystem::updateParticles() {
+	updateParticleBatch(this);
+}
+
 string FireParticleSystem::toString() const {
 	string result = ParticleSystem::toString();
 
@@ -1345,6 +1345,10 @@ void UnitParticleSystem::updateParticle(Particle *p){
 	}
 }
 
+void UnitParticleSystem::updateParticles() {
+	updateParticleBatch(this);
+}
+
 // ================= SET PARAMS ====================
 
 void UnitParticleSystem::setWind(float windAngle, float windSpeed){
@@ -1592,6 +1596,10 @@ bool RainParticleSystem::deathTest(Particle *p){
 	return p->pos.y < 0;
 }
 
+void RainParticleSystem::updateParticles() {
+	updateParticleBatch(this);
+}
+
 void RainParticleSystem::setRadius(float radius) {
 	this->radius= radius;
 }
@@ -1671,6 +1679,10 @@ bool SnowParticleSystem::deathTest(Particle *p){
 	return p->pos.y < 0;
 }
 
+void SnowParticleSystem::updateParticles() {
+	updateParticleBatch(this);
+}
+
 void SnowParticleSystem::setRadius(float radius){
 	this->radius= radius;
 }
@@ -1975,6 +1987,10 @@ void ProjectileParticleSystem::updateParticle(Particle *p){
 	p->energy--;
 }
 
+void ProjectileParticleSystem::updateParticles() {
+	updateParticleBatch(this);
+}
+
 void ProjectileParticleSystem::setPath(Vec3f startPos, Vec3f endPos) {
 	startPos.x = truncateDecimal<float>(startPos.x,6);
 	startPos.y = truncateDecimal<float>(startPos.y,6);
@@ -2292,6 +2308,10 @@ void SplashParticleSystem::updateParticle(Particle *p){
 	p->size = truncateDecimal<float>(p->size,6);
 }
 
+void SplashParticleSystem::updateParticles() {
+	updateParticleBatch(this);
+}
+
 void SplashParticleSystem::saveGame(XmlNode *rootNode) {
 	std::map<string,string> mapTagReplacements;
 	XmlNode *splashParticleSystemNode = rootNode->addChild("SplashParticleSystem");
@@ -2377,13 +2397,181 @@ string SplashParticleSystem::toString() const {
 //  ParticleManager
 // ===========================================================================
 
+// =====================================================
+//	class ParticleUpdateThread
+//
+///	Updates a slice of a ParticleManager's isolated systems
+// =====================================================
+
+class ParticleUpdateThread : public BaseThread {
+protected:
+	Semaphore semTaskSignalled;
+	Semaphore semTaskCompleted;
+	vector<ParticleSystem *> taskList;
+	string taskError;
+
+	virtual void setQuitStatus(bool value) {
+		BaseThread::setQuitStatus(value);
+		if(value == true) {
+			semTaskSignalled.signal();
+		}
+	}
+
+public:
+	ParticleUpdateThread() : BaseThread() {
+		uniqueID = "ParticleUpdateThread";
+	}
+
+	vector<ParticleSystem *> & getTaskList() { return taskList; }
+
+	void signalUpdate() {
+		taskError = "";
+		semTaskSignalled.signal();
+	}
+
+	// Returns an error message if the update failed or the thread died.
+	// Threads are started lazily on the frame they are first signalled, so
+	// not running yet is not an error. Only once execute() has been entered
+	// and left is the slice known to be abandoned
+	string waitForUpdate() {
+		for(;semTaskCompleted.waitTillSignalled(20) != 0;) {
+			if(getHasBeginExecution() == true && getRunningStatus() == false) {
+				return "particle update thread stopped";
+			}
+		}
+		return taskError;
+	}
+
+	virtual void execute() {
+		RunningStatusSafeWrapper runningStatus(this);
+		for(;;) {
+			if(getQuitStatus() == true) {
+				break;
+			}
+			semTaskSignalled.waitTillSignalled();
+			if(getQuitStatus() == true) {
+				break;
+			}
+
+			ExecutingTaskSafeWrapper safeExecutingTaskMutex(this);
+			try {
+				for(unsigned int i= 0; i < taskList.size(); ++i) {
+					taskList[i]->update();
+				}
+			}
+			catch(const exception &ex) {
+				SystemFlags::OutputDebug(SystemFlags::debugError,"In [%s::%s Line: %d] Error [%s]\n",__FILE__,__FUNCTION__,__LINE__,ex.what());
+				taskError = ex.what();
+			}
+			catch(...) {
+				SystemFlags::OutputDebug(SystemFlags::debugError,"In [%s::%s Line: %d] UNKNOWN Error\n",__FILE__,__FUNCTION__,__LINE__);
+				taskError = "unknown error";
+			}
+			// Always signalled, the caller waits for every slice it handed out
+			semTaskCompleted.signal();
+		}
+	}
+};
+
+// =====================================================
+//	class ParticleManager
+// =====================================================
+
+int ParticleManager::updateThreadCount = 0;
+
+// Below this many isolated systems per slice threading costs more than it saves
+static const unsigned int minParticleSystemsPerUpdateSlice = 8;
+
 ParticleManager::ParticleManager() {
 }
 
 ParticleManager::~ParticleManager() {
+	stopUpdateThreads();
 	end();
 }
 
+void ParticleManager::startUpdateThreads() {
+	for(int i= (int)updateThreadList.size(); i < updateThreadCount; ++i) {
+		ParticleUpdateThread *thread= new ParticleUpdateThread();
+		thread->setUniqueID(string(extractFileFromDirectoryPath(__FILE__).c_str()) + string("_") + intToStr(i));
+		thread->start();
+		updateThreadList.push_back(thread);
+	}
+}
+
+void ParticleManager::stopUpdateThreads() {
+	for(unsigned int i= 0; i < updateThreadList.size(); ++i) {
+		ParticleUpdateThread *thread= updateThreadList[i];
+		thread->signalQuit();
+		if(thread->shutdownAndWait() == true) {
+			delete thread;
+		}
+	}
+	updateThreadList.clear();
+}
+
+// Isolated systems are split into contiguous slices, one updated here and
+// the rest on the update threads. Systems that call out to observers or
+// touch their children run afterwards on this thread, in list order.
+void ParticleManager::updateParticleSystems(const vector<ParticleSystem *> &updateList) {
+	isolatedUpdateList.clear();
+	serialUpdateList.clear();
+	for(unsigned int i= 0; i < updateList.size(); ++i) {
+		ParticleSystem *ps= updateList[i];
+		if(ps->isUpdateIsolated() == true) {
+			isolatedUpdateList.push_back(ps);
+		}
+		else {
+			serialUpdateList.push_back(ps);
+		}
+	}
+
+	unsigned int sliceCount= min((unsigned int)updateThreadCount + 1,
+			(unsigned int)isolatedUpdateList.size() / minParticleSystemsPerUpdateSlice);
+	if(sliceCount <= 1) {
+		for(unsigned int i= 0; i < updateList.size(); ++i) {
+			updateList[i]->update();
+		}
+		return;
+	}
+
+	if(updateThreadList.size() < sliceCount - 1) {
+		startUpdateThreads();
+	}
+
+	unsigned int sliceSize= ((unsigned int)isolatedUpdateList.size() + sliceCount - 1) / sliceCount;
+	for(unsigned int slice= 1; slice < sliceCount; ++slice) {
+		vector<ParticleSystem *> &taskList= updateThreadList[slice - 1]->getTaskList();
+		unsigned int sliceStart= slice * sliceSize;
+		unsigned int sliceEnd= min(sliceStart + sliceSize, (unsigned int)isolatedUpdateList.size());
+
+		taskList.clear();
+		if(sliceStart < sliceEnd) {
+			taskList.insert(taskList.end(),isolatedUpdateList.begin() + sliceStart,isolatedUpdateList.begin() + sliceEnd);
+		}
+		updateThreadList[slice - 1]->signalUpdate();
+	}
+
+	for(unsigned int i= 0; i < sliceSize && i < isolatedUpdateList.size(); ++i) {
+		isolatedUpdateList[i]->update();
+	}
+
+	string taskError= "";
+	for(unsigned int slice= 1; slice < sliceCount; ++slice) {
+		string sliceError= updateThreadList[slice - 1]->waitForUpdate();
+		if(sliceError != "" && taskError == "") {
+			taskError= sliceError;
+		}
+	}
+	if(taskError != "") {
+		throw megaglest_runtime_error("Particle update failed: " + taskError);
+	}
+
+	for(unsigned int i= 0; i < serialUpdateList.size(); ++i) {
+		serialUpdateList[i]->update();
+	}
+}
+
 void ParticleManager::render(ParticleRenderer *pr, ModelRenderer *mr) const{
 	for(unsigned int i= 0; i < particleSystems.size(); i++){
 		ParticleSystem *ps= particleSystems[i];
@@ -2406,8 +2594,7 @@ bool ParticleManager::hasActiveParticleSystem(ParticleSystem::ParticleSystemType
 			//currentParticleCount+= ps->getAliveParticleCount();
 
 			bool showParticle= true;
-			if(dynamic_cast<UnitParticleSystem *> (ps) != NULL ||
-			   dynamic_cast<FireParticleSystem *> (ps) != NULL) {
+			if(isVisibilityManagedSystem(ps) == true) {
 				showParticle= ps->getVisible() || (ps->getState() == ParticleSystem::sFade);
 			}
 			if(showParticle == true){
@@ -2433,20 +2620,48 @@ void ParticleManager::update(int renderFps){
 	int currentParticleCount= 0;
 
 	vector<ParticleSystem *> cleanupParticleSystemsList;
-	for(unsigned int i= 0; i < particleSystems.size(); i++){
-		ParticleSystem *ps= particleSystems[i];
-		if(ps != NULL) {
-			currentParticleCount+= ps->getAliveParticleCount();
+	if(updateThreadCount > 0) {
+		vector<ParticleSystem *> updateList;
+		for(unsigned int i= 0; i < particleSystems.size(); i++){
+			ParticleSystem *ps= particleSystems[i];
+			if(ps != NULL) {
+				currentParticleCount+= ps->getAliveParticleCount();
+
+				bool showParticle= true;
+				if(isVisibilityManagedSystem(ps) == true) {
+					showParticle = ps->getVisible() || (ps->getState() == ParticleSystem::sFade);
+				}
+				if(showParticle == true){
+					updateList.push_back(ps);
+				}
+			}
+		}
 
-			bool showParticle= true;
-			if( dynamic_cast<UnitParticleSystem *> (ps) != NULL ||
-				dynamic_cast<FireParticleSystem *> (ps) != NULL) {
-				showParticle = ps->getVisible() || (ps->getState() == ParticleSystem::sFade);
+		updateParticleSystems(updateList);
+
+		// Collected in list order so cleanup matches the serial update
+		for(unsigned int i= 0; i < updateList.size(); i++){
+			ParticleSystem *ps= updateList[i];
+			if(ps->isEmpty() && ps->getState() == ParticleSystem::sFade) {
+				cleanupParticleSystemsList.push_back(ps);
 			}
-			if(showParticle == true){
-				ps->update();
-				if(ps->isEmpty() && ps->getState() == ParticleSystem::sFade) {
-					cleanupParticleSystemsList.push_back(ps);
+		}
+	}
+	else {
+		for(unsigned int i= 0; i < particleSystems.size(); i++){
+			ParticleSystem *ps= particleSystems[i];
+			if(ps != NULL) {
+				currentParticleCount+= ps->getAliveParticleCount();
+
+				bool showParticle= true;
+				if(isVisibilityManagedSystem(ps) == true) {
+					showParticle = ps->getVisible() || (ps->getState() == ParticleSystem::sFade);
+				}
+				if(showParticle == true){
+					ps->update();
+					if(ps->isEmpty() && ps->getState() == ParticleSystem::sFade) {
+						cleanupParticleSystemsList.push_back(ps);
+					}
 				}
 			}
 		}
@@ -26,6 +26,20 @@
 #include <setjmp.h>
 //#include <memory>
 #include "opengl.h"
+#include "platform_common.h"
+#include "conversion.h"
+#include "thread.h"
+#include <cstring>
+#include <algorithm>
+#ifndef WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <utime.h>
+#else
+#include <sys/utime.h>
+#endif
 #include "leak_dumper.h"
 
 using namespace Shared::Util;
@@ -893,6 +907,8 @@ void Pixmap1D::loadTga(const string &path) {
 
 // ===================== PUBLIC ========================
 
+string Pixmap2D::decodedCacheFolder = "";
+
 Pixmap2D::Pixmap2D() {
 	if(GlobalStaticFlags::getIsNonGraphicalModeEnabled() == true) {
 		throw megaglest_runtime_error("Loading graphics in headless server mode not allowed!");
@@ -902,6 +918,8 @@ Pixmap2D::Pixmap2D() {
     w= -1;
 	components= -1;
     pixels= NULL;
+	sourceFileCRC = 0;
+	sourceComponents = -1;
 }
 
 Pixmap2D::Pixmap2D(int components) {
@@ -913,6 +931,8 @@ Pixmap2D::Pixmap2D(int components) {
     w= -1;
 	this->components= -1;
     pixels= NULL;
+	sourceFileCRC = 0;
+	sourceComponents = -1;
 
 	init(components);
 }
@@ -926,6 +946,8 @@ Pixmap2D::Pixmap2D(int w, int h, int components) {
     this->w= -1;
     this->components= -1;
     pixels= NULL;
+	sourceFileCRC = 0;
+	sourceComponents = -1;
 
 	init(w, h, components);
 }
@@ -1011,11 +1033,230 @@ Pixmap2D* Pixmap2D::loadPath(const string& path) {
 void Pixmap2D::load(const string &path) {
 	//printf("Loading Pixmap2D [%s]\n",path.c_str());
 
-	FileReader<Pixmap2D>::readPath(path,this);
+	sourceComponents = components;
+	sourceFileCRC = 0;
+
+	string cacheFile = "";
+	if(decodedCacheFolder != "") {
+		sourceFileCRC = getFileCRC(path);
+		cacheFile = getDecodedCacheFile(sourceFileCRC, sourceComponents);
+	}
+
+	if(cacheFile == "" || loadDecodedCache(cacheFile) == false) {
+		FileReader<Pixmap2D>::readPath(path,this);
+		if(cacheFile != "") {
+			saveDecodedCache(cacheFile);
+		}
+	}
 	CalculatePixelsCRC(pixels,getPixelByteCount(), crc);
 	this->path = path;
 }
 
+// Decoded pixmap cache file layout, all values in host byte order since
+// the cache never leaves the machine
+static const char decodedCacheMagic[4] 	= { 'M', 'G', 'P', 'X' };
+static const uint32 decodedCacheVersion	= 1;
+
+struct DecodedCacheHeader {
+	char magic[4];
+	uint32 version;
+	uint32 sourceFileCRC;
+	int32 w;
+	int32 h;
+	int32 components;
+};
+
+void Pixmap2D::setDecodedCacheFolder(const string &folder) {
+	decodedCacheFolder = folder;
+	if(decodedCacheFolder != "") {
+		endPathWithSlash(decodedCacheFolder);
+	}
+}
+
+// Removes the least recently used cache files until the folder fits in
+// maxBytes, along with temporary files left by an interrupted write
+void Pixmap2D::purgeDecodedCache(uint64 maxBytes) {
+	if(decodedCacheFolder == "") {
+		return;
+	}
+
+	vector<string> tempFiles;
+	findAll(decodedCacheFolder + "*.tmp", tempFiles, false, false);
+	for(unsigned int i = 0; i < tempFiles.size(); ++i) {
+		removeFile(decodedCacheFolder + tempFiles[i]);
+	}
+
+	vector<string> cacheFiles;
+	findAll(decodedCacheFolder + "*.pxc", cacheFiles, false, false);
+
+	// Loading a cache file touches it, the oldest time was used longest ago
+	vector<pair<time_t,string> > filesByUse;
+	uint64 totalBytes = 0;
+	for(unsigned int i = 0; i < cacheFiles.size(); ++i) {
+		string cacheFile = decodedCacheFolder + cacheFiles[i];
+		totalBytes += getFileSize(cacheFile);
+		filesByUse.push_back(make_pair(getFileModificationTime(cacheFile), cacheFile));
+	}
+	std::sort(filesByUse.begin(), filesByUse.end());
+
+	int removedCount = 0;
+	for(unsigned int i = 0; i < filesByUse.size() && totalBytes > maxBytes; ++i) {
+		uint64 fileBytes = getFileSize(filesByUse[i].second);
+		if(removeFile(filesByUse[i].second) == true) {
+			totalBytes -= min(totalBytes, fileBytes);
+			removedCount++;
+		}
+	}
+
+	if(SystemFlags::VERBOSE_MODE_ENABLED) printf("In [%s::%s Line: %d] decoded cache files: %d removed: %d remaining MB: %d\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__,(int)cacheFiles.size(),removedCount,(int)(totalBytes / (1024 * 1024)));
+}
+
+uint32 Pixmap2D::getFileCRC(const string &path) {
+	// The same image is often looked up for deduplication and then loaded,
+	// hash each file only once as long as its size and time stay the same
+	static Mutex fileCRCCacheAccessor(CODE_AT_LINE);
+	static std::map<string, std::pair<std::pair<off_t,time_t>,uint32> > fileCRCCache;
+
+	std::pair<off_t,time_t> fileStamp(getFileSize(path), getFileModificationTime(path));
+	off_t fileSize = fileStamp.first;
+	MutexSafeWrapper safeMutex(&fileCRCCacheAccessor,CODE_AT_LINE);
+	std::map<string, std::pair<std::pair<off_t,time_t>,uint32> >::iterator iterFind = fileCRCCache.find(path);
+	if(iterFind != fileCRCCache.end() && iterFind->second.first == fileStamp) {
+		return iterFind->second.second;
+	}
+	safeMutex.ReleaseLock();
+
+#ifdef WIN32
+	FILE *file = _wfopen(utf8_decode(path).c_str(), L"rb");
+#else
+	FILE *file = fopen(path.c_str(), "rb");
+#endif
+	if(file == NULL) {
+		return 0;
+	}
+
+	Checksum checksum;
+	checksum.addUInt((uint32)fileSize);
+	char buf[65536];
+	for(size_t readBytes = fread(buf, 1, sizeof(buf), file); readBytes > 0;
+		readBytes = fread(buf, 1, sizeof(buf), file)) {
+		checksum.addBytes(buf, readBytes);
+	}
+	fclose(file);
+
+	uint32 result = checksum.getSum();
+	safeMutex.Lock();
+	fileCRCCache[path] = std::make_pair(fileStamp, result);
+	return result;
+}
+
+string Pixmap2D::getDecodedCacheFile(uint32 fileCRC, int requestedComponents) const {
+	if(fileCRC == 0) {
+		return "";
+	}
+	return decodedCacheFolder + uIntToStr(fileCRC) + "_" + intToStr(requestedComponents) + ".pxc";
+}
+
+bool Pixmap2D::loadDecodedCache(const string &cacheFile) {
+	if(fileExists(cacheFile) == false) {
+		return false;
+	}
+
+	bool result = false;
+#ifndef WIN32
+	// Map the file and copy the pixels straight out of the page cache
+	int fd = open(cacheFile.c_str(), O_RDONLY);
+	if(fd < 0) {
+		return false;
+	}
+	struct stat fileStat;
+	if(fstat(fd, &fileStat) == 0 && fileStat.st_size >= (off_t)sizeof(DecodedCacheHeader)) {
+		void *mapped = mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if(mapped != MAP_FAILED) {
+			const DecodedCacheHeader *header = static_cast<const DecodedCacheHeader *>(mapped);
+			std::size_t pixelBytes = (std::size_t)header->w * header->h * header->components;
+			if(memcmp(header->magic, decodedCacheMagic, 4) == 0 &&
+				header->version == decodedCacheVersion &&
+				header->sourceFileCRC == sourceFileCRC &&
+				header->w > 0 && header->h > 0 && header->components > 0 &&
+				(std::size_t)fileStat.st_size == sizeof(DecodedCacheHeader) + pixelBytes) {
+
+				init(header->w, header->h, header->components);
+				memcpy(pixels, static_cast<const uint8 *>(mapped) + sizeof(DecodedCacheHeader), pixelBytes);
+				result = true;
+			}
+			munmap(mapped, fileStat.st_size);
+		}
+	}
+	::close(fd);
+#else
+	FILE *file = _wfopen(utf8_decode(cacheFile).c_str(), L"rb");
+	if(file == NULL) {
+		return false;
+	}
+	DecodedCacheHeader header;
+	if(fread(&header, sizeof(header), 1, file) == 1 &&
+		memcmp(header.magic, decodedCacheMagic, 4) == 0 &&
+		header.version == decodedCacheVersion &&
+		header.sourceFileCRC == sourceFileCRC &&
+		header.w > 0 && header.h > 0 && header.components > 0) {
+
+		init(header.w, header.h, header.components);
+		result = (fread(pixels, getPixelByteCount(), 1, file) == 1);
+	}
+	fclose(file);
+#endif
+
+	// Keeps recently used files out of the startup purge
+	if(result == true) {
+#ifdef WIN32
+		_wutime(utf8_decode(cacheFile).c_str(), NULL);
+#else
+		utime(cacheFile.c_str(), NULL);
+#endif
+	}
+
+	if(SystemFlags::VERBOSE_MODE_ENABLED) printf("In [%s::%s Line: %d] decoded cache [%s] result = %d\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__,cacheFile.c_str(),result);
+	return result;
+}
+
+void Pixmap2D::saveDecodedCache(const string &cacheFile) const {
+	if(pixels == NULL || w <= 0 || h <= 0 || components <= 0) {
+		return;
+	}
+
+	// Written under a temporary name so a half written file is never used
+	string tempFile = cacheFile + ".tmp";
+#ifdef WIN32
+	FILE *file = _wfopen(utf8_decode(tempFile).c_str(), L"wb");
+#else
+	FILE *file = fopen(tempFile.c_str(), "wb");
+#endif
+	if(file == NULL) {
+		return;
+	}
+
+	DecodedCacheHeader header;
+	memcpy(header.magic, decodedCacheMagic, 4);
+	header.version = decodedCacheVersion;
+	header.sourceFileCRC = sourceFileCRC;
+	header.w = w;
+	header.h = h;
+	header.components = components;
+
+	bool written =	fwrite(&header, sizeof(header), 1, file) == 1 &&
+					fwrite(pixels, getPixelByteCount(), 1, file) == 1;
+	fclose(file);
+
+	if(written == true) {
+		removeFile(cacheFile);
+		written = (rename(tempFile.c_str(), cacheFile.c_str()) == 0);
+	}
+	if(written == false) {
+		removeFile(tempFile);
+	}
+}
+
 void Pixmap2D::save(const string &path) {
 	string extension = (path.empty() == false ? path.substr(path.find_last_of('.')+1) : "");
 	if(toLower(extension) == "bmp") {
@@ -1420,6 +1661,60 @@ bool Pixmap2D::doDimensionsAgree(const Pixmap2D *pixmap){
 	return pixmap->getW() == w && pixmap->getH() == h;
 }
 
+// =====================================================
+//	class PixmapRect
+// =====================================================
+
+void PixmapRect::add(int x, int y) {
+	if(isEmpty() == true) {
+		minX= maxX= x;
+		minY= maxY= y;
+		return;
+	}
+	minX= min(minX,x);
+	minY= min(minY,y);
+	maxX= max(maxX,x);
+	maxY= max(maxY,y);
+}
+
+void PixmapRect::add(const PixmapRect &rect) {
+	if(rect.isEmpty() == true) {
+		return;
+	}
+	if(isEmpty() == true) {
+		*this= rect;
+		return;
+	}
+	minX= min(minX,rect.minX);
+	minY= min(minY,rect.minY);
+	maxX= max(maxX,rect.maxX);
+	maxY= max(maxY,rect.maxY);
+}
+
+// =====================================================
+//	byte kernels
+// =====================================================
+
+void pixelsMax(uint8 *dest, const uint8 *src, std::size_t count) {
+	for(std::size_t i = 0; i < count; ++i) {
+		dest[i] = (src[i] > dest[i] ? src[i] : dest[i]);
+	}
+}
+
+void pixelsMaxOrLimit(uint8 *dest, const uint8 *src, uint8 limit, std::size_t count) {
+	for(std::size_t i = 0; i < count; ++i) {
+		uint8 limited = (dest[i] > limit ? limit : dest[i]);
+		dest[i] = (src[i] > dest[i] ? src[i] : limited);
+	}
+}
+
+void pixelsBlend(uint8 *dest, const uint8 *from, const uint8 *to, int count, int tFixed) {
+	for(int i = 0; i < count; ++i) {
+		uint8 blend = static_cast<uint8>((from[i] * (256 - tFixed) + to[i] * tFixed) >> 8);
+		dest[i] = (to[i] != dest[i] ? blend : dest[i]);
+	}
+}
+
 // =====================================================
 //	class Pixmap3D
 // =====================================================
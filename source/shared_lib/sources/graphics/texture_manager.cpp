@@ -52,6 +52,8 @@ void TextureManager::initTexture(Texture *texture) {
 
 void TextureManager::endTexture(Texture *texture,bool mustExistInList) {
 	if(texture != NULL) {
+		unindexTexture(texture);
+
 		bool found = false;
 		for(unsigned int idx = 0; idx < textures.size(); idx++) {
 			Texture *curTexture = textures[idx];
@@ -76,6 +78,7 @@ void TextureManager::endLastTexture(bool mustExistInList) {
 		int index = (int)textures.size()-1;
 		Texture *curTexture = textures[index];
 		textures.erase(textures.begin() + index);
+		unindexTexture(curTexture);
 
 		curTexture->end();
 		delete curTexture;
@@ -109,6 +112,9 @@ void TextureManager::end(){
 		}
 	}
 	textures.clear();
+	unindexedTextures.clear();
+	texturesByPath.clear();
+	textures2DByContent.clear();
 }
 
 void TextureManager::setFilter(Texture::Filter textureFilter){
@@ -119,18 +125,104 @@ void TextureManager::setMaxAnisotropy(int maxAnisotropy){
 	this->maxAnisotropy= maxAnisotropy;
 }
 
-Texture *TextureManager::getTexture(const string &path){
-	for(unsigned int i=0; i<textures.size(); ++i){
-		if(textures[i]->getPath()==path){
-			return textures[i];
+void TextureManager::indexPendingTextures() {
+	unsigned int keepCount = 0;
+	for(unsigned int i = 0; i < unindexedTextures.size(); ++i) {
+		Texture *texture = unindexedTextures[i];
+		string path = texture->getPath();
+		if(path == "") {
+			unindexedTextures[keepCount++] = texture;
+			continue;
+		}
+
+		// Keep the first texture for a path, same as the old linear search
+		if(texturesByPath.find(path) == texturesByPath.end()) {
+			texturesByPath[path] = texture;
+		}
+
+		Texture2D *texture2D = dynamic_cast<Texture2D *>(texture);
+		if(texture2D != NULL) {
+			const Pixmap2D *pixmap = texture2D->getPixmapConst();
+			uint32 fileCRC = pixmap->getSourceFileCRC();
+			if(fileCRC == 0) {
+				fileCRC = Pixmap2D::getFileCRC(path);
+			}
+			if(fileCRC != 0) {
+				pair<uint32,int> contentKey(fileCRC,pixmap->getSourceComponents());
+				if(textures2DByContent.find(contentKey) == textures2DByContent.end()) {
+					textures2DByContent[contentKey] = texture2D;
+				}
+			}
+		}
+	}
+	unindexedTextures.resize(keepCount);
+}
+
+void TextureManager::unindexTexture(Texture *texture) {
+	for(unsigned int i = 0; i < unindexedTextures.size(); ++i) {
+		if(unindexedTextures[i] == texture) {
+			unindexedTextures.erase(unindexedTextures.begin() + i);
+			return;
+		}
+	}
+
+	map<string,Texture*>::iterator iterPath = texturesByPath.find(texture->getPath());
+	if(iterPath != texturesByPath.end() && iterPath->second == texture) {
+		texturesByPath.erase(iterPath);
+
+		// Another texture loaded from the same path takes over the entry
+		for(unsigned int i = 0; i < textures.size(); ++i) {
+			if(textures[i] != texture && textures[i]->getPath() == texture->getPath()) {
+				unindexedTextures.push_back(textures[i]);
+				break;
+			}
 		}
 	}
+
+	for(map<pair<uint32,int>,Texture2D*>::iterator iterContent = textures2DByContent.begin();
+		iterContent != textures2DByContent.end(); ++iterContent) {
+		if(iterContent->second == texture) {
+			textures2DByContent.erase(iterContent);
+			break;
+		}
+	}
+}
+
+Texture *TextureManager::getTexture(const string &path){
+	indexPendingTextures();
+
+	map<string,Texture*>::iterator iterFind = texturesByPath.find(path);
+	if(iterFind != texturesByPath.end()) {
+		return iterFind->second;
+	}
+	return NULL;
+}
+
+Texture2D *TextureManager::getTexture2DByContent(const string &path, int components) {
+	indexPendingTextures();
+	if(textures2DByContent.empty() == true) {
+		return NULL;
+	}
+
+	uint32 fileCRC = Pixmap2D::getFileCRC(path);
+	if(fileCRC == 0) {
+		return NULL;
+	}
+	if(components == -1) {
+		components = Texture::defaultComponents;
+	}
+
+	map<pair<uint32,int>,Texture2D*>::iterator iterFind = textures2DByContent.find(make_pair(fileCRC,components));
+	if(iterFind != textures2DByContent.end()) {
+		return iterFind->second;
+	}
 	return NULL;
 }
 
 Texture1D *TextureManager::newTexture1D(){
 	Texture1D *texture1D= GraphicsInterface::getInstance().getFactory()->newTexture1D();
 	textures.push_back(texture1D);
+	unindexedTextures.push_back(texture1D);
 
 	return texture1D;
 }
@@ -138,6 +230,7 @@ Texture1D *TextureManager::newTexture1D(){
 Texture2D *TextureManager::newTexture2D(){
 	Texture2D *texture2D= GraphicsInterface::getInstance().getFactory()->newTexture2D();
 	textures.push_back(texture2D);
+	unindexedTextures.push_back(texture2D);
 
 	return texture2D;
 }
@@ -145,6 +238,7 @@ Texture2D *TextureManager::newTexture2D(){
 Texture3D *TextureManager::newTexture3D(){
 	Texture3D *texture3D= GraphicsInterface::getInstance().getFactory()->newTexture3D();
 	textures.push_back(texture3D);
+	unindexedTextures.push_back(texture3D);
 
 	return texture3D;
 }
@@ -153,6 +247,7 @@ Texture3D *TextureManager::newTexture3D(){
 TextureCube *TextureManager::newTextureCube(){
 	TextureCube *textureCube= GraphicsInterface::getInstance().getFactory()->newTextureCube();
 	textures.push_back(textureCube);
+	unindexedTextures.push_back(textureCube);
 
 	return textureCube;
 }
@@ -0,0 +1,158 @@
+// ==============================================================
+//	This file is part of Glest Shared Library (www.glest.org)
+//
+//	Copyright (C) 2001-2008 Martiño Figueroa
+//
+//	You can redistribute this code and/or modify it under
+//	the terms of the GNU General Public License as published
+//	by the Free Software Foundation; either version 2 of the
+//	License, or (at your option) any later version
+// ==============================================================
+
+#include "mapped_file.h"
+
+#include <cstdio>
+#include <cstring>
+#include "platform_common.h"
+#include "util.h"
+#ifndef WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include "leak_dumper.h"
+
+using namespace Shared::Util;
+
+namespace Shared { namespace PlatformCommon {
+
+// =====================================================
+//	class MappedFile
+// =====================================================
+
+MappedFile::MappedFile() {
+	data		= NULL;
+	size		= 0;
+	position	= 0;
+	opened		= false;
+	mapped		= false;
+}
+
+MappedFile::~MappedFile() {
+	close();
+}
+
+bool MappedFile::open(const string &path) {
+	close();
+
+#ifndef WIN32
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if(fd < 0) {
+		return false;
+	}
+	struct stat fileStat;
+	if(fstat(fd, &fileStat) != 0) {
+		::close(fd);
+		return false;
+	}
+	size = fileStat.st_size;
+	if(size > 0) {
+		void *mappedData = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if(mappedData != MAP_FAILED) {
+			// The whole file is parsed front to back right away
+			madvise(mappedData, size, MADV_WILLNEED);
+			data = static_cast<const unsigned char *>(mappedData);
+			mapped = true;
+		}
+	}
+	::close(fd);
+
+	if(size > 0 && mapped == false) {
+		if(SystemFlags::getSystemSettingType(SystemFlags::debugSystem).enabled) SystemFlags::OutputDebug(SystemFlags::debugSystem,"In [%s::%s Line: %d] mmap failed for [%s], reading it instead\n",__FILE__,__FUNCTION__,__LINE__,path.c_str());
+		size = 0;
+	}
+	else {
+		opened = true;
+		return true;
+	}
+#endif
+
+	// No mapping available, read the whole file with one call instead
+#ifdef WIN32
+	FILE *file = _wfopen(utf8_decode(path).c_str(), L"rb");
+#else
+	FILE *file = fopen(path.c_str(), "rb");
+#endif
+	if(file == NULL) {
+		return false;
+	}
+	fseek(file, 0, SEEK_END);
+	long fileSize = ftell(file);
+	fseek(file, 0, SEEK_SET);
+	if(fileSize < 0) {
+		fclose(file);
+		return false;
+	}
+
+	size = fileSize;
+	unsigned char *buffer = NULL;
+	if(size > 0) {
+		buffer = new unsigned char[size];
+		if(fread(buffer, size, 1, file) != 1) {
+			delete [] buffer;
+			fclose(file);
+			size = 0;
+			return false;
+		}
+	}
+	fclose(file);
+
+	data = buffer;
+	opened = true;
+	return true;
+}
+
+void MappedFile::close() {
+	if(data != NULL) {
+#ifndef WIN32
+		if(mapped == true) {
+			munmap(const_cast<unsigned char *>(data), size);
+		}
+		else
+#endif
+		{
+			delete [] data;
+		}
+	}
+	data		= NULL;
+	size		= 0;
+	position	= 0;
+	opened		= false;
+	mapped		= false;
+}
+
+size_t MappedFile::read(void *ptr, size_t itemSize, size_t itemCount) {
+	if(itemSize == 0 || itemCount == 0) {
+		return 0;
+	}
+
+	size_t availableCount = (size - position) / itemSize;
+	size_t readCount = (itemCount < availableCount ? itemCount : availableCount);
+	if(readCount > 0) {
+		memcpy(ptr, data + position, readCount * itemSize);
+		position += readCount * itemSize;
+	}
+	return readCount;
+}
+
+int MappedFile::skip(long offset) {
+	if((offset < 0 && (size_t)(-offset) > position) ||
+	   (offset > 0 && (size_t)offset > size - position)) {
+		return -1;
+	}
+	position += offset;
+	return 0;
+}
+
+}}//end namespace
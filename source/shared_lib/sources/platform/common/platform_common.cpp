@@ -141,16 +141,21 @@ time_t systemtime_now() {
 void PerformanceTimer::init(float fps, int maxTimes) {
 	this->times			= 0;
 	this->maxTimes		= maxTimes;
-	this->lastTicks		= SDL_GetTicks();
-	this->updateTicks	= static_cast<int>(1000.0f / fps);
+	this->lastTicks		= SDL_GetPerformanceCounter();
+	this->updateTicks	= static_cast<Uint64>(static_cast<double>(SDL_GetPerformanceFrequency()) / fps);
+	this->lastLateTicks	= 0;
 }
 
 bool PerformanceTimer::isTime() {
-	Uint32 thisTicks = SDL_GetTicks();
+	Uint64 thisTicks = SDL_GetPerformanceCounter();
 
 	if((thisTicks - lastTicks) >= updateTicks &&
 		times < maxTimes) {
 
+		// How far past its deadline the first interval of a run fired
+		if(times == 0) {
+			lastLateTicks = thisTicks - lastTicks - updateTicks;
+		}
 		lastTicks += updateTicks;
 		times++;
 		return true;
@@ -160,15 +165,44 @@ bool PerformanceTimer::isTime() {
 }
 
 void PerformanceTimer::reset() {
-	lastTicks = SDL_GetTicks();
+	lastTicks = SDL_GetPerformanceCounter();
+}
+
+// How far into the current interval we are, 0 right after isTime() fired
+// and 1 once the next one is due
+float PerformanceTimer::getIntervalProgress() const {
+	if(updateTicks == 0) {
+		return 0;
+	}
+	Uint64 elapsedTicks = SDL_GetPerformanceCounter() - lastTicks;
+	if(elapsedTicks >= updateTicks) {
+		return 1;
+	}
+	return static_cast<float>(elapsedTicks) / static_cast<float>(updateTicks);
+}
+
+// 0 when the next interval is already due
+int64 PerformanceTimer::getMicrosUntilNextTime() const {
+	Uint64 elapsedTicks = SDL_GetPerformanceCounter() - lastTicks;
+	if(elapsedTicks >= updateTicks) {
+		return 0;
+	}
+	return Chrono::countsToUnits(updateTicks - elapsedTicks,SDL_GetPerformanceFrequency(),1000000);
+}
+
+int64 PerformanceTimer::getLastLateMicros() const {
+	return Chrono::countsToUnits(lastLateTicks,SDL_GetPerformanceFrequency(),1000000);
 }
 
 // =====================================
 //         Chrono
 // =====================================
 
+// Counts come from the SDL performance counter, the highest resolution
+// monotonic clock of the platform (clock_gettime(CLOCK_MONOTONIC) or
+// QueryPerformanceCounter)
 Chrono::Chrono(bool autoStart) {
-	freq 			= 1000;
+	freq 			= SDL_GetPerformanceFrequency();
 	stopped			= true;
 	accumCount		= 0;
 
@@ -190,11 +224,11 @@ bool Chrono::isStarted() const {
 
 void Chrono::start() {
 	stopped		= false;
-	startCount 	= SDL_GetTicks();
+	startCount 	= SDL_GetPerformanceCounter();
 }
 
 void Chrono::stop() {
-	Uint32 endCount	= SDL_GetTicks();
+	Uint64 endCount	= SDL_GetPerformanceCounter();
 	accumCount 		+= endCount - startCount;
 	stopped			= true;
 }
@@ -206,7 +240,11 @@ void Chrono::reset() {
 	lastResult 		= 0;
 	lastMultiplier 	= 0;
 
-	startCount 		= SDL_GetTicks();
+	startCount 		= SDL_GetPerformanceCounter();
+}
+
+int64 Chrono::getNanos() {
+	return queryCounter(1000000000);
 }
 
 int64 Chrono::getMicros() {
@@ -221,6 +259,16 @@ int64 Chrono::getSeconds() {
 	return queryCounter(1);
 }
 
+// Split into whole seconds and remainder so counts * multiplier can not
+// overflow with nanosecond counters
+int64 Chrono::countsToUnits(Uint64 counts, Uint64 freq, int64 multiplier) {
+	if(freq == 0) {
+		return 0;
+	}
+	return static_cast<int64>((counts / freq) * multiplier +
+							  (counts % freq) * multiplier / freq);
+}
+
 int64 Chrono::queryCounter(int64 multiplier) {
 
 	if(	multiplier == lastMultiplier &&
@@ -231,7 +279,7 @@ int64 Chrono::queryCounter(int64 multiplier) {
 			return lastResult;
 		}
 		else {
-			Uint32 endCount = SDL_GetTicks();
+			Uint64 endCount = SDL_GetPerformanceCounter();
 			if(lastTickCount == endCount) {
 				return lastResult;
 			}
@@ -240,11 +288,11 @@ int64 Chrono::queryCounter(int64 multiplier) {
 
 	int64 result = 0;
 	if(stopped == true) {
-		result = multiplier * accumCount / freq;
+		result = countsToUnits(accumCount,freq,multiplier);
 	}
 	else {
-		Uint32 endCount = SDL_GetTicks();
-		result = multiplier * (accumCount + endCount - startCount) / freq;
+		Uint64 endCount = SDL_GetPerformanceCounter();
+		result = countsToUnits(accumCount + endCount - startCount,freq,multiplier);
 		lastTickCount = endCount;
 	}
 
@@ -262,6 +310,9 @@ int64 Chrono::getCurMillis() {
 int64 Chrono::getCurTicks() {
     return SDL_GetTicks();
 }
+int64 Chrono::getCurMicros() {
+	return countsToUnits(SDL_GetPerformanceCounter(),SDL_GetPerformanceFrequency(),1000000);
+}
 
 
 
@@ -569,6 +620,38 @@ string formatPath(string path) {
   return path;
 }
 
+string getCanonicalPath(const string &path) {
+	string formattedPath = formatPath(path);
+	replaceAll(formattedPath, "\\", "/");
+
+	// Resolve . and .. so different relative paths to one file compare equal
+	vector<string> parts;
+	Tokenize(formattedPath,parts,"/");
+	vector<string> resolvedParts;
+	for(unsigned int index = 0; index < parts.size(); ++index) {
+		const string &part = parts[index];
+		if(part == "" || part == ".") {
+			continue;
+		}
+		if(part == ".." && resolvedParts.empty() == false &&
+			resolvedParts.back() != "..") {
+			resolvedParts.pop_back();
+		}
+		else {
+			resolvedParts.push_back(part);
+		}
+	}
+
+	string result = (StartsWith(formattedPath, "/") == true ? "/" : "");
+	for(unsigned int index = 0; index < resolvedParts.size(); ++index) {
+		if(index > 0) {
+			result += "/";
+		}
+		result += resolvedParts[index];
+	}
+	return result;
+}
+
 void trimPathWithStartingSlash(string &path) {
 	if(StartsWith(path, "/") == true || StartsWith(path, "\\") == true) {
 		path.erase(path.begin(),path.begin()+1);
@@ -1469,6 +1552,97 @@ vector<std::pair<string,uint32> > getFolderTreeContentsCheckSumListRecursively(c
     return crcTreeCache[cacheKey];
 }
 
+// Returns path with '/' separators and without the first of rootPaths it
+// lies under, so the same file matches on hosts with different install roots
+string getFolderTreeRootRelativePath(const string &path, const vector<string> &rootPaths) {
+	string result = path;
+	replaceAll(result, "\\", "/");
+	for(unsigned int index = 0; index < rootPaths.size(); ++index) {
+		string rootPath = rootPaths[index];
+		replaceAll(rootPath, "\\", "/");
+		endPathWithSlash(rootPath);
+		if(StartsWith(result, rootPath) == true) {
+			return result.substr(rootPath.length());
+		}
+	}
+	return result;
+}
+
+// Returns the part of path below folderName, which must sit directly in
+// one of rootPaths (or lead a path already relative to them)
+string getFolderTreeRelativePath(const string &path, const vector<string> &rootPaths, const string &folderName) {
+	string result = getFolderTreeRootRelativePath(path, rootPaths);
+	string folderPrefix = folderName + "/";
+	if(StartsWith(result, folderPrefix) == false) {
+		return "";
+	}
+	return result.substr(folderPrefix.length());
+}
+
+// Compares a local and a remote per file CRC list of the same folder tree,
+// returns the remote files (relative to folderName) that are missing or
+// different locally and optionally the local files the remote side lacks
+vector<string> getFolderTreeContentsCheckSumListMismatches(const vector<std::pair<string,uint32> > &localList,
+		const vector<std::pair<string,uint32> > &remoteList, const vector<string> &rootPaths,
+		const string &folderName, vector<string> *localOnlyFiles) {
+	std::map<string,uint32> localCRCs;
+	std::map<string,string> localPaths;
+	for(unsigned int index = 0; index < localList.size(); ++index) {
+		string relativePath = getFolderTreeRelativePath(localList[index].first, rootPaths, folderName);
+		if(relativePath != "") {
+			localCRCs[relativePath] = localList[index].second;
+			localPaths[relativePath] = localList[index].first;
+		}
+	}
+
+	vector<string> result;
+	for(unsigned int index = 0; index < remoteList.size(); ++index) {
+		string relativePath = getFolderTreeRelativePath(remoteList[index].first, rootPaths, folderName);
+		if(relativePath == "") {
+			continue;
+		}
+
+		std::map<string,uint32>::iterator iterFind = localCRCs.find(relativePath);
+		if(iterFind == localCRCs.end() || iterFind->second != remoteList[index].second) {
+			if(std::find(result.begin(),result.end(),relativePath) == result.end()) {
+				result.push_back(relativePath);
+			}
+		}
+		localPaths.erase(relativePath);
+	}
+
+	if(localOnlyFiles != NULL) {
+		localOnlyFiles->clear();
+		for(std::map<string,string>::iterator iterMap = localPaths.begin();
+			iterMap != localPaths.end(); ++iterMap) {
+			localOnlyFiles->push_back(iterMap->second);
+		}
+	}
+	return result;
+}
+
+// One CRC over the files of a per file CRC list that do not end in
+// excludeFileExt, taken in order of their path relative to folderName so
+// hosts with different install roots agree
+uint32 getFolderTreeContentsCheckSumExcluding(const vector<std::pair<string,uint32> > &fileList,
+		const vector<string> &rootPaths, const string &folderName, const string &excludeFileExt) {
+	std::map<string,uint32> fileCRCs;
+	for(unsigned int index = 0; index < fileList.size(); ++index) {
+		string relativePath = getFolderTreeRelativePath(fileList[index].first, rootPaths, folderName);
+		if(relativePath != "" && EndsWith(toLower(relativePath), excludeFileExt) == false) {
+			fileCRCs[relativePath] = fileList[index].second;
+		}
+	}
+
+	Checksum checksum;
+	for(std::map<string,uint32>::iterator iterMap = fileCRCs.begin();
+		iterMap != fileCRCs.end(); ++iterMap) {
+		checksum.addString(iterMap->first);
+		checksum.addUInt(iterMap->second);
+	}
+	return checksum.getSum();
+}
+
 string extractFileFromDirectoryPath(string filename) {
 	size_t lastDirectory     = filename.find_last_of("/\\");
 	if (lastDirectory == string::npos) {
@@ -1997,6 +2171,23 @@ off_t getFileSize(string filename) {
   return 0;
 }
 
+time_t getFileModificationTime(string filename) {
+#ifdef WIN32
+  #if defined(__MINGW32__)
+  struct _stat stbuf;
+  #else
+  struct _stat64i32 stbuf;
+  #endif
+  if(_wstat(utf8_decode(filename).c_str(), &stbuf) != -1) {
+#else
+  struct stat stbuf;
+  if(stat(filename.c_str(), &stbuf) != -1) {
+#endif
+	  return stbuf.st_mtime;
+  }
+  return 0;
+}
+
 string executable_path(const string &exeName, bool includeExeNameInPath) {
 	string value = "";
 #ifdef _WIN32
@@ -631,35 +631,23 @@ bool SimpleTaskThread::getTaskSignalled() {
 
 // -------------------------------------------------
 
-LogFileThread::LogFileThread() : BaseThread(), mutexLogList(new Mutex(CODE_AT_LINE)) {
+LogFileThread::LogFileThread() : BaseThread() {
 	uniqueID = "LogFileThread";
-    logList.clear();
+	SDL_AtomicSet(&logQueueCount,0);
     lastSaveToDisk = time(NULL);
-    static string mutexOwnerId = CODE_AT_LINE;
-    mutexLogList->setOwnerId(mutexOwnerId);
 }
 
 LogFileThread::~LogFileThread() {
-
-	delete mutexLogList;
-	mutexLogList = NULL;
-
 	if(SystemFlags::VERBOSE_MODE_ENABLED) printf("#1 In [%s::%s Line: %d] LogFile thread is deleting\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__);
 }
 
-void LogFileThread::addLogEntry(SystemFlags::DebugType type, string logEntry) {
-	static string mutexOwnerId = CODE_AT_LINE;
-    MutexSafeWrapper safeMutex(mutexLogList,mutexOwnerId);
-    mutexLogList->setOwnerId(mutexOwnerId);
+void LogFileThread::addLogEntry(SystemFlags::DebugType type, const string &logEntry) {
 	LogFileEntry entry;
 	entry.type = type;
 	entry.entry = logEntry;
 	entry.entryDateTime = time(NULL);
-	logList.push_back(entry);
-
-    //if(logList.size() >= 750000) {
-    //    saveToDisk(false,true);
-    //}
+	logQueue.push(entry);
+	SDL_AtomicAdd(&logQueueCount,1);
 }
 
 bool LogFileThread::checkSaveCurrentLogBufferToDisk() {
@@ -694,7 +682,7 @@ void LogFileThread::execute() {
             for(;this->getQuitStatus() == false;) {
                 while(this->getQuitStatus() == false &&
                 	  checkSaveCurrentLogBufferToDisk() == true) {
-                    saveToDisk(false,false);
+                    saveToDisk();
                 }
                 if(this->getQuitStatus() == false) {
                     sleep(25);
@@ -703,7 +691,7 @@ void LogFileThread::execute() {
 
             // Ensure remaining entryies are logged to disk on shutdown
             if(SystemFlags::VERBOSE_MODE_ENABLED) printf("In [%s::%s Line: %d]\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__);
-            saveToDisk(true,false);
+            saveToDisk();
             if(SystemFlags::VERBOSE_MODE_ENABLED) printf("In [%s::%s Line: %d]\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__);
         }
         catch(const exception &ex) {
@@ -728,12 +716,8 @@ void LogFileThread::execute() {
 }
 
 std::size_t LogFileThread::getLogEntryBufferCount() {
-	static string mutexOwnerId = CODE_AT_LINE;
-    MutexSafeWrapper safeMutex(mutexLogList,mutexOwnerId);
-    mutexLogList->setOwnerId(mutexOwnerId);
-    std::size_t logCount = logList.size();
-    safeMutex.ReleaseLock();
-    return logCount;
+	int logCount = SDL_AtomicGet(&logQueueCount);
+	return (logCount > 0 ? (std::size_t)logCount : 0);
 }
 
 bool LogFileThread::canShutdown(bool deleteSelfIfShutdownDelayed) {
@@ -747,45 +731,16 @@ bool LogFileThread::canShutdown(bool deleteSelfIfShutdownDelayed) {
 	return ret;
 }
 
-void LogFileThread::saveToDisk(bool forceSaveAll,bool logListAlreadyLocked) {
-	static string mutexOwnerId = CODE_AT_LINE;
-    MutexSafeWrapper safeMutex(NULL,mutexOwnerId);
-    if(logListAlreadyLocked == false) {
-        safeMutex.setMutex(mutexLogList);
-        mutexLogList->setOwnerId(mutexOwnerId);
-    }
-
-    std::size_t logCount = logList.size();
-    if(logCount > 0) {
-        vector<LogFileEntry> tempLogList = logList;
-        safeMutex.ReleaseLock(true);
-
-        logCount = tempLogList.size();
-        //if(forceSaveAll == false) {
-        //    logCount = min(logCount,(std::size_t)2000000);
-        //}
-
-        if(logCount > 0) {
-            for(unsigned int i = 0; i < logCount; ++i) {
-                LogFileEntry &entry = tempLogList[i];
-                SystemFlags::logDebugEntry(entry.type, entry.entry, entry.entryDateTime);
-            }
-
-            safeMutex.Lock();
-            if(logList.size() > 0) {
-				if(logList.size() < logCount) {
-					char szBuf[8096]="";
-					snprintf(szBuf,8096,"logList.size() <= logCount [%lld][%lld]",(long long int)logList.size(),(long long int)logCount);
-					throw megaglest_runtime_error(szBuf);
-				}
-				logList.erase(logList.begin(),logList.begin() + logCount);
-            }
-            safeMutex.ReleaseLock();
-        }
-    }
-    else {
-        safeMutex.ReleaseLock();
-    }
+// Entries are formatted with their timestamp and written here, off the
+// threads that logged them. Only what was queued on entry is written so
+// busy loggers can not keep this going forever.
+void LogFileThread::saveToDisk() {
+	int logCount = SDL_AtomicGet(&logQueueCount);
+	LogFileEntry entry;
+	for(int index = 0; index < logCount && logQueue.pop(entry) == true; ++index) {
+		SDL_AtomicAdd(&logQueueCount,-1);
+		SystemFlags::logDebugEntry(entry.type, entry.entry, entry.entryDateTime);
+	}
 }
 
 }}//end namespace
@@ -191,7 +191,7 @@ void event_join(irc_session_t * session, const char * event, const char * origin
 
             if(SystemFlags::VERBOSE_MODE_ENABLED || IRCThread::debugEnabled) printf ("===> IRC: Line: %d\n", __LINE__);
 
-            MutexSafeWrapper safeMutex(ctx->getMutexNickList(),string(__FILE__) + "_" + intToStr(__LINE__));
+            MutexSafeWrapper safeMutex(ctx->getMutexNickList(),CODE_AT_LINE);
             std::vector<string> nickList = ctx->getCachedNickList();
             for(unsigned int i = 0;
                              i < nickList.size(); ++i) {
@@ -319,7 +319,7 @@ void event_channel(irc_session_t * session, const char * event, const char * ori
 
     IRCThread *ctx = (IRCThread *)irc_get_ctx(session);
 	if(ctx != NULL) {
-        MutexSafeWrapper safeMutex(ctx->getMutexIRCCB(),string(__FILE__) + "_" + intToStr(__LINE__));
+        MutexSafeWrapper safeMutex(ctx->getMutexIRCCB(),CODE_AT_LINE);
         IRCCallbackInterface *cb = ctx->getCallbackObj(false);
         if(cb != NULL) {
             cb->IRC_CallbackEvent(IRC_evt_chatText, realNick, params, count);
@@ -399,7 +399,7 @@ void event_leave(irc_session_t *session, const char *event, const char *origin,
 
         IRCThread *ctx = (IRCThread *)irc_get_ctx(session);
         if(ctx != NULL) {
-            MutexSafeWrapper safeMutex(ctx->getMutexNickList(),string(__FILE__) + "_" + intToStr(__LINE__));
+            MutexSafeWrapper safeMutex(ctx->getMutexNickList(),CODE_AT_LINE);
             std::vector<string> &nickList = ctx->getCachedNickList();
             for(unsigned int i = 0;
                              i < nickList.size(); ++i) {
@@ -491,7 +491,7 @@ void event_numeric(irc_session_t * session, unsigned int event, const char * ori
 
                     IRCThread *ctx = (IRCThread *)irc_get_ctx(session);
                     if(ctx != NULL) {
-                        MutexSafeWrapper safeMutex(ctx->getMutexNickList(),string(__FILE__) + "_" + intToStr(__LINE__));
+                        MutexSafeWrapper safeMutex(ctx->getMutexNickList(),CODE_AT_LINE);
                         ctx->setCachedNickList(nickList);
                     }
                 }
@@ -518,14 +518,14 @@ void event_numeric(irc_session_t * session, unsigned int event, const char * ori
 #endif
 
 bool IRCThread::getEventDataDone() {
-	MutexSafeWrapper safeMutex(&mutexEventDataDone,string(__FILE__) + "_" + intToStr(__LINE__));
+	MutexSafeWrapper safeMutex(&mutexEventDataDone,CODE_AT_LINE);
 	bool result = eventDataDone;
 	safeMutex.ReleaseLock();
 
 	return result;
 }
 void IRCThread::setEventDataDone(bool value) {
-	MutexSafeWrapper safeMutex(&mutexEventDataDone,string(__FILE__) + "_" + intToStr(__LINE__));
+	MutexSafeWrapper safeMutex(&mutexEventDataDone,CODE_AT_LINE);
 	eventDataDone=value;
 }
 
@@ -546,7 +546,7 @@ IRCThread::IRCThread(const std::vector<string> &argv, IRCCallbackInterface *call
 void IRCThread::disconnect() {
 #if !defined(DISABLE_IRCCLIENT)
 
-	MutexSafeWrapper safeMutex(&mutexIRCSession,string(__FILE__) + "_" + intToStr(__LINE__));
+	MutexSafeWrapper safeMutex(&mutexIRCSession,CODE_AT_LINE);
 	bool validSession = (ircSession != NULL);
 	safeMutex.ReleaseLock();
 
@@ -554,7 +554,7 @@ void IRCThread::disconnect() {
         setCallbackObj(NULL);
         if(SystemFlags::VERBOSE_MODE_ENABLED || IRCThread::debugEnabled) printf ("===> IRC: Quitting Channel\n");
 
-        MutexSafeWrapper safeMutex1(&mutexIRCSession,string(__FILE__) + "_" + intToStr(__LINE__));
+        MutexSafeWrapper safeMutex1(&mutexIRCSession,CODE_AT_LINE);
         if(ircSession != NULL) {
         	irc_disconnect(ircSession);
         }
@@ -573,7 +573,7 @@ void IRCThread::signalQuit() {
 
 #if !defined(DISABLE_IRCCLIENT)
 
-	MutexSafeWrapper safeMutex(&mutexIRCSession,string(__FILE__) + "_" + intToStr(__LINE__));
+	MutexSafeWrapper safeMutex(&mutexIRCSession,CODE_AT_LINE);
 	bool validSession = (ircSession != NULL);
 	safeMutex.ReleaseLock();
 
@@ -581,7 +581,7 @@ void IRCThread::signalQuit() {
         setCallbackObj(NULL);
         if(SystemFlags::VERBOSE_MODE_ENABLED || IRCThread::debugEnabled) printf ("===> IRC: Quitting Channel\n");
 
-        MutexSafeWrapper safeMutex1(&mutexIRCSession,string(__FILE__) + "_" + intToStr(__LINE__));
+        MutexSafeWrapper safeMutex1(&mutexIRCSession,CODE_AT_LINE);
         if(ircSession != NULL) {
         	irc_cmd_quit(ircSession, "MG Bot is closing!");
         }
@@ -603,7 +603,7 @@ bool IRCThread::shutdownAndWait() {
 }
 
 void IRCThread::SendIRCCmdMessage(string target, string msg) {
-	MutexSafeWrapper safeMutex(&mutexIRCSession,string(__FILE__) + "_" + intToStr(__LINE__));
+	MutexSafeWrapper safeMutex(&mutexIRCSession,CODE_AT_LINE);
 	bool validSession = (ircSession != NULL);
 	safeMutex.ReleaseLock();
 
@@ -611,7 +611,7 @@ void IRCThread::SendIRCCmdMessage(string target, string msg) {
     	if(SystemFlags::getSystemSettingType(SystemFlags::debugNetwork).enabled) SystemFlags::OutputDebug(SystemFlags::debugNetwork,"In [%s::%s Line: %d] sending IRC command to [%s] cmd [%s]\n",__FILE__,__FUNCTION__,__LINE__,target.c_str(),msg.c_str());
 
 #if !defined(DISABLE_IRCCLIENT)
-    	MutexSafeWrapper safeMutex1(&mutexIRCSession,string(__FILE__) + "_" + intToStr(__LINE__));
+    	MutexSafeWrapper safeMutex1(&mutexIRCSession,CODE_AT_LINE);
     	int ret = 0;
     	if(ircSession != NULL) {
     		ret = irc_cmd_msg (ircSession, target.c_str(), msg.c_str());
@@ -627,7 +627,7 @@ std::vector<string> IRCThread::GetIRCConnectedNickList(string target, bool waitF
     setEventDataDone(false);
 
     if(SystemFlags::VERBOSE_MODE_ENABLED || IRCThread::debugEnabled) printf ("===> IRC: Line: %d\n", __LINE__);
-	MutexSafeWrapper safeMutexSession(&mutexIRCSession,string(__FILE__) + "_" + intToStr(__LINE__));
+	MutexSafeWrapper safeMutexSession(&mutexIRCSession,CODE_AT_LINE);
 	bool validSession = (ircSession != NULL);
 	safeMutexSession.ReleaseLock();
 
@@ -640,7 +640,7 @@ std::vector<string> IRCThread::GetIRCConnectedNickList(string target, bool waitF
 
     	if(SystemFlags::VERBOSE_MODE_ENABLED || IRCThread::debugEnabled) printf ("===> IRC: Line: %d\n", __LINE__);
 
-    	MutexSafeWrapper safeMutex1(&mutexIRCSession,string(__FILE__) + "_" + intToStr(__LINE__));
+    	MutexSafeWrapper safeMutex1(&mutexIRCSession,CODE_AT_LINE);
 
     	if(SystemFlags::VERBOSE_MODE_ENABLED || IRCThread::debugEnabled) printf ("===> IRC: Line: %d\n", __LINE__);
         int ret = irc_cmd_names (ircSession, target.c_str());
@@ -671,7 +671,7 @@ std::vector<string> IRCThread::GetIRCConnectedNickList(string target, bool waitF
 
     if(SystemFlags::VERBOSE_MODE_ENABLED || IRCThread::debugEnabled) printf ("===> IRC: Line: %d\n", __LINE__);
 
-    MutexSafeWrapper safeMutex(&mutexNickList,string(__FILE__) + "_" + intToStr(__LINE__));
+    MutexSafeWrapper safeMutex(&mutexNickList,CODE_AT_LINE);
     std::vector<string> nickList = eventData;
     safeMutex.ReleaseLock();
 
@@ -683,7 +683,7 @@ std::vector<string> IRCThread::GetIRCConnectedNickList(string target, bool waitF
 bool IRCThread::isConnected(bool mutexLockRequired) {
     bool ret = false;
     if(this->getQuitStatus() == false) {
-		MutexSafeWrapper safeMutex(NULL,string(__FILE__) + "_" + intToStr(__LINE__));
+		MutexSafeWrapper safeMutex(NULL,CODE_AT_LINE);
 		int lockStatus = 0;
 		if(mutexLockRequired == true) {
 			lockStatus = safeMutex.setMutexAndTryLock(&mutexIRCSession);
@@ -695,7 +695,7 @@ bool IRCThread::isConnected(bool mutexLockRequired) {
 
 		if(validSession == true) {
 #if !defined(DISABLE_IRCCLIENT)
-			MutexSafeWrapper safeMutex1(NULL,string(__FILE__) + "_" + intToStr(__LINE__));
+			MutexSafeWrapper safeMutex1(NULL,CODE_AT_LINE);
 			if(ircSession != NULL) {
 				lockStatus = 0;
 				if(mutexLockRequired == true) {
@@ -714,7 +714,7 @@ bool IRCThread::isConnected(bool mutexLockRequired) {
 }
 
 std::vector<string> IRCThread::getNickList() {
-    MutexSafeWrapper safeMutex(&mutexNickList,string(__FILE__) + "_" + intToStr(__LINE__));
+    MutexSafeWrapper safeMutex(&mutexNickList,CODE_AT_LINE);
     std::vector<string> nickList = eventData;
     safeMutex.ReleaseLock();
 
@@ -722,14 +722,14 @@ std::vector<string> IRCThread::getNickList() {
 }
 
 IRCCallbackInterface * IRCThread::getCallbackObj(bool lockObj) {
-    MutexSafeWrapper safeMutex(NULL,string(__FILE__) + "_" + intToStr(__LINE__));
+    MutexSafeWrapper safeMutex(NULL,CODE_AT_LINE);
     if(lockObj == true) {
         safeMutex.setMutex(&mutexIRCCB);
     }
     return callbackObj;
 }
 void IRCThread::setCallbackObj(IRCCallbackInterface *cb) {
-    MutexSafeWrapper safeMutex(&mutexIRCCB,string(__FILE__) + "_" + intToStr(__LINE__));
+    MutexSafeWrapper safeMutex(&mutexIRCCB,CODE_AT_LINE);
     callbackObj=cb;
 }
 
@@ -751,7 +751,7 @@ void IRCThread::execute() {
 #if !defined(DISABLE_IRCCLIENT)
             irc_callbacks_t	callbacks;
 
-        	MutexSafeWrapper safeMutex(&mutexIRCSession,string(__FILE__) + "_" + intToStr(__LINE__));
+        	MutexSafeWrapper safeMutex(&mutexIRCSession,CODE_AT_LINE);
         	ircSession=NULL;
         	safeMutex.ReleaseLock(true);
 
@@ -886,7 +886,7 @@ void IRCThread::execute() {
 		//printf("In ~IRCThread Line: %d [%p]\n",__LINE__,this);
 		// Delete ourself when the thread is done (no other actions can happen after this
 		// such as the mutex which modifies the running status of this method
-		MutexSafeWrapper safeMutex(&mutexIRCCB,string(__FILE__) + "_" + intToStr(__LINE__));
+		MutexSafeWrapper safeMutex(&mutexIRCCB,CODE_AT_LINE);
 		IRCCallbackInterface *cb = getCallbackObj(false);
 		if(cb != NULL) {
 			//printf("In ~IRCThread Line: %d [%p]\n",__LINE__,this);
@@ -911,7 +911,7 @@ int IRCThread::irc_run_session(irc_session_t * session) {
 //		return 1;
 //	}
 
-	MutexSafeWrapper safeMutex(&mutexIRCSession,string(__FILE__) + "_" + intToStr(__LINE__));
+	MutexSafeWrapper safeMutex(&mutexIRCSession,CODE_AT_LINE);
 
 	if ( isConnected(false) == false ) {
 		//session->lasterror = LIBIRC_ERR_STATE;
@@ -1024,7 +1024,7 @@ void normalizeNick(char *nick) {
 void IRCThread::connectToHost() {
 	bool connectRequired = false;
 
-	MutexSafeWrapper safeMutex(&mutexIRCSession,string(__FILE__) + "_" + intToStr(__LINE__));
+	MutexSafeWrapper safeMutex(&mutexIRCSession,CODE_AT_LINE);
 	bool validSession = (ircSession != NULL);
 	safeMutex.ReleaseLock();
 
@@ -1034,7 +1034,7 @@ void IRCThread::connectToHost() {
 	else {
 #if !defined(DISABLE_IRCCLIENT)
 
-		MutexSafeWrapper safeMutex1(&mutexIRCSession,string(__FILE__) + "_" + intToStr(__LINE__));
+		MutexSafeWrapper safeMutex1(&mutexIRCSession,CODE_AT_LINE);
 		int result = irc_is_connected(ircSession);
 		if(result != 1) {
 			connectRequired = true;
@@ -1045,7 +1045,7 @@ void IRCThread::connectToHost() {
 
 	if(connectRequired == false) {
 #if !defined(DISABLE_IRCCLIENT)
-		MutexSafeWrapper safeMutex1(&mutexIRCSession,string(__FILE__) + "_" + intToStr(__LINE__));
+		MutexSafeWrapper safeMutex1(&mutexIRCSession,CODE_AT_LINE);
         if(irc_connect(ircSession, argv[0].c_str(), IRC_SERVER_PORT, 0, this->nick.c_str(), this->username.c_str(), "megaglest")) {
         	safeMutex1.ReleaseLock();
 
@@ -1061,14 +1061,14 @@ void IRCThread::joinChannel() {
 	wantToLeaveChannel = false;
 	connectToHost();
 
-	MutexSafeWrapper safeMutex(&mutexIRCSession,string(__FILE__) + "_" + intToStr(__LINE__));
+	MutexSafeWrapper safeMutex(&mutexIRCSession,CODE_AT_LINE);
 	bool validSession = (ircSession != NULL);
 	safeMutex.ReleaseLock();
 
 	if(validSession == true) {
 #if !defined(DISABLE_IRCCLIENT)
 
-		MutexSafeWrapper safeMutex1(&mutexIRCSession,string(__FILE__) + "_" + intToStr(__LINE__));
+		MutexSafeWrapper safeMutex1(&mutexIRCSession,CODE_AT_LINE);
 		IRCThread *ctx = (IRCThread *)irc_get_ctx(ircSession);
 		if(ctx != NULL) {
 			eventData.clear();
@@ -1087,14 +1087,14 @@ void IRCThread::joinChannel() {
 void IRCThread::leaveChannel() {
 	wantToLeaveChannel = true;
 
-	MutexSafeWrapper safeMutex(&mutexIRCSession,string(__FILE__) + "_" + intToStr(__LINE__));
+	MutexSafeWrapper safeMutex(&mutexIRCSession,CODE_AT_LINE);
 	bool validSession = (ircSession != NULL);
 	safeMutex.ReleaseLock();
 
 	if(validSession == true) {
 #if !defined(DISABLE_IRCCLIENT)
 
-		MutexSafeWrapper safeMutex1(&mutexIRCSession,string(__FILE__) + "_" + intToStr(__LINE__));
+		MutexSafeWrapper safeMutex1(&mutexIRCSession,CODE_AT_LINE);
 		IRCThread *ctx = (IRCThread *)irc_get_ctx(ircSession);
 		if(ctx != NULL) {
 			irc_cmd_part(ircSession,ctx->getChannel().c_str());
@@ -439,6 +439,19 @@ void FTPClientThread::addTechtreeToRequests(string techtreeName,string URL) {
     }
 }
 
+void FTPClientThread::addTechtreeFilesToRequests(string techtreeName,vector<string> changedFiles,vector<string> removedFiles) {
+	FTPClientFileDeltaRequest item;
+	item.itemName = techtreeName;
+	item.changedFiles = changedFiles;
+	item.removedFiles = removedFiles;
+	static string mutexOwnerId = string(__FILE__) + string("_") + intToStr(__LINE__);
+    MutexSafeWrapper safeMutex(&mutexTechtreeList,mutexOwnerId);
+    mutexTechtreeList.setOwnerId(mutexOwnerId);
+    if(std::find(techtreeDeltaList.begin(),techtreeDeltaList.end(),item) == techtreeDeltaList.end()) {
+    	techtreeDeltaList.push_back(item);
+    }
+}
+
 void FTPClientThread::addScenarioToRequests(string fileName,string URL) {
 	std::pair<string,string> item = make_pair(fileName,URL);
 	static string mutexOwnerId = string(__FILE__) + string("_") + intToStr(__LINE__);
@@ -741,6 +754,104 @@ pair<FTP_Client_ResultType,string>  FTPClientThread::getTechtreeFromServer(pair<
 
 }
 
+void FTPClientThread::getTechtreeFilesFromServer(FTPClientFileDeltaRequest request) {
+	pair<FTP_Client_ResultType,string> result = make_pair(ftp_crt_SUCCESS,"");
+
+	if(SystemFlags::VERBOSE_MODE_ENABLED) printf("FTPClientThread::getTechtreeFilesFromServer [%s] changed files: " MG_SIZE_T_SPECIFIER " removed files: " MG_SIZE_T_SPECIFIER "\n",request.itemName.c_str(),request.changedFiles.size(),request.removedFiles.size());
+
+	string destRootFolder = this->techtreesPath.second;
+	endPathWithSlash(destRootFolder);
+	destRootFolder += request.itemName;
+	endPathWithSlash(destRootFolder);
+
+	// Every changed file is fetched next to the old one before any is
+	// swapped in, so a failed update leaves the techtree as it was
+	for(unsigned int index = 0; index < request.changedFiles.size(); ++index) {
+		if(this->getQuitStatus() == true) {
+			result = make_pair(ftp_crt_FAIL,"cancelled");
+			break;
+		}
+		result = getTechtreeFileFromServer(request.itemName, request.changedFiles[index]);
+		if(result.first != ftp_crt_SUCCESS) {
+			break;
+		}
+	}
+
+	for(unsigned int index = 0; index < request.changedFiles.size(); ++index) {
+		string relativeFile = request.changedFiles[index];
+		if(relativeFile == "" || relativeFile.find("..") != relativeFile.npos) {
+			continue;
+		}
+		string destFile = destRootFolder + relativeFile;
+		string destFileSaveAs = destFile + ".part";
+		if(fileExists(destFileSaveAs) == false) {
+			continue;
+		}
+
+		if(result.first != ftp_crt_SUCCESS) {
+			removeFile(destFileSaveAs);
+			continue;
+		}
+		if(fileExists(destFile) == true) {
+			removeFile(destFile);
+		}
+		if(renameFile(destFileSaveAs,destFile) == false) {
+			result.first = ftp_crt_FAIL;
+			result.second = "failed to replace file [" + destFile + "]";
+		}
+	}
+
+	if(result.first == ftp_crt_SUCCESS) {
+		for(unsigned int index = 0; index < request.removedFiles.size(); ++index) {
+			string removedFile = request.removedFiles[index];
+			// Only ever touch the downloadable copy of the techtree
+			if(StartsWith(removedFile,destRootFolder) == true &&
+				removedFile.find("..") == removedFile.npos) {
+				removeFile(removedFile);
+			}
+		}
+	}
+
+	static string mutexOwnerId = string(__FILE__) + string("_") + intToStr(__LINE__);
+    MutexSafeWrapper safeMutex(this->getProgressMutex(),mutexOwnerId);
+    this->getProgressMutex()->setOwnerId(mutexOwnerId);
+    if(this->pCBObject != NULL) {
+        this->pCBObject->FTPClient_CallbackEvent(
+        		request.itemName,
+        		ftp_cct_Techtree,
+        		result,
+        		NULL);
+    }
+}
+
+pair<FTP_Client_ResultType,string> FTPClientThread::getTechtreeFileFromServer(string techtreeName, string relativeFile) {
+	if(techtreeName == "" || relativeFile == "" || relativeFile.find("..") != relativeFile.npos) {
+		return make_pair(ftp_crt_FAIL,"invalid file [" + relativeFile + "]");
+	}
+
+	string destFile = this->techtreesPath.second;
+	endPathWithSlash(destFile);
+	destFile += techtreeName + "/" + relativeFile;
+	// Download next to the old file, the caller swaps it in once the whole
+	// update has arrived
+	string destFileSaveAs = destFile + ".part";
+	string remotePath = techtreeName + "/" + relativeFile;
+	pair<string,string> fileNameTitle = make_pair(techtreeName,"");
+
+	pair<FTP_Client_ResultType,string> result = getFileFromServer(ftp_cct_Techtree,
+			fileNameTitle, remotePath, destFileSaveAs,
+			FTP_TECHTREES_CUSTOM_USERNAME, FTP_COMMON_PASSWORD);
+	if(result.first == ftp_crt_FAIL && this->getQuitStatus() == false) {
+		result = getFileFromServer(ftp_cct_Techtree,
+				fileNameTitle, remotePath, destFileSaveAs,
+				FTP_TECHTREES_USERNAME, FTP_COMMON_PASSWORD);
+	}
+
+	if(SystemFlags::VERBOSE_MODE_ENABLED) printf("FTPClientThread::getTechtreeFileFromServer [%s] remotePath [%s] destFile [%s] result.first = %d [%s]\n",techtreeName.c_str(),remotePath.c_str(),destFile.c_str(),result.first,result.second.c_str());
+
+	return result;
+}
+
 void FTPClientThread::getScenarioFromServer(pair<string,string> fileName) {
 	pair<FTP_Client_ResultType,string> result = make_pair(ftp_crt_FAIL,"");
 	bool findArchive = executeShellCommand(
@@ -1170,6 +1281,13 @@ void FTPClientThread::execute() {
 
                     getTechtreeFromServer(techtree);
                 }
+                else if(techtreeDeltaList.size() > 0) {
+                	FTPClientFileDeltaRequest techtreeDelta = techtreeDeltaList[0];
+                	techtreeDeltaList.erase(techtreeDeltaList.begin() + 0);
+                    safeMutex3.ReleaseLock();
+
+                    getTechtreeFilesFromServer(techtreeDelta);
+                }
                 else {
                     safeMutex3.ReleaseLock();
                 }
@@ -14,6 +14,7 @@
 #include <assert.h>
 #include "noimpl.h"
 #include <algorithm>
+#include <set>
 #include "platform_util.h"
 #include "platform_common.h"
 #include "base_thread.h"
@@ -476,7 +477,144 @@ public:
 const bool debugMutexLock 						= false;
 //const int debugMutexLockMillisecondThreshold 	= 2000;
 
-Mutex::Mutex(string ownerId) {
+// =====================================================
+//	class MutexContentionProfiler
+// =====================================================
+
+bool MutexContentionProfiler::enabled = false;
+
+// Function local statics so mutexes created during static initialization
+// can use the profiler regardless of translation unit order
+SDL_mutex * MutexContentionProfiler::getStatsAccessor() {
+	static SDL_mutex *statsAccessor = SDL_CreateMutex();
+	return statsAccessor;
+}
+
+MutexContentionProfiler::MutexContentionStatsList & MutexContentionProfiler::getStatsList() {
+	static MutexContentionStatsList statsList;
+	return statsList;
+}
+
+void MutexContentionProfiler::setEnabled(bool value) {
+	enabled = value;
+}
+
+int64 MutexContentionProfiler::getMicrosSince(Uint64 counter) {
+	static Uint64 frequency = SDL_GetPerformanceFrequency();
+	if(frequency == 0) {
+		return 0;
+	}
+	Uint64 elapsed = SDL_GetPerformanceCounter() - counter;
+	return (int64)(elapsed * 1000000 / frequency);
+}
+
+void MutexContentionProfiler::addAcquire(const char *mutexId, bool contended, int64 waitMicros) {
+	SDL_mutex *statsAccessor = getStatsAccessor();
+	SDLMutexSafeWrapper safeMutex(&statsAccessor,true);
+
+	MutexContentionStats &stats = getStatsList()[make_pair(mutexId,Thread::getCurrentThreadId())];
+	stats.acquireCount++;
+	if(contended == true) {
+		stats.contendedCount++;
+		stats.waitMicros += waitMicros;
+		stats.maxWaitMicros = max(stats.maxWaitMicros,waitMicros);
+	}
+}
+
+void MutexContentionProfiler::addHold(const char *mutexId, int64 holdMicros) {
+	SDL_mutex *statsAccessor = getStatsAccessor();
+	SDLMutexSafeWrapper safeMutex(&statsAccessor,true);
+
+	MutexContentionStats &stats = getStatsList()[make_pair(mutexId,Thread::getCurrentThreadId())];
+	stats.holdMicros += holdMicros;
+	stats.maxHoldMicros = max(stats.maxHoldMicros,holdMicros);
+}
+
+void MutexContentionProfiler::clearStats() {
+	SDL_mutex *statsAccessor = getStatsAccessor();
+	SDLMutexSafeWrapper safeMutex(&statsAccessor,true);
+
+	getStatsList().clear();
+}
+
+bool MutexContentionProfiler::compareByWaitMicros(const pair<MutexThreadKey,MutexContentionStats> &a,
+													const pair<MutexThreadKey,MutexContentionStats> &b) {
+	return a.second.waitMicros > b.second.waitMicros;
+}
+
+string MutexContentionProfiler::getStats() {
+	vector<pair<MutexThreadKey,MutexContentionStats> > sortedStats;
+	{
+		SDL_mutex *statsAccessor = getStatsAccessor();
+		SDLMutexSafeWrapper safeMutex(&statsAccessor,true);
+
+		MutexContentionStatsList &statsList = getStatsList();
+		sortedStats.assign(statsList.begin(),statsList.end());
+	}
+
+	// Most waited on first
+	std::sort(sortedStats.begin(),sortedStats.end(),compareByWaitMicros);
+
+	std::ostringstream out;
+	out << "Mutex contention stats (" << (enabled == true ? "enabled" : "disabled") << "):\n";
+	for(unsigned int i = 0; i < sortedStats.size(); ++i) {
+		const MutexThreadKey &key = sortedStats[i].first;
+		const MutexContentionStats &stats = sortedStats[i].second;
+		out << "[" << (key.first != NULL ? key.first : "unknown") << "] thread: " << key.second
+			<< " locks: " << stats.acquireCount
+			<< " contended: " << stats.contendedCount
+			<< " wait us: " << stats.waitMicros
+			<< " max wait us: " << stats.maxWaitMicros
+			<< " hold us: " << stats.holdMicros
+			<< " max hold us: " << stats.maxHoldMicros << "\n";
+	}
+	return out.str();
+}
+
+// =====================================================
+//	class Mutex
+// =====================================================
+
+const char * Mutex::internOwnerId(const string &ownerId) {
+	static SDL_mutex *internAccessor = SDL_CreateMutex();
+	static std::set<string> internedOwnerIds;
+
+	SDLMutexSafeWrapper safeMutex(&internAccessor,true);
+	return internedOwnerIds.insert(ownerId).first->c_str();
+}
+
+void Mutex::profiledLock() {
+	if(SDL_TryLockMutex(mutex) == 0) {
+		refCount++;
+		if(refCount == 1) {
+			lockAcquiredCounter = SDL_GetPerformanceCounter();
+			MutexContentionProfiler::addAcquire(profileId,false,0);
+		}
+		return;
+	}
+
+	Uint64 waitStart = SDL_GetPerformanceCounter();
+	SDL_LockMutex(mutex);
+	refCount++;
+	if(refCount == 1) {
+		lockAcquiredCounter = SDL_GetPerformanceCounter();
+		MutexContentionProfiler::addAcquire(profileId,true,
+				MutexContentionProfiler::getMicrosSince(waitStart));
+	}
+}
+
+void Mutex::profiledUnlock() {
+	int64 holdMicros = MutexContentionProfiler::getMicrosSince(lockAcquiredCounter);
+	lockAcquiredCounter = 0;
+	const char *lockProfileId = profileId;
+
+	refCount--;
+	SDL_UnlockMutex(mutex);
+
+	MutexContentionProfiler::addHold(lockProfileId,holdMicros);
+}
+
+Mutex::Mutex(const string &ownerId) {
 	this->isStaticMutexListMutex 	= false;
 	this->mutexAccessor 			= SDL_CreateMutex();
 
@@ -493,6 +631,8 @@ Mutex::Mutex(string ownerId) {
 		throw megaglest_runtime_error(szBuf);
 	}
 	this->deleteownerId 			= "";
+	this->profileId 				= internOwnerId(ownerId);
+	this->lockAcquiredCounter 		= 0;
 
 	this->chronoPerf 				= NULL;
 	if(debugMutexLock == true) {
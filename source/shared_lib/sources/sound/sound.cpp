@@ -14,9 +14,13 @@
 #include <fstream>
 #include <stdexcept>
 #include "util.h"
+#include "conversion.h"
+#include "platform_common.h"
+#include "platform_util.h"
 #include "leak_dumper.h"
 
 using namespace Shared::Util;
+using namespace Shared::PlatformCommon;
 namespace Shared { namespace Sound {
 
 //bool Sound::masterserverMode = false;
@@ -48,9 +52,9 @@ Sound::Sound() {
 // =====================================================
 
 StaticSound::StaticSound() {
-	samples= NULL;
 	soundFileLoader = NULL;
 	fileName = "";
+	cacheKey = "";
 }
 
 StaticSound::~StaticSound() {
@@ -58,9 +62,9 @@ StaticSound::~StaticSound() {
 }
 
 void StaticSound::close() {
-	if(samples != NULL) {
-		delete [] samples;
-		samples = NULL;
+	if(cacheKey != "") {
+		SoundSampleCache::getInstance().removeReference(cacheKey);
+		cacheKey = "";
 	}
 
 	if(soundFileLoader!=NULL){
@@ -78,19 +82,310 @@ void StaticSound::load(const string &path) {
 	if(GlobalStaticFlags::getIsNonGraphicalModeEnabled() == true) {
 		return;
 	}
-	string ext = (path.empty() == false ? path.substr(path.find_last_of('.')+1) : "");
-	soundFileLoader= SoundFileLoaderFactory::getInstance()->newInstance(ext);
 
+	// Only the header is read here, the samples are decoded when the
+	// sound is first played
+	string key = SoundSampleCache::getCacheKey(path);
+	SoundSampleCache::getInstance().addReference(key, &info);
+	cacheKey = key;
+}
+
+int8 * StaticSound::getSamples() const {
+	if(cacheKey == "") {
+		return NULL;
+	}
+	return SoundSampleCache::getInstance().getSamples(cacheKey);
+}
+
+void StaticSound::releaseSamples() const {
+	if(cacheKey != "") {
+		SoundSampleCache::getInstance().releaseSamples(cacheKey);
+	}
+}
+
+// =====================================================
+//	class StaticSoundSamplesSafeWrapper
+// =====================================================
+
+StaticSoundSamplesSafeWrapper::StaticSoundSamplesSafeWrapper(const StaticSound *sound) {
+	this->sound = sound;
+	this->samples = sound->getSamples();
+}
+
+StaticSoundSamplesSafeWrapper::~StaticSoundSamplesSafeWrapper() {
+	if(samples != NULL) {
+		sound->releaseSamples();
+	}
+}
+
+// =====================================================
+//	class SoundSampleCache
+// =====================================================
+
+SoundSampleCache::SoundSampleCache() : mutex(CODE_AT_LINE) {
+	useCounter			= 0;
+	residentBytes		= 0;
+	maxResidentBytes	= 0;
+	prefetchEnabled		= false;
+	hitCount			= 0;
+	decodeCount			= 0;
+	evictionCount		= 0;
+}
+
+// Never deleted, static sounds owned by other singletons still release
+// their references while the program exits
+SoundSampleCache & SoundSampleCache::getInstance() {
+	static SoundSampleCache *soundSampleCache = new SoundSampleCache();
+	return *soundSampleCache;
+}
+
+string SoundSampleCache::getCacheKey(const string &path) {
+	return getCanonicalPath(path);
+}
+
+SoundFileLoader * SoundSampleCache::newLoader(const string &path) {
+	string ext = (path.empty() == false ? path.substr(path.find_last_of('.')+1) : "");
+	SoundFileLoader *soundFileLoader = SoundFileLoaderFactory::getInstance()->newInstance(ext);
 	if(soundFileLoader == NULL) {
 		throw megaglest_runtime_error("soundFileLoader == NULL");
 	}
-	soundFileLoader->open(path, &info);
-	samples= new int8[info.getSize()];
-	soundFileLoader->read(samples, info.getSize());
-	soundFileLoader->close();
+	return soundFileLoader;
+}
 
+int8 * SoundSampleCache::decode(const string &path, const SoundInfo &info) {
+	SoundFileLoader *soundFileLoader = newLoader(path);
+	int8 *samples = NULL;
+	try {
+		SoundInfo decodedInfo;
+		soundFileLoader->open(path, &decodedInfo);
+		samples = new int8[info.getSize()];
+		soundFileLoader->read(samples, info.getSize());
+		soundFileLoader->close();
+	}
+	catch(...) {
+		delete [] samples;
+		delete soundFileLoader;
+		throw;
+	}
 	delete soundFileLoader;
-	soundFileLoader= NULL;
+	return samples;
+}
+
+void SoundSampleCache::addReference(const string &key, SoundInfo *info) {
+	MutexSafeWrapper safeMutex(&mutex,CODE_AT_LINE);
+	SampleEntryMap::iterator iterFind = entries.find(key);
+	if(iterFind == entries.end()) {
+		safeMutex.ReleaseLock();
+
+		SoundInfo headerInfo;
+		SoundFileLoader *soundFileLoader = newLoader(key);
+		try {
+			soundFileLoader->open(key, &headerInfo);
+			soundFileLoader->close();
+		}
+		catch(...) {
+			delete soundFileLoader;
+			throw;
+		}
+		delete soundFileLoader;
+
+		safeMutex.Lock();
+		iterFind = entries.find(key);
+		if(iterFind == entries.end()) {
+			SampleEntry &entry = entries[key];
+			entry.info = headerInfo;
+			iterFind = entries.find(key);
+
+			if(prefetchEnabled == true) {
+				prefetchQueue.push_back(key);
+			}
+		}
+	}
+
+	iterFind->second.referenceCount++;
+	*info = iterFind->second.info;
+}
+
+void SoundSampleCache::removeReference(const string &key) {
+	MutexSafeWrapper safeMutex(&mutex,CODE_AT_LINE);
+	SampleEntryMap::iterator iterFind = entries.find(key);
+	if(iterFind == entries.end()) {
+		return;
+	}
+
+	SampleEntry &entry = iterFind->second;
+	entry.referenceCount--;
+	// Samples still being copied out are freed by releaseSamples instead
+	if(entry.referenceCount <= 0 && entry.pinCount <= 0) {
+		if(entry.samples != NULL) {
+			residentBytes -= entry.info.getSize();
+			delete [] entry.samples;
+			entry.samples = NULL;
+		}
+		entries.erase(iterFind);
+	}
+}
+
+int8 * SoundSampleCache::getSamples(const string &key) {
+	MutexSafeWrapper safeMutex(&mutex,CODE_AT_LINE);
+	SampleEntryMap::iterator iterFind = entries.find(key);
+	if(iterFind == entries.end()) {
+		return NULL;
+	}
+
+	if(iterFind->second.samples != NULL) {
+		hitCount++;
+	}
+	else {
+		// Decode without holding the lock so other sounds can still play
+		SoundInfo info = iterFind->second.info;
+		safeMutex.ReleaseLock();
+		int8 *samples = decode(key, info);
+		safeMutex.Lock();
+
+		iterFind = entries.find(key);
+		if(iterFind == entries.end()) {
+			delete [] samples;
+			return NULL;
+		}
+		if(iterFind->second.samples == NULL) {
+			iterFind->second.samples = samples;
+			residentBytes += info.getSize();
+			decodeCount++;
+		}
+		else {
+			delete [] samples;
+		}
+	}
+
+	iterFind->second.lastUsed = ++useCounter;
+	iterFind->second.pinCount++;
+	evictUnused(key);
+	return iterFind->second.samples;
+}
+
+void SoundSampleCache::releaseSamples(const string &key) {
+	MutexSafeWrapper safeMutex(&mutex,CODE_AT_LINE);
+	SampleEntryMap::iterator iterFind = entries.find(key);
+	if(iterFind == entries.end()) {
+		return;
+	}
+
+	SampleEntry &entry = iterFind->second;
+	entry.pinCount--;
+	if(entry.pinCount > 0) {
+		return;
+	}
+	if(entry.referenceCount <= 0) {
+		if(entry.samples != NULL) {
+			residentBytes -= entry.info.getSize();
+			delete [] entry.samples;
+			entry.samples = NULL;
+		}
+		entries.erase(iterFind);
+	}
+	else {
+		// Eviction may have been held back while the samples were pinned
+		evictUnused("");
+	}
+}
+
+void SoundSampleCache::evictUnused(const string &keepKey) {
+	while(maxResidentBytes > 0 && residentBytes > maxResidentBytes) {
+		SampleEntryMap::iterator oldest = entries.end();
+		for(SampleEntryMap::iterator iterMap = entries.begin();
+			iterMap != entries.end(); ++iterMap) {
+			if(iterMap->second.samples != NULL && iterMap->second.pinCount <= 0 &&
+				iterMap->first != keepKey &&
+				(oldest == entries.end() || iterMap->second.lastUsed < oldest->second.lastUsed)) {
+				oldest = iterMap;
+			}
+		}
+		if(oldest == entries.end()) {
+			break;
+		}
+
+		residentBytes -= oldest->second.info.getSize();
+		delete [] oldest->second.samples;
+		oldest->second.samples = NULL;
+		evictionCount++;
+	}
+}
+
+int SoundSampleCache::decodePendingPrefetches(int maxCount) {
+	int decoded = 0;
+	for(; decoded < maxCount; ++decoded) {
+		MutexSafeWrapper safeMutex(&mutex,CODE_AT_LINE);
+		if(prefetchQueue.empty() == true ||
+			(maxResidentBytes > 0 && residentBytes >= maxResidentBytes)) {
+			break;
+		}
+		string key = prefetchQueue.front();
+		prefetchQueue.erase(prefetchQueue.begin());
+
+		SampleEntryMap::iterator iterFind = entries.find(key);
+		if(iterFind == entries.end() || iterFind->second.samples != NULL) {
+			continue;
+		}
+		SoundInfo info = iterFind->second.info;
+		safeMutex.ReleaseLock();
+
+		int8 *samples = NULL;
+		try {
+			samples = decode(key, info);
+		}
+		catch(const exception &ex) {
+			SystemFlags::OutputDebug(SystemFlags::debugError,"In [%s::%s Line: %d] Error [%s]\n",__FILE__,__FUNCTION__,__LINE__,ex.what());
+			continue;
+		}
+
+		safeMutex.Lock();
+		iterFind = entries.find(key);
+		if(iterFind != entries.end() && iterFind->second.samples == NULL) {
+			iterFind->second.samples = samples;
+			iterFind->second.lastUsed = ++useCounter;
+			residentBytes += info.getSize();
+			decodeCount++;
+		}
+		else {
+			delete [] samples;
+		}
+	}
+	return decoded;
+}
+
+void SoundSampleCache::setMaxResidentBytes(uint64 value) {
+	MutexSafeWrapper safeMutex(&mutex,CODE_AT_LINE);
+	maxResidentBytes = value;
+	evictUnused("");
+}
+
+void SoundSampleCache::setPrefetchEnabled(bool value) {
+	MutexSafeWrapper safeMutex(&mutex,CODE_AT_LINE);
+	prefetchEnabled = value;
+	if(prefetchEnabled == false) {
+		prefetchQueue.clear();
+	}
+}
+
+uint64 SoundSampleCache::getResidentBytes() {
+	MutexSafeWrapper safeMutex(&mutex,CODE_AT_LINE);
+	return residentBytes;
+}
+
+int SoundSampleCache::getEntryCount() {
+	MutexSafeWrapper safeMutex(&mutex,CODE_AT_LINE);
+	return (int)entries.size();
+}
+
+string SoundSampleCache::getStats() {
+	MutexSafeWrapper safeMutex(&mutex,CODE_AT_LINE);
+	string result = "Sound sample cache files: " + intToStr(entries.size()) +
+			" resident bytes: " + intToStr(residentBytes) +
+			" hits: " + intToStr(hitCount) +
+			" decodes: " + intToStr(decodeCount) +
+			" evictions: " + intToStr(evictionCount);
+	return result;
 }
 
 // =====================================================
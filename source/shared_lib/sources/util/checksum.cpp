@@ -374,7 +374,7 @@ uint32 Checksum::getSum() {
 		for(std::map<string,uint32>::iterator iterMap = fileList.begin();
 			iterMap != fileList.end(); ++iterMap) {
 
-			MutexSafeWrapper safeMutexSocketDestructorFlag(&Checksum::fileListCacheSynchAccessor,string(__FILE__) + "_" + intToStr(__LINE__));
+			MutexSafeWrapper safeMutexSocketDestructorFlag(&Checksum::fileListCacheSynchAccessor,CODE_AT_LINE);
 			if(Checksum::fileListCache.find(iterMap->first) == Checksum::fileListCache.end()) {
 				Checksum fileResult;
 				//bool fileAddedOk = fileResult.addFileToSum(iterMap->first);
@@ -418,14 +418,14 @@ uint32 Checksum::getFileCount() {
 }
 
 void Checksum::removeFileFromCache(const string file) {
-	MutexSafeWrapper safeMutexSocketDestructorFlag(&Checksum::fileListCacheSynchAccessor,string(__FILE__) + "_" + intToStr(__LINE__));
+	MutexSafeWrapper safeMutexSocketDestructorFlag(&Checksum::fileListCacheSynchAccessor,CODE_AT_LINE);
     if(Checksum::fileListCache.find(file) != Checksum::fileListCache.end()) {
         Checksum::fileListCache.erase(file);
     }
 }
 
 void Checksum::clearFileCache() {
-	MutexSafeWrapper safeMutexSocketDestructorFlag(&Checksum::fileListCacheSynchAccessor,string(__FILE__) + "_" + intToStr(__LINE__));
+	MutexSafeWrapper safeMutexSocketDestructorFlag(&Checksum::fileListCacheSynchAccessor,CODE_AT_LINE);
     Checksum::fileListCache.clear();
 }
 
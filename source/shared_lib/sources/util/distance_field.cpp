@@ -0,0 +1,190 @@
+// ==============================================================
+//	This file is part of Glest Shared Library (www.glest.org)
+//
+//	Copyright (C) 2001-2008 Martiño Figueroa
+//
+//	You can redistribute this code and/or modify it under
+//	the terms of the GNU General Public License as published
+//	by the Free Software Foundation; either version 2 of the
+//	License, or (at your option) any later version
+// ==============================================================
+
+#include "distance_field.h"
+
+#include "leak_dumper.h"
+
+namespace Shared{ namespace Util{
+
+// =====================================================
+//	class DistanceField
+// =====================================================
+
+const uint16 DistanceField::unreachable = 0xFFFF;
+
+static const int neighbourX[] = { -1,  0,  1, -1, 1, -1, 0, 1 };
+static const int neighbourY[] = { -1, -1, -1,  0, 0,  1, 1, 1 };
+
+DistanceField::DistanceField() {
+	w = 0;
+	h = 0;
+}
+
+void DistanceField::clear() {
+	w = 0;
+	h = 0;
+	distances.clear();
+	nearestSources.clear();
+	buckets.clear();
+}
+
+// Shorter, or as short and leading to a source with a lower cell index
+bool DistanceField::isCloser(int cellIndex, int distance, int nearestSource) const {
+	return distance < distances[cellIndex] ||
+			(distance == distances[cellIndex] && nearestSource < nearestSources[cellIndex]);
+}
+
+void DistanceField::push(int cellIndex, int distance, int nearestSource) {
+	distances[cellIndex] = distance;
+	nearestSources[cellIndex] = nearestSource;
+	if((int)buckets.size() <= distance) {
+		buckets.resize(distance + 1);
+	}
+	buckets[distance].push_back(cellIndex);
+}
+
+void DistanceField::propagate(const DistanceFieldCellsInterface *cells, int startDistance) {
+	// Every step costs one, so a bucket per distance visits cells in order
+	// without a priority queue. A cell only gets closer from cells one step
+	// nearer, which are all done before its own bucket starts
+	for(int distance = startDistance; distance < (int)buckets.size(); ++distance) {
+		for(unsigned int index = 0; index < buckets[distance].size(); ++index) {
+			int cellIndex = buckets[distance][index];
+			// Reached again later with a shorter distance
+			if(distances[cellIndex] != distance || distance + 1 >= unreachable) {
+				continue;
+			}
+
+			int x = cellIndex % w;
+			int y = cellIndex / w;
+			for(int neighbour = 0; neighbour < 8; ++neighbour) {
+				int nx = x + neighbourX[neighbour];
+				int ny = y + neighbourY[neighbour];
+				if(nx < 0 || ny < 0 || nx >= w || ny >= h) {
+					continue;
+				}
+				int neighbourIndex = ny * w + nx;
+				if(isCloser(neighbourIndex, distance + 1, nearestSources[cellIndex]) == true &&
+					cells->isDistanceFieldCellBlocked(neighbourIndex) == false) {
+					push(neighbourIndex, distance + 1, nearestSources[cellIndex]);
+				}
+			}
+		}
+		buckets[distance].clear();
+	}
+	buckets.clear();
+}
+
+void DistanceField::build(const DistanceFieldCellsInterface *cells, int w, int h, const std::vector<int> &sources) {
+	this->w = w;
+	this->h = h;
+	distances.assign(w * h, unreachable);
+	nearestSources.assign(w * h, -1);
+	buckets.clear();
+
+	for(unsigned int index = 0; index < sources.size(); ++index) {
+		push(sources[index], 0, sources[index]);
+	}
+	propagate(cells, 0);
+}
+
+bool DistanceField::relaxFromNeighbours(const DistanceFieldCellsInterface *cells, int cellIndex) {
+	if(cells->isDistanceFieldCellBlocked(cellIndex) == true) {
+		return false;
+	}
+
+	bool improved = false;
+	int x = cellIndex % w;
+	int y = cellIndex / w;
+	for(int neighbour = 0; neighbour < 8; ++neighbour) {
+		int nx = x + neighbourX[neighbour];
+		int ny = y + neighbourY[neighbour];
+		if(nx < 0 || ny < 0 || nx >= w || ny >= h) {
+			continue;
+		}
+		int neighbourIndex = ny * w + nx;
+		if(nearestSources[neighbourIndex] >= 0 && distances[neighbourIndex] + 1 < unreachable &&
+			isCloser(cellIndex, distances[neighbourIndex] + 1, nearestSources[neighbourIndex]) == true) {
+			push(cellIndex, distances[neighbourIndex] + 1, nearestSources[neighbourIndex]);
+			improved = true;
+		}
+	}
+	return improved;
+}
+
+// The source cell must already be open (or still blocked) in cells
+void DistanceField::removeSource(const DistanceFieldCellsInterface *cells, int cellIndex) {
+	if(isBuilt() == false || nearestSources[cellIndex] != cellIndex) {
+		return;
+	}
+
+	// The cells that led to the removed source form one connected region,
+	// each has a neighbour one step nearer that led to it too. Forget
+	// their distances
+	std::vector<int> region;
+	region.push_back(cellIndex);
+	distances[cellIndex] = unreachable;
+	nearestSources[cellIndex] = -1;
+	for(unsigned int index = 0; index < region.size(); ++index) {
+		int x = region[index] % w;
+		int y = region[index] / w;
+		for(int neighbour = 0; neighbour < 8; ++neighbour) {
+			int nx = x + neighbourX[neighbour];
+			int ny = y + neighbourY[neighbour];
+			if(nx < 0 || ny < 0 || nx >= w || ny >= h) {
+				continue;
+			}
+			int neighbourIndex = ny * w + nx;
+			if(nearestSources[neighbourIndex] == cellIndex) {
+				distances[neighbourIndex] = unreachable;
+				nearestSources[neighbourIndex] = -1;
+				region.push_back(neighbourIndex);
+			}
+		}
+	}
+
+	// Fill it again from the cells around it, which can also reach past
+	// it through the now open source cell
+	int startDistance = unreachable;
+	for(unsigned int index = 0; index < region.size(); ++index) {
+		if(relaxFromNeighbours(cells, region[index]) == true &&
+			distances[region[index]] < startDistance) {
+			startDistance = distances[region[index]];
+		}
+	}
+	if(startDistance != unreachable) {
+		propagate(cells, startDistance);
+	}
+}
+
+// A blocked cell became open, paths through it can be shorter
+void DistanceField::openCell(const DistanceFieldCellsInterface *cells, int cellIndex) {
+	if(isBuilt() == true && relaxFromNeighbours(cells, cellIndex) == true) {
+		propagate(cells, distances[cellIndex]);
+	}
+}
+
+int DistanceField::getDistance(int cellIndex) const {
+	if(isBuilt() == false) {
+		return unreachable;
+	}
+	return distances[cellIndex];
+}
+
+int DistanceField::getNearestSource(int cellIndex) const {
+	if(isBuilt() == false) {
+		return -1;
+	}
+	return nearestSources[cellIndex];
+}
+
+}}//end namespace
@@ -0,0 +1,114 @@
+// ==============================================================
+//	This file is part of Glest Shared Library (www.glest.org)
+//
+//	Copyright (C) 2001-2008 Martiño Figueroa
+//
+//	You can redistribute this code and/or modify it under
+//	the terms of the GNU General Public License as published
+//	by the Free Software Foundation; either version 2 of the
+//	License, or (at your option) any later version
+// ==============================================================
+
+#include "lag_estimator.h"
+
+#include "leak_dumper.h"
+
+namespace Shared{ namespace Util{
+
+// =====================================================
+//	class KeyframeHistory
+// =====================================================
+
+KeyframeHistory::KeyframeHistory() {
+	clear();
+}
+
+void KeyframeHistory::clear() {
+	for(int index = 0; index < historySize; ++index) {
+		frames[index] = -1;
+		micros[index] = 0;
+	}
+	nextIndex = 0;
+	lastFrame = -1;
+}
+
+// Records when frameCount was broadcast. The frame last recorded is
+// ignored, so a paused game re-sending the same keyframe does not push the
+// older ones out, and an older one means the frames started over
+bool KeyframeHistory::add(int frameCount, int64 nowMicros) {
+	if(frameCount == lastFrame) {
+		return false;
+	}
+	if(frameCount < lastFrame) {
+		clear();
+	}
+	frames[nextIndex] = frameCount;
+	micros[nextIndex] = nowMicros;
+	nextIndex = (nextIndex + 1) % historySize;
+	lastFrame = frameCount;
+	return true;
+}
+
+// When frameCount was broadcast, -1 if it is not in the history. A frame
+// older than the whole history gets the oldest broadcast time, which is a
+// lower bound
+int64 KeyframeHistory::getBroadcastMicros(int frameCount) const {
+	int oldestIndex = -1;
+	for(int index = 0; index < historySize; ++index) {
+		if(frames[index] < 0) {
+			continue;
+		}
+		if(frames[index] == frameCount) {
+			return micros[index];
+		}
+		if(oldestIndex < 0 || frames[index] < frames[oldestIndex]) {
+			oldestIndex = index;
+		}
+	}
+	if(oldestIndex >= 0 && frameCount < frames[oldestIndex]) {
+		return micros[oldestIndex];
+	}
+	return -1;
+}
+
+// =====================================================
+//	class LagEstimate
+// =====================================================
+
+LagEstimate::LagEstimate() {
+	clear();
+}
+
+void LagEstimate::clear() {
+	lagMillis		= 0;
+	jitterMillis	= 0;
+	sampleCount		= 0;
+	lastClientFrame	= -1;
+	stalledSamples	= 0;
+}
+
+// Takes one sample per new keyframe: how long ago the keyframe the client
+// last reported was broadcast
+void LagEstimate::addSample(int clientFrameCount, double sampleMillis) {
+	if(sampleCount == 0) {
+		lagMillis		= sampleMillis;
+		jitterMillis	= sampleMillis / 2;
+	}
+	else {
+		double errorMillis = sampleMillis - lagMillis;
+		double deviationMillis = (errorMillis < 0 ? -errorMillis : errorMillis);
+		lagMillis		+= errorMillis / 8;
+		jitterMillis	+= (deviationMillis - jitterMillis) / 4;
+	}
+	sampleCount++;
+
+	if(clientFrameCount == lastClientFrame) {
+		stalledSamples++;
+	}
+	else {
+		stalledSamples = 0;
+	}
+	lastClientFrame = clientFrameCount;
+}
+
+}}//end namespace
@@ -0,0 +1,158 @@
+// ==============================================================
+//	This file is part of Glest Shared Library (www.glest.org)
+//
+//	Copyright (C) 2001-2008 Martiño Figueroa
+//
+//	You can redistribute this code and/or modify it under
+//	the terms of the GNU General Public License as published
+//	by the Free Software Foundation; either version 2 of the
+//	License, or (at your option) any later version
+// ==============================================================
+
+#include "object_pool.h"
+
+#include <cstdlib>
+#include <algorithm>
+#include "conversion.h"
+#include "util.h"
+#include "platform_common.h"
+#include "platform_util.h"
+#include "leak_dumper.h"
+
+using namespace std;
+using namespace Shared::PlatformCommon;
+
+namespace Shared{ namespace Util{
+
+// Every pool registers itself so the stats of all of them can be dumped
+// together with the rest of the world debug information
+static Mutex & getPoolListAccessor() {
+	static Mutex poolListAccessor(CODE_AT_LINE);
+	return poolListAccessor;
+}
+
+static vector<ObjectPool *> & getPoolList() {
+	static vector<ObjectPool *> poolList;
+	return poolList;
+}
+
+// =====================================================
+//	class ObjectPool
+// =====================================================
+
+ObjectPool::ObjectPool(const char *name, size_t blockSize, size_t blocksPerChunk) :
+		mutex(CODE_AT_LINE) {
+	this->name				= name;
+	// Each free block stores the link to the next one
+	this->blockSize			= max(blockSize,sizeof(void *));
+	this->blocksPerChunk	= max(blocksPerChunk,(size_t)1);
+	this->freeList			= NULL;
+	this->liveCount			= 0;
+	this->peakCount			= 0;
+	this->allocationCount	= 0;
+
+	MutexSafeWrapper safeMutex(&getPoolListAccessor(),CODE_AT_LINE);
+	getPoolList().push_back(this);
+}
+
+ObjectPool::~ObjectPool() {
+	MutexSafeWrapper safeMutexList(&getPoolListAccessor(),CODE_AT_LINE);
+	vector<ObjectPool *> &poolList = getPoolList();
+	poolList.erase(std::remove(poolList.begin(),poolList.end(),this),poolList.end());
+	safeMutexList.ReleaseLock();
+
+	if(liveCount > 0) {
+		SystemFlags::OutputDebug(SystemFlags::debugError,"In [%s::%s Line: %d] pool [%s] destroyed with " MG_I64_SPECIFIER " objects still in use\n",__FILE__,__FUNCTION__,__LINE__,name,liveCount);
+	}
+
+	for(unsigned int index = 0; index < chunks.size(); ++index) {
+		free(chunks[index]);
+	}
+	chunks.clear();
+	freeList = NULL;
+}
+
+void ObjectPool::addChunk() {
+	char *chunk = static_cast<char *>(malloc(blockSize * blocksPerChunk));
+	if(chunk == NULL) {
+		throw megaglest_runtime_error("Out of memory allocating object pool chunk for: " + string(name));
+	}
+	chunks.push_back(chunk);
+
+	for(size_t index = 0; index < blocksPerChunk; ++index) {
+		void *block = chunk + (index * blockSize);
+		*static_cast<void **>(block) = freeList;
+		freeList = block;
+	}
+}
+
+void * ObjectPool::allocate() {
+	MutexSafeWrapper safeMutex(&mutex,CODE_AT_LINE);
+	if(freeList == NULL) {
+		addChunk();
+	}
+
+	void *block = freeList;
+	freeList = *static_cast<void **>(block);
+
+	liveCount++;
+	allocationCount++;
+	if(liveCount > peakCount) {
+		peakCount = liveCount;
+	}
+	return block;
+}
+
+void ObjectPool::deallocate(void *ptr) {
+	if(ptr == NULL) {
+		return;
+	}
+
+	MutexSafeWrapper safeMutex(&mutex,CODE_AT_LINE);
+	*static_cast<void **>(ptr) = freeList;
+	freeList = ptr;
+	liveCount--;
+}
+
+int64 ObjectPool::getLiveCount() {
+	MutexSafeWrapper safeMutex(&mutex,CODE_AT_LINE);
+	return liveCount;
+}
+
+int64 ObjectPool::getPeakCount() {
+	MutexSafeWrapper safeMutex(&mutex,CODE_AT_LINE);
+	return peakCount;
+}
+
+int64 ObjectPool::getAllocationCount() {
+	MutexSafeWrapper safeMutex(&mutex,CODE_AT_LINE);
+	return allocationCount;
+}
+
+size_t ObjectPool::getChunkCount() {
+	MutexSafeWrapper safeMutex(&mutex,CODE_AT_LINE);
+	return chunks.size();
+}
+
+string ObjectPool::getStats() {
+	MutexSafeWrapper safeMutex(&mutex,CODE_AT_LINE);
+	string result = string(name) +
+			" live: " + intToStr(liveCount) +
+			" peak: " + intToStr(peakCount) +
+			" allocations: " + intToStr(allocationCount) +
+			" chunks: " + intToStr(chunks.size()) +
+			" block size: " + intToStr(blockSize);
+	return result;
+}
+
+string ObjectPool::getAllStats() {
+	MutexSafeWrapper safeMutex(&getPoolListAccessor(),CODE_AT_LINE);
+	string result = "Object pool stats:\n";
+	vector<ObjectPool *> &poolList = getPoolList();
+	for(unsigned int index = 0; index < poolList.size(); ++index) {
+		result += poolList[index]->getStats() + "\n";
+	}
+	return result;
+}
+
+}}//end namespace
@@ -400,6 +400,24 @@ void SystemFlags::Close() {
 	if(SystemFlags::VERBOSE_MODE_ENABLED) printf("In [%s::%s Line: %d]\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__);
 }
 
+// Counts entries in one second windows. Returns true when this entry is
+// over the limit, suppressedCount is set when a new window opens after
+// entries were dropped in the last one.
+static bool isDebugEntryRateLimited(SystemFlags::SystemFlagsType &debugLog, int &suppressedCount) {
+	int nowSecond = (int)time(NULL);
+	int windowSecond = SDL_AtomicGet(&debugLog.rateLimitSecond);
+	if(windowSecond != nowSecond &&
+		SDL_AtomicCAS(&debugLog.rateLimitSecond,windowSecond,nowSecond) == SDL_TRUE) {
+		SDL_AtomicSet(&debugLog.rateLimitCount,0);
+		suppressedCount = SDL_AtomicSet(&debugLog.rateLimitSuppressed,0);
+	}
+	if(SDL_AtomicAdd(&debugLog.rateLimitCount,1) >= debugLog.maxEntriesPerSecond) {
+		SDL_AtomicAdd(&debugLog.rateLimitSuppressed,1);
+		return true;
+	}
+	return false;
+}
+
 void SystemFlags::handleDebug(DebugType type, const char *fmt, ...) {
 	if(SystemFlags::debugLogFileList == NULL) {
 		if(SystemFlags::VERBOSE_MODE_ENABLED) printf("In [%s::%s Line: %d]\n",extractFileFromDirectoryPath(__FILE__).c_str(),__FUNCTION__,__LINE__);
@@ -418,6 +436,13 @@ void SystemFlags::handleDebug(DebugType type, const char *fmt, ...) {
         return;
     }
 
+    // Errors are never dropped
+    int suppressedCount = 0;
+    if(currentDebugLog.maxEntriesPerSecond > 0 && type != debugError &&
+    	isDebugEntryRateLimited(currentDebugLog,suppressedCount) == true) {
+    	return;
+    }
+
     va_list argList;
     va_start(argList, fmt);
 
@@ -426,16 +451,21 @@ void SystemFlags::handleDebug(DebugType type, const char *fmt, ...) {
     vsnprintf(szBuf,max_debug_buffer_size-1,fmt, argList);
     va_end(argList);
 
+    string debugEntry = szBuf;
+    if(suppressedCount > 0) {
+    	debugEntry = "[" + intToStr(suppressedCount) + " entries suppressed by rate limit]\n" + debugEntry;
+    }
+
     if( currentDebugLog.debugLogFileName != "" &&
     	SystemFlags::ENABLE_THREADED_LOGGING &&
     	threadLogger != NULL &&
         threadLogger->getRunningStatus() == true) {
-        threadLogger->addLogEntry(type, szBuf);
+        threadLogger->addLogEntry(type, debugEntry);
     }
     else {
         // Get the current time.
         time_t curtime = time (NULL);
-        logDebugEntry(type, (szBuf[0] != '\0' ? szBuf : ""), curtime);
+        logDebugEntry(type, debugEntry, curtime);
     }
 }
 
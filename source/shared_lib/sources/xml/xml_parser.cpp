@@ -898,6 +898,21 @@ XmlNode *XmlNode::addChild(const string &name, const string text) {
 	return node;
 }
 
+XmlNode *XmlNode::addChildCopy(const XmlNode *node) {
+	assert(!superNode);
+	XmlNode *copyNode= addChild(node->getName(), node->getText());
+
+	std::map<string,string> mapTagReplacementValues;
+	for(unsigned int i = 0; i < node->getAttributeCount(); ++i) {
+		XmlAttribute *attr= node->getAttribute(i);
+		copyNode->addAttribute(attr->getName(), attr->getValue("",false), mapTagReplacementValues);
+	}
+	for(unsigned int i = 0; i < node->getChildCount(); ++i) {
+		copyNode->addChildCopy(node->getChild(i));
+	}
+	return copyNode;
+}
+
 XmlAttribute *XmlNode::addAttribute(const string &name, const string &value, const std::map<string,string> &mapTagReplacementValues) {
 	XmlAttribute *attr= new XmlAttribute(name, value, mapTagReplacementValues);
 	attributes.push_back(attr);
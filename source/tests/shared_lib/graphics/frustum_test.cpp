@@ -0,0 +1,196 @@
+// ==============================================================
+//	This file is part of MegaGlest Unit Tests (www.megaglest.org)
+//
+//	Copyright (C) 2013 Mark Vejvoda
+//
+//	You can redistribute this code and/or modify it under
+//	the terms of the GNU General Public License as published
+//	by the Free Software Foundation; either version 2 of the
+//	License, or (at your option) any later version
+// ==============================================================
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cstdlib>
+#include <vector>
+#include "frustum.h"
+#include "platform_common.h"
+
+using namespace Shared::Graphics;
+using namespace Shared::PlatformCommon;
+
+// An identity projection and modelview clip to the -1..1 cube
+static void makeIdentity(float *matrix) {
+	for(int index = 0; index < 16; ++index) {
+		matrix[index] = (index % 5 == 0 ? 1.0f : 0.0f);
+	}
+}
+
+// A perspective projection looking down -z and a camera moved back
+static void makePerspective(float *proj, float *modl) {
+	const float nearPlane = 1.0f;
+	const float farPlane = 100.0f;
+	for(int index = 0; index < 16; ++index) {
+		proj[index] = 0;
+	}
+	proj[0] = 1.0f;
+	proj[5] = 1.33f;
+	proj[10] = -(farPlane + nearPlane) / (farPlane - nearPlane);
+	proj[11] = -1.0f;
+	proj[14] = -(2.0f * farPlane * nearPlane) / (farPlane - nearPlane);
+
+	makeIdentity(modl);
+	modl[12] = -3.0f;
+	modl[13] = -2.0f;
+	modl[14] = -20.0f;
+}
+
+// The eight corner test the renderer used before the frustum was flattened
+static bool cubeInFrustumByCorners(const Frustum &frustum, float x, float y, float z, float size) {
+	for(int planeIndex = 0; planeIndex < Frustum::planeCount; ++planeIndex) {
+		const float *plane = frustum.getPlane(planeIndex);
+		bool cornerInside = false;
+		for(int corner = 0; corner < 8 && cornerInside == false; ++corner) {
+			float cornerX = x + ((corner & 1) ? size : -size);
+			float cornerY = y + ((corner & 2) ? size : -size);
+			float cornerZ = z + ((corner & 4) ? size : -size);
+			cornerInside = (plane[0] * cornerX + plane[1] * cornerY + plane[2] * cornerZ + plane[3] > 0);
+		}
+		if(cornerInside == false) {
+			return false;
+		}
+	}
+	return true;
+}
+
+//
+// Tests for frustum extraction and culling
+//
+class FrustumTest : public CppUnit::TestFixture {
+	// Register the suite of tests for this fixture
+	CPPUNIT_TEST_SUITE( FrustumTest );
+
+	CPPUNIT_TEST( test_identity_frustum_contains_origin );
+	CPPUNIT_TEST( test_batch_matches_corner_test );
+
+	CPPUNIT_TEST_SUITE_END();
+	// End of Fixture registration
+
+public:
+
+	void test_identity_frustum_contains_origin() {
+		float proj[16];
+		float modl[16];
+		makeIdentity(proj);
+		makeIdentity(modl);
+
+		Frustum frustum;
+		frustum.extract(proj,modl);
+
+		CPPUNIT_ASSERT( frustum.cubeInFrustum(0, 0, 0, 0) == true );
+		CPPUNIT_ASSERT( frustum.cubeInFrustum(0.5f, -0.5f, 0.5f, 0.1f) == true );
+		CPPUNIT_ASSERT( frustum.cubeInFrustum(5, 0, 0, 1) == false );
+		// Reaches back into the clip volume
+		CPPUNIT_ASSERT( frustum.cubeInFrustum(5, 0, 0, 4.5f) == true );
+		CPPUNIT_ASSERT( frustum.cubeInFrustum(0, 0, -3, 1) == false );
+	}
+
+	void test_batch_matches_corner_test() {
+		float proj[16];
+		float modl[16];
+		makePerspective(proj,modl);
+
+		Frustum frustum;
+		frustum.extract(proj,modl);
+
+		srand(1234);
+		FrustumCullBatch batch;
+		std::vector<bool> expected;
+		for(int index = 0; index < 1000; ++index) {
+			float x = (rand() % 2000) / 10.0f - 100.0f;
+			float y = (rand() % 2000) / 10.0f - 100.0f;
+			float z = (rand() % 2000) / 10.0f - 100.0f;
+			float size = (rand() % 50) / 10.0f;
+			batch.add(x, y, z, size);
+			expected.push_back(cubeInFrustumByCorners(frustum, x, y, z, size));
+		}
+
+		int visibleCount = batch.cull(frustum);
+		int expectedVisibleCount = 0;
+		for(int index = 0; index < batch.size(); ++index) {
+			CPPUNIT_ASSERT_EQUAL( (bool)expected[index], batch.isVisible(index) );
+			if(expected[index] == true) {
+				expectedVisibleCount++;
+			}
+		}
+		CPPUNIT_ASSERT_EQUAL( expectedVisibleCount, visibleCount );
+		CPPUNIT_ASSERT( visibleCount > 0 );
+		CPPUNIT_ASSERT( visibleCount < batch.size() );
+	}
+};
+
+//
+// Cull throughput of the batch against the eight corner test the renderer
+// used before, run with --benchmark
+//
+class FrustumBenchmark : public CppUnit::TestFixture {
+	CPPUNIT_TEST_SUITE( FrustumBenchmark );
+
+	CPPUNIT_TEST( benchmark_cull_throughput );
+
+	CPPUNIT_TEST_SUITE_END();
+
+	static void printThroughput(const char *name, int64 cubes, int64 elapsedMicros) {
+		printf("\n%s: %lld cubes in %lld usecs (%.0f cubes/sec)",name,
+				(long long int)cubes,(long long int)elapsedMicros,
+				(elapsedMicros > 0 ? (double)cubes * 1000000.0 / (double)elapsedMicros : 0.0));
+	}
+
+public:
+
+	void benchmark_cull_throughput() {
+		const int cubeCount = 20000;
+		const int passCount = 200;
+
+		float proj[16];
+		float modl[16];
+		makePerspective(proj,modl);
+
+		Frustum frustum;
+		frustum.extract(proj,modl);
+
+		FrustumCullBatch batch;
+		for(int index = 0; index < cubeCount; ++index) {
+			batch.add((float)(index % 200) - 100.0f, 0.0f, (float)(index / 200) - 100.0f, 1.0f);
+		}
+
+		int64 batchVisible = 0;
+		Chrono chrono;
+		chrono.start();
+		for(int pass = 0; pass < passCount; ++pass) {
+			batchVisible += batch.cull(frustum);
+		}
+		int64 batchMicros = chrono.getMicros();
+
+		int64 cornerVisible = 0;
+		chrono.start();
+		for(int pass = 0; pass < passCount; ++pass) {
+			for(int index = 0; index < cubeCount; ++index) {
+				if(cubeInFrustumByCorners(frustum, (float)(index % 200) - 100.0f, 0.0f, (float)(index / 200) - 100.0f, 1.0f) == true) {
+					cornerVisible++;
+				}
+			}
+		}
+		int64 cornerMicros = chrono.getMicros();
+
+		printThroughput("Batched frustum cull", (int64)cubeCount * passCount, batchMicros);
+		printThroughput("Eight corner frustum cull", (int64)cubeCount * passCount, cornerMicros);
+		printf("\n");
+		CPPUNIT_ASSERT( batchVisible > 0 );
+		CPPUNIT_ASSERT( cornerVisible > 0 );
+	}
+};
+
+// Test Suite Registrations
+CPPUNIT_TEST_SUITE_REGISTRATION( FrustumTest );
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION( FrustumBenchmark, "benchmark" );
+//
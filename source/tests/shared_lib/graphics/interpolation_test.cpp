@@ -0,0 +1,141 @@
+// ==============================================================
+//	This file is part of MegaGlest Unit Tests (www.megaglest.org)
+//
+//	Copyright (C) 2013 Mark Vejvoda
+//
+//	You can redistribute this code and/or modify it under
+//	the terms of the GNU General Public License as published
+//	by the Free Software Foundation; either version 2 of the
+//	License, or (at your option) any later version
+// ==============================================================
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <algorithm>
+#include "interpolation.h"
+
+using namespace Shared::Graphics;
+
+// Program updates every 25ms, rendering every 5ms, a unit moving 1/500
+// of a cell per world frame
+static const int64 updateMicros = 25000;
+static const int64 renderMicros = 5000;
+static const float progressStep = 0.002f;
+
+// Runs updateCount program updates, advancing the world by the frames
+// listed for each one, and checks what a unit moving at a steady speed
+// would be drawn at on every render. Returns the largest step between
+// two renders past the first warmupUpdates updates
+static float drawUnit(const int *advanceFrames, int updateCount, int warmupUpdates) {
+	FrameInterpolation frameInterpolation;
+	frameInterpolation.reset(updateMicros);
+
+	int frameCount = 0;
+	int64 nowMicros = 0;
+	float lastDrawn = 0;
+	float largestStep = 0;
+	frameInterpolation.update(frameCount, nowMicros);
+	for(int update = 0; update < updateCount; ++update) {
+		frameCount += advanceFrames[update];
+		frameInterpolation.update(frameCount, nowMicros);
+
+		for(int64 render = 0; render < updateMicros; render += renderMicros) {
+			float progress = frameCount * progressStep;
+			float lastProgress = (frameCount > 0 ? progress - progressStep : progress);
+			float drawn = extrapolateProgress(progress, lastProgress, frameInterpolation.get(nowMicros + render));
+
+			// Never drawn back behind where it was, no rubber banding
+			CPPUNIT_ASSERT( drawn >= lastDrawn - 0.0001f );
+			if(update >= warmupUpdates) {
+				largestStep = std::max(largestStep, drawn - lastDrawn);
+			}
+			lastDrawn = drawn;
+		}
+		nowMicros += updateMicros;
+	}
+	return largestStep;
+}
+
+//
+// Tests for drawing units between world frames
+//
+class InterpolationTest : public CppUnit::TestFixture {
+	// Register the suite of tests for this fixture
+	CPPUNIT_TEST_SUITE( InterpolationTest );
+
+	CPPUNIT_TEST( test_extrapolate_progress );
+	CPPUNIT_TEST( test_frame_interpolation );
+	CPPUNIT_TEST( test_slow_speed );
+	CPPUNIT_TEST( test_client_waiting_for_keyframe );
+
+	CPPUNIT_TEST_SUITE_END();
+	// End of Fixture registration
+
+public:
+
+	void test_extrapolate_progress() {
+		CPPUNIT_ASSERT_EQUAL( 0.5f, extrapolateProgress(0.5f, 0.4f, 0.f) );
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( 0.55f, extrapolateProgress(0.5f, 0.4f, 0.5f), 0.0001f );
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( 0.7f, extrapolateProgress(0.5f, 0.4f, 2.f), 0.0001f );
+		// Never past the target cell
+		CPPUNIT_ASSERT_EQUAL( 1.f, extrapolateProgress(0.95f, 0.85f, 1.f) );
+		// A progress that went back (new skill or animation cycle) is not carried on
+		CPPUNIT_ASSERT_EQUAL( 0.1f, extrapolateProgress(0.1f, 0.9f, 1.f) );
+		CPPUNIT_ASSERT_EQUAL( 0.4f, extrapolateProgress(0.4f, 0.4f, 1.f) );
+	}
+
+	void test_frame_interpolation() {
+		FrameInterpolation frameInterpolation;
+		frameInterpolation.reset(25000);
+		CPPUNIT_ASSERT_EQUAL( 0.f, frameInterpolation.get(0) );
+
+		frameInterpolation.update(100, 0);
+		CPPUNIT_ASSERT_EQUAL( 0.f, frameInterpolation.get(10000) );
+
+		frameInterpolation.update(101, 25000);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL( 0.5f, frameInterpolation.get(37500), 0.0001f );
+		// Held at one frame while the world waits
+		CPPUNIT_ASSERT_EQUAL( 1.f, frameInterpolation.get(200000) );
+
+		// Catching up two frames in one update does not draw two ahead
+		frameInterpolation.update(103, 50000);
+		CPPUNIT_ASSERT_EQUAL( 1.f, frameInterpolation.get(200000) );
+
+		// Loading a saved game goes back in frames
+		frameInterpolation.update(10, 75000);
+		CPPUNIT_ASSERT_EQUAL( 0.f, frameInterpolation.get(80000) );
+	}
+
+	void test_slow_speed() {
+		// Speed "slow" advances the world on every other program update
+		int advanceFrames[200];
+		for(int index = 0; index < 200; ++index) {
+			advanceFrames[index] = (index % 2 == 0 ? 1 : 0);
+		}
+		float largestStep = drawUnit(advanceFrames, 200, 100);
+
+		// Once the time per frame settled the unit moves at an even pace,
+		// a tenth of a frame's progress per render rather than half of it
+		// at once
+		CPPUNIT_ASSERT( largestStep < progressStep * 0.11f );
+	}
+
+	void test_client_waiting_for_keyframe() {
+		// A client running normally, then waiting half a second for a
+		// keyframe, then catching up two frames per update
+		int advanceFrames[120];
+		for(int index = 0; index < 120; ++index) {
+			advanceFrames[index] = 1;
+			if(index >= 40 && index < 60) {
+				advanceFrames[index] = 0;
+			}
+			else if(index >= 60 && index < 80) {
+				advanceFrames[index] = 2;
+			}
+		}
+		drawUnit(advanceFrames, 120, 0);
+	}
+};
+
+// Test Suite Registrations
+CPPUNIT_TEST_SUITE_REGISTRATION( InterpolationTest );
+//
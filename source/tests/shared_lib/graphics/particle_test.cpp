@@ -0,0 +1,182 @@
+// ==============================================================
+//	This file is part of MegaGlest Unit Tests (www.megaglest.org)
+//
+//	Copyright (C) 2013 Mark Vejvoda
+//
+//	You can redistribute this code and/or modify it under
+//	the terms of the GNU General Public License as published
+//	by the Free Software Foundation; either version 2 of the
+//	License, or (at your option) any later version
+// ==============================================================
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <memory>
+#include "particle.h"
+#include "platform_common.h"
+
+using namespace Shared::Graphics;
+using namespace Shared::PlatformCommon;
+
+//
+// The per particle update loop as it was before updates were batched,
+// calling the virtual updateParticle and deathTest for every particle
+//
+class UnbatchedFireParticleSystem : public FireParticleSystem {
+public:
+	UnbatchedFireParticleSystem(int particleCount) : FireParticleSystem(particleCount) {}
+
+	virtual void updateParticles() {
+		for(int i= 0; i < aliveParticleCount; ++i) {
+			updateParticle(&particles[i]);
+
+			if(deathTest(&particles[i])) {
+				killParticle(&particles[i]);
+
+				if(aliveParticleCount > 0) {
+					particles[i]= particles[aliveParticleCount];
+				}
+			}
+		}
+	}
+};
+
+static void setupFire(FireParticleSystem &fire) {
+	fire.setEmissionRate(100.0f);
+	fire.setMaxParticleEnergy(40);
+	fire.setVarParticleEnergy(10);
+	fire.setRadius(2.0f);
+	fire.setWind(45.0f, 0.5f);
+}
+
+//
+// Tests for particle system updates
+//
+class ParticleSystemTest : public CppUnit::TestFixture {
+	// Register the suite of tests for this fixture
+	CPPUNIT_TEST_SUITE( ParticleSystemTest );
+
+	CPPUNIT_TEST( test_update_keeps_alive_particles_packed );
+	CPPUNIT_TEST( test_batched_update_matches_unbatched );
+
+	CPPUNIT_TEST_SUITE_END();
+	// End of Fixture registration
+
+public:
+
+	void test_update_keeps_alive_particles_packed() {
+		FireParticleSystem fire(200);
+		fire.setEmissionRate(5.0f);
+		fire.setMaxParticleEnergy(20);
+		fire.setVarParticleEnergy(5);
+
+		for(int frame = 0; frame < 100; ++frame) {
+			fire.update();
+
+			CPPUNIT_ASSERT( fire.getAliveParticleCount() <= 200 );
+			for(int i = 0; i < fire.getAliveParticleCount(); ++i) {
+				// Dead particles are swapped out during the same pass, the
+				// one moved into a freed slot was updated at most once
+				CPPUNIT_ASSERT( fire.getParticle(i)->getEnergy() >= 0 );
+			}
+		}
+
+		// Stops emitting when faded, everything dies off
+		fire.fade();
+		for(int frame = 0; frame < 100; ++frame) {
+			fire.update();
+		}
+		CPPUNIT_ASSERT_EQUAL( 0, fire.getAliveParticleCount() );
+	}
+
+	void test_batched_update_matches_unbatched() {
+		const int particleCount = 2000;
+		const int frameCount 	= 300;
+
+		FireParticleSystem batched(particleCount);
+		UnbatchedFireParticleSystem unbatched(particleCount);
+		setupFire(batched);
+		setupFire(unbatched);
+
+		for(int frame = 0; frame < frameCount; ++frame) {
+			batched.update();
+			unbatched.update();
+		}
+
+		// Particles are emitted, die off and get swapped around over the
+		// run, the batched pass has to end up with the very same state
+		CPPUNIT_ASSERT( batched.getAliveParticleCount() > 0 );
+		CPPUNIT_ASSERT_EQUAL( unbatched.getAliveParticleCount(), batched.getAliveParticleCount() );
+		for(int i = 0; i < batched.getAliveParticleCount(); ++i) {
+			const Particle *expected = unbatched.getParticle(i);
+			const Particle *actual = batched.getParticle(i);
+
+			CPPUNIT_ASSERT_EQUAL( expected->getEnergy(), actual->getEnergy() );
+			CPPUNIT_ASSERT_EQUAL( expected->getPos().x, actual->getPos().x );
+			CPPUNIT_ASSERT_EQUAL( expected->getPos().y, actual->getPos().y );
+			CPPUNIT_ASSERT_EQUAL( expected->getPos().z, actual->getPos().z );
+			CPPUNIT_ASSERT_EQUAL( expected->getSpeed().x, actual->getSpeed().x );
+			CPPUNIT_ASSERT_EQUAL( expected->getSpeed().y, actual->getSpeed().y );
+			CPPUNIT_ASSERT_EQUAL( expected->getSpeed().z, actual->getSpeed().z );
+			CPPUNIT_ASSERT_EQUAL( expected->getColor().w, actual->getColor().w );
+			CPPUNIT_ASSERT_EQUAL( expected->getSize(), actual->getSize() );
+		}
+	}
+};
+
+//
+// Particle update throughput, run with --benchmark
+//
+class ParticleSystemBenchmark : public CppUnit::TestFixture {
+	CPPUNIT_TEST_SUITE( ParticleSystemBenchmark );
+
+	CPPUNIT_TEST( benchmark_update_throughput );
+
+	CPPUNIT_TEST_SUITE_END();
+
+	template<typename T>
+	static void runFrames(T &fire, int frameCount, int64 &particleUpdates, int64 &elapsedMicros) {
+		setupFire(fire);
+
+		particleUpdates = 0;
+		Chrono chrono;
+		chrono.start();
+		for(int frame = 0; frame < frameCount; ++frame) {
+			particleUpdates += fire.getAliveParticleCount();
+			fire.update();
+		}
+		elapsedMicros = chrono.getMicros();
+	}
+
+	static void printThroughput(const char *name, int64 particleUpdates, int64 elapsedMicros) {
+		printf("\n%s: %lld particles in %lld usecs (%.0f particles/sec)",name,
+				(long long int)particleUpdates,(long long int)elapsedMicros,
+				(elapsedMicros > 0 ? (double)particleUpdates * 1000000.0 / (double)elapsedMicros : 0.0));
+	}
+
+public:
+
+	void benchmark_update_throughput() {
+		const int particleCount = 20000;
+		const int frameCount 	= 2000;
+
+		int64 batchedUpdates = 0;
+		int64 batchedMicros = 0;
+		FireParticleSystem batched(particleCount);
+		runFrames(batched, frameCount, batchedUpdates, batchedMicros);
+
+		int64 unbatchedUpdates = 0;
+		int64 unbatchedMicros = 0;
+		UnbatchedFireParticleSystem unbatched(particleCount);
+		runFrames(unbatched, frameCount, unbatchedUpdates, unbatchedMicros);
+
+		printThroughput("Batched particle update", batchedUpdates, batchedMicros);
+		printThroughput("Unbatched particle update", unbatchedUpdates, unbatchedMicros);
+		printf("\n");
+		CPPUNIT_ASSERT( batchedUpdates > 0 );
+	}
+};
+
+// Test Suite Registrations
+CPPUNIT_TEST_SUITE_REGISTRATION( ParticleSystemTest );
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION( ParticleSystemBenchmark, "benchmark" );
+//
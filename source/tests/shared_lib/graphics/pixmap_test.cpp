@@ -0,0 +1,227 @@
+// ==============================================================
+//	This file is part of MegaGlest Unit Tests (www.megaglest.org)
+//
+//	Copyright (C) 2013 Mark Vejvoda
+//
+//	You can redistribute this code and/or modify it under
+//	the terms of the GNU General Public License as published
+//	by the Free Software Foundation; either version 2 of the
+//	License, or (at your option) any later version
+// ==============================================================
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cstdlib>
+#include <vector>
+#include "pixmap.h"
+#include "platform_common.h"
+
+using namespace Shared::Graphics;
+using namespace Shared::PlatformCommon;
+
+// Every pair of byte values, so the kernels see each combination once
+static void makeAllPairs(std::vector<uint8> &first, std::vector<uint8> &second) {
+	first.clear();
+	second.clear();
+	for(int a = 0; a < 256; ++a) {
+		for(int b = 0; b < 256; ++b) {
+			first.push_back((uint8)a);
+			second.push_back((uint8)b);
+		}
+	}
+}
+
+//
+// Tests for the pixmap dirty rectangle and byte kernels
+//
+class PixmapTest : public CppUnit::TestFixture {
+	// Register the suite of tests for this fixture
+	CPPUNIT_TEST_SUITE( PixmapTest );
+
+	CPPUNIT_TEST( test_rect_add );
+	CPPUNIT_TEST( test_pixels_max );
+	CPPUNIT_TEST( test_pixels_max_or_limit );
+	CPPUNIT_TEST( test_pixels_blend );
+
+	CPPUNIT_TEST_SUITE_END();
+	// End of Fixture registration
+
+public:
+
+	void test_rect_add() {
+		PixmapRect rect;
+		CPPUNIT_ASSERT( rect.isEmpty() == true );
+
+		rect.add(PixmapRect());
+		CPPUNIT_ASSERT( rect.isEmpty() == true );
+
+		rect.add(5, 7);
+		CPPUNIT_ASSERT( rect.isEmpty() == false );
+		CPPUNIT_ASSERT_EQUAL( 5, rect.minX );
+		CPPUNIT_ASSERT_EQUAL( 5, rect.maxX );
+		CPPUNIT_ASSERT_EQUAL( 7, rect.minY );
+		CPPUNIT_ASSERT_EQUAL( 7, rect.maxY );
+
+		rect.add(2, 9);
+		CPPUNIT_ASSERT_EQUAL( 2, rect.minX );
+		CPPUNIT_ASSERT_EQUAL( 5, rect.maxX );
+		CPPUNIT_ASSERT_EQUAL( 7, rect.minY );
+		CPPUNIT_ASSERT_EQUAL( 9, rect.maxY );
+
+		PixmapRect other;
+		other.add(10, 0);
+		rect.add(other);
+		CPPUNIT_ASSERT_EQUAL( 2, rect.minX );
+		CPPUNIT_ASSERT_EQUAL( 10, rect.maxX );
+		CPPUNIT_ASSERT_EQUAL( 0, rect.minY );
+		CPPUNIT_ASSERT_EQUAL( 9, rect.maxY );
+
+		other.setAll(4, 3);
+		CPPUNIT_ASSERT_EQUAL( 0, other.minX );
+		CPPUNIT_ASSERT_EQUAL( 3, other.maxX );
+		CPPUNIT_ASSERT_EQUAL( 2, other.maxY );
+
+		rect.clear();
+		CPPUNIT_ASSERT( rect.isEmpty() == true );
+	}
+
+	void test_pixels_max() {
+		std::vector<uint8> dest;
+		std::vector<uint8> src;
+		makeAllPairs(dest, src);
+		std::vector<uint8> before = dest;
+
+		pixelsMax(&dest[0], &src[0], dest.size());
+		for(std::size_t index = 0; index < dest.size(); ++index) {
+			uint8 expected = (src[index] > before[index] ? src[index] : before[index]);
+			CPPUNIT_ASSERT_EQUAL( (int)expected, (int)dest[index] );
+		}
+	}
+
+	void test_pixels_max_or_limit() {
+		const uint8 limit = 127;
+		std::vector<uint8> dest;
+		std::vector<uint8> src;
+		makeAllPairs(dest, src);
+		std::vector<uint8> before = dest;
+
+		pixelsMaxOrLimit(&dest[0], &src[0], limit, dest.size());
+		for(std::size_t index = 0; index < dest.size(); ++index) {
+			uint8 expected = before[index];
+			if(src[index] > before[index]) {
+				expected = src[index];
+			}
+			else if(before[index] > limit) {
+				expected = limit;
+			}
+			CPPUNIT_ASSERT_EQUAL( (int)expected, (int)dest[index] );
+		}
+	}
+
+	void test_pixels_blend() {
+		std::vector<uint8> from;
+		std::vector<uint8> to;
+		makeAllPairs(from, to);
+		const int count = (int)from.size();
+
+		// Nothing moves at t= 0 except texels not at the target yet,
+		// which start from the old value
+		std::vector<uint8> dest = from;
+		pixelsBlend(&dest[0], &from[0], &to[0], count, 0);
+		for(int index = 0; index < count; ++index) {
+			CPPUNIT_ASSERT_EQUAL( (int)from[index], (int)dest[index] );
+		}
+
+		// Halfway lands between the two values
+		pixelsBlend(&dest[0], &from[0], &to[0], count, 128);
+		for(int index = 0; index < count; ++index) {
+			int low = (from[index] < to[index] ? from[index] : to[index]);
+			int high = (from[index] < to[index] ? to[index] : from[index]);
+			CPPUNIT_ASSERT( (int)dest[index] >= low );
+			CPPUNIT_ASSERT( (int)dest[index] <= high );
+		}
+
+		// t= 1 reaches the target exactly, and a texel already there stays
+		pixelsBlend(&dest[0], &from[0], &to[0], count, 256);
+		for(int index = 0; index < count; ++index) {
+			CPPUNIT_ASSERT_EQUAL( (int)to[index], (int)dest[index] );
+		}
+		pixelsBlend(&dest[0], &from[0], &to[0], count, 64);
+		for(int index = 0; index < count; ++index) {
+			CPPUNIT_ASSERT_EQUAL( (int)to[index], (int)dest[index] );
+		}
+	}
+};
+
+//
+// Fog of war kernel throughput on a 512x512 map, the full map passes
+// against a blend limited to a dirty rectangle, run with --benchmark
+//
+class PixmapBenchmark : public CppUnit::TestFixture {
+	CPPUNIT_TEST_SUITE( PixmapBenchmark );
+
+	CPPUNIT_TEST( benchmark_fow_kernels );
+
+	CPPUNIT_TEST_SUITE_END();
+
+	static void printThroughput(const char *name, int64 texels, int64 elapsedMicros) {
+		printf("\n%s: %lld texels in %lld usecs (%.0f texels/sec)",name,
+				(long long int)texels,(long long int)elapsedMicros,
+				(elapsedMicros > 0 ? (double)texels * 1000000.0 / (double)elapsedMicros : 0.0));
+	}
+
+public:
+
+	void benchmark_fow_kernels() {
+		const int size = 512;
+		const int dirtySize = 64;
+		const int passCount = 1000;
+		const int texelCount = size * size;
+
+		srand(1234);
+		std::vector<uint8> pixels0(texelCount);
+		std::vector<uint8> pixels1(texelCount);
+		std::vector<uint8> pixelsTex(texelCount);
+		for(int index = 0; index < texelCount; ++index) {
+			pixels0[index] = (uint8)(rand() % 256);
+			pixels1[index] = (uint8)(rand() % 256);
+		}
+
+		Chrono chrono;
+		chrono.start();
+		for(int pass = 0; pass < passCount; ++pass) {
+			pixelsMaxOrLimit(&pixels1[0], &pixels0[0], 127, texelCount);
+		}
+		int64 resetMicros = chrono.getMicros();
+
+		chrono.start();
+		for(int pass = 0; pass < passCount; ++pass) {
+			pixelsBlend(&pixelsTex[0], &pixels0[0], &pixels1[0], texelCount, pass % 257);
+		}
+		int64 blendMicros = chrono.getMicros();
+
+		PixmapRect rect;
+		rect.add(size / 2 - dirtySize / 2, size / 2 - dirtySize / 2);
+		rect.add(size / 2 + dirtySize / 2 - 1, size / 2 + dirtySize / 2 - 1);
+		const int rowCount = rect.maxX - rect.minX + 1;
+		chrono.start();
+		for(int pass = 0; pass < passCount; ++pass) {
+			for(int y = rect.minY; y <= rect.maxY; ++y) {
+				std::size_t offset = y * size + rect.minX;
+				pixelsBlend(&pixelsTex[offset], &pixels0[offset], &pixels1[offset], rowCount, pass % 257);
+			}
+		}
+		int64 dirtyBlendMicros = chrono.getMicros();
+
+		printThroughput("Fog of war reset, full map", (int64)texelCount * passCount, resetMicros);
+		printThroughput("Fog of war blend, full map", (int64)texelCount * passCount, blendMicros);
+		printThroughput("Fog of war blend, 64x64 dirty rect", (int64)dirtySize * dirtySize * passCount, dirtyBlendMicros);
+		printf("\n");
+		CPPUNIT_ASSERT( resetMicros >= 0 );
+		CPPUNIT_ASSERT( dirtyBlendMicros >= 0 );
+	}
+};
+
+// Test Suite Registrations
+CPPUNIT_TEST_SUITE_REGISTRATION( PixmapTest );
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION( PixmapBenchmark, "benchmark" );
+//
@@ -0,0 +1,69 @@
+// ==============================================================
+//	This file is part of MegaGlest Unit Tests (www.megaglest.org)
+//
+//	Copyright (C) 2013 Mark Vejvoda
+//
+//	You can redistribute this code and/or modify it under
+//	the terms of the GNU General Public License as published
+//	by the Free Software Foundation; either version 2 of the
+//	License, or (at your option) any later version
+// ==============================================================
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "platform_common.h"
+
+using namespace Shared::PlatformCommon;
+
+//
+// Tests for the high resolution Chrono
+//
+class ChronoTest : public CppUnit::TestFixture {
+	// Register the suite of tests for this fixture
+	CPPUNIT_TEST_SUITE( ChronoTest );
+
+	CPPUNIT_TEST( test_counts_to_units );
+	CPPUNIT_TEST( test_sub_millisecond_resolution );
+
+	CPPUNIT_TEST_SUITE_END();
+	// End of Fixture registration
+
+public:
+
+	void test_counts_to_units() {
+		const Uint64 nanoFreq = 1000000000;
+		CPPUNIT_ASSERT_EQUAL( (int64)1500, Chrono::countsToUnits(1500000,nanoFreq,1000000) );
+		CPPUNIT_ASSERT_EQUAL( (int64)1, Chrono::countsToUnits(1500000,nanoFreq,1000) );
+		// A week of nanosecond counts does not overflow when scaled to nanos
+		const Uint64 weekCounts = nanoFreq * 60 * 60 * 24 * 7 + 123;
+		CPPUNIT_ASSERT_EQUAL( (int64)weekCounts, Chrono::countsToUnits(weekCounts,nanoFreq,1000000000) );
+		CPPUNIT_ASSERT_EQUAL( (int64)(60 * 60 * 24 * 7), Chrono::countsToUnits(weekCounts,nanoFreq,1) );
+		// A millisecond counter as SDL_GetTicks gave
+		CPPUNIT_ASSERT_EQUAL( (int64)2500000, Chrono::countsToUnits(2500,1000,1000000) );
+		CPPUNIT_ASSERT_EQUAL( (int64)0, Chrono::countsToUnits(2500,0,1000) );
+	}
+
+	void test_sub_millisecond_resolution() {
+		Chrono chrono;
+		chrono.start();
+		int64 lastNanos = chrono.getNanos();
+		int64 distinctReadings = 0;
+		for(int index = 0; index < 100000 && chrono.getMillis() < 1; ++index) {
+			int64 nanos = chrono.getNanos();
+			CPPUNIT_ASSERT( nanos >= lastNanos );
+			if(nanos != lastNanos) {
+				distinctReadings++;
+			}
+			lastNanos = nanos;
+		}
+		// Several readings inside the first millisecond
+		CPPUNIT_ASSERT( distinctReadings > 1 );
+
+		chrono.stop();
+		int64 stoppedMicros = chrono.getMicros();
+		CPPUNIT_ASSERT_EQUAL( stoppedMicros, chrono.getMicros() );
+	}
+};
+
+// Test Suite Registrations
+CPPUNIT_TEST_SUITE_REGISTRATION( ChronoTest );
+//
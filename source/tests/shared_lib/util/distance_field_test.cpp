@@ -0,0 +1,240 @@
+// ==============================================================
+//	This file is part of MegaGlest Unit Tests (www.megaglest.org)
+//
+//	Copyright (C) 2013 Mark Vejvoda
+//
+//	You can redistribute this code and/or modify it under
+//	the terms of the GNU General Public License as published
+//	by the Free Software Foundation; either version 2 of the
+//	License, or (at your option) any later version
+// ==============================================================
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+#include "distance_field.h"
+
+using namespace Shared::Util;
+
+// A grid of open and blocked cells, sources are blocked like resources on
+// the map
+class TestCells : public DistanceFieldCellsInterface {
+public:
+	int w;
+	int h;
+	std::vector<bool> blocked;
+	std::vector<int> sources;
+
+	TestCells(int w, int h) : w(w), h(h), blocked(w * h, false) {}
+
+	virtual bool isDistanceFieldCellBlocked(int cellIndex) const {
+		return blocked[cellIndex];
+	}
+
+	void addSource(int cellIndex) {
+		blocked[cellIndex] = true;
+		sources.push_back(cellIndex);
+	}
+
+	void removeSource(int cellIndex) {
+		blocked[cellIndex] = false;
+		sources.erase(std::remove(sources.begin(), sources.end(), cellIndex), sources.end());
+	}
+
+	// Random walls and sources, the same every run
+	void randomize(unsigned int seed) {
+		srand(seed);
+		for(int cellIndex = 0; cellIndex < w * h; ++cellIndex) {
+			int roll = rand() % 100;
+			if(roll < 6) {
+				addSource(cellIndex);
+			}
+			else if(roll < 30) {
+				blocked[cellIndex] = true;
+			}
+		}
+	}
+};
+
+// Walks from every source on its own and keeps the closest one, the
+// lowest cell index on a tie
+static void buildReference(const TestCells &cells, std::vector<int> &distances, std::vector<int> &nearestSources) {
+	const int cellCount = cells.w * cells.h;
+	distances.assign(cellCount, DistanceField::unreachable);
+	nearestSources.assign(cellCount, -1);
+
+	std::vector<int> sources = cells.sources;
+	std::sort(sources.begin(), sources.end());
+	for(unsigned int sourceIndex = 0; sourceIndex < sources.size(); ++sourceIndex) {
+		std::vector<int> walk(cellCount, -1);
+		std::vector<int> queue;
+		walk[sources[sourceIndex]] = 0;
+		queue.push_back(sources[sourceIndex]);
+		for(unsigned int index = 0; index < queue.size(); ++index) {
+			int x = queue[index] % cells.w;
+			int y = queue[index] / cells.w;
+			for(int dy = -1; dy <= 1; ++dy) {
+				for(int dx = -1; dx <= 1; ++dx) {
+					int nx = x + dx;
+					int ny = y + dy;
+					if(nx < 0 || ny < 0 || nx >= cells.w || ny >= cells.h) {
+						continue;
+					}
+					int neighbourIndex = ny * cells.w + nx;
+					if(walk[neighbourIndex] < 0 && cells.blocked[neighbourIndex] == false) {
+						walk[neighbourIndex] = walk[queue[index]] + 1;
+						queue.push_back(neighbourIndex);
+					}
+				}
+			}
+		}
+		for(int cellIndex = 0; cellIndex < cellCount; ++cellIndex) {
+			if(walk[cellIndex] >= 0 && walk[cellIndex] < distances[cellIndex]) {
+				distances[cellIndex] = walk[cellIndex];
+				nearestSources[cellIndex] = sources[sourceIndex];
+			}
+		}
+	}
+}
+
+static bool matchesReference(const TestCells &cells, const DistanceField &field) {
+	std::vector<int> distances;
+	std::vector<int> nearestSources;
+	buildReference(cells, distances, nearestSources);
+	for(int cellIndex = 0; cellIndex < cells.w * cells.h; ++cellIndex) {
+		if(field.getDistance(cellIndex) != distances[cellIndex] ||
+			field.getNearestSource(cellIndex) != nearestSources[cellIndex]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+//
+// Tests for the distance field build and its local repairs
+//
+class DistanceFieldTest : public CppUnit::TestFixture {
+	// Register the suite of tests for this fixture
+	CPPUNIT_TEST_SUITE( DistanceFieldTest );
+
+	CPPUNIT_TEST( test_tie_break );
+	CPPUNIT_TEST( test_build );
+	CPPUNIT_TEST( test_build_order );
+	CPPUNIT_TEST( test_remove_source );
+	CPPUNIT_TEST( test_open_cell );
+
+	CPPUNIT_TEST_SUITE_END();
+	// End of Fixture registration
+
+public:
+
+	void test_tie_break() {
+		// One row: source, three open cells, source
+		TestCells cells(5, 1);
+		cells.addSource(4);
+		cells.addSource(0);
+
+		DistanceField field;
+		CPPUNIT_ASSERT( field.isBuilt() == false );
+		field.build(&cells, cells.w, cells.h, cells.sources);
+		CPPUNIT_ASSERT( field.isBuilt() == true );
+		CPPUNIT_ASSERT_EQUAL( 2, field.getDistance(2) );
+		CPPUNIT_ASSERT_EQUAL( 0, field.getNearestSource(2) );
+		CPPUNIT_ASSERT_EQUAL( 4, field.getNearestSource(3) );
+
+		cells.removeSource(0);
+		field.removeSource(&cells, 0);
+		CPPUNIT_ASSERT_EQUAL( 2, field.getDistance(2) );
+		CPPUNIT_ASSERT_EQUAL( 4, field.getNearestSource(2) );
+		CPPUNIT_ASSERT_EQUAL( 4, field.getDistance(0) );
+
+		// Walled off
+		TestCells walled(5, 1);
+		walled.addSource(0);
+		walled.blocked[2] = true;
+		field.build(&walled, walled.w, walled.h, walled.sources);
+		CPPUNIT_ASSERT_EQUAL( (int)DistanceField::unreachable, field.getDistance(3) );
+		CPPUNIT_ASSERT_EQUAL( -1, field.getNearestSource(3) );
+		CPPUNIT_ASSERT_EQUAL( -1, field.getNearestSource(2) );
+	}
+
+	void test_build() {
+		for(unsigned int seed = 1; seed <= 20; ++seed) {
+			TestCells cells(24, 17);
+			cells.randomize(seed);
+
+			DistanceField field;
+			field.build(&cells, cells.w, cells.h, cells.sources);
+			CPPUNIT_ASSERT( matchesReference(cells, field) == true );
+		}
+	}
+
+	void test_build_order() {
+		TestCells cells(32, 32);
+		cells.randomize(7);
+
+		DistanceField field;
+		field.build(&cells, cells.w, cells.h, cells.sources);
+
+		std::vector<int> reversed(cells.sources.rbegin(), cells.sources.rend());
+		DistanceField reversedField;
+		reversedField.build(&cells, cells.w, cells.h, reversed);
+
+		for(int cellIndex = 0; cellIndex < cells.w * cells.h; ++cellIndex) {
+			CPPUNIT_ASSERT_EQUAL( field.getDistance(cellIndex), reversedField.getDistance(cellIndex) );
+			CPPUNIT_ASSERT_EQUAL( field.getNearestSource(cellIndex), reversedField.getNearestSource(cellIndex) );
+		}
+	}
+
+	void test_remove_source() {
+		for(unsigned int seed = 1; seed <= 10; ++seed) {
+			TestCells cells(24, 17);
+			cells.randomize(seed);
+
+			// The other field sees the freed cells open up, like the fields
+			// of the other resource types
+			TestCells otherCells(24, 17);
+			otherCells.blocked = cells.blocked;
+			otherCells.sources.push_back(0);
+
+			DistanceField field;
+			field.build(&cells, cells.w, cells.h, cells.sources);
+			DistanceField otherField;
+			otherField.build(&otherCells, otherCells.w, otherCells.h, otherCells.sources);
+
+			while(cells.sources.empty() == false) {
+				int cellIndex = cells.sources[rand() % cells.sources.size()];
+				cells.removeSource(cellIndex);
+				otherCells.blocked[cellIndex] = false;
+				field.removeSource(&cells, cellIndex);
+				otherField.openCell(&otherCells, cellIndex);
+
+				// Repaired exactly as a field built now would be
+				CPPUNIT_ASSERT( matchesReference(cells, field) == true );
+				CPPUNIT_ASSERT( matchesReference(otherCells, otherField) == true );
+			}
+			CPPUNIT_ASSERT_EQUAL( -1, field.getNearestSource(0) );
+		}
+	}
+
+	void test_open_cell() {
+		TestCells cells(24, 17);
+		cells.randomize(3);
+
+		DistanceField field;
+		field.build(&cells, cells.w, cells.h, cells.sources);
+		for(int cellIndex = 0; cellIndex < cells.w * cells.h; ++cellIndex) {
+			if(cells.blocked[cellIndex] == true &&
+				std::find(cells.sources.begin(), cells.sources.end(), cellIndex) == cells.sources.end()) {
+				cells.blocked[cellIndex] = false;
+				field.openCell(&cells, cellIndex);
+				CPPUNIT_ASSERT( matchesReference(cells, field) == true );
+			}
+		}
+	}
+};
+
+// Test Suite Registrations
+CPPUNIT_TEST_SUITE_REGISTRATION( DistanceFieldTest );
+//
@@ -0,0 +1,114 @@
+// ==============================================================
+//	This file is part of MegaGlest Unit Tests (www.megaglest.org)
+//
+//	Copyright (C) 2013 Mark Vejvoda
+//
+//	You can redistribute this code and/or modify it under
+//	the terms of the GNU General Public License as published
+//	by the Free Software Foundation; either version 2 of the
+//	License, or (at your option) any later version
+// ==============================================================
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "platform_common.h"
+#include <vector>
+#include <algorithm>
+
+using namespace Shared::PlatformCommon;
+
+//
+// Tests for matching per file CRC lists of a folder tree between hosts
+//
+class FolderTreeDeltaTest : public CppUnit::TestFixture {
+	// Register the suite of tests for this fixture
+	CPPUNIT_TEST_SUITE( FolderTreeDeltaTest );
+
+	CPPUNIT_TEST( test_relative_path );
+	CPPUNIT_TEST( test_relative_path_install_root_named_like_techtree );
+	CPPUNIT_TEST( test_mismatches_across_install_roots );
+
+	CPPUNIT_TEST_SUITE_END();
+	// End of Fixture registration
+
+public:
+
+	void test_relative_path() {
+		vector<string> rootPaths;
+		rootPaths.push_back("/usr/share/megaglest/techs");
+		rootPaths.push_back("C:\\megaglest\\techs\\");
+		rootPaths.push_back("/home/user/techs/");
+
+		CPPUNIT_ASSERT_EQUAL( string("factions/magic/magic.xml"),
+				getFolderTreeRelativePath("/usr/share/megaglest/techs/megapack/factions/magic/magic.xml",rootPaths,"megapack") );
+		CPPUNIT_ASSERT_EQUAL( string("megapack.xml"),
+				getFolderTreeRelativePath("C:\\megaglest\\techs\\megapack\\megapack.xml",rootPaths,"megapack") );
+		// A sub folder sharing the techtree name stays part of the path
+		CPPUNIT_ASSERT_EQUAL( string("factions/mod/mod.xml"),
+				getFolderTreeRelativePath("/home/user/techs/mod/factions/mod/mod.xml",rootPaths,"mod") );
+		CPPUNIT_ASSERT_EQUAL( string(""),
+				getFolderTreeRelativePath("/home/user/techs/other/other.xml",rootPaths,"mod") );
+		// Paths the host already sent relative to its techs folder
+		CPPUNIT_ASSERT_EQUAL( string("factions/a/a.xml"),
+				getFolderTreeRelativePath("mod/factions/a/a.xml",rootPaths,"mod") );
+		CPPUNIT_ASSERT_EQUAL( string("mod/factions/a/a.xml"),
+				getFolderTreeRootRelativePath("/home/user/techs/mod/factions/a/a.xml",rootPaths) );
+	}
+
+	void test_relative_path_install_root_named_like_techtree() {
+		// The install root itself holds a folder with the techtree's name
+		vector<string> rootPaths;
+		rootPaths.push_back("C:\\games\\megapack\\techs");
+
+		CPPUNIT_ASSERT_EQUAL( string("factions/magic/magic.xml"),
+				getFolderTreeRelativePath("C:\\games\\megapack\\techs\\megapack\\factions\\magic\\magic.xml",rootPaths,"megapack") );
+		CPPUNIT_ASSERT_EQUAL( string(""),
+				getFolderTreeRelativePath("C:\\games\\megapack\\techs\\other\\other.xml",rootPaths,"megapack") );
+	}
+
+	void test_mismatches_across_install_roots() {
+		vector<string> rootPaths;
+		rootPaths.push_back("/usr/share/megaglest/techs");
+		rootPaths.push_back("/home/user/.megaglest/techs");
+
+		vector<std::pair<string,uint32> > localList;
+		localList.push_back(std::pair<string,uint32>("/home/user/.megaglest/techs/mod/mod.xml",1));
+		localList.push_back(std::pair<string,uint32>("/home/user/.megaglest/techs/mod/factions/a/a.xml",2));
+		localList.push_back(std::pair<string,uint32>("/home/user/.megaglest/techs/mod/factions/old/old.xml",3));
+
+		// As sent by the host, relative to its techs folder
+		vector<std::pair<string,uint32> > remoteList;
+		remoteList.push_back(std::pair<string,uint32>("mod/mod.xml",1));
+		remoteList.push_back(std::pair<string,uint32>("mod/factions/a/a.xml",20));
+		remoteList.push_back(std::pair<string,uint32>("mod/factions/b/b.xml",4));
+
+		vector<string> localOnlyFiles;
+		vector<string> changedFiles = getFolderTreeContentsCheckSumListMismatches(
+				localList,remoteList,rootPaths,"mod",&localOnlyFiles);
+
+		CPPUNIT_ASSERT_EQUAL( (size_t)2, changedFiles.size() );
+		CPPUNIT_ASSERT( std::find(changedFiles.begin(),changedFiles.end(),"factions/a/a.xml") != changedFiles.end() );
+		CPPUNIT_ASSERT( std::find(changedFiles.begin(),changedFiles.end(),"factions/b/b.xml") != changedFiles.end() );
+
+		CPPUNIT_ASSERT_EQUAL( (size_t)1, localOnlyFiles.size() );
+		CPPUNIT_ASSERT_EQUAL( string("/home/user/.megaglest/techs/mod/factions/old/old.xml"), localOnlyFiles[0] );
+
+		// Identical trees need nothing
+		changedFiles = getFolderTreeContentsCheckSumListMismatches(localList,localList,rootPaths,"mod",&localOnlyFiles);
+		CPPUNIT_ASSERT( changedFiles.empty() == true );
+		CPPUNIT_ASSERT( localOnlyFiles.empty() == true );
+
+		// The content CRC agrees between install roots and skips excluded files
+		vector<std::pair<string,uint32> > otherRootList;
+		otherRootList.push_back(std::pair<string,uint32>("/usr/share/megaglest/techs/mod/mod.xml",10));
+		otherRootList.push_back(std::pair<string,uint32>("/usr/share/megaglest/techs/mod/factions/a/a.xml",2));
+		otherRootList.push_back(std::pair<string,uint32>("/usr/share/megaglest/techs/mod/factions/old/old.xml",3));
+		CPPUNIT_ASSERT_EQUAL( getFolderTreeContentsCheckSumExcluding(localList,rootPaths,"mod","mod.xml"),
+				getFolderTreeContentsCheckSumExcluding(otherRootList,rootPaths,"mod","mod.xml") );
+		CPPUNIT_ASSERT( getFolderTreeContentsCheckSumExcluding(localList,rootPaths,"mod",".png") !=
+				getFolderTreeContentsCheckSumExcluding(otherRootList,rootPaths,"mod",".png") );
+	}
+};
+
+// Test Suite Registrations
+CPPUNIT_TEST_SUITE_REGISTRATION( FolderTreeDeltaTest );
+//
@@ -0,0 +1,150 @@
+// ==============================================================
+//	This file is part of MegaGlest Unit Tests (www.megaglest.org)
+//
+//	Copyright (C) 2013 Mark Vejvoda
+//
+//	You can redistribute this code and/or modify it under
+//	the terms of the GNU General Public License as published
+//	by the Free Software Foundation; either version 2 of the
+//	License, or (at your option) any later version
+// ==============================================================
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "lag_estimator.h"
+
+using namespace Shared::Util;
+
+// Keyframes go out every 100ms, 10 frames apart
+static const int keyframeFrames = 10;
+static const int64 keyframeMicros = 100000;
+
+// What the server does on each keyframe: record it and, when it is new,
+// sample the client against it
+static void broadcastKeyframe(KeyframeHistory &history, LagEstimate &estimate,
+		int frameCount, int64 nowMicros, int clientFrameCount) {
+	if(history.add(frameCount, nowMicros) == true && clientFrameCount > 0) {
+		int64 broadcastMicros = history.getBroadcastMicros(clientFrameCount);
+		if(broadcastMicros >= 0) {
+			estimate.addSample(clientFrameCount, (nowMicros - broadcastMicros) / 1000.0);
+		}
+	}
+}
+
+//
+// Tests for the keyframe history and client lag estimate
+//
+class LagEstimatorTest : public CppUnit::TestFixture {
+	// Register the suite of tests for this fixture
+	CPPUNIT_TEST_SUITE( LagEstimatorTest );
+
+	CPPUNIT_TEST( test_history_lookup );
+	CPPUNIT_TEST( test_history_restart );
+	CPPUNIT_TEST( test_paused_server );
+	CPPUNIT_TEST( test_stalled_client );
+
+	CPPUNIT_TEST_SUITE_END();
+	// End of Fixture registration
+
+public:
+
+	void test_history_lookup() {
+		KeyframeHistory history;
+		CPPUNIT_ASSERT_EQUAL( (int64)-1, history.getBroadcastMicros(10) );
+
+		for(int index = 1; index <= KeyframeHistory::historySize + 10; ++index) {
+			CPPUNIT_ASSERT( history.add(index * keyframeFrames, index * keyframeMicros) == true );
+		}
+		int lastFrame = (KeyframeHistory::historySize + 10) * keyframeFrames;
+		CPPUNIT_ASSERT_EQUAL( lastFrame, history.getLastFrame() );
+		CPPUNIT_ASSERT_EQUAL( (int64)(20 * keyframeMicros), history.getBroadcastMicros(20 * keyframeFrames) );
+
+		// Older than the whole history gets the oldest time as a lower bound
+		CPPUNIT_ASSERT_EQUAL( (int64)(11 * keyframeMicros), history.getBroadcastMicros(keyframeFrames) );
+		// Frames never broadcast are not guessed
+		CPPUNIT_ASSERT_EQUAL( (int64)-1, history.getBroadcastMicros(20 * keyframeFrames + 1) );
+		CPPUNIT_ASSERT_EQUAL( (int64)-1, history.getBroadcastMicros(lastFrame + keyframeFrames) );
+	}
+
+	void test_history_restart() {
+		KeyframeHistory history;
+		history.add(500, 1000);
+		history.add(510, 2000);
+
+		// A new game starts counting frames from the beginning
+		CPPUNIT_ASSERT( history.add(10, 3000) == true );
+		CPPUNIT_ASSERT_EQUAL( 10, history.getLastFrame() );
+		CPPUNIT_ASSERT_EQUAL( (int64)-1, history.getBroadcastMicros(500) );
+		CPPUNIT_ASSERT_EQUAL( (int64)3000, history.getBroadcastMicros(10) );
+	}
+
+	void test_paused_server() {
+		KeyframeHistory history;
+		LagEstimate estimate;
+
+		// Client one keyframe behind
+		int64 nowMicros = 0;
+		int frameCount = 0;
+		for(int index = 1; index <= 20; ++index) {
+			frameCount = index * keyframeFrames;
+			nowMicros = index * keyframeMicros;
+			broadcastKeyframe(history, estimate, frameCount, nowMicros, frameCount - keyframeFrames);
+		}
+		CPPUNIT_ASSERT_EQUAL( 19, estimate.getSampleCount() );
+		double settledLagMillis = estimate.getLagMillis();
+		CPPUNIT_ASSERT( settledLagMillis > 99.0 && settledLagMillis < 101.0 );
+
+		// Paused for 10 seconds, the same keyframe goes out 40 times a second
+		for(int index = 0; index < 400; ++index) {
+			nowMicros += 25000;
+			CPPUNIT_ASSERT( history.add(frameCount, nowMicros) == false );
+			broadcastKeyframe(history, estimate, frameCount, nowMicros, frameCount);
+		}
+
+		// Neither the history nor the estimate moved
+		CPPUNIT_ASSERT_EQUAL( 19, estimate.getSampleCount() );
+		CPPUNIT_ASSERT_EQUAL( settledLagMillis, estimate.getLagMillis() );
+		CPPUNIT_ASSERT_EQUAL( (int64)(keyframeMicros), history.getBroadcastMicros(keyframeFrames) );
+		CPPUNIT_ASSERT_EQUAL( (int64)(20 * keyframeMicros), history.getBroadcastMicros(frameCount) );
+		CPPUNIT_ASSERT( estimate.isStalled() == false );
+	}
+
+	void test_stalled_client() {
+		KeyframeHistory history;
+		LagEstimate estimate;
+
+		int frameCount = 0;
+		for(int index = 1; index <= 40; ++index) {
+			frameCount = index * keyframeFrames;
+			broadcastKeyframe(history, estimate, frameCount, index * keyframeMicros, frameCount - keyframeFrames);
+			CPPUNIT_ASSERT( estimate.isStalled() == false );
+		}
+		double settledPredictedMillis = estimate.getPredictedMillis();
+
+		// The client stops at its last frame while the server goes on
+		int clientFrameCount = frameCount - keyframeFrames;
+		for(int index = 41; index <= 40 + LagEstimate::stallSampleCount; ++index) {
+			frameCount = index * keyframeFrames;
+			broadcastKeyframe(history, estimate, frameCount, index * keyframeMicros, clientFrameCount);
+		}
+		CPPUNIT_ASSERT( estimate.isStalled() == true );
+
+		// The smoothed lag is still well short of the real one, which is
+		// why a stalled client is not judged on it
+		double realLagMillis = (frameCount - clientFrameCount) / keyframeFrames * keyframeMicros / 1000.0;
+		CPPUNIT_ASSERT( estimate.getLagMillis() < realLagMillis );
+		CPPUNIT_ASSERT( settledPredictedMillis < realLagMillis );
+
+		// Once it moves again it is no longer stalled
+		frameCount += keyframeFrames;
+		broadcastKeyframe(history, estimate, frameCount, (frameCount / keyframeFrames) * keyframeMicros, clientFrameCount + keyframeFrames);
+		CPPUNIT_ASSERT( estimate.isStalled() == false );
+
+		estimate.clear();
+		CPPUNIT_ASSERT_EQUAL( 0, estimate.getSampleCount() );
+		CPPUNIT_ASSERT( estimate.isStalled() == false );
+	}
+};
+
+// Test Suite Registrations
+CPPUNIT_TEST_SUITE_REGISTRATION( LagEstimatorTest );
+//
@@ -0,0 +1,155 @@
+// ==============================================================
+//	This file is part of MegaGlest Unit Tests (www.megaglest.org)
+//
+//	Copyright (C) 2013 Mark Vejvoda
+//
+//	You can redistribute this code and/or modify it under
+//	the terms of the GNU General Public License as published
+//	by the Free Software Foundation; either version 2 of the
+//	License, or (at your option) any later version
+// ==============================================================
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "thread.h"
+#include <string>
+#include <vector>
+
+using namespace Shared::Platform;
+
+static const int producerCount 		= 4;
+static const int pushesPerProducer 	= 20000;
+
+//
+// Tests for the queue between ConnectionSlotThreads and the game thread
+//
+class LockFreeQueueTest : public CppUnit::TestFixture {
+	// Register the suite of tests for this fixture
+	CPPUNIT_TEST_SUITE( LockFreeQueueTest );
+
+	CPPUNIT_TEST( test_fifo_order );
+	CPPUNIT_TEST( test_interleaved_push_pop );
+	CPPUNIT_TEST( test_multiple_producers );
+
+	CPPUNIT_TEST_SUITE_END();
+	// End of Fixture registration
+
+private:
+
+	class ProducerArgs {
+	public:
+		LockFreeQueue<int> *queue;
+		SDL_atomic_t *finishedProducers;
+		int producerIndex;
+	};
+
+	// Each value encodes its producer and that producer's sequence number
+	static int producerExecute(void *data) {
+		ProducerArgs *args = static_cast<ProducerArgs *>(data);
+		for(int sequence = 0; sequence < pushesPerProducer; ++sequence) {
+			args->queue->push(args->producerIndex * pushesPerProducer + sequence);
+		}
+		SDL_AtomicAdd(args->finishedProducers,1);
+		return 0;
+	}
+
+public:
+
+	void test_fifo_order() {
+		LockFreeQueue<int> queue;
+		int value = -1;
+		CPPUNIT_ASSERT( queue.empty() == true );
+		CPPUNIT_ASSERT( queue.pop(value) == false );
+
+		for(int index = 0; index < 100; ++index) {
+			queue.push(index);
+		}
+		CPPUNIT_ASSERT( queue.empty() == false );
+		for(int index = 0; index < 100; ++index) {
+			CPPUNIT_ASSERT( queue.pop(value) == true );
+			CPPUNIT_ASSERT_EQUAL( index, value );
+		}
+		CPPUNIT_ASSERT( queue.pop(value) == false );
+		CPPUNIT_ASSERT( queue.empty() == true );
+	}
+
+	void test_interleaved_push_pop() {
+		LockFreeQueue<std::string> queue;
+		std::string value;
+
+		// The last node left in the queue has to come out through the stub
+		queue.push("a");
+		CPPUNIT_ASSERT( queue.pop(value) == true );
+		CPPUNIT_ASSERT_EQUAL( std::string("a"), value );
+		CPPUNIT_ASSERT( queue.pop(value) == false );
+
+		queue.push("b");
+		queue.push("c");
+		CPPUNIT_ASSERT( queue.pop(value) == true );
+		CPPUNIT_ASSERT_EQUAL( std::string("b"), value );
+		queue.push("d");
+		CPPUNIT_ASSERT( queue.pop(value) == true );
+		CPPUNIT_ASSERT_EQUAL( std::string("c"), value );
+		CPPUNIT_ASSERT( queue.pop(value) == true );
+		CPPUNIT_ASSERT_EQUAL( std::string("d"), value );
+		CPPUNIT_ASSERT( queue.empty() == true );
+
+		// Nodes still queued are freed with the queue
+		queue.push("e");
+	}
+
+	void test_multiple_producers() {
+		LockFreeQueue<int> queue;
+		SDL_atomic_t finishedProducers;
+		SDL_AtomicSet(&finishedProducers,0);
+
+		ProducerArgs args[producerCount];
+		SDL_Thread *threads[producerCount];
+		for(int index = 0; index < producerCount; ++index) {
+			args[index].queue 				= &queue;
+			args[index].finishedProducers 	= &finishedProducers;
+			args[index].producerIndex 		= index;
+			threads[index] = SDL_CreateThread(producerExecute, "lockFreeQueueProducer", &args[index]);
+			CPPUNIT_ASSERT( threads[index] != NULL );
+		}
+
+		// Pop on this thread while the producers are still pushing. Errors are
+		// only counted here, asserting has to wait until the threads are joined
+		std::vector<int> nextSequence(producerCount,0);
+		int received = 0;
+		int orderErrors = 0;
+		int value = -1;
+		for(;;) {
+			if(queue.pop(value) == true) {
+				int producerIndex = value / pushesPerProducer;
+				// Values from one producer come out in the order pushed and
+				// none is skipped or repeated
+				if(producerIndex < 0 || producerIndex >= producerCount ||
+					value % pushesPerProducer != nextSequence[producerIndex]) {
+					orderErrors++;
+				}
+				else {
+					nextSequence[producerIndex]++;
+				}
+				received++;
+			}
+			else if(SDL_AtomicGet(&finishedProducers) == producerCount &&
+					queue.empty() == true) {
+				break;
+			}
+		}
+
+		for(int index = 0; index < producerCount; ++index) {
+			SDL_WaitThread(threads[index], NULL);
+		}
+		CPPUNIT_ASSERT_EQUAL( 0, orderErrors );
+		for(int index = 0; index < producerCount; ++index) {
+			CPPUNIT_ASSERT_EQUAL( pushesPerProducer, nextSequence[index] );
+		}
+		CPPUNIT_ASSERT_EQUAL( producerCount * pushesPerProducer, received );
+		CPPUNIT_ASSERT( queue.pop(value) == false );
+	}
+};
+
+// Test Suite Registrations
+CPPUNIT_TEST_SUITE_REGISTRATION( LockFreeQueueTest );
+//
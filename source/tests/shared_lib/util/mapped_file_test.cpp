@@ -0,0 +1,104 @@
+// ==============================================================
+//	This file is part of MegaGlest Unit Tests (www.megaglest.org)
+//
+//	Copyright (C) 2013 Mark Vejvoda
+//
+//	You can redistribute this code and/or modify it under
+//	the terms of the GNU General Public License as published
+//	by the Free Software Foundation; either version 2 of the
+//	License, or (at your option) any later version
+// ==============================================================
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cstdio>
+#include "mapped_file.h"
+#include "platform_common.h"
+
+using namespace Shared::PlatformCommon;
+
+//
+// Tests for the memory mapped file reader
+//
+class MappedFileTest : public CppUnit::TestFixture {
+	// Register the suite of tests for this fixture
+	CPPUNIT_TEST_SUITE( MappedFileTest );
+
+	CPPUNIT_TEST( test_read_like_fread );
+	CPPUNIT_TEST( test_skip_like_fseek );
+	CPPUNIT_TEST( test_missing_file );
+
+	CPPUNIT_TEST_SUITE_END();
+	// End of Fixture registration
+
+private:
+
+	const string testFile;
+
+	void writeTestFile(int valueCount) {
+		FILE *file = fopen(testFile.c_str(),"wb");
+		CPPUNIT_ASSERT( file != NULL );
+		for(int value = 0; value < valueCount; ++value) {
+			fwrite(&value, sizeof(value), 1, file);
+		}
+		fclose(file);
+	}
+
+public:
+
+	MappedFileTest() : testFile("mapped_file_test.bin") {}
+
+	void tearDown() {
+		removeFile(testFile);
+	}
+
+	void test_read_like_fread() {
+		writeTestFile(10);
+
+		MappedFile file;
+		CPPUNIT_ASSERT( file.open(testFile) == true );
+		CPPUNIT_ASSERT_EQUAL( sizeof(int) * 10, file.getSize() );
+
+		int values[4] = { -1, -1, -1, -1 };
+		CPPUNIT_ASSERT_EQUAL( (size_t)4, file.read(values, sizeof(int), 4) );
+		CPPUNIT_ASSERT_EQUAL( 0, values[0] );
+		CPPUNIT_ASSERT_EQUAL( 3, values[3] );
+
+		// One block of four ints, then only whole items are returned
+		CPPUNIT_ASSERT_EQUAL( (size_t)1, file.read(values, sizeof(int) * 4, 1) );
+		CPPUNIT_ASSERT_EQUAL( 4, values[0] );
+		CPPUNIT_ASSERT_EQUAL( (size_t)0, file.read(values, sizeof(int) * 4, 1) );
+		CPPUNIT_ASSERT_EQUAL( (size_t)2, file.read(values, sizeof(int), 4) );
+		CPPUNIT_ASSERT_EQUAL( 9, values[1] );
+		CPPUNIT_ASSERT_EQUAL( file.getSize(), file.getPosition() );
+	}
+
+	void test_skip_like_fseek() {
+		writeTestFile(10);
+
+		MappedFile file;
+		CPPUNIT_ASSERT( file.open(testFile) == true );
+
+		int value = -1;
+		CPPUNIT_ASSERT_EQUAL( 0, file.skip(sizeof(int) * 7) );
+		CPPUNIT_ASSERT_EQUAL( (size_t)1, file.read(&value, sizeof(int), 1) );
+		CPPUNIT_ASSERT_EQUAL( 7, value );
+
+		CPPUNIT_ASSERT_EQUAL( 0, file.skip(-(long)sizeof(int) * 2) );
+		CPPUNIT_ASSERT_EQUAL( (size_t)1, file.read(&value, sizeof(int), 1) );
+		CPPUNIT_ASSERT_EQUAL( 6, value );
+
+		CPPUNIT_ASSERT_EQUAL( -1, file.skip(sizeof(int) * 10) );
+		CPPUNIT_ASSERT_EQUAL( -1, file.skip(-(long)sizeof(int) * 10) );
+	}
+
+	void test_missing_file() {
+		MappedFile file;
+		CPPUNIT_ASSERT( file.open("mapped_file_test_missing.bin") == false );
+		CPPUNIT_ASSERT( file.isOpen() == false );
+		CPPUNIT_ASSERT_EQUAL( (size_t)0, file.getSize() );
+	}
+};
+
+// Test Suite Registrations
+CPPUNIT_TEST_SUITE_REGISTRATION( MappedFileTest );
+//
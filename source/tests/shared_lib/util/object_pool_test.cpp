@@ -0,0 +1,104 @@
+// ==============================================================
+//	This file is part of MegaGlest Unit Tests (www.megaglest.org)
+//
+//	Copyright (C) 2013 Mark Vejvoda
+//
+//	You can redistribute this code and/or modify it under
+//	the terms of the GNU General Public License as published
+//	by the Free Software Foundation; either version 2 of the
+//	License, or (at your option) any later version
+// ==============================================================
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "object_pool.h"
+#include <vector>
+#include <set>
+
+using namespace Shared::Util;
+
+//
+// Tests for the object pool and scratch vectors
+//
+class ObjectPoolTest : public CppUnit::TestFixture {
+	// Register the suite of tests for this fixture
+	CPPUNIT_TEST_SUITE( ObjectPoolTest );
+
+	CPPUNIT_TEST( test_allocate_recycles_blocks );
+	CPPUNIT_TEST( test_allocate_grows_by_chunk );
+	CPPUNIT_TEST( test_scratch_vector_keeps_capacity );
+
+	CPPUNIT_TEST_SUITE_END();
+	// End of Fixture registration
+
+public:
+
+	void test_allocate_recycles_blocks() {
+		ObjectPool pool("test",24,8);
+
+		void *first = pool.allocate();
+		CPPUNIT_ASSERT( first != NULL );
+		CPPUNIT_ASSERT_EQUAL( (int64)1, pool.getLiveCount() );
+
+		pool.deallocate(first);
+		CPPUNIT_ASSERT_EQUAL( (int64)0, pool.getLiveCount() );
+
+		// The last freed block is handed out again
+		void *second = pool.allocate();
+		CPPUNIT_ASSERT( first == second );
+		CPPUNIT_ASSERT_EQUAL( (int64)2, pool.getAllocationCount() );
+		CPPUNIT_ASSERT_EQUAL( (int64)1, pool.getPeakCount() );
+
+		pool.deallocate(second);
+	}
+
+	void test_allocate_grows_by_chunk() {
+		const int blockCount = 20;
+		ObjectPool pool("test",sizeof(double) * 3,8);
+
+		std::vector<void *> blocks;
+		std::set<void *> uniqueBlocks;
+		for(int index = 0; index < blockCount; ++index) {
+			double *block = static_cast<double *>(pool.allocate());
+			block[0] = block[1] = block[2] = index;
+			blocks.push_back(block);
+			uniqueBlocks.insert(block);
+		}
+		CPPUNIT_ASSERT_EQUAL( (size_t)blockCount, uniqueBlocks.size() );
+		CPPUNIT_ASSERT_EQUAL( (size_t)3, pool.getChunkCount() );
+		CPPUNIT_ASSERT_EQUAL( (int64)blockCount, pool.getLiveCount() );
+
+		// Writes to one block must not spill into its neighbours
+		for(int index = 0; index < blockCount; ++index) {
+			double *block = static_cast<double *>(blocks[index]);
+			CPPUNIT_ASSERT_EQUAL( (double)index, block[2] );
+		}
+
+		for(int index = 0; index < blockCount; ++index) {
+			pool.deallocate(blocks[index]);
+		}
+		CPPUNIT_ASSERT_EQUAL( (int64)0, pool.getLiveCount() );
+		CPPUNIT_ASSERT_EQUAL( (int64)blockCount, pool.getPeakCount() );
+	}
+
+	void test_scratch_vector_keeps_capacity() {
+		ScratchVectorPool<int> pool;
+
+		size_t capacity = 0;
+		{
+			ScratchVector<int> list(pool);
+			for(int index = 0; index < 100; ++index) {
+				list.get().push_back(index);
+			}
+			capacity = list.get().capacity();
+		}
+
+		// Borrowing again gets the same, emptied vector back
+		ScratchVector<int> list(pool);
+		CPPUNIT_ASSERT( list.get().empty() == true );
+		CPPUNIT_ASSERT_EQUAL( capacity, list.get().capacity() );
+	}
+};
+
+// Test Suite Registrations
+CPPUNIT_TEST_SUITE_REGISTRATION( ObjectPoolTest );
+//
@@ -335,6 +335,7 @@ class XmlNodeTest : public CppUnit::TestFixture {
 	CPPUNIT_TEST( test_valid_named_node );
 	CPPUNIT_TEST( test_child_nodes );
 	CPPUNIT_TEST( test_node_attributes );
+	CPPUNIT_TEST( test_child_copy );
 
 	CPPUNIT_TEST_SUITE_END();
 	// End of Fixture registration
@@ -471,6 +472,27 @@ public:
 		CPPUNIT_ASSERT_EQUAL( true, node.hasAttribute("some-attribute") );
 	}
 
+	void test_child_copy() {
+		std::map<string,string> mapTagReplacementValues;
+		XmlNode sourceNode("sourceNode");
+		sourceNode.addAttribute("some-attribute", "some-value", mapTagReplacementValues);
+		XmlNode *childNode1 = sourceNode.addChild("child1", "child1Value");
+		childNode1->addAttribute("child-attribute", "child-value", mapTagReplacementValues);
+		childNode1->addChild("childchild1", "testValue");
+
+		XmlNode node("testNode");
+		XmlNode *copyNode = node.addChildCopy(&sourceNode);
+		CPPUNIT_ASSERT_EQUAL( (size_t)1,node.getChildCount() );
+		CPPUNIT_ASSERT_EQUAL( string("sourceNode"), copyNode->getName() );
+		CPPUNIT_ASSERT_EQUAL( string("some-value"), copyNode->getAttribute("some-attribute")->getValue() );
+
+		XmlNode *copyChildNode1 = copyNode->getChild("child1");
+		CPPUNIT_ASSERT( copyChildNode1 != childNode1 );
+		CPPUNIT_ASSERT_EQUAL( string("child1Value"), copyChildNode1->getText() );
+		CPPUNIT_ASSERT_EQUAL( string("child-value"), copyChildNode1->getAttribute("child-attribute")->getValue() );
+		CPPUNIT_ASSERT_EQUAL( string("testValue"), copyChildNode1->getChild("childchild1")->getText() );
+	}
+
 };
 
 #if defined(WANT_XERCES)
@@ -12,12 +12,26 @@
 #include <cppunit/CompilerOutputter.h>
 #include <cppunit/extensions/TestFactoryRegistry.h>
 #include <cppunit/ui/text/TestRunner.h>
+#include <cstring>
 
+// Benchmarks are registered under this name instead of the default
+// registry, they time work rather than check it and only run when the
+// runner is started with --benchmark
+static const char *benchmarkRegistryName = "benchmark";
 
 int main(int argc, char* argv[])
 {
+  bool runBenchmarks = false;
+  for(int i = 1; i < argc; ++i) {
+    if(strcmp(argv[i],"--benchmark") == 0) {
+      runBenchmarks = true;
+    }
+  }
+
   // Get the top level suite from the registry
-  CppUnit::Test *suite = CppUnit::TestFactoryRegistry::getRegistry().makeTest();
+  CppUnit::Test *suite = (runBenchmarks == true ?
+		  CppUnit::TestFactoryRegistry::getRegistry(benchmarkRegistryName).makeTest() :
+		  CppUnit::TestFactoryRegistry::getRegistry().makeTest());
 
   // Adds the test to the list of test to run
   CppUnit::TextUi::TestRunner runner;